@@ -24,7 +24,8 @@ from .parser import (Parser, create_obj_instance, generate_scope,
                      get_ast_type, get_node_type, get_args, get_args_default_values,
                      get_ast_namespace_symbol, get_operation_namespace_symbol,
                      get_parse_method_of_class, get_scope_name, expand_expr_statement,
-                     is_class_member, parse_cb, resolve_symbol, convert_to_ms_tensor, get_object_description)
+                     is_class_member, parse_cb, resolve_symbol, convert_to_ms_tensor, get_object_description,
+                     get_compile_cache_key)
 
 __all__ = ['parse_cb', 'get_parse_method_of_class', 'get_bprop_method_of_class', 'resolve_symbol',
            'get_object_key', 'get_class_instance_type', 'is_class_member', 'get_ast_type', 'get_node_type',
@@ -32,4 +33,5 @@ __all__ = ['parse_cb', 'get_parse_method_of_class', 'get_bprop_method_of_class',
            'get_args', 'get_obj_type', 'get_obj_id', 'create_obj_instance', 'get_module_namespace',
            'get_class_member_namespace_symbol', 'get_obj_id', 'Parser', 'get_dataclass_attributes',
            'get_dataclass_methods', 'get_dataclass_methods', 'get_scope_name',
-           'create_slice_obj', 'convert_to_ms_tensor', 'get_object_description', 'expand_expr_statement']
+           'create_slice_obj', 'convert_to_ms_tensor', 'get_object_description', 'expand_expr_statement',
+           'get_compile_cache_key']
@@ -19,6 +19,8 @@
 import ast
 import hashlib
 import inspect
+import os
+import sys
 import types
 from dataclasses import is_dataclass
 from textwrap import dedent
@@ -31,7 +33,7 @@ from mindspore import log as logger
 from mindspore import nn
 from mindspore import ops
 from mindspore.common.api import _MindSporeFunction
-from mindspore.common.dtype import pytype_to_dtype
+from mindspore.common.dtype import pytype_to_dtype, Type as MsType
 from .namespace import CellNamespace, ClosureNamespace, ClassMemberNamespace
 from .resources import parse_object_map, convert_object_map, trope_ns, SYMBOL_UNDEFINE, NO_IMPLEMENT
 
@@ -372,6 +374,112 @@ def get_object_description(obj, fname, fline):
     return str(obj)
 
 
+def _update_source_hash(sha, obj, visited_files):
+    """Feed the source file that defines obj into the hash, once per file."""
+    try:
+        source_file = inspect.getsourcefile(obj)
+    except TypeError:
+        return
+    if source_file is None or source_file in visited_files:
+        return
+    visited_files.add(source_file)
+    with open(source_file, 'rb') as f:
+        sha.update(f.read())
+
+
+def _is_user_module(module):
+    """Whether the module is user code, rather than MindSpore, whose version is hashed, or an installed package."""
+    module_file = getattr(module, '__file__', None)
+    if module_file is None:
+        return False
+    module_file = os.path.realpath(module_file)
+    excluded_dirs = {os.path.dirname(os.path.dirname(os.path.realpath(__file__))), os.path.realpath(sys.prefix),
+                     os.path.realpath(sys.base_prefix)}
+    excluded_dirs.add(os.path.dirname(os.path.realpath(os.__file__)))
+    return not any(module_file.startswith(excluded_dir + os.sep) for excluded_dir in excluded_dirs)
+
+
+def _update_module_hash(sha, module, visited_files, visited_modules):
+    """Feed the sources of a user module, and of the user modules it imports or takes names from, into the hash."""
+    if module is None or module in visited_modules or not _is_user_module(module):
+        return
+    visited_modules.add(module)
+    _update_source_hash(sha, module, visited_files)
+    for value in list(vars(module).values()):
+        if isinstance(value, types.ModuleType):
+            _update_module_hash(sha, value, visited_files, visited_modules)
+        elif isinstance(value, (type, types.FunctionType)):
+            _update_module_hash(sha, inspect.getmodule(value), visited_files, visited_modules)
+
+
+def _update_value_hash(sha, value):
+    """Feed an attribute value the graph could depend on into the hash."""
+    if value is None or isinstance(value, (bool, int, float, str, MsType)):
+        sha.update(f'{value!r};'.encode())
+    elif isinstance(value, (tuple, list)):
+        sha.update(f'{type(value).__name__}[{len(value)}]'.encode())
+        for element in value:
+            _update_value_hash(sha, element)
+    elif isinstance(value, dict):
+        sha.update(f'dict[{len(value)}]'.encode())
+        for key, element in sorted(value.items(), key=lambda item: repr(item[0])):
+            _update_value_hash(sha, key)
+            _update_value_hash(sha, element)
+    elif isinstance(value, MsTensor):
+        sha.update(f'Tensor:{value.shape}:{value.dtype};'.encode())
+        if value.has_init:
+            sha.update(f'{value.init!r};'.encode())
+        else:
+            sha.update(value.asnumpy().tobytes())
+    elif isinstance(value, ops.Primitive):
+        sha.update(f'Primitive:{value.name}'.encode())
+        _update_value_hash(sha, value.attrs)
+    else:
+        # Other objects, e.g. the ones the graph only calls methods of, are covered by the source of their class.
+        sha.update(f'{type(value).__module__}.{type(value).__qualname__};'.encode())
+
+
+def get_compile_cache_key(obj, build_info):
+    """
+    Get the key of the compile cache of obj.
+
+    The key covers:
+    - the python sources the network is defined in, and the user modules they import, recursively;
+    - the structure of every sub cell: init args, parameter shapes and public attributes, including tensors with their
+      data, lists, dicts and primitives with their attrs;
+    - the MindSpore version and the build info given by the caller, i.e. the input signature, the phase and the context.
+
+    It does not cover the values of global variables, attributes whose names start with an underscore, or the state of
+    other objects the network calls into, which must not change between two runs sharing a cache.
+    """
+    from mindspore import __version__
+    sha = hashlib.sha256()
+    sha.update(__version__.encode())
+    sha.update(build_info.encode())
+    visited_files = set()
+    visited_modules = set()
+    if isinstance(obj, types.MethodType):
+        obj = obj.__self__
+    if not isinstance(obj, nn.Cell):
+        _update_source_hash(sha, obj, visited_files)
+        _update_module_hash(sha, inspect.getmodule(obj), visited_files, visited_modules)
+        return sha.hexdigest()
+
+    for name, cell in obj.cells_and_names():
+        _update_source_hash(sha, type(cell), visited_files)
+        _update_module_hash(sha, inspect.getmodule(type(cell)), visited_files, visited_modules)
+        sha.update(f'{name}:{type(cell).__module__}.{type(cell).__qualname__}'.encode())
+        if hasattr(cell, 'cell_init_args'):
+            sha.update(cell.cell_init_args.encode())
+        for attr, value in sorted(cell.__dict__.items()):
+            if not attr.startswith('_'):
+                sha.update(f'{attr}='.encode())
+                _update_value_hash(sha, value)
+        for param in cell.get_parameters(expand=False):
+            sha.update(f'{param.name}:{param.shape}:{param.dtype}:{param.requires_grad}'.encode())
+    return sha.hexdigest()
+
+
 def expand_expr_statement(node):
     """
     Process the expr statement and expand it.
@@ -16,37 +16,13 @@
 #include <thread>
 #include <string>
 #include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/embedding_rows.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "ir/primitive.h"
 #include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
-namespace {
-template <typename T>
-void LookUpTableTask(const float *input_addr, const T *indices_addr, float *output_addr, size_t indices_lens,
-                     size_t outer_dim_size, T offset, size_t first_dim_size) {
-  auto type_size = sizeof(float);
-  size_t lens = outer_dim_size * type_size;
-  for (size_t i = 0; i < indices_lens; ++i) {
-    T index = indices_addr[i] - offset;
-    if (index >= 0 && index < SizeToInt(first_dim_size)) {
-      size_t pos = static_cast<size_t>(index) * outer_dim_size;
-      auto ret = memcpy_s(output_addr, (indices_lens - i) * lens, input_addr + pos, lens);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memcpy failed.";
-      }
-    } else {
-      auto ret = memset_s(output_addr, (indices_lens - i) * lens, 0, lens);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memset failed.";
-      }
-    }
-    output_addr += outer_dim_size;
-  }
-}
-}  // namespace
-
 void EmbeddingLookUpCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   CheckParam(kernel_node);
   node_wpt_ = kernel_node;
@@ -111,8 +87,8 @@ void EmbeddingLookUpCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr
     }
     MS_LOG(DEBUG) << "task_offset: " << task_offset << " task_proc_lenss:" << task_proc_lens;
     auto task = [input_addr, indices_addr, output_addr, task_offset, task_proc_lens, this]() {
-      LookUpTableTask<T>(input_addr, indices_addr + task_offset, output_addr + task_offset * outer_dim_size_,
-                         task_proc_lens, outer_dim_size_, static_cast<T>(offset_), first_dim_size_);
+      GatherEmbeddingRows<T>(input_addr, first_dim_size_, outer_dim_size_, indices_addr + task_offset,
+                             task_proc_lens, static_cast<T>(offset_), output_addr + task_offset * outer_dim_size_);
       return common::SUCCESS;
     };
     tasks.emplace_back(task);
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/cpu/embedding_rows.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "common/thread_pool.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+#ifdef ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(ENABLE_AVX512)
+#include <x86intrin.h>
+#endif
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// The rows of the ids this far ahead are prefetched while the current row is copied.
+constexpr size_t kPrefetchDistance = 8;
+constexpr size_t kCacheLineFloats = 16;
+// The update is split among threads only when each of them copies at least this many elements.
+constexpr size_t kMinScatterElementsPerThread = 64 * 1024;
+
+inline void PrefetchRow(const float *row, size_t outer_dim_size) {
+#if defined(__GNUC__)
+  for (size_t i = 0; i < outer_dim_size; i += kCacheLineFloats) {
+    __builtin_prefetch(row + i);
+  }
+#endif
+}
+
+inline void CopyRow(const float *src, size_t size, float *dst) {
+  size_t i = 0;
+#if defined(ENABLE_AVX512)
+  constexpr size_t kAvx512Width = 16;
+  for (; i + kAvx512Width <= size; i += kAvx512Width) {
+    _mm512_storeu_ps(dst + i, _mm512_loadu_ps(src + i));
+  }
+#elif defined(ENABLE_NEON)
+  constexpr size_t kNeonWidth = 4;
+  for (; i + kNeonWidth <= size; i += kNeonWidth) {
+    vst1q_f32(dst + i, vld1q_f32(src + i));
+  }
+#endif
+  for (; i < size; ++i) {
+    dst[i] = src[i];
+  }
+}
+
+template <typename T>
+inline bool IsValidRow(T index, size_t first_dim_size) {
+  return index >= 0 && static_cast<size_t>(index) < first_dim_size;
+}
+}  // namespace
+
+template <typename T>
+void GatherEmbeddingRows(const float *table, size_t first_dim_size, size_t outer_dim_size, const T *ids,
+                         size_t ids_size, T offset, float *output) {
+  MS_EXCEPTION_IF_NULL(table);
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(output);
+  for (size_t i = 0; i < ids_size; ++i) {
+    if (i + kPrefetchDistance < ids_size) {
+      T ahead = ids[i + kPrefetchDistance] - offset;
+      if (IsValidRow(ahead, first_dim_size)) {
+        PrefetchRow(table + static_cast<size_t>(ahead) * outer_dim_size, outer_dim_size);
+      }
+    }
+    T index = ids[i] - offset;
+    float *dst = output + i * outer_dim_size;
+    if (IsValidRow(index, first_dim_size)) {
+      CopyRow(table + static_cast<size_t>(index) * outer_dim_size, outer_dim_size, dst);
+    } else {
+      std::fill(dst, dst + outer_dim_size, 0.0f);
+    }
+  }
+}
+
+template <typename T>
+void ScatterEmbeddingRows(float *table, size_t first_dim_size, size_t outer_dim_size, const T *ids, size_t ids_size,
+                          T offset, const float *values) {
+  MS_EXCEPTION_IF_NULL(table);
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(values);
+  auto scatter_task = [=](size_t row_begin, size_t row_end) {
+    for (size_t i = 0; i < ids_size; ++i) {
+      T index = ids[i] - offset;
+      if (!IsValidRow(index, first_dim_size)) {
+        continue;
+      }
+      auto row = static_cast<size_t>(index);
+      if (row >= row_begin && row < row_end) {
+        CopyRow(values + i * outer_dim_size, outer_dim_size, table + row * outer_dim_size);
+      }
+    }
+  };
+
+  size_t thread_num = ids_size * outer_dim_size / kMinScatterElementsPerThread + 1;
+  thread_num = std::min(thread_num, common::ThreadPool::GetInstance().GetSyncRunThreadNum());
+  thread_num = std::min(thread_num, first_dim_size);
+  if (thread_num <= 1) {
+    scatter_task(0, first_dim_size);
+    return;
+  }
+  std::vector<common::Task> tasks;
+  size_t rows_per_task = (first_dim_size + thread_num - 1) / thread_num;
+  for (size_t row_begin = 0; row_begin < first_dim_size; row_begin += rows_per_task) {
+    size_t row_end = std::min(row_begin + rows_per_task, first_dim_size);
+    tasks.emplace_back([scatter_task, row_begin, row_end]() {
+      scatter_task(row_begin, row_end);
+      return common::SUCCESS;
+    });
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+}
+
+template void GatherEmbeddingRows<int>(const float *table, size_t first_dim_size, size_t outer_dim_size,
+                                       const int *ids, size_t ids_size, int offset, float *output);
+template void GatherEmbeddingRows<int64_t>(const float *table, size_t first_dim_size, size_t outer_dim_size,
+                                           const int64_t *ids, size_t ids_size, int64_t offset, float *output);
+template void ScatterEmbeddingRows<int>(float *table, size_t first_dim_size, size_t outer_dim_size, const int *ids,
+                                        size_t ids_size, int offset, const float *values);
+template void ScatterEmbeddingRows<int64_t>(float *table, size_t first_dim_size, size_t outer_dim_size,
+                                            const int64_t *ids, size_t ids_size, int64_t offset,
+                                            const float *values);
+}  // namespace kernel
+}  // namespace mindspore
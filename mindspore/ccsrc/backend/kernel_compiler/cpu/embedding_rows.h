@@ -0,0 +1,41 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_EMBEDDING_ROWS_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_EMBEDDING_ROWS_H_
+
+#include <cstddef>
+
+namespace mindspore {
+namespace kernel {
+// Row kernels of the embedding lookup and update, shared by the cpu kernels, the parameter server and its cache.
+// The rows a few ids ahead are prefetched, and the rows are copied with the simd registers of the build.
+
+// Copy the rows of the table at the ids into the output, which has a row for each id. The ids are shifted by the
+// offset, and an id out of [0, first_dim_size) after that gives a row of zeros.
+template <typename T>
+void GatherEmbeddingRows(const float *table, size_t first_dim_size, size_t outer_dim_size, const T *ids,
+                         size_t ids_size, T offset, float *output);
+
+// Overwrite the rows of the table at the ids with the values, which have a row for each id. The ids are shifted by the
+// offset, and an id out of [0, first_dim_size) after that is skipped. The rows are split among the threads by range,
+// so a row is written by a single thread and a repeated id keeps its last value.
+template <typename T>
+void ScatterEmbeddingRows(float *table, size_t first_dim_size, size_t outer_dim_size, const T *ids, size_t ids_size,
+                          T offset, const float *values);
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_EMBEDDING_ROWS_H_
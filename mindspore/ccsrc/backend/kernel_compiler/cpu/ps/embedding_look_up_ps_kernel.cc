@@ -19,6 +19,7 @@
 #include <memory>
 #include <functional>
 #include "backend/kernel_compiler/common_utils.h"
+#include "backend/kernel_compiler/cpu/embedding_rows.h"
 #include "ps/util.h"
 
 namespace mindspore {
@@ -74,20 +75,16 @@ bool EmbeddingLookUpPSKernel::Execute(const std::vector<AddressPtr> &inputs, con
 
 void EmbeddingLookUpPSKernel::UpdateEmbeddings(float *embedding_table, const size_t *lookup_ids,
                                                const float *update_vals, size_t ids_size) {
-  size_t copy_len = outer_dim_size_ * sizeof(float);
-  size_t dest_len = copy_len;
+  MS_EXCEPTION_IF_NULL(lookup_ids);
+  std::vector<int64_t> ids(ids_size);
   for (size_t i = 0; i < ids_size; ++i) {
-    int index = SizeToInt(lookup_ids[i]) - LongToInt(offset_);
-    if (index >= 0 && index < SizeToInt(first_dim_size_)) {
-      auto ret = memcpy_s(embedding_table + IntToSize(index) * outer_dim_size_, dest_len,
-                          update_vals + i * outer_dim_size_, copy_len);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memcpy failed.";
-      }
-    } else {
+    ids[i] = SizeToLong(lookup_ids[i]) - offset_;
+    if (ids[i] < 0 || LongToSize(ids[i]) >= first_dim_size_) {
       MS_LOG(EXCEPTION) << "UpdateEmbeddings index invalid.";
     }
   }
+  ScatterEmbeddingRows<int64_t>(embedding_table, first_dim_size_, outer_dim_size_, ids.data(), ids_size, 0,
+                                update_vals);
 }
 
 const std::vector<size_t> &EmbeddingLookUpPSKernel::input_sizes() const { return input_shape_; }
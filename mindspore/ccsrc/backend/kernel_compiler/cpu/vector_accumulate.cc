@@ -0,0 +1,89 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/cpu/vector_accumulate.h"
+
+#ifdef ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(ENABLE_AVX512)
+#include <x86intrin.h>
+#endif
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// The values this far ahead of a sparse update are prefetched while the current one is added.
+constexpr size_t kSparsePrefetchDistance = 16;
+}  // namespace
+
+void AccumulateVector(const float *src, size_t size, float *dst) {
+  size_t i = 0;
+#if defined(ENABLE_AVX512)
+  constexpr size_t kAvx512Width = 16;
+  for (; i + kAvx512Width <= size; i += kAvx512Width) {
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(dst + i), _mm512_loadu_ps(src + i)));
+  }
+#elif defined(ENABLE_NEON)
+  constexpr size_t kNeonWidth = 4;
+  for (; i + kNeonWidth <= size; i += kNeonWidth) {
+    vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+  }
+#endif
+  for (; i < size; ++i) {
+    dst[i] += src[i];
+  }
+}
+
+void AccumulateInt8Vector(const int8_t *src, size_t size, float scale, float *dst) {
+  size_t i = 0;
+#if defined(ENABLE_AVX512)
+  constexpr size_t kAvx512Width = 16;
+  __m512 scale_vec = _mm512_set1_ps(scale);
+  for (; i + kAvx512Width <= size; i += kAvx512Width) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m512 values = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(bytes));
+    _mm512_storeu_ps(dst + i, _mm512_fmadd_ps(values, scale_vec, _mm512_loadu_ps(dst + i)));
+  }
+#elif defined(ENABLE_NEON)
+  constexpr size_t kNeonWidth = 8;
+  constexpr size_t kNeonHalfWidth = 4;
+  for (; i + kNeonWidth <= size; i += kNeonWidth) {
+    int16x8_t values = vmovl_s8(vld1_s8(src + i));
+    float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(values)));
+    float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(values)));
+    vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), low, scale));
+    vst1q_f32(dst + i + kNeonHalfWidth, vmlaq_n_f32(vld1q_f32(dst + i + kNeonHalfWidth), high, scale));
+  }
+#endif
+  for (; i < size; ++i) {
+    dst[i] += static_cast<float>(src[i]) * scale;
+  }
+}
+
+void AccumulateSparseVector(const int *indices, const float *values, size_t size, float *dst) {
+  for (size_t i = 0; i < size; ++i) {
+#if defined(__GNUC__)
+    if (i + kSparsePrefetchDistance < size) {
+      __builtin_prefetch(dst + indices[i + kSparsePrefetchDistance], 1);
+    }
+#endif
+    dst[indices[i]] += values[i];
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,38 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_VECTOR_ACCUMULATE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_VECTOR_ACCUMULATE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mindspore {
+namespace kernel {
+// Accumulation kernels of the server aggregation, which add the uploaded values into a float sum with the simd
+// registers of the build. The compressed values are decompressed in the registers, so they are never materialized.
+
+// Add the size values of src to dst.
+void AccumulateVector(const float *src, size_t size, float *dst);
+
+// Add the int8 values of src multiplied by the scale to dst.
+void AccumulateInt8Vector(const int8_t *src, size_t size, float scale, float *dst);
+
+// Add the values to dst at the indices. The indices must be in the range of dst.
+void AccumulateSparseVector(const int *indices, const float *values, size_t size, float *dst);
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_VECTOR_ACCUMULATE_H_
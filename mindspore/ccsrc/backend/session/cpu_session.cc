@@ -225,6 +225,33 @@ void CPUSession::SetOutputFlags(const VectorRef &base_ref) {
   }
 }
 
+void CPUSession::BindOutputPlaceholder(const tensor::TensorPtr &placeholder, VectorRef *outputs,
+                                       std::map<tensor::TensorPtr, KernelWithIndex> *tensor_to_node) {
+  MS_EXCEPTION_IF_NULL(placeholder);
+  MS_EXCEPTION_IF_NULL(outputs);
+  MS_EXCEPTION_IF_NULL(tensor_to_node);
+  if (outputs->size() != 1 || !utils::isa<tensor::TensorPtr>((*outputs)[0])) {
+    MS_LOG(EXCEPTION) << "The op with an output placeholder should have a single tensor output, but got "
+                      << outputs->size() << " outputs.";
+  }
+  auto output = utils::cast<tensor::TensorPtr>((*outputs)[0]);
+  MS_EXCEPTION_IF_NULL(output);
+  if (output->data_type() != placeholder->data_type() || output->shape() != placeholder->shape()) {
+    MS_LOG(EXCEPTION) << "The output " << output->ToAbstract()->ToString() << " is not the same as the placeholder "
+                      << placeholder->ToAbstract()->ToString();
+  }
+  // The output address is bound to the data of the placeholder then, so the kernel writes into it.
+  placeholder->set_device_address(output->device_address());
+  placeholder->set_sync_status(output->sync_status());
+  auto node_iter = tensor_to_node->find(output);
+  if (node_iter != tensor_to_node->end()) {
+    auto node_index = node_iter->second;
+    (void)tensor_to_node->erase(node_iter);
+    (*tensor_to_node)[placeholder] = node_index;
+  }
+  (*outputs)[0] = placeholder;
+}
+
 void CPUSession::UpdateDynamicOutputShape(const std::map<tensor::TensorPtr, KernelWithIndex> &tensor_to_node) {
   for (const auto &tensor_node : tensor_to_node) {
     if (AnfAlgo::IsDynamicShape(tensor_node.second.first)) {
@@ -244,6 +271,7 @@ void CPUSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
   MS_EXCEPTION_IF_NULL(input_tensors);
   MS_EXCEPTION_IF_NULL(op_run_info);
   BuildOpImpl(*op_run_info, graph_info, *input_tensors, tensors_mask);
+  TouchSingleOpGraph(graph_info);
   EraseValueNodeTensor(tensors_mask, input_tensors);
 
   auto kernel_graph = run_op_graphs_[graph_info];
@@ -261,6 +289,9 @@ void CPUSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
   runtime_.AssignKernelAddress(kernel_graph.get());
   std::map<tensor::TensorPtr, session::KernelWithIndex> tensor_to_node;
   runtime_.CreateOutputTensors(kernel_graph.get(), *input_tensors, outputs, &tensor_to_node);
+  if (op_run_info->output_placeholder != nullptr) {
+    BindOutputPlaceholder(op_run_info->output_placeholder, outputs, &tensor_to_node);
+  }
   runtime_.BindInputOutput(kernel_graph.get(), *input_tensors, outputs);
 
   MS_LOG(INFO) << "Run Op start";
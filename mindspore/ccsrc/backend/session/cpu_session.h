@@ -56,6 +56,8 @@ class CPUSession : public SessionBasic {
   void SetKernelInfo(const KernelGraph *kernel_graph);
   void BuildKernel(const KernelGraph *kernel_graph);
   void SetOutputFlags(const VectorRef &base_ref);
+  void BindOutputPlaceholder(const tensor::TensorPtr &placeholder, VectorRef *outputs,
+                             std::map<tensor::TensorPtr, KernelWithIndex> *tensor_to_node);
   void UpdateDynamicOutputShape(const std::map<tensor::TensorPtr, KernelWithIndex> &tensor_to_node);
   device::cpu::CPUKernelRuntime runtime_;
 };
@@ -20,6 +20,8 @@
 #include "runtime/device/kernel_runtime_manager.h"
 #include "utils/comm_manager.h"
 #include "utils/scoped_long_running.h"
+#include "utils/ms_utils.h"
+#include "utils/flags.h"
 #include "pybind_api/ir/tensor_py.h"
 #if (ENABLE_CPU && !_WIN32)
 #include "ps/ps_cache/ps_cache_manager.h"
@@ -58,6 +60,46 @@ bool TensorInVector(const VectorRef *outputs) {
   return false;
 }
 
+TensorPtr GetFirstOutputTensor(const VectorRef &outputs) {
+  for (auto &item : outputs) {
+    if (utils::isa<VectorRefPtr>(item)) {
+      auto tensor = GetFirstOutputTensor(utils::cast<VectorRef>(item));
+      if (tensor != nullptr) {
+        return tensor;
+      }
+    } else if (utils::isa<tensor::TensorPtr>(item)) {
+      return utils::cast<tensor::TensorPtr>(item);
+    }
+  }
+  return nullptr;
+}
+
+// An op is launched asynchronously only if its single output can be created from the inferred abstract, and it
+// does not touch memory or io the caller may read without waiting on the output.
+bool CanRunOpAsync(const OpRunInfo &op_run_info) {
+  static const bool enable_async_run_op = (common::GetEnv("ENV_PYNATIVE_ASYNC_RUN_OP") == "1");
+  if (!enable_async_run_op || op_run_info.is_dynamic_shape || op_run_info.is_grad_needed ||
+      op_run_info.primitive == nullptr) {
+    return false;
+  }
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (ms_context->get_param<std::string>(MS_CTX_DEVICE_TARGET) != kCPUDevice) {
+    return false;
+  }
+  const auto &prim = op_run_info.primitive;
+  if (prim->HasAttr(GRAPH_FLAG_SIDE_EFFECT) || prim->HasAttr(GRAPH_FLAG_SIDE_EFFECT_MEM) ||
+      prim->HasAttr(GRAPH_FLAG_SIDE_EFFECT_IO)) {
+    return false;
+  }
+  auto abstract = dyn_cast<abstract::AbstractTensor>(op_run_info.abstract);
+  if (abstract == nullptr || abstract->element() == nullptr || abstract->shape() == nullptr) {
+    return false;
+  }
+  const auto &shape = abstract->shape()->shape();
+  return std::all_of(shape.begin(), shape.end(), [](int64_t dim) { return dim >= 0; });
+}
+
 bool IsTaskReady(const std::shared_ptr<RunGraphTask> &task) {
   MS_EXCEPTION_IF_NULL(task);
   for (auto &input : task->input_need_wait_tensors_) {
@@ -153,6 +195,22 @@ void RunOpTask::Run() {
   session_->RunOpImpl(graph_info_, op_run_info_, input_tensors_, &outputs_, tensors_mask_);
 }
 
+void RunOpAsyncTask::Run() {
+  MS_EXCEPTION_IF_NULL(session_);
+  MS_EXCEPTION_IF_NULL(output_tensor_);
+  try {
+    VectorRef outputs;
+    session_->RunOpImpl(graph_info_, &op_run_info_, &input_tensors_, &outputs, tensors_mask_);
+    if (GetFirstOutputTensor(outputs) != output_tensor_) {
+      MS_LOG(EXCEPTION) << "The output of op " << op_run_info_.op_name << " is not written into its placeholder.";
+    }
+  } catch (const std::exception &e) {
+    ExecutorManager::Instance().OnEvent(ExecutorEvent::kException);
+    MsException::Instance().SetException();
+  }
+  output_tensor_->SetNeedWait(false);
+}
+
 void RunOpsInGraphTask::Run() {
   MS_EXCEPTION_IF_NULL(session_);
   session_->RunOpsInGraphImpl(graph_id_, input_tensors_, &outputs_);
@@ -206,7 +264,7 @@ void Executor::WorkerLoop() {
       std::lock_guard<std::mutex> lock(done_task_mutex_);
       done_tasks_.emplace_back(task);
     }
-    if (task->type_ != kRunGraph || task->sync_run_) {
+    if ((task->type_ != kRunGraph && task->type_ != kRunOpAsync) || task->sync_run_) {
       std::lock_guard<std::mutex> lock(task_mutex_);
       sync_run_task_finished_ = true;
       sync_cond_var_.notify_all();
@@ -379,6 +437,40 @@ void Executor::RunGraphAsync(const SessionPtr &session, const GraphId &graph_id,
   RunTask(task, false);
 }
 
+bool Executor::RunOpAsync(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
+                          std::vector<tensor::TensorPtr> *input_tensors, VectorRef *outputs,
+                          const std::vector<int64_t> &tensors_mask) {
+  MS_EXCEPTION_IF_NULL(op_run_info);
+  MS_EXCEPTION_IF_NULL(input_tensors);
+  MS_EXCEPTION_IF_NULL(outputs);
+  {
+    // A pending graph is not in the worker queue yet, so the op may not rely on queue order for its inputs.
+    std::lock_guard<std::mutex> lock(pending_task_mutex_);
+    if (!pending_tasks_.empty()) {
+      return false;
+    }
+  }
+  auto abstract = op_run_info->abstract->cast<abstract::AbstractTensorPtr>();
+  MS_EXCEPTION_IF_NULL(abstract);
+  auto type_id = abstract->element()->BuildType()->type_id();
+  auto output_tensor = std::make_shared<tensor::Tensor>(type_id, abstract->shape()->shape());
+  // Readers of the output, such as asnumpy, block until the worker has run the op.
+  output_tensor->SetNeedWait(true);
+
+  auto task = std::make_shared<RunOpAsyncTask>();
+  task->session_ = session;
+  task->op_run_info_ = *op_run_info;
+  task->op_run_info_.output_placeholder = output_tensor;
+  task->graph_info_ = graph_info;
+  task->input_tensors_ = *input_tensors;
+  task->tensors_mask_ = tensors_mask;
+  task->output_tensor_ = output_tensor;
+  // The worker runs tasks in order, so the inputs produced by earlier async ops are ready when this one runs.
+  RunTask(task, false);
+  outputs->push_back(output_tensor);
+  return true;
+}
+
 void Executor::RunOp(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
                      std::vector<tensor::TensorPtr> *input_tensors, VectorRef *outputs,
                      const std::vector<int64_t> &tensors_mask) {
@@ -400,7 +492,8 @@ void Executor::RunOp(const SessionPtr &session, OpRunInfo *op_run_info, const Gr
         session->RunOpImpl(graph_info, op_run_info, input_tensors, outputs, tensors_mask);
       }
     }
-  } else {
+  } else if (!CanRunOpAsync(*op_run_info) ||
+             !RunOpAsync(session, op_run_info, graph_info, input_tensors, outputs, tensors_mask)) {
     auto task = std::make_shared<RunOpTask>();
     task->session_ = session;
     task->op_run_info_ = op_run_info;
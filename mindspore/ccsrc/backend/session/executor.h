@@ -46,7 +46,8 @@ enum TaskType {
   kRunOp,
   kCreateCommGroup,
   kDestroyCommGroup,
-  kRunOpsInGraph
+  kRunOpsInGraph,
+  kRunOpAsync
 };
 
 class Task {
@@ -121,6 +122,20 @@ class RunOpTask : public Task {
   std::vector<int64_t> tensors_mask_;
 };
 
+// Run a single op whose outputs have been created from the inferred abstract and handed to the caller already.
+// The task owns copies of the op info and the inputs, as the caller does not wait for it.
+class RunOpAsyncTask : public Task {
+ public:
+  RunOpAsyncTask() { type_ = kRunOpAsync; }
+  ~RunOpAsyncTask() override = default;
+  void Run() override;
+  OpRunInfo op_run_info_;
+  GraphInfo graph_info_;
+  std::vector<tensor::TensorPtr> input_tensors_;
+  std::vector<int64_t> tensors_mask_;
+  tensor::TensorPtr output_tensor_{nullptr};
+};
+
 class CreateCommGroupTask : public Task {
  public:
   CreateCommGroupTask() { type_ = kCreateCommGroup; }
@@ -172,6 +187,10 @@ class Executor {
 
  private:
   void RunTask(const std::shared_ptr<Task> &task, bool sync, bool long_run = false);
+  // Queue the op with its output created from the inferred abstract, returns false if it has to run synchronously.
+  bool RunOpAsync(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
+                  std::vector<tensor::TensorPtr> *input_tensors, VectorRef *outputs,
+                  const std::vector<int64_t> &tensors_mask);
   std::vector<std::shared_ptr<RunGraphTask>> GetReadyTasksFromPendingList();
   void OnWorkerExit();
   void OnClear();
@@ -560,6 +560,10 @@ void GPUSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
   MS_EXCEPTION_IF_NULL(input_tensors);
   MS_EXCEPTION_IF_NULL(op_run_info);
   BuildOpImpl(*op_run_info, graph_info, *input_tensors, tensors_mask);
+  bool cache_graph = kOpCacheAllowList.find(op_run_info->op_name) == kOpCacheAllowList.end();
+  if (cache_graph) {
+    TouchSingleOpGraph(graph_info);
+  }
   EraseValueNodeTensor(tensors_mask, input_tensors);
   // wait for allreduce
   for (auto &tensor : *input_tensors) {
@@ -583,7 +587,7 @@ void GPUSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
     UpdateOutputAbstract(kernel_graph, op_run_info);
   }
   RunOpClearMemory(kernel_graph.get());
-  if (kOpCacheAllowList.find(op_run_info->op_name) != kOpCacheAllowList.end()) {
+  if (!cache_graph) {
     run_op_graphs_.erase(graph_info);
   }
 }
@@ -16,6 +16,7 @@
 #include "backend/session/session_basic.h"
 
 #include <algorithm>
+#include <exception>
 #include <set>
 #include <queue>
 #include <unordered_map>
@@ -43,6 +44,7 @@
 #include "debug/dump_proto.h"
 #include "debug/common.h"
 #include "utils/trace_base.h"
+#include "utils/profile.h"
 #include "frontend/parallel/context.h"
 #if (ENABLE_CPU && !_WIN32)
 #include "ps/ps_cache/ps_cache_manager.h"
@@ -60,6 +62,30 @@ MS_REG_SESSION(kSessionBasic, SessionBasic);
 namespace {
 const int kSummaryGetItem = 2;
 const size_t max_depth = 128;
+const size_t kMaxSingleOpGraphCacheSize = 1024;
+// The AllReduce cost model of the bucket planner, set by ENV_ALLREDUCE_LATENCY in us, the fixed cost of one AllReduce,
+// and by ENV_ALLREDUCE_BANDWIDTH in bytes per us, which is MB/s. The defaults are used when they are not set.
+const char kAllReduceLatencyEnv[] = "ENV_ALLREDUCE_LATENCY";
+const char kAllReduceBandwidthEnv[] = "ENV_ALLREDUCE_BANDWIDTH";
+const double kDefaultAllReduceLatency = 20.0;
+const double kDefaultAllReduceBandwidth = 10000.0;
+double GetAllReduceCost(const std::string &env, double default_value, bool allow_zero) {
+  auto value_str = common::GetEnv(env);
+  if (value_str.empty()) {
+    return default_value;
+  }
+  try {
+    size_t pos = 0;
+    auto value = std::stod(value_str, &pos);
+    if (pos == value_str.size() && (value > 0 || (allow_zero && value == 0))) {
+      return value;
+    }
+  } catch (const std::exception &) {
+  }
+  MS_LOG(WARNING) << "Invalid " << env << ": " << value_str << ", use the default " << default_value << " instead.";
+  return default_value;
+}
+
 bool IsShapeDynamic(const abstract::ShapePtr &shape) {
   if (shape == nullptr) {
     return false;
@@ -1187,6 +1213,108 @@ KernelGraphPtr SessionBasic::ConstructKernelGraph(const AnfNodePtrList &lst, con
   return graph;
 }
 
+void SingleOpSignature::AddTensor(const tensor::TensorPtr &tensor) {
+  MS_EXCEPTION_IF_NULL(tensor);
+  const auto &tensor_shape = tensor->shape();
+  Add(tensor_shape.size());
+  for (const auto &dim : tensor_shape) {
+    Add(static_cast<size_t>(dim));
+  }
+  Add(static_cast<size_t>(tensor->data_type()));
+  auto device_address = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address());
+  if (device_address != nullptr) {
+    Add(static_cast<size_t>(device_address->type_id()));
+    Add(device_address->format());
+  }
+  Add(tensor->padding_type());
+}
+
+void SingleOpSignature::AddValue(const ValuePtr &value) {
+  if (value == nullptr) {
+    Add(static_cast<size_t>(0));
+    return;
+  }
+  Add(value->tid());
+  if (value->isa<ValueSequeue>()) {
+    auto value_sequeue = value->cast<ValueSequeuePtr>();
+    Add(value_sequeue->size());
+    for (const auto &element : value_sequeue->value()) {
+      AddValue(element);
+    }
+    return;
+  }
+  if (value->isa<StringImm>()) {
+    Add(value->cast<StringImmPtr>()->value());
+    return;
+  }
+  if (value->isa<BoolImm>()) {
+    Add(static_cast<size_t>(value->cast<BoolImmPtr>()->value()));
+    return;
+  }
+  if (value->isa<Int64Imm>()) {
+    Add(static_cast<size_t>(value->cast<Int64ImmPtr>()->value()));
+    return;
+  }
+  if (value->isa<Int32Imm>()) {
+    Add(static_cast<size_t>(value->cast<Int32ImmPtr>()->value()));
+    return;
+  }
+  if (value->isa<FP32Imm>()) {
+    auto float_value = value->cast<FP32ImmPtr>()->value();
+    uint32_t bits = 0;
+    auto ret = memcpy_s(&bits, sizeof(bits), &float_value, sizeof(float_value));
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Copy the value of attr failed, error code " << ret;
+    }
+    Add(static_cast<size_t>(bits));
+    return;
+  }
+  Add(value->ToString());
+}
+
+void SingleOpSignature::AddShape(const abstract::BaseShapePtr &shape) {
+  MS_EXCEPTION_IF_NULL(shape);
+  if (shape->isa<abstract::Shape>()) {
+    auto tensor_shape = shape->cast<abstract::ShapePtr>();
+    for (const auto &shape_vector : {tensor_shape->shape_, tensor_shape->min_shape_, tensor_shape->max_shape_}) {
+      Add(shape_vector.size());
+      for (const auto &dim : shape_vector) {
+        Add(static_cast<size_t>(dim));
+      }
+    }
+    return;
+  }
+  if (shape->isa<abstract::SequeueShape>()) {
+    auto sequeue_shape = shape->cast<abstract::SequeueShapePtr>();
+    Add(shape->tid());
+    Add(sequeue_shape->size());
+    for (const auto &element : sequeue_shape->shape()) {
+      AddShape(element);
+    }
+    return;
+  }
+  Add(shape->ToString());
+}
+
+void SingleOpSignature::AddAttrs(const PrimitivePtr &prim) {
+  MS_EXCEPTION_IF_NULL(prim);
+  // The attrs are kept in a hash map, so they are packed in the order of their names to get the same key for the
+  // same attrs.
+  const auto &attrs = prim->attrs();
+  std::vector<std::pair<const std::string *, const ValuePtr *>> sorted_attrs;
+  sorted_attrs.reserve(attrs.size());
+  for (const auto &attr : attrs) {
+    sorted_attrs.emplace_back(&attr.first, &attr.second);
+  }
+  std::sort(sorted_attrs.begin(), sorted_attrs.end(),
+            [](const auto &left, const auto &right) { return *left.first < *right.first; });
+  Add(sorted_attrs.size());
+  for (const auto &attr : sorted_attrs) {
+    Add(*attr.first);
+    AddValue(*attr.second);
+  }
+}
+
 GraphInfo SessionBasic::GetSingleOpGraphInfo(const CNodePtr &kernel,
                                              const std::vector<tensor::TensorPtr> &input_tensors) {
   MS_EXCEPTION_IF_NULL(kernel);
@@ -1195,41 +1323,38 @@ GraphInfo SessionBasic::GetSingleOpGraphInfo(const CNodePtr &kernel,
   const AbstractBasePtr &abstract = kernel->abstract();
   MS_EXCEPTION_IF_NULL(abstract);
   size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-  GraphInfo graph_info;
+  SingleOpSignature signature;
   // get input tensor info
+  signature.Add(input_tensors.size());
   for (const auto &tensor : input_tensors) {
-    MS_EXCEPTION_IF_NULL(tensor);
-    auto tensor_shape = tensor->shape();
-    (void)std::for_each(tensor_shape.begin(), tensor_shape.end(),
-                        [&](const auto &dim) { (void)graph_info.append(std::to_string(dim) + "_"); });
-    (void)graph_info.append(std::to_string(tensor->data_type()) + "_");
-    if (tensor->device_address() != nullptr) {
-      const auto type_id = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address())->type_id();
-      (void)graph_info.append(std::to_string(type_id) + "_");
-      const auto format = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address())->format();
-      (void)graph_info.append(format + "_");
-    }
-    for (const auto &padding_type : tensor->padding_type()) {
-      (void)graph_info.append(std::to_string(padding_type) + "_");
-    }
+    signature.AddTensor(tensor);
   }
   // get attr info
-  const auto &attr_map = prim->attrs();
-  (void)std::for_each(attr_map.begin(), attr_map.end(), [&](const auto &element) {
-    if (element.second->ToString().empty()) {
-      return;
-    }
-    (void)graph_info.append(element.second->ToString() + "_");
-  });
-  auto build_shape = abstract->BuildShape();
-  MS_EXCEPTION_IF_NULL(build_shape);
-  (void)graph_info.append(build_shape->ToString() + "_");
+  signature.AddAttrs(prim);
+  signature.AddShape(abstract->BuildShape());
   for (size_t output_index = 0; output_index < output_num; output_index += 1) {
     const auto output_type = AnfAlgo::GetOutputInferDataType(kernel, output_index);
-    (void)graph_info.append(std::to_string(output_type) + "_");
+    signature.Add(static_cast<size_t>(output_type));
+  }
+  signature.Add(prim->id());
+  return signature.ToGraphInfo(prim->name());
+}
+
+void SessionBasic::TouchSingleOpGraph(const GraphInfo &graph_info) {
+  auto pos_iter = run_op_graphs_lru_pos_.find(graph_info);
+  if (pos_iter != run_op_graphs_lru_pos_.end()) {
+    run_op_graphs_lru_.splice(run_op_graphs_lru_.begin(), run_op_graphs_lru_, pos_iter->second);
+    return;
+  }
+  run_op_graphs_lru_.push_front(graph_info);
+  run_op_graphs_lru_pos_[graph_info] = run_op_graphs_lru_.begin();
+  while (run_op_graphs_lru_.size() > kMaxSingleOpGraphCacheSize) {
+    const auto &evicted = run_op_graphs_lru_.back();
+    MS_LOG(DEBUG) << "Evict single op graph " << evicted;
+    (void)run_op_graphs_.erase(evicted);
+    (void)run_op_graphs_lru_pos_.erase(evicted);
+    run_op_graphs_lru_.pop_back();
   }
-  graph_info.append(prim->id());
-  return graph_info;
 }
 
 void SessionBasic::GetSingleOpRunInfo(const CNodePtr cnode, OpRunInfo *run_info) {
@@ -2314,11 +2439,31 @@ void SessionBasic::InitAllBucket(const KernelGraphPtr &graph, const device::Devi
     return;
   }
 
-  std::vector<std::shared_ptr<device::Bucket>> bucket_list;
   // Create bucket for every split allreduce ops
   auto split_index = GetAllReduceSplitIndex();
+  if (split_index.empty()) {
+    // Without split indices all the grads share one bucket at first, which is replanned by the backward timing.
+    bucket_timing_profile_map_[graph->graph_id()].device_context = device_context;
+  }
   PreProcessOnSplitIndex(graph, &split_index);
   auto bucket_size_list = GenerateBucketSizeList(graph, split_index);
+  auto bucket_list = CreateBucketList(bucket_size_list, device_context);
+
+  auto bucket_ret = bucket_map_.try_emplace(graph->graph_id(), bucket_list);
+  if (!bucket_ret.second) {
+    MS_LOG(EXCEPTION) << "Duplicate bucket_map_ graph key:" << graph->graph_id();
+  }
+  // set all free bucket index to 0
+  auto free_bucket_ret = free_bucket_id_map_.try_emplace(graph->graph_id(), 0);
+  if (!free_bucket_ret.second) {
+    MS_LOG(EXCEPTION) << "Duplicate free_bucket_id_map_ graph key:" << graph->graph_id();
+  }
+  MS_LOG(INFO) << "Init Bucket finish";
+}
+
+std::vector<std::shared_ptr<device::Bucket>> SessionBasic::CreateBucketList(
+  const std::vector<uint32_t> &bucket_size_list, const device::DeviceContext *device_context) {
+  std::vector<std::shared_ptr<device::Bucket>> bucket_list;
   uint32_t bucket_id = 0;
   for (auto bucket_size : bucket_size_list) {
     MS_LOG(INFO) << "Create new bucket:" << bucket_id;
@@ -2330,17 +2475,70 @@ void SessionBasic::InitAllBucket(const KernelGraphPtr &graph, const device::Devi
     }
     bucket_list.emplace_back(bucket);
   }
+  return bucket_list;
+}
 
-  auto bucket_ret = bucket_map_.try_emplace(graph->graph_id(), bucket_list);
-  if (!bucket_ret.second) {
-    MS_LOG(EXCEPTION) << "Duplicate bucket_map_ graph key:" << graph->graph_id();
+void SessionBasic::SyncBucketTimingStream(const BucketTimingProfile &profile) {
+  if (profile.device_context != nullptr) {
+    if (!profile.device_context->SyncStream()) {
+      MS_LOG(EXCEPTION) << "Sync stream failed.";
+    }
+    return;
   }
-  // set all free bucket index to 0
-  auto free_bucket_ret = free_bucket_id_map_.try_emplace(graph->graph_id(), 0);
-  if (!free_bucket_ret.second) {
-    MS_LOG(EXCEPTION) << "Duplicate free_bucket_id_map_ graph key:" << graph->graph_id();
+  SyncStream();
+}
+
+void SessionBasic::RecordGradTiming(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &grad_tensor) {
+  auto iter = bucket_timing_profile_map_.find(graph_id);
+  if (iter == bucket_timing_profile_map_.end() || !iter->second.profiler.profiling() || grad_tensor.empty()) {
+    return;
   }
-  MS_LOG(INFO) << "Init Bucket finish";
+  // The kernels are launched ahead of the device, so the profiled step waits for each gradient to be computed.
+  auto &profile = iter->second;
+  SyncBucketTimingStream(profile);
+  auto ready_time = GetTime();
+  for (auto &tensor : grad_tensor) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    auto device_address = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address());
+    profile.profiler.RecordGrad(ready_time, device_address == nullptr ? 0 : device_address->GetSize());
+  }
+}
+
+void SessionBasic::PlanBucketByTiming(const GraphId &graph_id) {
+  auto iter = bucket_timing_profile_map_.find(graph_id);
+  if (iter == bucket_timing_profile_map_.end()) {
+    return;
+  }
+  auto &profile = iter->second;
+  auto &profiler = profile.profiler;
+  profiler.NextStep();
+  if (profiler.profiling()) {
+    // The work of the last step is not counted in the backward timing of this one.
+    SyncBucketTimingStream(profile);
+    profiler.set_step_start_time(GetTime());
+    return;
+  }
+  if (!profiler.ready_to_plan()) {
+    return;
+  }
+  auto &bucket_list = bucket_map_[graph_id];
+  size_t grads_count = 0;
+  for (auto &bucket : bucket_list) {
+    MS_EXCEPTION_IF_NULL(bucket);
+    grads_count += bucket->bucket_size();
+  }
+  static const double latency = GetAllReduceCost(kAllReduceLatencyEnv, kDefaultAllReduceLatency, true);
+  static const double bandwidth = GetAllReduceCost(kAllReduceBandwidthEnv, kDefaultAllReduceBandwidth, false);
+  auto profiled_grads_count = profiler.grad_num();
+  auto bucket_size_list = profiler.Plan(latency, bandwidth);
+  if (profiled_grads_count != grads_count) {
+    MS_LOG(WARNING) << "Profiled " << profiled_grads_count << " grads of graph " << graph_id << ", but it has "
+                    << grads_count << " grads. Keep its buckets.";
+    return;
+  }
+  MS_LOG(INFO) << "Plan buckets of graph " << graph_id << " by the backward timing with AllReduce latency " << latency
+               << " us and bandwidth " << bandwidth << " bytes/us: " << bucket_size_list;
+  bucket_list = CreateBucketList(bucket_size_list, profile.device_context);
 }
 
 void SessionBasic::AddGradAddrToBucket(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &grad_tensor) {
@@ -2350,6 +2548,7 @@ void SessionBasic::AddGradAddrToBucket(const GraphId &graph_id, const std::vecto
   if (parallel_mode != parallel::DATA_PARALLEL) {
     return;
   }
+  RecordGradTiming(graph_id, grad_tensor);
 
   auto iter = bucket_map_.find(graph_id);
   if (iter == bucket_map_.end()) {
@@ -2391,6 +2590,7 @@ void SessionBasic::ClearAllBucket(const GraphId &graph_id) {
   if (free_iter != free_bucket_id_map_.end()) {
     free_iter->second = 0;
   }
+  PlanBucketByTiming(graph_id);
 }
 
 void SessionBasic::FinalOptimize(const KernelGraphPtr &graph) const {
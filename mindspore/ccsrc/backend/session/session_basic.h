@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_BACKEND_SESSION_SESSION_BASIC_H
 
 #include <vector>
+#include <list>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -67,6 +68,10 @@ struct OpRunInfo {
 #else
   size_t next_input_index = 0;
 #endif
+  // The outputs are read by the grad as soon as the op returns, so the op can't be run asynchronously.
+  bool is_grad_needed = false;
+  // The output handed to the caller before the op runs, which the kernel writes into instead of a new tensor.
+  tensor::TensorPtr output_placeholder = nullptr;
 };
 
 struct InputTensorInfo {
@@ -87,6 +92,49 @@ struct GraphOutputInfo {
 };
 
 using OpRunInfoPtr = std::shared_ptr<OpRunInfo>;
+
+// Backward timing of the gradients of a graph whose buckets are planned at runtime, as no split indices are set.
+struct BucketTimingProfile {
+  const device::DeviceContext *device_context{nullptr};
+  device::BucketTimingProfiler profiler;
+};
+
+// Incrementally built signature of a single op and its inputs, which keys the single op graph cache. Every shape,
+// dtype, format and attr value is packed into the key without being formatted, and the packing is lossless, so the
+// cache compares whole signatures on lookup and two different ops never share a graph.
+class SingleOpSignature {
+ public:
+  SingleOpSignature() = default;
+  ~SingleOpSignature() = default;
+
+  // A number is packed into 5 bits per char from the low bits on, and its last char is taken from another range, so
+  // the packed numbers are printable and can be split again.
+  void Add(size_t value) {
+    while (value >= kDigitRange) {
+      key_.push_back(static_cast<char>(kMoreDigit + (value & (kDigitRange - 1))));
+      value >>= kDigitBits;
+    }
+    key_.push_back(static_cast<char>(kLastDigit + value));
+  }
+  void Add(const std::string &value) {
+    Add(value.size());
+    (void)key_.append(value);
+  }
+  void AddTensor(const tensor::TensorPtr &tensor);
+  void AddValue(const ValuePtr &value);
+  void AddShape(const abstract::BaseShapePtr &shape);
+  void AddAttrs(const PrimitivePtr &prim);
+  // The graph info starts with the op name, so logs show which op a graph is for. The packed key after it is
+  // printable, but it is not meant to be read.
+  GraphInfo ToGraphInfo(const std::string &op_name) const { return op_name + "_" + key_; }
+
+ private:
+  static constexpr size_t kDigitBits = 5;
+  static constexpr size_t kDigitRange = 1 << kDigitBits;
+  static constexpr char kMoreDigit = '0';
+  static constexpr char kLastDigit = kMoreDigit + kDigitRange;
+  std::string key_;
+};
 using KernelMapTensor = std::map<session::KernelWithIndex, BaseRef, session::KernelWithIndexCmp>;
 class Executor;
 
@@ -189,6 +237,7 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   friend class BuildGraphTask;
   friend class RunGraphTask;
   friend class RunOpTask;
+  friend class RunOpAsyncTask;
   friend class RunOpsInGraphTask;
   friend class mindspore::runtime::GraphCompiler;
   virtual bool IsSupportSummary() { return true; }
@@ -241,6 +290,8 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   CNodePtr ConstructOutput(const AnfNodePtrList &outputs, const std::shared_ptr<KernelGraph> &graph);
   // Generate graph info for a single op graph
   GraphInfo GetSingleOpGraphInfo(const CNodePtr &kernel, const std::vector<tensor::TensorPtr> &input_tensors);
+  // Mark the single op graph as most recently used, and drop the least recently used ones beyond the cache bound.
+  void TouchSingleOpGraph(const GraphInfo &graph_info);
   void GetSingleOpRunInfo(const CNodePtr cnode, OpRunInfo *run_info);
   tensor::TensorPtr GetValueNodeOutputTensor(const AnfNodePtr &node, size_t output_index);
   tensor::TensorPtr GetParameterOutputTensor(const AnfNodePtr &node,
@@ -267,6 +318,12 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   void InitAllBucket(const KernelGraphPtr &graph, const device::DeviceContext *device_context = nullptr);
   void AddGradAddrToBucket(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &grad_tensor);
   void ClearAllBucket(const GraphId &graph_id);
+  std::vector<std::shared_ptr<device::Bucket>> CreateBucketList(const std::vector<uint32_t> &bucket_size_list,
+                                                                const device::DeviceContext *device_context);
+  void RecordGradTiming(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &grad_tensor);
+  void PlanBucketByTiming(const GraphId &graph_id);
+  // Wait for the kernels launched, so the time taken next is when they are computed on device.
+  void SyncBucketTimingStream(const BucketTimingProfile &profile);
   std::vector<uint32_t> GetAllReduceSplitIndex();
   virtual std::string GetCommWorldGroup() { return std::string(); }
   void DumpGraph(const std::shared_ptr<KernelGraph> &kernel_graph);
@@ -278,8 +335,12 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
 
   std::map<uint32_t, std::vector<std::shared_ptr<device::Bucket>>> bucket_map_;
   std::map<uint32_t, uint32_t> free_bucket_id_map_;
+  std::map<uint32_t, BucketTimingProfile> bucket_timing_profile_map_;
   std::unordered_map<GraphId, std::shared_ptr<KernelGraph>> graphs_;
   std::unordered_map<GraphInfo, std::shared_ptr<KernelGraph>> run_op_graphs_;
+  // Recently used order of run_op_graphs_, which bounds the single op graph cache.
+  std::list<GraphInfo> run_op_graphs_lru_;
+  std::unordered_map<GraphInfo, std::list<GraphInfo>::iterator> run_op_graphs_lru_pos_;
   std::unordered_map<FuncGraph *, KernelGraphPtr> front_backend_graph_map_;
   std::unordered_map<AnfNodePtr, AnfNodePtr> partial_parameters_map_;
   std::unordered_map<AnfNodePtr, std::string> partial_target_map_;
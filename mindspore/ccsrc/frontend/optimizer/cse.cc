@@ -18,11 +18,16 @@
 
 #include "frontend/optimizer/cse.h"
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <set>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "abstract/abstract_function.h"
+#include "base/core_ops.h"
 #include "utils/flags.h"
 #include "utils/utils.h"
 
@@ -67,54 +72,110 @@ BasePtr AbsOf(const AnfNodePtr &node, bool ignore_fg_abs_tracking_id) {
   return node_abs;
 }
 
+namespace {
+// The value number of a node, kept in the node's user data so that it outlives a single CSE invocation.
+// A value node's number only depends on its value and abstract, so it stays valid while they are unchanged;
+// a cnode's number depends on its inputs, which any pass may rewrite, so it is only valid in the generation
+// that computed it.
+struct CseValueNumber {
+  constexpr static char key[] = "CseValueNumber";
+  std::size_t hash;
+  std::size_t generation;
+  ValuePtr value;
+  AbstractBasePtr abstract;
+};
+
+std::atomic<std::size_t> cse_generation{0};
+
+// Maximum and Minimum are not listed: their gradients send the ties to a fixed input, so swapping the operands changes
+// the gradients.
+bool IsCommutative(const CNodePtr &cnode) {
+  static const std::unordered_set<std::string> commutative_ops = {
+    prim::kPrimAdd->name(),        prim::kPrimTensorAdd->name(),  prim::kPrimMul->name(),
+    prim::kPrimScalarAdd->name(),  prim::kPrimScalarMul->name(),  prim::kPrimLogicalAnd->name(),
+    prim::kPrimLogicalOr->name(),  prim::kPrimEqual->name(),      prim::kPrimNotEqual->name()};
+  constexpr size_t kBinaryOpInputsSize = 3;
+  if (cnode->size() != kBinaryOpInputsSize) {
+    return false;
+  }
+  auto prim = GetCNodePrimitive(cnode);
+  return prim != nullptr && commutative_ops.find(prim->name()) != commutative_ops.end();
+}
+
+std::size_t ValueNumberOf(const AnfNodePtr &node, std::size_t generation) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto number = node->user_data<CseValueNumber>();
+  if (node->isa<ValueNode>()) {
+    auto value = GetValueNode(node);
+    MS_EXCEPTION_IF_NULL(value);
+    if (number != nullptr && number->value == value && number->abstract == node->abstract()) {
+      return number->hash;
+    }
+    auto h = hash_combine(value->hash(), AbsOf(node, true)->hash());
+    // Set a new object rather than updating the old one, which may be shared with the clones of the node.
+    node->set_user_data(std::make_shared<CseValueNumber>(CseValueNumber{h, generation, value, node->abstract()}));
+    return h;
+  }
+  if (node->isa<Parameter>()) {
+    return node->hash();
+  }
+  if (!node->isa<CNode>()) {
+    MS_LOG(ERROR) << "Unknown node type";
+    return 0;
+  }
+  if (number != nullptr && number->generation == generation) {
+    return number->hash;
+  }
+  // The inputs are numbered before their users, as the nodes are visited in topological order.
+  auto cnode = node->cast<CNodePtr>();
+  auto &inputs = cnode->inputs();
+  std::size_t h = 0;
+  if (IsCommutative(cnode)) {
+    auto lhs = ValueNumberOf(inputs[1], generation);
+    auto rhs = ValueNumberOf(inputs[2], generation);
+    h = hash_combine({ValueNumberOf(inputs[0], generation), std::min(lhs, rhs), std::max(lhs, rhs)});
+  } else {
+    h = std::accumulate(inputs.begin(), inputs.end(), std::size_t(0),
+                        [generation](std::size_t hash, const AnfNodePtr &input) {
+                          return hash_combine(hash, ValueNumberOf(input, generation));
+                        });
+  }
+  node->set_user_data(std::make_shared<CseValueNumber>(CseValueNumber{h, generation, nullptr, nullptr}));
+  return h;
+}
+}  // namespace
+
 bool CSE::BuildOrderGroupAndDoReplace(const FuncGraphManagerPtr manager) const {
-  bool changed = false;
+  // Number the nodes of all graphs in the manager in one table, so that the same computation in a closure and in
+  // the graph it is nested in gets the same number.
+  auto generation = ++cse_generation;
+  std::vector<std::size_t> order_group;
+  std::unordered_map<std::size_t, std::vector<AnfNodePtr>> groups;
+  std::unordered_set<AnfNodePtr> visited;
   for (FuncGraphPtr fg : manager->func_graphs()) {
     MS_EXCEPTION_IF_NULL(fg);
-    std::vector<std::size_t> order_group;
-    std::unordered_map<std::size_t, std::vector<AnfNodePtr>> groups;
-    std::unordered_map<AnfNodePtr, std::size_t> hashes;
-
     std::vector<AnfNodePtr> toposet = TopoSort(fg->get_return());
     for (auto node : toposet) {
       MS_EXCEPTION_IF_NULL(node);
-      if (hashes.find(node) != hashes.end()) {
+      if (!visited.insert(node).second) {
         continue;
       }
-
-      std::size_t h = 0;
+      std::size_t h = ValueNumberOf(node, generation);
+      // Value nodes are only merged with the ones of the same graph.
       if (node->isa<ValueNode>()) {
-        ValueNodePtr value_node = node->cast<ValueNodePtr>();
-        auto value = value_node->value();
-        MS_EXCEPTION_IF_NULL(value);
-        h = hash_combine(value->hash(), (AbsOf(value_node, true)->hash()));
-      } else if (node->isa<CNode>()) {
-        auto cnode = node->cast<CNodePtr>();
-        auto &inputs = cnode->inputs();
-        size_t init = 0;
-        h = std::accumulate(inputs.begin(), inputs.end(), init, [&hashes](std::size_t hash, const AnfNodePtr &node_in) {
-          return hash_combine(hash, hashes[node_in]);
-        });
-      } else if (node->isa<Parameter>()) {
-        h = node->hash();
-      } else {
-        MS_LOG(ERROR) << "Unknown node type";
+        h = hash_combine(h, std::hash<FuncGraphPtr>()(fg));
       }
-
-      hashes[node] = h;
-      if (groups.find(h) == groups.end()) {
-        std::vector<AnfNodePtr> innervec({node});
-        groups[h] = innervec;
+      auto iter = groups.find(h);
+      if (iter == groups.end()) {
+        groups[h] = {node};
         order_group.emplace_back(h);
       } else {
-        groups[h].push_back(node);
+        iter->second.push_back(node);
       }
     }
-
-    changed = DoReplace(manager, order_group, &groups) || changed;
   }
 
-  return changed;
+  return DoReplace(manager, order_group, &groups);
 }
 
 // The op like print, summary, or the op do not has true output, and always as a depend node input.
@@ -147,6 +208,40 @@ bool CSE::CheckRandomEffect(const AnfNodePtr &main, const AnfNodePtr &node) cons
   return has_random_effect;
 }
 
+bool CSE::CheckInputsReplace(const CNodePtr &main, const CNodePtr &node, bool swap_operands) const {
+  const auto &inp1 = main->inputs();
+  const auto &inp2 = node->inputs();
+  if (inp1.size() != inp2.size()) {
+    return false;
+  }
+  for (size_t j = 0; j < inp1.size(); j++) {
+    auto inp1_j = inp1[j];
+    // The operands of a commutative binary op are compared crosswise.
+    auto inp2_j = (swap_operands && j > 0) ? inp2[inp2.size() - j] : inp2[j];
+    MS_EXCEPTION_IF_NULL(inp1_j);
+    MS_EXCEPTION_IF_NULL(inp2_j);
+    if (!(*inp1_j == *inp2_j)) {
+      // Handle the case of two different Tensor, but with the same value
+      if (IsValueNode<tensor::Tensor>(inp1_j) && IsValueNode<tensor::Tensor>(inp2_j)) {
+        auto tensor1 = GetValueNode<tensor::TensorPtr>(inp1_j);
+        auto tensor2 = GetValueNode<tensor::TensorPtr>(inp2_j);
+        if (tensor1->ValueEqual(*tensor2)) {
+          continue;
+        }
+      } else if (HasSideEffect(inp1_j) && HasSideEffect(inp2_j)) {
+        // When the same side effect node as another two nodes' inputs, we still merge the node.
+        // Because the node only can be the inputs of `depend`, when the `depend` is duplicated merge the depend the
+        // node.
+        if (CheckReplace(inp1_j, inp2_j, false)) {
+          continue;
+        }
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
 bool CSE::CheckReplace(const AnfNodePtr &main, const AnfNodePtr &node, bool check_side_effect) const {
   MS_EXCEPTION_IF_NULL(main);
   MS_EXCEPTION_IF_NULL(node);
@@ -166,35 +261,10 @@ bool CSE::CheckReplace(const AnfNodePtr &main, const AnfNodePtr &node, bool chec
     if (check_side_effect && HasSideEffect(main)) {
       return false;
     }
-    const auto &inp1 = c_main->inputs();
-    const auto &inp2 = c_node->inputs();
-    if (inp1.size() != inp2.size()) {
+    if (!CheckInputsReplace(c_main, c_node, false) &&
+        !(IsCommutative(c_main) && IsCommutative(c_node) && CheckInputsReplace(c_main, c_node, true))) {
       return false;
     }
-    for (size_t j = 0; j < inp1.size(); j++) {
-      auto inp1_j = inp1[j];
-      auto inp2_j = inp2[j];
-      MS_EXCEPTION_IF_NULL(inp1_j);
-      MS_EXCEPTION_IF_NULL(inp2_j);
-      if (!(*inp1_j == *inp2_j)) {
-        // Handle the case of two different Tensor, but with the same value
-        if (IsValueNode<tensor::Tensor>(inp1_j) && IsValueNode<tensor::Tensor>(inp2_j)) {
-          auto tensor1 = GetValueNode<tensor::TensorPtr>(inp1_j);
-          auto tensor2 = GetValueNode<tensor::TensorPtr>(inp2_j);
-          if (tensor1->ValueEqual(*tensor2)) {
-            continue;
-          }
-        } else if (HasSideEffect(inp1_j) && HasSideEffect(inp2_j)) {
-          // When the same side effect node as another two nodes' inputs, we still merge the node.
-          // Because the node only can be the inputs of `depend`, when the `depend` is duplicated merge the depend the
-          // node.
-          if (CheckReplace(inp1_j, inp2_j, false)) {
-            continue;
-          }
-        }
-        return false;
-      }
-    }
     // When appsame is true, check if has random effect do not merge
     if (CheckRandomEffect(c_main, c_node)) {
       return false;
@@ -205,6 +275,31 @@ bool CSE::CheckReplace(const AnfNodePtr &main, const AnfNodePtr &node, bool chec
   return false;
 }
 
+namespace {
+std::size_t GraphDepth(const FuncGraphManagerPtr &manager, const AnfNodePtr &node) {
+  auto fg = node->func_graph();
+  if (fg == nullptr || node->isa<ValueNode>()) {
+    return 0;
+  }
+  return manager->func_graph_parents_total(fg).size();
+}
+
+// A node can be replaced by one in the same graph, or by a cnode of a graph it is nested in, which it then uses as
+// a free variable.
+bool CanReplaceInGraph(const FuncGraphManagerPtr &manager, const AnfNodePtr &main, const AnfNodePtr &node) {
+  auto main_fg = main->func_graph();
+  auto node_fg = node->func_graph();
+  if (main_fg == node_fg) {
+    return true;
+  }
+  if (main_fg == nullptr || node_fg == nullptr || !main->isa<CNode>()) {
+    return false;
+  }
+  const auto &children = manager->children(main_fg);
+  return children.find(node_fg) != children.end();
+}
+}  // namespace
+
 bool CSE::DoReplace(const FuncGraphManagerPtr manager, const std::vector<std::size_t> &order_group,
                     std::unordered_map<std::size_t, std::vector<AnfNodePtr>> *groups) const {
   bool changes = false;
@@ -213,6 +308,10 @@ bool CSE::DoReplace(const FuncGraphManagerPtr manager, const std::vector<std::si
     std::vector<AnfNodePtr> &group = (*groups)[h];
     // If there are more than 2 node in that group, they may be same common expression can be eliminated.
     if (group.size() > 1) {
+      // Keep the nodes of the outer graphs first, so the nodes in their closures are replaced by them.
+      std::stable_sort(group.begin(), group.end(), [&manager](const AnfNodePtr &a, const AnfNodePtr &b) {
+        return GraphDepth(manager, a) < GraphDepth(manager, b);
+      });
       for (size_t k = 0; k < group.size() - 1; k++) {
         AnfNodePtr main = group[k];
         MS_EXCEPTION_IF_NULL(main);
@@ -236,7 +335,7 @@ bool CSE::DoReplace(const FuncGraphManagerPtr manager, const std::vector<std::si
           if (clear_set.find(i) != clear_set.end()) {
             continue;
           }
-          if (main->func_graph() != node->func_graph()) {
+          if (!CanReplaceInGraph(manager, main, node)) {
             continue;
           }
           if (CheckReplace(node, main)) {
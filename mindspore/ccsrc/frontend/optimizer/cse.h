@@ -42,6 +42,7 @@ class CSE {
 
  private:
   bool BuildOrderGroupAndDoReplace(const FuncGraphManagerPtr manager) const;
+  bool CheckInputsReplace(const CNodePtr &main, const CNodePtr &node, bool swap_operands) const;
   bool DoReplace(const FuncGraphManagerPtr manager, const std::vector<std::size_t> &order_group,
                  std::unordered_map<std::size_t, std::vector<AnfNodePtr>> *groups) const;
 };
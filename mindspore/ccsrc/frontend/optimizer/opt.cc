@@ -20,6 +20,7 @@
 #include <memory>
 #include <unordered_map>
 #include <algorithm>
+#include <iterator>
 
 #include "ir/anf.h"
 #include "ir/manager.h"
@@ -31,8 +32,9 @@ namespace mindspore {
 namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
+  MS_EXCEPTION_IF_NULL(prim);
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, std::vector<std::string>{prim->name()});
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -59,7 +61,12 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  std::vector<std::string> prim_names;
+  (void)std::transform(prims.begin(), prims.end(), std::back_inserter(prim_names), [](const PrimitivePtr &prim) {
+    MS_EXCEPTION_IF_NULL(prim);
+    return prim->name();
+  });
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, prim_names);
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -158,6 +165,46 @@ static void UpdateTransformingList(const OptimizerPtr &optimizer, const AnfNodeP
   }
 }
 
+void SubstitutionList::BuildPrimitiveIndex() {
+  for (const auto &substitution : list_) {
+    MS_EXCEPTION_IF_NULL(substitution);
+    for (const auto &prim_name : substitution->prim_names_) {
+      (void)prim_index_.emplace(prim_name, std::vector<SubstitutionPtr>());
+    }
+  }
+  for (const auto &substitution : list_) {
+    if (substitution->prim_names_.empty()) {
+      generic_list_.push_back(substitution);
+      for (auto &iter : prim_index_) {
+        iter.second.push_back(substitution);
+      }
+      continue;
+    }
+    for (const auto &prim_name : substitution->prim_names_) {
+      auto &candidates = prim_index_[prim_name];
+      // A substitution may list the same primitive twice.
+      if (candidates.empty() || candidates.back() != substitution) {
+        candidates.push_back(substitution);
+      }
+    }
+  }
+}
+
+const std::vector<SubstitutionPtr> &SubstitutionList::GetCandidateSubstitutions(const AnfNodePtr &node) const {
+  if (prim_index_.empty() || !node->isa<CNode>()) {
+    return generic_list_;
+  }
+  auto prim = GetCNodePrimitive(node);
+  if (prim == nullptr) {
+    return generic_list_;
+  }
+  auto iter = prim_index_.find(prim->name());
+  if (iter == prim_index_.end()) {
+    return generic_list_;
+  }
+  return iter->second;
+}
+
 bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
@@ -179,7 +226,7 @@ bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, con
     node->seen_ = seen;
 
     bool change = false;
-    for (auto &substitution : list_) {
+    for (auto &substitution : GetCandidateSubstitutions(node)) {
       auto res = DoTransform(optimizer, node, substitution);
       if (res != nullptr) {
         change = true;
@@ -43,9 +43,15 @@ class Substitution {
   PredicateFuncType predicate_{nullptr};
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
+  // names of the primitives that the matched CNode must be rooted at, empty if the predicate may match any node
+  std::vector<std::string> prim_names_;
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
-               const RenormAction &renorm_action)
-      : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action) {}
+               const RenormAction &renorm_action, const std::vector<std::string> &prim_names = {})
+      : transform_(transform),
+        name_(name),
+        predicate_(predicate),
+        renorm_action_(renorm_action),
+        prim_names_(prim_names) {}
   ~Substitution() = default;
   AnfNodePtr operator()(const OptimizerPtr &optimizer, const AnfNodePtr &node);
 };
@@ -66,7 +72,9 @@ class SubstitutionList {
  public:
   explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false,
                             bool global_sensitive = false)
-      : list_(patterns), is_once_(is_once), global_sensitive_(global_sensitive) {}
+      : list_(patterns), is_once_(is_once), global_sensitive_(global_sensitive) {
+    BuildPrimitiveIndex();
+  }
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
@@ -75,10 +83,17 @@ class SubstitutionList {
   bool ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const;
   bool ApplySubstitutionToIR(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &sub) const;
   bool ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const;
+  // Index the substitutions by the primitive they are rooted at, so a node only tries the ones that can match it.
+  void BuildPrimitiveIndex();
+  const std::vector<SubstitutionPtr> &GetCandidateSubstitutions(const AnfNodePtr &node) const;
   void DisplayStatusOfSubstitution(const std::unordered_map<std::string, std::vector<bool>> &status,
                                    const OptimizerPtr &optimizer, size_t space) const;
 
   std::vector<SubstitutionPtr> list_;
+  // substitutions that may match any node, in the order of list_
+  std::vector<SubstitutionPtr> generic_list_;
+  // for each primitive name, the substitutions rooted at it merged with generic_list_, in the order of list_
+  std::unordered_map<std::string, std::vector<SubstitutionPtr>> prim_index_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
   bool global_sensitive_;
@@ -19,13 +19,94 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 #include <utility>
 #include "frontend/parallel/auto_parallel/costmodel.h"
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
 #include "frontend/parallel/tensor_layout/tensor_redistribution.h"
+#include "common/thread_pool.h"
+#include "utils/ms_exception.h"
 
 namespace mindspore {
 namespace parallel {
+namespace {
+// Below this number of strategy pairs, an edge computes its costs inline, as the thread pool would cost more.
+constexpr size_t kParallelEdgeCostThreshold = 64;
+
+struct RedistributionCost {
+  double computation_cost;
+  double comm_cost;
+  double forward_comm_cost;
+  double backward_comm_cost;
+  double memory_cost;
+};
+
+// The same layout pairs recur on many edges, e.g. in every layer of a transformer, so the costs of a redistribution
+// are computed once per layout pair and device list.
+std::mutex redistribution_cost_mutex;
+std::unordered_map<std::string, RedistributionCost> redistribution_cost_cache;
+size_t redistribution_cost_hit_num = 0;
+size_t redistribution_cost_miss_num = 0;
+
+std::string RedistributionCostKey(const TensorLayout &from, const TensorLayout &to, const RankList &dev_list) {
+  std::ostringstream buffer;
+  buffer << from.ToString() << to.ToString() << std::endl << "device list = ";
+  for (auto rank : dev_list) {
+    buffer << rank << ",";
+  }
+  return buffer.str();
+}
+
+RedistributionCost ComputeRedistributionCost(const TensorLayout &from, const TensorLayout &to,
+                                             const RankList &dev_list) {
+  auto key = RedistributionCostKey(from, to, dev_list);
+  {
+    std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+    auto iter = redistribution_cost_cache.find(key);
+    if (iter != redistribution_cost_cache.end()) {
+      ++redistribution_cost_hit_num;
+      return iter->second;
+    }
+    ++redistribution_cost_miss_num;
+  }
+  TensorRedistribution tensor_redistribution(false);
+
+  // Init TensorRedistribution
+  if (tensor_redistribution.Init(from, to, dev_list) == FAILED) {
+    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
+  }
+
+  if (tensor_redistribution.ComputeCost() == FAILED) {
+    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
+  }
+  RedistributionCost result = {tensor_redistribution.computation_cost(), tensor_redistribution.comm_cost(),
+                               tensor_redistribution.forward_comm_cost(), tensor_redistribution.backward_comm_cost(),
+                               tensor_redistribution.memory_cost()};
+  std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+  (void)redistribution_cost_cache.emplace(key, result);
+  return result;
+}
+}  // namespace
+
+void Edge::ClearRedistributionCostCache() {
+  std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+  redistribution_cost_cache.clear();
+  redistribution_cost_hit_num = 0;
+  redistribution_cost_miss_num = 0;
+}
+
+size_t Edge::RedistributionCostCacheHitNum() {
+  std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+  return redistribution_cost_hit_num;
+}
+
+size_t Edge::RedistributionCostCacheMissNum() {
+  std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+  return redistribution_cost_miss_num;
+}
+
 Status Edge::InitEdgeCost() {
   bool has_available_cost = false;
   pre_op_output_.clear();
@@ -61,32 +142,48 @@ Status Edge::InitEdgeCost() {
       }
     }
   } else {
-    for (auto &target_output : pre_op_output_) {
-      auto target_output_lyt = target_output.second[prev_op_output_index_].tensor_layout();
-      auto target_output_str = target_output.first;
-      auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
-      auto type = prev_op_->outputs_type()[prev_op_output_index_];
-      for (auto &target_input : next_op_input_) {
-        auto target_input_lyt = target_input.second[next_op_input_index_].tensor_layout();
-        auto target_input_str = target_input.first;
-        CostPtr cost;
-        if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, type, &cost) != SUCCESS) {
-          MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
+    auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
+    auto type = prev_op_->outputs_type()[prev_op_output_index_];
+    size_t input_num = next_op_input_.size();
+    size_t pair_num = pre_op_output_.size() * input_num;
+    // The costs of the strategy pairs are independent of each other, so they are computed in parallel.
+    std::vector<CostPtr> costs(pair_num);
+    size_t task_num = 1;
+    if (pair_num >= kParallelEdgeCostThreshold) {
+      task_num = std::min(common::ThreadPool::GetInstance().GetSyncRunThreadNum(), pair_num);
+    }
+    size_t block_size = (pair_num + task_num - 1) / task_num;
+    std::vector<common::Task> tasks;
+    for (size_t start = 0; start < pair_num; start += block_size) {
+      size_t end = std::min(start + block_size, pair_num);
+      tasks.emplace_back([this, start, end, input_num, type_length, &type, &costs]() {
+        for (size_t i = start; i < end; ++i) {
+          const auto &target_output_lyt = pre_op_output_[i / input_num].second[prev_op_output_index_].tensor_layout();
+          const auto &target_input_lyt = next_op_input_[i % input_num].second[next_op_input_index_].tensor_layout();
+          if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, type, &costs[i]) != SUCCESS) {
+            MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
+          }
+          // refine communication cost calculation for practice
+          RefineForPracticalCost(costs[i], true);
+          costs[i]->communication_forward_ = costs[i]->communication_redis_forward_;
         }
-        MS_EXCEPTION_IF_NULL(cost);
-        MS_LOG(DEBUG) << "The redistribution cost: computation_cost: " << cost->computation_cost_
-                      << ", communication_cost: " << cost->communication_cost_
-                      << ", communication_without_parameter_: " << cost->communication_without_parameter_
-                      << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
-        // refine communication cost calculation for practice
-        RefineForPracticalCost(cost, true);
-        cost->communication_forward_ = cost->communication_redis_forward_;
-        CostPtrKey ck = {target_output_str, target_input_str};
-        CostPtrList cl;
-        cl.push_back(cost);
-        (void)cost_map_.emplace(std::make_pair(ck, cl));
-        has_available_cost = true;
-      }
+        return common::SUCCESS;
+      });
+    }
+    (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+    MsException::Instance().CheckException();
+    for (size_t i = 0; i < pair_num; ++i) {
+      const auto &cost = costs[i];
+      MS_EXCEPTION_IF_NULL(cost);
+      MS_LOG(DEBUG) << "The redistribution cost: computation_cost: " << cost->computation_cost_
+                    << ", communication_cost: " << cost->communication_cost_
+                    << ", communication_without_parameter_: " << cost->communication_without_parameter_
+                    << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
+      CostPtrKey ck = {pre_op_output_[i / input_num].first, next_op_input_[i % input_num].first};
+      CostPtrList cl;
+      cl.push_back(cost);
+      (void)cost_map_.emplace(std::make_pair(ck, cl));
+      has_available_cost = true;
     }
   }
   if (!has_available_cost) {
@@ -116,22 +213,13 @@ Status Edge::GetRedistributionCost(const TensorLayout &prev_op_output_layout, co
   MS_EXCEPTION_IF_NULL(prev_op_);
   MS_EXCEPTION_IF_NULL(cost);
   RankList dev_list = prev_op_->stage_device_list();
-  TensorRedistribution tensor_redistribution(false);
-
-  // Init TensorRedistribution
-  if (tensor_redistribution.Init(prev_op_output_layout, next_op_input_layout, dev_list) == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
-  }
-
-  if (tensor_redistribution.ComputeCost() == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
-  }
+  auto redistribution_cost = ComputeRedistributionCost(prev_op_output_layout, next_op_input_layout, dev_list);
 
-  double comm_cost = tensor_redistribution.comm_cost();
-  double forward_comm_cost = tensor_redistribution.forward_comm_cost();
-  double backward_comm_cost = tensor_redistribution.backward_comm_cost();
-  double computation_cost = tensor_redistribution.computation_cost();
-  double mem_cost = tensor_redistribution.memory_cost();
+  double comm_cost = redistribution_cost.comm_cost;
+  double forward_comm_cost = redistribution_cost.forward_comm_cost;
+  double backward_comm_cost = redistribution_cost.backward_comm_cost;
+  double computation_cost = redistribution_cost.computation_cost;
+  double mem_cost = redistribution_cost.memory_cost;
   const auto gamma = CostModelContext::GetInstance()->costmodel_gamma();
 
   // Now AllGather, ReduceScatter, AlltoAll don't support bool type
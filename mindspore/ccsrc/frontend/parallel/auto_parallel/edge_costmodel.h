@@ -80,6 +80,11 @@ class Edge {
   std::string edge_name() const { return edge_name_; }
   // Init cost_map_: for each output layout and input layout, calculate the cost
   Status InitEdgeCost();
+  // Drop the redistribution costs memoized across edges, which are only valid for one cost graph.
+  static void ClearRedistributionCostCache();
+  // The number of redistribution costs read from the cache, and computed, since it was last cleared.
+  static size_t RedistributionCostCacheHitNum();
+  static size_t RedistributionCostCacheMissNum();
   std::map<CostPtrKey, CostPtrList> GetCostMap() { return cost_map_; }
   void SetCostMapAndInputOutput(std::map<CostPtrKey, CostPtrList> &);
   // For two operators u--->v, given the output tensor layout of u,
@@ -1827,5 +1827,27 @@ void CostGraph::CheckApproximateCostGraphEdges() {
     }
   }
 }
+
+std::map<int64_t, std::vector<double>> GetSelectedStageCosts() {
+  std::map<int64_t, std::vector<double>> stage_costs;
+  if (entire_costgraph == nullptr) {
+    return stage_costs;
+  }
+  for (auto &op : entire_costgraph->GetOperators()) {
+    MS_EXCEPTION_IF_NULL(op);
+    auto cost = op->selected_cost();
+    if (cost == nullptr) {
+      continue;
+    }
+    auto &stage_cost = stage_costs[op->stage_id()];
+    if (stage_cost.empty()) {
+      stage_cost.assign(3, 0.0);
+    }
+    stage_cost[0] += cost->computation_cost_;
+    stage_cost[1] += cost->communication_cost_;
+    stage_cost[2] += cost->memory_with_reuse_;
+  }
+  return stage_costs;
+}
 }  // namespace parallel
 }  // namespace mindspore
@@ -208,6 +208,10 @@ class CostGraph {
   std::map<OperatorInfoPtr, std::vector<EdgePtr>> out_edges_;
   std::map<OperatorInfoPtr, std::vector<EdgePtr>> in_edges_;
 };
+
+// The computation, communication and memory costs of the strategies selected by the last search, summed over the
+// operators of each pipeline stage. Stages without selected costs, e.g. searched by recursive programming, are absent.
+std::map<int64_t, std::vector<double>> GetSelectedStageCosts();
 }  // namespace parallel
 }  // namespace mindspore
 
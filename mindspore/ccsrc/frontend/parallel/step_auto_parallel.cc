@@ -237,6 +237,7 @@ void InitCostGraph() {
   MS_EXCEPTION_IF_NULL(CostModelContext::GetInstance());
   CostModelContext::GetInstance()->PrintCostModel();
   entire_costgraph->Init();
+  Edge::ClearRedistributionCostCache();
 }
 
 void SetStrategyToOperator(const OperatorInfoPtr &operator_info, const PrimitivePtr &prim,
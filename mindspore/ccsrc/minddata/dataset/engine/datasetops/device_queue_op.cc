@@ -24,6 +24,9 @@
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/util/task_manager.h"
+#if defined(ENABLE_TDTQUE) && ENABLE_D
+#include "ps/ps_cache/ps_data/ps_data_prefetch.h"
+#endif
 
 namespace mindspore {
 namespace dataset {
@@ -190,7 +193,7 @@ Status DeviceQueueOp::SendDataToAscend() {
   md_channel_info_->RecordPreprocessBatch(0);
 #endif
   TensorRow curr_row;
-  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&curr_row));
+  RETURN_IF_NOT_OK(FetchNextRowWithLookahead(&curr_row));
   while (!curr_row.eof() && !is_break_loop) {
     while (!curr_row.eoe() && !is_break_loop) {
       RETURN_IF_NOT_OK(FilterMetadata(&curr_row));
@@ -224,7 +227,7 @@ Status DeviceQueueOp::SendDataToAscend() {
         connector_size = ChildOpConnectorSize();
         connector_capacity = ChildOpConnectorCapacity();
       }
-      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&curr_row));
+      RETURN_IF_NOT_OK(FetchNextRowWithLookahead(&curr_row));
     }
     if (curr_row.eoe() && send_epoch_end_) {
       TensorRow currRow;
@@ -252,7 +255,7 @@ Status DeviceQueueOp::SendDataToAscend() {
       connector_capacity = ChildOpConnectorCapacity();
       tree_->SetEpochEnd();
     }
-    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&curr_row));
+    RETURN_IF_NOT_OK(FetchNextRowWithLookahead(&curr_row));
   }
 
   // now we use this flag to judge whether exception raised.
@@ -263,6 +266,30 @@ Status DeviceQueueOp::SendDataToAscend() {
 
   return Status::OK();
 }
+
+Status DeviceQueueOp::FetchNextRowWithLookahead(TensorRow *row) {
+  RETURN_UNEXPECTED_IF_NULL(row);
+#if ENABLE_D
+  if (ps::PsDataPrefetch::GetInstance().cache_enable()) {
+    // The cache pulls the rows of the ids of these batches from the server while the current batch is processed.
+    while (lookahead_rows_.size() <= ps::kMaxLookaheadBatchNum &&
+           (lookahead_rows_.empty() || (!lookahead_rows_.back().eoe() && !lookahead_rows_.back().eof()))) {
+      TensorRow next_row;
+      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&next_row));
+      if (!next_row.empty() && next_row[0] != nullptr && next_row[0]->type() == DataType::DE_INT32) {
+        (void)ps::PsDataPrefetch::GetInstance().HintData(channel_name_, next_row[0]->GetBuffer(),
+                                                         next_row[0]->SizeInBytes(), "int32");
+      }
+      lookahead_rows_.push_back(std::move(next_row));
+    }
+    *row = std::move(lookahead_rows_.front());
+    lookahead_rows_.pop_front();
+    return Status::OK();
+  }
+#endif
+  return child_iterator_->FetchNextTensorRow(row);
+}
+
 void DeviceQueueOp::WaitContinueSignal() const {
   while (stop_send_ && ascend_keep_waiting_) {
     MS_LOG(DEBUG) << "stop_send flag is set, waiting for continue signal...";
@@ -376,7 +403,7 @@ Status DeviceQueueOp::PushDataToGPU() {
   md_channel_info_->RecordPreprocessBatch(0);
 #endif
   std::vector<device::DataItemGpu> items;
-  RETURN_IF_NOT_OK(gpu_item_connector_->Pop(0, &items));
+  RETURN_IF_NOT_OK(PopItemsWithLookahead(&items));
   int64_t send_batch = 0;
   bool is_open = false;
   uint32_t handle = INVALID_HANDLE;
@@ -430,9 +457,10 @@ Status DeviceQueueOp::PushDataToGPU() {
       break;
     }
     if (!TaskManager::FindMe()->Interrupted() && !GpuBufferMgr::GetInstance().IsClosed()) {
-      auto rc = gpu_item_connector_->Pop(0, &items);
+      auto rc = PopItemsWithLookahead(&items);
       // If the batches send by dataset are more than gpu calculate, gpu will core for no signal notify.
       if (rc.IsError()) {
+        ReleaseLookaheadItems();
         GpuBufferMgr::GetInstance().Close(handle);
         GpuBufferMgr::GetInstance().CloseConfirm();
         return rc;
@@ -449,11 +477,46 @@ Status DeviceQueueOp::PushDataToGPU() {
   tree_->SetFinished();
   MS_LOG(INFO) << "Device queue send " << send_batch << " batch.";
 
+  ReleaseLookaheadItems();
   GpuBufferMgr::GetInstance().Close(handle);
   GpuBufferMgr::GetInstance().CloseConfirm();
   return Status::OK();
 }
 
+Status DeviceQueueOp::PopItemsWithLookahead(std::vector<device::DataItemGpu> *items) {
+  RETURN_UNEXPECTED_IF_NULL(items);
+  if (!ps::PsDataPrefetch::GetInstance().cache_enable()) {
+    return gpu_item_connector_->Pop(0, items);
+  }
+  // The cache pulls the rows of the ids of these batches from the server while the current batch is processed.
+  while (lookahead_items_.size() <= ps::kMaxLookaheadBatchNum && !lookahead_end_) {
+    std::vector<device::DataItemGpu> next_items;
+    RETURN_IF_NOT_OK(gpu_item_connector_->Pop(0, &next_items));
+    if (next_items.empty()) {
+      lookahead_end_ = true;
+      break;
+    }
+    (void)ps::PsDataPrefetch::GetInstance().HintData(channel_name_, next_items[0].data_ptr_, next_items[0].data_len_,
+                                                     next_items[0].data_type_);
+    lookahead_items_.push_back(std::move(next_items));
+  }
+  items->clear();
+  if (!lookahead_items_.empty()) {
+    *items = std::move(lookahead_items_.front());
+    lookahead_items_.pop_front();
+  }
+  return Status::OK();
+}
+
+void DeviceQueueOp::ReleaseLookaheadItems() {
+  for (const auto &items : lookahead_items_) {
+    for (const auto &item : items) {
+      ReleaseData(item.data_ptr_, item.worker_id_);
+    }
+  }
+  lookahead_items_.clear();
+}
+
 Status DeviceQueueOp::RetryPushData(unsigned int handle, const std::vector<DataItemGpu> &items) {
   bool flagLog = false;
   while (!GpuBufferMgr::GetInstance().IsClosed() && !TaskManager::FindMe()->Interrupted()) {
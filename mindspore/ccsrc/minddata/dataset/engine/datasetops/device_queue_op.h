@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_DEVICE_QUEUE_OP_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_DEVICE_QUEUE_OP_H_
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
@@ -197,7 +198,11 @@ class DeviceQueueOp : public PipelineOp {
   void WaitContinueSignal() const;
   Status SendDataToAscend();
   Status SendRowToTdt(TensorRow currRow, bool isProfilingEnable, int32_t *tdt_cost);
+  // Fetch the next row. In PS cache mode the rows of the batches coming next are fetched ahead, until the end of the
+  // epoch, and their ids are handed to the cache.
+  Status FetchNextRowWithLookahead(TensorRow *row);
   bool ascend_keep_waiting_;
+  std::deque<TensorRow> lookahead_rows_;
 #endif
 
 #ifdef ENABLE_GPUQUE
@@ -209,6 +214,10 @@ class DeviceQueueOp : public PipelineOp {
   Status PushDataToGPU();
   Status WorkerEntry(int32_t worker_id);
   Status SetThreadDevice();
+  // Pop the next items. In PS cache mode the items of the batches coming next are popped ahead, and their ids are
+  // handed to the cache.
+  Status PopItemsWithLookahead(std::vector<device::DataItemGpu> *items);
+  void ReleaseLookaheadItems();
 
   QueueList<TensorRow> receive_queues_;
   std::vector<std::shared_ptr<MemoryPool>> pool_;
@@ -219,6 +228,8 @@ class DeviceQueueOp : public PipelineOp {
   // for standalone scenario, this rank_id may come from env 'CUDA_VISIBLE_DEVICES',
   // but for distribute scenario, this rank_id come from _get_global_rank() in python
   uint32_t rank_id_;
+  std::deque<std::vector<device::DataItemGpu>> lookahead_items_;
+  bool lookahead_end_{false};
 #endif
 
   Status SendDataToCPU();
@@ -28,6 +28,7 @@
 #include "utils/mpi/mpi_config.h"
 #include "frontend/parallel/context.h"
 #include "frontend/parallel/costmodel_context.h"
+#include "frontend/parallel/auto_parallel/graph_costmodel.h"
 #include "crypto/crypto_pybind.h"
 #ifdef ENABLE_GPU_COLLECTIVE
 #include "runtime/device/gpu/distribution/collective_init.h"
@@ -112,6 +113,8 @@ PYBIND11_MODULE(_c_expression, m) {
   (void)m.def("init_pipeline", &mindspore::pipeline::InitPipeline, "Init Pipeline.");
 
   (void)m.def("export_graph", &mindspore::pipeline::ExportGraph, "Export Graph.");
+  (void)m.def("get_strategy_search_cost", &mindspore::parallel::GetSelectedStageCosts,
+              "Get the costs of the searched strategies in each stage.");
   (py::object) m.def("load_mindir", &mindspore::pipeline::LoadMindIR, py::arg("file_name"), "Load model as Graph.");
 
   (void)py::class_<mindspore::MpiConfig, std::shared_ptr<mindspore::MpiConfig>>(m, "MpiConfig")
@@ -335,6 +338,7 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("clone_hash_table", &PSContext::CloneHashTable, "Clone a hash table.")
     .def("set_cache_enable", &PSContext::set_cache_enable, "Set ps mode cache enable or not.")
     .def("set_rank_id", &PSContext::set_rank_id, "Set rank id for worker on ps mode.")
+    .def("set_cache_policy", &PSContext::set_cache_policy, "Set the replacement policy of the ps embedding cache.")
     .def("set_server_mode", &PSContext::set_server_mode, "Set server mode.")
     .def("server_mode", &PSContext::server_mode, "Get server mode.")
     .def("set_ms_role", &PSContext::set_ms_role, "Set role for this process.")
@@ -359,8 +363,14 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("set_client_batch_size", &PSContext::set_client_batch_size, "Set federated learning client batch size.")
     .def("set_client_learning_rate", &PSContext::set_client_learning_rate,
          "Set federated learning client learning rate.")
+    .def("set_model_store_memory_budget", &PSContext::set_model_store_memory_budget,
+         "Set memory budget of the models stored by federated learning server.")
     .def("set_scheduler_manage_port", &PSContext::set_scheduler_manage_port,
          "Set scheduler manage port used to scale out/in.")
+    .def("set_tcp_transport", &PSContext::set_tcp_transport,
+         "Set the transport of the tcp communication between workers and servers.")
+    .def("set_load_rebalance_interval", &PSContext::set_load_rebalance_interval,
+         "Set the number of pushes per key between the load rebalances of the parameter servers.")
     .def("set_enable_ssl", &PSContext::enable_ssl, "Set PS SSL mode enabled or disabled.");
 
   (void)py::class_<OpInfoLoaderPy, std::shared_ptr<OpInfoLoaderPy>>(m, "OpInfoLoaderPy")
@@ -18,12 +18,15 @@
 
 #include "pipeline/jit/pipeline.h"
 
+#include <unistd.h>
 #include <sstream>
 #include <map>
 #include <unordered_map>
 #include <cstdlib>
 #include <algorithm>
 #include <iomanip>
+#include <optional>
+#include <cstdio>
 
 #include "ir/param_info.h"
 #include "pipeline/jit/pass.h"
@@ -101,7 +104,7 @@ std::unordered_map<abstract::AbstractBasePtrList, int64_t, abstract::AbstractBas
   g_args_cache;
 
 namespace {
-constexpr char kCompileCacheFilePath[] = "compile_cache.mindir";
+constexpr char kCompileCacheDir[] = "compile_cache";
 
 std::string GetBaseNameForIR(int64_t stage_idx, const std::string &action_name) {
   std::ostringstream oss;
@@ -173,24 +176,66 @@ void SetGpuLoopSink(const ResourcePtr &resource) {
   }
 }
 
-void GetCachedFuncGraph(const ResourcePtr &resource) {
+std::string GetCompileCacheBuildInfo(const ResourcePtr &resource, const std::string &phase) {
   MS_EXCEPTION_IF_NULL(resource);
-  auto realpath = Common::GetRealPath(kCompileCacheFilePath);
+  std::ostringstream oss;
+  oss << "phase:" << GetPhasePrefix(phase) << ";";
+  for (const auto &arg : resource->args_spec()) {
+    MS_EXCEPTION_IF_NULL(arg);
+    oss << arg->ToString() << ";";
+  }
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  oss << "device_target:" << context->get_param<std::string>(MS_CTX_DEVICE_TARGET) << ";"
+      << "backend_policy:" << context->backend_policy() << ";"
+      << "execution_mode:" << context->get_param<int>(MS_CTX_EXECUTION_MODE) << ";"
+      << "enable_graph_kernel:" << context->get_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL) << ";"
+      << "grad_for_scalar:" << context->get_param<bool>(MS_CTX_GRAD_FOR_SCALAR) << ";";
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  oss << "parallel_mode:" << parallel_context->parallel_mode() << ";"
+      << "device_num:" << parallel_context->device_num() << ";"
+      << "global_rank:" << parallel_context->global_rank() << ";";
+  return oss.str();
+}
+
+// The cache file of a network is addressed by the hash of its python sources and the user modules they import, the
+// attributes and parameters of its cells, the input signature, the phase and the build options. The values of global
+// variables and of private attributes are not covered, see get_compile_cache_key in parser.py.
+std::optional<std::string> GetCompileCacheFilePath(const ResourcePtr &resource, const std::string &phase) {
+  MS_EXCEPTION_IF_NULL(resource);
+  py::object key_obj = parse::python_adapter::CallPyFn(parse::PYTHON_MOD_PARSE_MODULE,
+                                                       parse::PYTHON_MOD_GET_COMPILE_CACHE_KEY, resource->input(),
+                                                       GetCompileCacheBuildInfo(resource, phase));
+  auto key = py::cast<std::string>(key_obj);
+  std::string file_path = std::string(kCompileCacheDir) + "/" + key + ".mindir";
+  auto realpath = Common::GetRealPath(file_path);
   if (!realpath.has_value()) {
-    MS_LOG(EXCEPTION) << "Get real path failed. filename=" << kCompileCacheFilePath;
+    MS_LOG(WARNING) << "Get real path failed. filename=" << file_path;
+  }
+  return realpath;
+}
+
+void GetCachedFuncGraph(const ResourcePtr &resource) {
+  MS_EXCEPTION_IF_NULL(resource);
+  const auto &realpath = resource->compile_cache_path();
+  if (realpath.empty()) {
+    return;
   }
-  std::ifstream f(realpath.value());
+  std::ifstream f(realpath);
   bool cache_file_existed = f.good();
   f.close();
   if (!cache_file_existed) {
-    MS_LOG(WARNING) << "The compilation cache file '" << realpath.value()
-                    << "' dose not exist. Execute all the compilation actions.";
+    MS_LOG(INFO) << "The compilation cache file '" << realpath
+                 << "' dose not exist. Execute all the compilation actions.";
     return;
   }
-  MS_LOG(INFO) << "Use the compilation cache \"" << realpath.value() << "\" and execute the backend actions only.";
-  FuncGraphPtr fg = LoadMindIR(realpath.value());
+  MS_LOG(INFO) << "Use the compilation cache \"" << realpath << "\" and execute the backend actions only.";
+  FuncGraphPtr fg = LoadMindIR(realpath);
   if (fg == nullptr) {
-    MS_LOG(EXCEPTION) << "Failed to load the compilation cache file: " << realpath.value();
+    MS_LOG(WARNING) << "Failed to load the compilation cache file: " << realpath
+                    << ". Execute all the compilation actions.";
+    return;
   }
   FuncGraphManagerPtr mng = fg->manager();
   if (mng == nullptr) {
@@ -204,23 +249,38 @@ void GetCachedFuncGraph(const ResourcePtr &resource) {
 
 void CacheFuncGraph(const ResourcePtr &resource) {
   MS_EXCEPTION_IF_NULL(resource);
-  auto realpath = Common::GetRealPath(kCompileCacheFilePath);
-  if (!realpath.has_value()) {
-    MS_LOG(EXCEPTION) << "Get real path failed. filename=" << kCompileCacheFilePath;
+  const auto &realpath = resource->compile_cache_path();
+  if (realpath.empty()) {
+    return;
+  }
+  std::ifstream f(realpath);
+  bool cache_file_existed = f.good();
+  f.close();
+  if (cache_file_existed) {
+    MS_LOG(INFO) << "The compilation cache file '" << realpath << "' already exists.";
+    return;
   }
 
-  ChangeFileMode(realpath.value(), S_IRWXU);
-  std::ofstream fout(realpath.value());
+  // Write to a process private file first and rename it, so that a concurrent reader never sees a partial cache.
+  std::string tmp_path = realpath + "." + std::to_string(getpid()) + ".tmp";
+  std::ofstream fout(tmp_path);
   if (!fout.is_open()) {
-    MS_LOG(EXCEPTION) << "Open cache file '" << realpath.value() << "' failed!";
+    MS_LOG(WARNING) << "Open cache file '" << tmp_path << "' failed!";
+    return;
   }
   FuncGraphPtr fg = resource->func_graph();
   mind_ir::ModelProto fg_model = GetBinaryProto(fg);
   if (!fg_model.SerializeToOstream(&fout)) {
-    MS_LOG(EXCEPTION) << "Failed to cache the graph to file " << realpath.value();
+    fout.close();
+    (void)std::remove(tmp_path.c_str());
+    MS_LOG(EXCEPTION) << "Failed to cache the graph to file " << tmp_path;
   }
   fout.close();
-  ChangeFileMode(realpath.value(), S_IRUSR);
+  ChangeFileMode(tmp_path, S_IRUSR);
+  if (std::rename(tmp_path.c_str(), realpath.c_str()) != 0) {
+    (void)std::remove(tmp_path.c_str());
+    MS_LOG(WARNING) << "Failed to rename the cache file " << tmp_path << " to " << realpath;
+  }
 }
 }  // namespace
 
@@ -640,13 +700,6 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   MS_LOG(INFO) << "ExecutorPy compile phase:" << phase_s << "!";
   ResourcePtr resource = std::make_shared<Resource>(obj);
 
-  if (MsContext::GetInstance()->get_param<bool>(MS_CTX_LOAD_COMPILE_CACHE)) {
-    GetCachedFuncGraph(resource);
-  }
-
-  auto p_actions = GetPipeline(resource, phase_s, use_vm);
-  std::shared_ptr<Pipeline> pip = std::make_shared<Pipeline>(resource, FilterActions(p_actions, phase_s));
-
   // get the parameters items and add the value to args_spec
   abstract::AbstractBasePtrList args_spec;
   std::size_t size = args.size();
@@ -660,6 +713,23 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   }
 
   resource->set_args_spec(args_spec);
+
+  // The input signature is part of the cache key, so the key is computed only after the args spec is set. It's computed
+  // once for both loading and saving the cache, as it hashes the sources of the network.
+  auto context = MsContext::GetInstance();
+  if (context->get_param<bool>(MS_CTX_LOAD_COMPILE_CACHE) || context->get_param<bool>(MS_CTX_SAVE_COMPILE_CACHE)) {
+    auto realpath = GetCompileCacheFilePath(resource, phase_s);
+    if (realpath.has_value()) {
+      resource->set_compile_cache_path(realpath.value());
+    }
+  }
+  if (context->get_param<bool>(MS_CTX_LOAD_COMPILE_CACHE)) {
+    GetCachedFuncGraph(resource);
+  }
+
+  auto p_actions = GetPipeline(resource, phase_s, use_vm);
+  std::shared_ptr<Pipeline> pip = std::make_shared<Pipeline>(resource, FilterActions(p_actions, phase_s));
+
   executor_info->arg_list_size = size;
   executor_info->resource = resource;
   info_[phase_s] = executor_info;
@@ -81,6 +81,9 @@ class Resource : public ResourceBase {
   }
   bool gpu_loopsink_flag() { return gpu_loopsink_flag_; }
   int64_t gpu_loopsink_size() { return gpu_loopsink_size_; }
+  // The compile cache file of the network, which is empty if the compile cache is not used.
+  const std::string &compile_cache_path() const { return compile_cache_path_; }
+  void set_compile_cache_path(const std::string &path) { compile_cache_path_ = path; }
   // Reclaim resource and clear the cache.
   // ExecutorPy::Compile() can be called multiple times, so cache
   // should be cleared.
@@ -94,6 +97,7 @@ class Resource : public ResourceBase {
   bool is_cleaned_;
   bool gpu_loopsink_flag_{false};
   int64_t gpu_loopsink_size_{1};
+  std::string compile_cache_path_;
 };
 
 using ResourcePtr = std::shared_ptr<pipeline::Resource>;
@@ -60,6 +60,7 @@ void AnalysisCache::set_value(const AnfNodeConfigPtr &conf, const EvalResultPtr
   MS_LOG(DEBUG) << "AnalysisCache set for NodeConfig: " << conf->node()->DebugString()
                 << ", Context: " << conf->context()->ToString() << ", Value: " << result->abstract()->ToString()
                 << ", Pointer: " << result->abstract().get();
+  std::lock_guard<std::mutex> lock(lock_);
   analysis_cache_map_[conf] = result;
 
   // Set intermediate abstract value.
@@ -79,6 +80,7 @@ void AnalysisCache::set_value(const AnfNodeConfigPtr &conf, const EvalResultPtr
 }
 
 EvalResultPtr AnalysisCache::GetValue(const AnfNodeConfigPtr &conf) {
+  std::lock_guard<std::mutex> lock(lock_);
   auto value = analysis_cache_map_.find(conf);
   if (value == analysis_cache_map_.end()) {
     return nullptr;
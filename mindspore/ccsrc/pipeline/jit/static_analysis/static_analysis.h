@@ -21,6 +21,7 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -154,16 +155,20 @@ class VirtualConfig : public Config {
   AbstractBasePtr abstract_;
 };
 
-// AnalysisCache
+// AnalysisCache, it is safe to be read and written by multiple evaluating threads.
 class AnalysisCache {
  public:
   AnalysisCache() = default;
   ~AnalysisCache() = default;
-  void Clear() { analysis_cache_map_.clear(); }
+  void Clear() {
+    std::lock_guard<std::mutex> lock(lock_);
+    analysis_cache_map_.clear();
+  }
   void set_value(const AnfNodeConfigPtr &conf, const EvalResultPtr &arg);
   EvalResultPtr GetValue(const AnfNodeConfigPtr &conf);
 
  private:
+  std::mutex lock_;
   std::unordered_map<AnfNodeConfigPtr, EvalResultPtr, AnfNodeConfigHasher, AnfNodeConfigEqual> analysis_cache_map_;
 };
 
@@ -186,8 +191,7 @@ struct PartialAppHasher {
 class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
  public:
   AnalysisEngine(const PrimEvaluatorMap &prim_evaluator_map, const FuncGraphManagerPtr &func_graph_manager)
-      : analysis_cache_(AnalysisCache()),
-        prim_constructors_(prim_evaluator_map),
+      : prim_constructors_(prim_evaluator_map),
         func_graph_manager_(func_graph_manager) {
     function_call_depth_ = 0;
     function_call_max_depth_ = 0;
@@ -77,6 +77,8 @@ std::mutex PynativeExecutor::instance_lock_;
 namespace {
 const size_t PTR_LEN = 15;
 const size_t ARG_SIZE = 2;
+// Bound of the inferred abstracts cached for one primitive, which grows with every new input shape.
+const size_t kMaxPrimAbsCacheSize = 256;
 
 // primitive unable to infer value for constant input in PyNative mode
 const std::set<std::string> kVmOperators = {"make_ref", "HookBackward", "InsertGradientOf", "stop_gradient",
@@ -284,66 +286,38 @@ std::string GetSingleOpGraphInfo(const OpExecInfoPtr &op_exec_info, const std::v
     MS_LOG(EXCEPTION) << "Input tensors size " << input_tensors.size() << " should be equal to tensors mask size "
                       << tensors_mask.size();
   }
-  std::string graph_info;
+  session::SingleOpSignature signature;
   // get input tensor info
+  signature.Add(input_tensors.size());
   for (size_t index = 0; index < input_tensors.size(); ++index) {
     MS_EXCEPTION_IF_NULL(input_tensors[index]);
-    auto tensor_shape = input_tensors[index]->shape();
-    (void)std::for_each(tensor_shape.begin(), tensor_shape.end(), [&graph_info](const auto &dim) {
-      (void)graph_info.append(std::to_string(dim));
-      graph_info += "_";
-    });
-    (void)graph_info.append(std::to_string(input_tensors[index]->data_type()));
-    graph_info += "_";
-    (void)graph_info.append(input_tensors[index]->padding_type());
-    graph_info += "_";
-    auto tensor_addr = input_tensors[index]->device_address();
-    if (tensor_addr != nullptr) {
-      (void)graph_info.append(std::to_string(std::dynamic_pointer_cast<device::DeviceAddress>(tensor_addr)->type_id()));
-      graph_info += "_";
-      (void)graph_info.append(std::dynamic_pointer_cast<device::DeviceAddress>(tensor_addr)->format());
-      graph_info += "_";
-    }
+    signature.AddTensor(input_tensors[index]);
     if (tensors_mask[index] == kValueNodeTensorMask) {
-      if (input_tensors[index]->Dtype()->type_id() == kNumberTypeInt64) {
-        (void)graph_info.append(std::to_string(*reinterpret_cast<int *>(input_tensors[index]->data_c())));
-        graph_info += "_";
-      } else if (input_tensors[index]->Dtype()->type_id() == kNumberTypeFloat32 ||
-                 input_tensors[index]->Dtype()->type_id() == kNumberTypeFloat16) {
-        (void)graph_info.append(std::to_string(*reinterpret_cast<float *>(input_tensors[index]->data_c())));
-        graph_info += "_";
-      } else {
+      auto type_id = input_tensors[index]->Dtype()->type_id();
+      if (type_id != kNumberTypeInt64 && type_id != kNumberTypeFloat32 && type_id != kNumberTypeFloat16) {
         MS_LOG(EXCEPTION) << "The dtype of the constant input is not int64 or float32!";
       }
+      // Constant inputs become value nodes of the graph, so their data is a part of the key.
+      auto data = static_cast<const char *>(input_tensors[index]->data_c());
+      signature.Add(std::string(data, input_tensors[index]->data().nbytes()));
     }
   }
-  // get prim and abstract info
-  graph_info += (op_exec_info->op_name);
-  graph_info += "_";
   // get attr info
   const auto &op_prim = op_exec_info->py_primitive;
   MS_EXCEPTION_IF_NULL(op_prim);
-  const auto &attr_map = op_prim->attrs();
-  (void)std::for_each(attr_map.begin(), attr_map.end(), [&graph_info](const auto &element) {
-    graph_info += (element.second->ToString());
-    graph_info += "_";
-  });
+  signature.AddAttrs(op_prim);
 
   // Add output information(shape, type id) of the operator to graph_info to solve the problem of cache missing
   // caused by operators like DropoutGenMask whose output is related to values of input when input shapes are
   // the same but values are different
   auto abstr = op_exec_info->abstract;
   MS_EXCEPTION_IF_NULL(abstr);
-  auto build_shape = abstr->BuildShape();
-  MS_EXCEPTION_IF_NULL(build_shape);
-  graph_info += (build_shape->ToString());
-  graph_info += "_";
+  signature.AddShape(abstr->BuildShape());
   auto build_type = abstr->BuildType();
   MS_EXCEPTION_IF_NULL(build_type);
-  graph_info += std::to_string(build_type->type_id());
-  graph_info += "_";
+  signature.Add(static_cast<size_t>(build_type->type_id()));
 
-  return graph_info;
+  return signature.ToGraphInfo(op_exec_info->op_name);
 }
 
 bool RunOpConvertConstInputToAttr(const py::object &input_object, size_t input_index, const PrimitivePtr &op_prim,
@@ -886,9 +860,11 @@ void ForwardExecutor::GetOpOutputAbstract(const OpExecInfoPtr &op_exec_info,
   auto temp = prim_abs_list_.find(prim);
   if (temp != prim_abs_list_.end()) {
     MS_LOG(DEBUG) << "Match prim input args " << op_name << mindspore::ToString(args_spec_list);
-    auto iter = temp->second.find(args_spec_list);
-    if (iter != temp->second.end()) {
+    auto &cache = temp->second;
+    auto iter = cache.abs_map.find(args_spec_list);
+    if (iter != cache.abs_map.end()) {
       MS_LOG(DEBUG) << "Match prim ok " << op_name;
+      cache.lru.splice(cache.lru.begin(), cache.lru, iter->second.lru_pos);
       op_exec_info->abstract = iter->second.abs;
       prim->set_evaluate_added_attrs(iter->second.attrs);
       *prim_cache_hit = true;
@@ -931,9 +907,22 @@ void ForwardExecutor::GetOpOutput(const OpExecInfoPtr &op_exec_info,
 
   // Add output abstract info into cache, the const value needs to infer evert step
   if (!prim_cache_hit && !op_exec_info->is_dynamic_shape) {
-    auto &out = prim_abs_list_[prim];
-    out[args_spec_list].abs = op_exec_info->abstract;
-    out[args_spec_list].attrs = prim->evaluate_added_attrs();
+    auto &cache = prim_abs_list_[prim];
+    auto iter = cache.abs_map.find(args_spec_list);
+    if (iter == cache.abs_map.end()) {
+      while (cache.abs_map.size() >= kMaxPrimAbsCacheSize) {
+        MS_LOG(DEBUG) << "Evict the least recently used abstract of prim " << prim->name();
+        (void)cache.abs_map.erase(cache.lru.back());
+        cache.lru.pop_back();
+      }
+      cache.lru.push_front(args_spec_list);
+      iter = cache.abs_map.emplace(args_spec_list, PrimAbsInfo()).first;
+      iter->second.lru_pos = cache.lru.begin();
+    } else {
+      cache.lru.splice(cache.lru.begin(), cache.lru, iter->second.lru_pos);
+    }
+    iter->second.abs = op_exec_info->abstract;
+    iter->second.attrs = prim->evaluate_added_attrs();
   }
   // run op with selected backend
   auto result = RunOpWithInitBackendPolicy(op_exec_info);
@@ -1673,6 +1662,8 @@ py::object ForwardExecutor::RunOpInMs(const OpExecInfoPtr &op_exec_info, Pynativ
                                     op_exec_info->next_op_name,
                                     op_exec_info->next_input_index};
 #endif
+  // The bprop graph takes the device address and data of the outputs right after the op is run.
+  op_run_info.is_grad_needed = grad()->grad_flag();
   VectorRef outputs;
   if (!compile::IsMindRTUsed()) {
     kSession->RunOp(&op_run_info, graph_info, &input_tensors, &outputs, tensors_mask);
@@ -23,6 +23,7 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <list>
 #include <mutex>
 #include <stack>
 #include <set>
@@ -49,10 +50,17 @@ struct PrimAbsInfo {
   abstract::AbstractBasePtr abs;
   bool is_dynamic_shape = false;
   std::unordered_map<std::string, ValuePtr> attrs;
+  // Position of the input args in the recently used order of PrimAbsCache.
+  std::list<abstract::AbstractBasePtrList>::iterator lru_pos;
 };
 
 using AbstractListMap = std::unordered_map<abstract::AbstractBasePtrList, PrimAbsInfo,
                                            abstract::AbstractBasePtrListHasher, abstract::AbstractBasePtrListEqual>;
+// The abstracts inferred for one primitive, of which the least recently used are dropped beyond the cache bound.
+struct PrimAbsCache {
+  AbstractListMap abs_map;
+  std::list<abstract::AbstractBasePtrList> lru;
+};
 using MsFunctionGradCache = std::unordered_map<std::string, std::pair<FuncGraphPtr, FuncGraphPtr>>;
 using OpInfoWithTensorId = std::unordered_map<std::string, std::vector<std::string>>;
 using TensorIdWithTensorObject = std::unordered_map<std::string, std::vector<tensor::TensorPtr>>;
@@ -336,7 +344,7 @@ class ForwardExecutor {
 
  private:
   GradExecutorWeakPtr grad_executor_;
-  std::unordered_map<PrimitivePtr, AbstractListMap, PrimitiveHasher, PrimitiveTotalEqual> prim_abs_list_;
+  std::unordered_map<PrimitivePtr, PrimAbsCache, PrimitiveHasher, PrimitiveTotalEqual> prim_abs_list_;
   std::unordered_map<std::string, abstract::AbstractBasePtr> node_abs_map_;
   // Used to cache cast struct
   std::unordered_map<std::string, OpExecInfoPtr> cast_struct_map_;
@@ -71,6 +71,9 @@ constexpr int64_t kEmbeddingLookupCmd = 30;
 constexpr int64_t kFinalizeCmd = 40;
 constexpr int64_t kPushCmd = 50;
 constexpr int64_t kPullCmd = 51;
+constexpr int64_t kMigrateKeyCmd = 60;
+constexpr int64_t kRebalanceKeysCmd = 61;
+constexpr int64_t kMigrateDoneCmd = 62;
 
 constexpr size_t kInvalidKey = UINT64_MAX;
 constexpr int64_t kInvalidID = -1;
@@ -80,7 +83,6 @@ constexpr char kServerNum[] = "server_num";
 constexpr char kWorkerNum[] = "worker_num";
 constexpr char kNodesIds[] = "node_ids";
 
-constexpr int64_t kSubmitTaskIntervalInMs = 1;
 constexpr int64_t kMaxTaskNum = 10240;
 constexpr int64_t kSubmitTimeOutInMs = 30000;
 constexpr int64_t kRetryCount = 60;
@@ -88,6 +90,25 @@ constexpr int64_t kRetryIntervalInMs = 10;
 
 constexpr int64_t kThreadNum = 32;
 
+// The per key state of the parameter server is guarded by a fixed number of striped locks, and the requests of the
+// workers are served by a pool of threads.
+constexpr size_t kKeyLockStripeNum = 64;
+constexpr size_t kServerHandlerThreadNum = 8;
+
+// The dense keys are placed on the servers by a consistent hash ring with this number of virtual nodes per server. A
+// key is migrated to another server at the boundary of its steps, which is polled at an interval. It's sent again a few
+// times until its new server confirms it, and the keys not migrated in time stay on their servers. The servers staying
+// in a scale in wait for the leaving servers to migrate their keys, and the leaving servers answer the workers with the
+// new servers of the keys for a while before exiting.
+constexpr size_t kShardVirtualNodeNum = 64;
+constexpr int64_t kMigrateKeyIntervalInMs = 10;
+constexpr size_t kMigrateKeySendRetryNum = 3;
+constexpr int64_t kMigrateKeysTimeoutInSeconds = 300;
+constexpr int64_t kScaleInMigrateTimeoutInSeconds = 600;
+constexpr int64_t kScaleInRetireDelayInSeconds = 30;
+// The loads of the servers are rebalanced down to the average load by this ratio.
+constexpr double kRebalanceLoadTolerance = 0.1;
+
 using DataPtr = std::shared_ptr<unsigned char[]>;
 using VectorPtr = std::shared_ptr<std::vector<unsigned char>>;
 using Key = uint64_t;
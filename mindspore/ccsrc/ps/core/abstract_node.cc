@@ -15,6 +15,8 @@
  */
 
 #include "ps/core/abstract_node.h"
+#include "ps/core/communicator/epoll_tcp_client.h"
+#include "ps/core/communicator/epoll_tcp_server.h"
 
 namespace mindspore {
 namespace ps {
@@ -70,6 +72,7 @@ bool AbstractNode::Broadcast(const enum NodeRole &node_role, const DataPtr &mess
     MS_LOG(EXCEPTION) << "Currently only supports broadcast to server nodes";
   }
 
+  std::shared_lock<std::shared_mutex> metadata_lock(metadata_mutex_);
   uint64_t request_id = AddMessageTrack(nodes_address_.size());
 
   for (auto it = nodes_address_.begin(); it != nodes_address_.end(); ++it) {
@@ -81,7 +84,7 @@ bool AbstractNode::Broadcast(const enum NodeRole &node_role, const DataPtr &mess
     message_meta->set_user_cmd(command);
 
     auto client = GetOrCreateTcpClient((*it).first.second);
-    client->SendMessage(message_meta, Protos::RAW, message.get(), size);
+    client->SendMessage(message_meta, Protos::RAW, message, size);
   }
   MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
                 << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << request_id;
@@ -90,12 +93,14 @@ bool AbstractNode::Broadcast(const enum NodeRole &node_role, const DataPtr &mess
 
 void AbstractNode::set_ready_for_scale_out() {
   Register(client_to_scheduler_);
+  std::lock_guard<std::mutex> lock(client_mutex_);
   connected_nodes_.clear();
 }
 
 void AbstractNode::set_ready_for_scale_in() {
   if (!is_current_node_scale_in_) {
     Register(client_to_scheduler_);
+    std::lock_guard<std::mutex> lock(client_mutex_);
     connected_nodes_.clear();
   } else {
     current_cluster_state_ = ClusterState::CLUSTER_SCALE_IN;
@@ -139,6 +144,29 @@ void AbstractNode::set_scale_in_done() {
                << " the node id:" << node_info_.node_id_ << "is send scale_in_done to scheduler!";
 }
 
+bool AbstractNode::set_scale_in_failed(const std::string &reason) {
+  auto message_meta = std::make_shared<MessageMeta>();
+  message_meta->set_cmd(NodeCommand::SCALE_IN_FAILED);
+
+  ScaleInFailedMessage scale_in_failed_message;
+  scale_in_failed_message.set_node_id(node_info_.node_id_);
+  scale_in_failed_message.set_role(node_info_.node_role_);
+  scale_in_failed_message.set_reason(reason);
+
+  if (!SendMessageSync(client_to_scheduler_, message_meta, Protos::PROTOBUF,
+                       scale_in_failed_message.SerializeAsString().data(), scale_in_failed_message.ByteSizeLong())) {
+    MS_LOG(ERROR) << "The node role:" << CommUtil::NodeRoleToString(node_info_.node_role_)
+                  << " the node id:" << node_info_.node_id_ << " scale_in_failed timeout!";
+    return false;
+  }
+  is_current_node_scale_in_ = false;
+  MS_LOG(WARNING) << "The node role:" << CommUtil::NodeRoleToString(node_info_.node_role_)
+                  << " the node id:" << node_info_.node_id_ << " fails to be scaled in and stays in the cluster!";
+  return true;
+}
+
+void AbstractNode::set_pinned(bool is_pinned) { is_pinned_ = is_pinned; }
+
 void AbstractNode::RegisterEventCallback(const core::ClusterEvent &event, const EventCallback &event_cb) {
   event_to_callback_.try_emplace(event, event_cb);
 }
@@ -185,7 +213,7 @@ bool AbstractNode::Send(const NodeRole &node_role, const std::vector<uint32_t> &
     auto send = data.at(it);
     auto len = lens.at(it);
     auto client = GetOrCreateTcpClient(rank_ids.at(it));
-    client->SendMessage(message_meta, Protos::RAW, send.get(), len);
+    client->SendMessage(message_meta, Protos::RAW, send, len);
   }
   MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
                 << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << request_id;
@@ -218,7 +246,7 @@ bool AbstractNode::Send(const enum NodeRole &node_role, const uint32_t &rank_id,
   message_meta->set_user_cmd(command);
 
   auto client = GetOrCreateTcpClient(rank_id);
-  client->SendMessage(message_meta, Protos::RAW, message.get(), len);
+  client->SendMessage(message_meta, Protos::RAW, message, len);
   MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
                 << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << request_id;
   return Wait(request_id, timeout);
@@ -263,7 +291,7 @@ bool AbstractNode::Send(const NodeRole &node_role, const std::vector<uint32_t> &
     auto len = data_lens.at(it);
 
     auto client = GetOrCreateTcpClient(rank_ids.at(it));
-    client->SendMessage(message_meta, Protos::RAW, send.get(), len);
+    client->SendMessage(message_meta, Protos::RAW, send, len);
   }
   MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
                 << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << request_id;
@@ -332,6 +360,25 @@ int32_t AbstractNode::server_num() const { return server_num_; }
 
 ClusterState AbstractNode::cluster_state() const { return current_cluster_state_; }
 
+std::shared_mutex &AbstractNode::metadata_mutex() { return metadata_mutex_; }
+
+std::map<uint32_t, std::string> AbstractNode::server_addresses() const {
+  std::map<uint32_t, std::string> addresses;
+  for (const auto &node_address : nodes_address_) {
+    if (node_address.first.first == NodeRole::SERVER) {
+      addresses[node_address.first.second] =
+        node_address.second.first + ":" + std::to_string(node_address.second.second);
+    }
+  }
+  return addresses;
+}
+
+const std::vector<std::string> &AbstractNode::scale_in_servers() const { return scale_in_servers_; }
+
+uint64_t AbstractNode::metadata_version() const { return metadata_version_; }
+
+std::string AbstractNode::address() const { return node_info_.ip_ + ":" + std::to_string(node_info_.port_); }
+
 void AbstractNode::StartHeartbeatTimer(const std::shared_ptr<TcpClient> &client) {
   MS_LOG(INFO) << "The node role: " << CommUtil::NodeRoleToString(node_info_.node_role_)
                << ", the node id:" << node_info_.node_id_ << ", the node rank id:" << node_info_.rank_id_
@@ -364,6 +411,7 @@ bool AbstractNode::Heartbeat(const std::shared_ptr<TcpClient> &client) {
 
   HeartbeatMessage heartbeat_message;
   heartbeat_message.set_node_id(node_info_.node_id_);
+  heartbeat_message.set_is_pinned(is_pinned_);
 
   if (!SendMessageSync(client, meta, Protos::PROTOBUF, heartbeat_message.SerializeAsString().data(),
                        heartbeat_message.ByteSizeLong())) {
@@ -428,6 +476,9 @@ void AbstractNode::ProcessFetchServersResp(std::shared_ptr<MessageMeta> meta, co
   FetchServersRespMessage fetch_servers_resp_message;
   fetch_servers_resp_message.ParseFromArray(data, size);
 
+  std::unique_lock<std::shared_mutex> metadata_lock(metadata_mutex_);
+  std::lock_guard<std::mutex> lock(client_mutex_);
+  metadata_version_++;
   nodes_address_.clear();
   for (const auto &it : fetch_servers_resp_message.servers_meta()) {
     nodes_address_[std::make_pair(NodeRole::SERVER, it.rank_id())] = std::make_pair(it.ip(), it.port());
@@ -442,14 +493,22 @@ void AbstractNode::ProcessSendMetadata(std::shared_ptr<TcpConnection> conn, std:
   MS_EXCEPTION_IF_NULL(data);
   SendMetadataMessage send_meta_message;
   send_meta_message.ParseFromArray(data, size);
-  worker_num_ = send_meta_message.worker_num();
-  server_num_ = send_meta_message.server_num();
-  MS_LOG(WARNING) << "The send metadata worker num:" << worker_num_ << ", server num:" << server_num_;
-
-  nodes_address_.clear();
-  for (const auto &it : send_meta_message.servers_meta()) {
-    nodes_address_[std::make_pair(NodeRole::SERVER, it.rank_id())] = std::make_pair(it.ip(), it.port());
-    MS_LOG(INFO) << "The server ip is:" << it.ip() << ", the port is:" << it.port();
+  {
+    // The requests in flight to the servers finish before the ranks change, and the clients connected by the old ranks
+    // are dropped.
+    std::unique_lock<std::shared_mutex> metadata_lock(metadata_mutex_);
+    std::lock_guard<std::mutex> lock(client_mutex_);
+    worker_num_ = send_meta_message.worker_num();
+    server_num_ = send_meta_message.server_num();
+    MS_LOG(WARNING) << "The send metadata worker num:" << worker_num_ << ", server num:" << server_num_;
+
+    metadata_version_++;
+    nodes_address_.clear();
+    for (const auto &it : send_meta_message.servers_meta()) {
+      nodes_address_[std::make_pair(NodeRole::SERVER, it.rank_id())] = std::make_pair(it.ip(), it.port());
+      MS_LOG(INFO) << "The server ip is:" << it.ip() << ", the port is:" << it.port();
+    }
+    connected_nodes_.clear();
   }
   server_->SendMessage(conn, meta, Protos::RAW, data, size);
   is_ready_ = true;
@@ -529,6 +588,13 @@ void AbstractNode::ProcessScaleIn(std::shared_ptr<TcpConnection> conn, std::shar
   MS_LOG(WARNING) << "The scale in worker num:" << worker_num << ", the server num:" << server_num;
 
   is_current_node_scale_in_ = scale_in_message.is_node_scale_in();
+  {
+    std::unique_lock<std::shared_mutex> metadata_lock(metadata_mutex_);
+    scale_in_servers_.clear();
+    for (const auto &it : scale_in_message.scale_in_servers_meta()) {
+      scale_in_servers_.push_back(it.ip() + ":" + std::to_string(it.port()));
+    }
+  }
 
   if (is_current_node_scale_in_) {
     MS_LOG(WARNING) << "The node role:" << CommUtil::NodeRoleToString(node_info_.node_role_)
@@ -614,7 +680,7 @@ const std::shared_ptr<TcpClient> &AbstractNode::GetOrCreateTcpClient(const int &
     }
     std::string ip = nodes_address_[std::make_pair(NodeRole::SERVER, rank_id)].first;
     uint16_t port = nodes_address_[std::make_pair(NodeRole::SERVER, rank_id)].second;
-    auto client = std::make_shared<TcpClient>(ip, port);
+    auto client = CreateDataTcpClient(ip, port);
     client->SetMessageCallback([&](std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data,
                                    size_t size) {
       switch (meta->cmd()) {
@@ -636,6 +702,33 @@ const std::shared_ptr<TcpClient> &AbstractNode::GetOrCreateTcpClient(const int &
   }
 }
 
+namespace {
+bool UseEpollTransport() {
+  if (PSContext::instance()->tcp_transport() != kTcpTransportEpoll) {
+    return false;
+  }
+  if (PSContext::instance()->enable_ssl()) {
+    MS_LOG(WARNING) << "The epoll tcp transport doesn't support SSL, so libevent is used.";
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+std::shared_ptr<TcpServer> AbstractNode::CreateDataTcpServer(const std::string &ip) const {
+  if (UseEpollTransport()) {
+    return std::make_shared<EpollTcpServer>(ip, 0);
+  }
+  return std::make_shared<TcpServer>(ip, 0);
+}
+
+std::shared_ptr<TcpClient> AbstractNode::CreateDataTcpClient(const std::string &ip, uint16_t port) const {
+  if (UseEpollTransport()) {
+    return std::make_shared<EpollTcpClient>(ip, port);
+  }
+  return std::make_shared<TcpClient>(ip, port);
+}
+
 void AbstractNode::ProcessSendDataResp(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data,
                                        size_t size) {
   MS_EXCEPTION_IF_NULL(meta);
@@ -757,6 +850,7 @@ void AbstractNode::InitCommandHandler() {
   handlers_[NodeCommand::FINISH] = nullptr;
   handlers_[NodeCommand::SCALE_OUT_DONE] = nullptr;
   handlers_[NodeCommand::SCALE_IN_DONE] = nullptr;
+  handlers_[NodeCommand::SCALE_IN_FAILED] = nullptr;
 }
 
 void AbstractNode::InitServerHandler() {
@@ -23,6 +23,7 @@
 #include <map>
 #include <vector>
 #include <unordered_map>
+#include <shared_mutex>
 
 #include "ps/core/node.h"
 #include "ps/core/communicator/message.h"
@@ -42,7 +43,9 @@ class AbstractNode : public Node {
         server_thread_(nullptr),
         worker_num_(-1),
         server_num_(-1),
-        is_current_node_scale_in_(false) {}
+        metadata_version_(0),
+        is_current_node_scale_in_(false),
+        is_pinned_(false) {}
   ~AbstractNode() override = default;
 
   typedef void (AbstractNode::*ResponseHandler)(std::shared_ptr<MessageMeta> meta, const void *data, size_t size);
@@ -66,6 +69,14 @@ class AbstractNode : public Node {
   // Send scale_in_done instructions to the scheduler.
   void set_scale_in_done();
 
+  // Tell the scheduler this node fails to be scaled in, so it stays in the cluster and registers again with the next
+  // set_ready_for_scale_in. Returns false if the scheduler is not told, and the node leaves as planned.
+  bool set_scale_in_failed(const std::string &reason);
+
+  // The node holds the data which can't be migrated, like the shards of the embedding tables. It's reported to the
+  // scheduler by the heartbeats, and the scheduler refuses to scale in the node.
+  void set_pinned(bool is_pinned);
+
   // Set the callback corresponding to the event.
   void RegisterEventCallback(const ClusterEvent &event, const EventCallback &event_cb);
 
@@ -89,6 +100,19 @@ class AbstractNode : public Node {
 
   ClusterState cluster_state() const;
 
+  // The addresses of the servers are replaced with metadata_mutex held exclusively when the cluster is scaled. The
+  // callers of server_addresses and scale_in_servers hold it shared, as do the callers resolving the rank of a server
+  // and sending to it, so the rank doesn't change in between.
+  std::shared_mutex &metadata_mutex();
+  // The addresses "ip:port" of the servers by their ranks.
+  std::map<uint32_t, std::string> server_addresses() const;
+  // The addresses of the servers leaving in the latest scale in.
+  const std::vector<std::string> &scale_in_servers() const;
+  // It's increased each time the addresses of the servers are replaced.
+  uint64_t metadata_version() const;
+  // The address "ip:port" of this node.
+  std::string address() const;
+
  protected:
   void Register(const std::shared_ptr<TcpClient> &client);
   bool Heartbeat(const std::shared_ptr<TcpClient> &client);
@@ -123,6 +147,10 @@ class AbstractNode : public Node {
   bool WaitForDisconnect(const uint32_t &timeout);
   bool InitClientToScheduler();
   const std::shared_ptr<TcpClient> &GetOrCreateTcpClient(const int &rank_id);
+  // The tcp server and clients between the workers and the servers use the transport set in PSContext, except that
+  // libevent is always used with SSL.
+  std::shared_ptr<TcpServer> CreateDataTcpServer(const std::string &ip) const;
+  std::shared_ptr<TcpClient> CreateDataTcpClient(const std::string &ip, uint16_t port) const;
 
   void ProcessSendDataResp(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size);
   void RunMessageCallback(const uint64_t &request_id);
@@ -182,8 +210,13 @@ class AbstractNode : public Node {
   int32_t worker_num_;
   int32_t server_num_;
 
+  std::shared_mutex metadata_mutex_;
+  std::atomic<uint64_t> metadata_version_;
+  std::vector<std::string> scale_in_servers_;
+
   // Identify whether the current node is a scale in node.
   std::atomic<bool> is_current_node_scale_in_;
+  std::atomic<bool> is_pinned_;
 
   // Each ClusterEvent corresponds to a EventCallback to process the event.
   std::map<ClusterEvent, EventCallback> event_to_callback_;
@@ -166,6 +166,22 @@ bool CommUtil::IsFileExists(const std::string &file) {
     return true;
   }
 }
+
+bool CommUtil::AddReferenceToBuffer(struct evbuffer *buffer, const void *data, size_t size,
+                                    const std::shared_ptr<void> &owner) {
+  MS_EXCEPTION_IF_NULL(buffer);
+  if (size == 0) {
+    return true;
+  }
+  MS_EXCEPTION_IF_NULL(data);
+  auto holder = new std::shared_ptr<void>(owner);
+  auto cleanup = [](const void *, size_t, void *arg) { delete static_cast<std::shared_ptr<void> *>(arg); };
+  if (evbuffer_add_reference(buffer, data, size, cleanup, holder) == -1) {
+    delete holder;
+    return false;
+  }
+  return true;
+}
 }  // namespace core
 }  // namespace ps
 }  // namespace mindspore
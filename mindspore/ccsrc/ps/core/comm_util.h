@@ -46,6 +46,7 @@
 #include <string>
 #include <utility>
 #include <thread>
+#include <memory>
 #include <fstream>
 #include <iostream>
 
@@ -86,6 +87,9 @@ class CommUtil {
 
   // Check if the file exists.
   static bool IsFileExists(const std::string &file);
+  // Append the data to the buffer without copying it, the owner is held until libevent has sent the data.
+  static bool AddReferenceToBuffer(struct evbuffer *buffer, const void *data, size_t size,
+                                   const std::shared_ptr<void> &owner);
 
  private:
   static std::random_device rd;
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/core/communicator/epoll_event_loop.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+size_t EventLoopNum() {
+  size_t core_num = std::thread::hardware_concurrency();
+  return std::min(std::max(core_num, static_cast<size_t>(1)), kMaxEventLoopNum);
+}
+
+EpollEventLoop::~EpollEventLoop() {
+  Stop();
+  if (epoll_fd_ >= 0) {
+    close(epoll_fd_);
+    epoll_fd_ = -1;
+  }
+  if (wakeup_fd_ >= 0) {
+    close(wakeup_fd_);
+    wakeup_fd_ = -1;
+  }
+}
+
+void EpollEventLoop::Initialize() {
+  if (epoll_fd_ >= 0) {
+    return;
+  }
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ < 0) {
+    MS_LOG(EXCEPTION) << "Create epoll failed: " << strerror(errno);
+  }
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wakeup_fd_ < 0) {
+    MS_LOG(EXCEPTION) << "Create eventfd failed: " << strerror(errno);
+  }
+  struct epoll_event event {};
+  event.events = EPOLLIN;
+  event.data.fd = wakeup_fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event) != 0) {
+    MS_LOG(EXCEPTION) << "Add the eventfd to epoll failed: " << strerror(errno);
+  }
+}
+
+void EpollEventLoop::Start() {
+  Initialize();
+  if (thread_ != nullptr) {
+    return;
+  }
+  is_stop_->store(false);
+  thread_ = std::make_unique<std::thread>(&EpollEventLoop::Loop, this, is_stop_);
+}
+
+void EpollEventLoop::Stop() {
+  if (thread_ == nullptr) {
+    return;
+  }
+  is_stop_->store(true);
+  uint64_t one = 1;
+  if (write(wakeup_fd_, &one, sizeof(one)) != sizeof(one)) {
+    MS_LOG(WARNING) << "Wake up the event loop failed: " << strerror(errno);
+  }
+  if (thread_->get_id() == std::this_thread::get_id()) {
+    thread_->detach();
+  } else if (thread_->joinable()) {
+    thread_->join();
+  }
+  thread_ = nullptr;
+}
+
+bool EpollEventLoop::AddFd(int fd, uint32_t events, const EventHandler &handler) {
+  Initialize();
+  {
+    std::lock_guard<std::mutex> lock(handler_mutex_);
+    handlers_[fd] = std::make_shared<EventHandler>(handler);
+  }
+  struct epoll_event event {};
+  event.events = events;
+  event.data.fd = fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+    MS_LOG(ERROR) << "Add fd " << fd << " to epoll failed: " << strerror(errno);
+    std::lock_guard<std::mutex> lock(handler_mutex_);
+    handlers_.erase(fd);
+    return false;
+  }
+  return true;
+}
+
+bool EpollEventLoop::ModifyFd(int fd, uint32_t events) {
+  struct epoll_event event {};
+  event.events = events;
+  event.data.fd = fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event) != 0) {
+    MS_LOG(ERROR) << "Modify the events of fd " << fd << " failed: " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+void EpollEventLoop::RemoveFd(int fd) {
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr) != 0) {
+    MS_LOG(DEBUG) << "Remove fd " << fd << " from epoll failed: " << strerror(errno);
+  }
+  std::lock_guard<std::mutex> lock(handler_mutex_);
+  handlers_.erase(fd);
+}
+
+void EpollEventLoop::Loop(std::shared_ptr<std::atomic<bool>> is_stop) {
+  std::vector<struct epoll_event> events(kMaxEpollEvents);
+  while (!is_stop->load()) {
+    int event_num = epoll_wait(epoll_fd_, events.data(), kMaxEpollEvents, -1);
+    if (event_num < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      MS_LOG(ERROR) << "Epoll wait failed: " << strerror(errno);
+      break;
+    }
+    for (int i = 0; i < event_num; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == wakeup_fd_) {
+        uint64_t count = 0;
+        while (read(wakeup_fd_, &count, sizeof(count)) > 0) {
+        }
+        continue;
+      }
+      std::shared_ptr<EventHandler> handler = nullptr;
+      {
+        std::lock_guard<std::mutex> lock(handler_mutex_);
+        auto iter = handlers_.find(fd);
+        if (iter != handlers_.end()) {
+          handler = iter->second;
+        }
+      }
+      if (handler != nullptr) {
+        (*handler)(events[i].events);
+      }
+      if (is_stop->load()) {
+        return;
+      }
+    }
+  }
+  MS_LOG(INFO) << "The event loop exits.";
+}
+
+EpollEventLoopGroup &EpollEventLoopGroup::GetInstance() {
+  static EpollEventLoopGroup instance;
+  return instance;
+}
+
+std::shared_ptr<EpollEventLoop> EpollEventLoopGroup::NextLoop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (loops_.empty()) {
+    size_t loop_num = EventLoopNum();
+    for (size_t i = 0; i < loop_num; ++i) {
+      auto loop = std::make_shared<EpollEventLoop>();
+      loop->Start();
+      loops_.push_back(loop);
+    }
+    MS_LOG(INFO) << "Start " << loop_num << " event loops for the epoll tcp clients.";
+  }
+  return loops_[next_loop_++ % loops_.size()];
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
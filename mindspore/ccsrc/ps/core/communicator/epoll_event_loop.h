@@ -0,0 +1,92 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_EVENT_LOOP_H_
+#define MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_EVENT_LOOP_H_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+namespace core {
+// The most events handled by one epoll_wait.
+constexpr int kMaxEpollEvents = 256;
+// The most event loops of a server or of the clients of a process.
+constexpr size_t kMaxEventLoopNum = 32;
+
+// The number of event loops to run, which is one per core.
+size_t EventLoopNum();
+
+// EpollEventLoop waits for the events of its fds in its own thread and calls their handlers in that thread.
+class EpollEventLoop {
+ public:
+  using EventHandler = std::function<void(uint32_t events)>;
+
+  EpollEventLoop()
+      : epoll_fd_(-1), wakeup_fd_(-1), is_stop_(std::make_shared<std::atomic<bool>>(true)), thread_(nullptr) {}
+  ~EpollEventLoop();
+
+  void Initialize();
+  void Start();
+  // Stop the loop and wait for its thread to exit unless it's called in the loop thread.
+  void Stop();
+
+  // The handler of a fd may still be running when RemoveFd returns, so it should hold the object it calls weakly.
+  bool AddFd(int fd, uint32_t events, const EventHandler &handler);
+  bool ModifyFd(int fd, uint32_t events);
+  void RemoveFd(int fd);
+
+ private:
+  // The stop flag is held by the loop thread, since the loop may be destroyed by a handler in the thread.
+  void Loop(std::shared_ptr<std::atomic<bool>> is_stop);
+
+  int epoll_fd_;
+  // An eventfd which wakes the loop up to stop.
+  int wakeup_fd_;
+  std::shared_ptr<std::atomic<bool>> is_stop_;
+  std::unique_ptr<std::thread> thread_;
+  std::mutex handler_mutex_;
+  std::map<int, std::shared_ptr<EventHandler>> handlers_;
+};
+
+// The event loops shared by the epoll tcp clients of the process, which are started when they're first used.
+class EpollEventLoopGroup {
+ public:
+  static EpollEventLoopGroup &GetInstance();
+
+  // The loops are handed out in turn.
+  std::shared_ptr<EpollEventLoop> NextLoop();
+
+ private:
+  EpollEventLoopGroup() : next_loop_(0) {}
+  ~EpollEventLoopGroup() = default;
+  EpollEventLoopGroup(const EpollEventLoopGroup &) = delete;
+  EpollEventLoopGroup &operator=(const EpollEventLoopGroup &) = delete;
+
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<EpollEventLoop>> loops_;
+  size_t next_loop_;
+};
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_EVENT_LOOP_H_
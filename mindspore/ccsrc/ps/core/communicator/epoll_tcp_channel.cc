@@ -0,0 +1,378 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/core/communicator/epoll_tcp_channel.h"
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+EpollTcpChannel::EpollTcpChannel(int fd, const std::shared_ptr<EpollEventLoop> &loop)
+    : fd_(fd),
+      loop_(loop),
+      closed_(false),
+      header_length_(0),
+      message_buffer_(nullptr),
+      message_offset_(0),
+      message_received_(0),
+      stage_(new char[kReadStageSize]),
+      stage_begin_(0),
+      stage_end_(0),
+      connecting_(false),
+      want_write_(false) {
+  MS_EXCEPTION_IF_NULL(loop_);
+}
+
+EpollTcpChannel::~EpollTcpChannel() {
+  (void)CloseSocket();
+  close(fd_);
+}
+
+bool EpollTcpChannel::Open(bool connecting) {
+  std::weak_ptr<EpollTcpChannel> weak_channel = shared_from_this();
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  connecting_ = connecting;
+  // A connecting socket becomes writable when it's connected.
+  want_write_ = connecting;
+  uint32_t events = EPOLLIN | EPOLLRDHUP | (connecting ? static_cast<uint32_t>(EPOLLOUT) : 0);
+  return loop_->AddFd(fd_, events, [weak_channel](uint32_t events) {
+    auto channel = weak_channel.lock();
+    if (channel != nullptr) {
+      channel->HandleEvents(events);
+    }
+  });
+}
+
+void EpollTcpChannel::Close() { (void)CloseSocket(); }
+
+bool EpollTcpChannel::CloseSocket() {
+  if (closed_.exchange(true)) {
+    return false;
+  }
+  loop_->RemoveFd(fd_);
+  // The fd is closed by the destructor, so it isn't reused while a handler may still read it.
+  (void)shutdown(fd_, SHUT_RDWR);
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  pending_writes_.clear();
+  return true;
+}
+
+bool EpollTcpChannel::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data,
+                                  size_t size, const DataPtr &owner) {
+  MS_EXCEPTION_IF_NULL(meta);
+  std::string meta_data = meta->SerializeAsString();
+  MessageHeader header;
+  header.message_proto_ = protos;
+  header.message_meta_length_ = SizeToUint(meta_data.size());
+  header.message_length_ = size + header.message_meta_length_;
+  std::string head(reinterpret_cast<const char *>(&header), sizeof(header));
+  head.append(meta_data);
+  return Send(std::move(head), data, size, owner);
+}
+
+bool EpollTcpChannel::Send(std::string head, const void *data, size_t size, const DataPtr &owner) {
+  if (size > 0) {
+    MS_EXCEPTION_IF_NULL(data);
+  }
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  if (closed_.load()) {
+    MS_LOG(ERROR) << "The connection of fd " << fd_ << " is closed.";
+    return false;
+  }
+  PendingWrite pending_write;
+  pending_write.head = std::move(head);
+  pending_write.data = reinterpret_cast<const unsigned char *>(data);
+  pending_write.size = size;
+  pending_write.owner = owner;
+  pending_writes_.push_back(std::move(pending_write));
+
+  // The message is written by the caller if nothing is queued before it, which saves a wakeup of the loop.
+  if (!connecting_ && pending_writes_.size() == 1 && !FlushWrites()) {
+    return false;
+  }
+  if (pending_writes_.empty()) {
+    return true;
+  }
+
+  // The messages queued before are already owned, so only this one may have to be copied.
+  PendingWrite &last = pending_writes_.back();
+  if (last.owner == nullptr && last.size > 0) {
+    DataPtr copy(new unsigned char[last.size]);
+    int ret = memcpy_s(copy.get(), last.size, last.data, last.size);
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      pending_writes_.pop_back();
+      return false;
+    }
+    last.data = copy.get();
+    last.owner = copy;
+  }
+  if (!connecting_ && !want_write_) {
+    UpdateEvents(true);
+  }
+  return true;
+}
+
+void EpollTcpChannel::HandleEvents(uint32_t events) {
+  if (closed_.load()) {
+    return;
+  }
+  bool connecting = false;
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    connecting = connecting_;
+  }
+  if (connecting) {
+    if ((events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) == 0) {
+      return;
+    }
+    HandleConnected();
+    return;
+  }
+
+  if ((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0) {
+    HandleRead();
+  }
+  if (closed_.load() || (events & EPOLLOUT) == 0) {
+    return;
+  }
+  bool flushed = true;
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    flushed = FlushWrites();
+    if (flushed && pending_writes_.empty()) {
+      UpdateEvents(false);
+    }
+  }
+  if (!flushed) {
+    HandleClose();
+  }
+}
+
+void EpollTcpChannel::HandleConnected() {
+  int error = 0;
+  socklen_t length = sizeof(error);
+  if (getsockopt(fd_, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0) {
+    MS_LOG(WARNING) << "Connect failed: " << strerror(error);
+    HandleClose();
+    return;
+  }
+  bool flushed = true;
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    connecting_ = false;
+    flushed = FlushWrites();
+    UpdateEvents(!pending_writes_.empty());
+  }
+  if (!flushed) {
+    HandleClose();
+    return;
+  }
+  if (connected_callback_) {
+    connected_callback_();
+  }
+}
+
+void EpollTcpChannel::HandleRead() {
+  while (!closed_.load()) {
+    ConsumeStage();
+    if (closed_.load()) {
+      return;
+    }
+    struct iovec iov[2];
+    int iov_num = 0;
+    size_t message_remaining = 0;
+    if (message_buffer_ != nullptr) {
+      message_remaining = message_header_.message_length_ - message_received_;
+      iov[iov_num].iov_base = message_buffer_.get() + message_offset_ + message_received_;
+      iov[iov_num].iov_len = message_remaining;
+      iov_num++;
+    }
+    iov[iov_num].iov_base = stage_.get();
+    iov[iov_num].iov_len = kReadStageSize;
+    iov_num++;
+
+    ssize_t read_size = readv(fd_, iov, iov_num);
+    if (read_size > 0) {
+      size_t size = static_cast<size_t>(read_size);
+      if (message_remaining > 0) {
+        size_t message_size = std::min(size, message_remaining);
+        message_received_ += message_size;
+        size -= message_size;
+        if (message_received_ == message_header_.message_length_) {
+          DeliverMessage();
+        }
+      }
+      stage_begin_ = 0;
+      stage_end_ = size;
+      continue;
+    }
+    if (read_size == 0) {
+      MS_LOG(INFO) << "The peer of fd " << fd_ << " closes the connection.";
+      HandleClose();
+      return;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return;
+    }
+    MS_LOG(WARNING) << "Read fd " << fd_ << " failed: " << strerror(errno);
+    HandleClose();
+    return;
+  }
+}
+
+void EpollTcpChannel::HandleClose() {
+  if (CloseSocket() && closed_callback_) {
+    closed_callback_();
+  }
+}
+
+void EpollTcpChannel::ConsumeStage() {
+  while (stage_begin_ < stage_end_ && !closed_.load()) {
+    size_t stage_remaining = stage_end_ - stage_begin_;
+    if (message_buffer_ == nullptr) {
+      size_t copy_length = std::min(static_cast<size_t>(kHeaderLen) - header_length_, stage_remaining);
+      int ret = memcpy_s(header_ + header_length_, kHeaderLen - header_length_, stage_.get() + stage_begin_, copy_length);
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+      }
+      header_length_ += copy_length;
+      stage_begin_ += copy_length;
+      if (header_length_ == static_cast<size_t>(kHeaderLen)) {
+        BeginMessage();
+      }
+      continue;
+    }
+
+    size_t message_remaining = message_header_.message_length_ - message_received_;
+    size_t copy_length = std::min(message_remaining, stage_remaining);
+    int ret = memcpy_s(message_buffer_.get() + message_offset_ + message_received_, message_remaining,
+                       stage_.get() + stage_begin_, copy_length);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+    }
+    message_received_ += copy_length;
+    stage_begin_ += copy_length;
+    if (message_received_ == message_header_.message_length_) {
+      DeliverMessage();
+    }
+  }
+}
+
+void EpollTcpChannel::BeginMessage() {
+  header_length_ = 0;
+  int ret = memcpy_s(&message_header_, sizeof(message_header_), header_, kHeaderLen);
+  if (ret != 0) {
+    MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+  }
+  if (message_header_.message_meta_length_ > message_header_.message_length_) {
+    MS_LOG(ERROR) << "The meta length " << message_header_.message_meta_length_ << " exceeds the message length "
+                  << message_header_.message_length_ << ", so the connection of fd " << fd_ << " is closed.";
+    HandleClose();
+    return;
+  }
+  message_buffer_.reset(new unsigned char[message_header_.message_length_ + kMessageDataAlignment]);
+  size_t data_begin = reinterpret_cast<uintptr_t>(message_buffer_.get()) + message_header_.message_meta_length_;
+  message_offset_ = (kMessageDataAlignment - data_begin % kMessageDataAlignment) % kMessageDataAlignment;
+  message_received_ = 0;
+  if (message_header_.message_length_ == 0) {
+    DeliverMessage();
+  }
+}
+
+void EpollTcpChannel::DeliverMessage() {
+  if (message_callback_) {
+    auto meta = std::make_shared<MessageMeta>();
+    unsigned char *message = message_buffer_.get() + message_offset_;
+    meta->ParseFromArray(message, message_header_.message_meta_length_);
+    message_callback_(meta, message_header_.message_proto_, message + message_header_.message_meta_length_,
+                      message_header_.message_length_ - message_header_.message_meta_length_);
+  }
+  message_buffer_ = nullptr;
+  message_received_ = 0;
+}
+
+bool EpollTcpChannel::FlushWrites() {
+  while (!pending_writes_.empty()) {
+    struct iovec iov[kMaxWriteIovNum];
+    int iov_num = 0;
+    for (auto iter = pending_writes_.begin(); iter != pending_writes_.end() && iov_num + 1 < kMaxWriteIovNum; ++iter) {
+      size_t offset = iter->offset;
+      if (offset < iter->head.size()) {
+        iov[iov_num].iov_base = const_cast<char *>(iter->head.data() + offset);
+        iov[iov_num].iov_len = iter->head.size() - offset;
+        iov_num++;
+        offset = 0;
+      } else {
+        offset -= iter->head.size();
+      }
+      if (offset < iter->size) {
+        iov[iov_num].iov_base = const_cast<unsigned char *>(iter->data + offset);
+        iov[iov_num].iov_len = iter->size - offset;
+        iov_num++;
+      }
+    }
+
+    struct msghdr message {};
+    message.msg_iov = iov;
+    message.msg_iovlen = IntToSize(iov_num);
+    ssize_t written = sendmsg(fd_, &message, MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return true;
+      }
+      MS_LOG(ERROR) << "Write fd " << fd_ << " failed: " << strerror(errno);
+      return false;
+    }
+
+    size_t written_size = static_cast<size_t>(written);
+    while (!pending_writes_.empty()) {
+      PendingWrite &front = pending_writes_.front();
+      size_t remaining = front.head.size() + front.size - front.offset;
+      if (remaining > written_size) {
+        front.offset += written_size;
+        break;
+      }
+      written_size -= remaining;
+      pending_writes_.pop_front();
+    }
+  }
+  return true;
+}
+
+void EpollTcpChannel::UpdateEvents(bool want_write) {
+  want_write_ = want_write;
+  (void)loop_->ModifyFd(fd_, EPOLLIN | EPOLLRDHUP | (want_write ? static_cast<uint32_t>(EPOLLOUT) : 0));
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
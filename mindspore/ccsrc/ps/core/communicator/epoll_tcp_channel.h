@@ -0,0 +1,125 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_TCP_CHANNEL_H_
+#define MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_TCP_CHANNEL_H_
+
+#include <sys/uio.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "ps/core/communicator/epoll_event_loop.h"
+#include "ps/core/communicator/tcp_message_handler.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+// The bytes following the message being received are read into a staging buffer of this size.
+constexpr size_t kReadStageSize = 65536;
+// The most iovecs written by one writev.
+constexpr int kMaxWriteIovNum = 64;
+
+// EpollTcpChannel sends and receives the messages of a connected socket in an event loop.
+// A message is a MessageHeader, the meta and the data. Its header and meta are written together with its data by one
+// writev, and the data is written from the buffer of the caller. The rest of a message being received is read straight
+// into its buffer, and whatever follows it into the staging buffer by the same readv.
+class EpollTcpChannel : public std::enable_shared_from_this<EpollTcpChannel> {
+ public:
+  using OnConnected = std::function<void()>;
+  using OnClosed = std::function<void()>;
+
+  EpollTcpChannel(int fd, const std::shared_ptr<EpollEventLoop> &loop);
+  ~EpollTcpChannel();
+
+  void set_message_callback(const messageReceive &callback) { message_callback_ = callback; }
+  void set_connected_callback(const OnConnected &callback) { connected_callback_ = callback; }
+  // Called when the peer closes the connection or it fails, but not when Close is called.
+  void set_closed_callback(const OnClosed &callback) { closed_callback_ = callback; }
+
+  // Watch the socket in the event loop. The messages sent to a connecting socket are queued until it's connected.
+  bool Open(bool connecting);
+  void Close();
+
+  bool SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size,
+                   const DataPtr &owner);
+  // Send the bytes as they are. The data isn't copied if the owner is not nullptr.
+  bool Send(std::string head, const void *data, size_t size, const DataPtr &owner);
+
+  int fd() const { return fd_; }
+  bool closed() const { return closed_.load(); }
+  // The buffer of the message being delivered to the callback.
+  const DataPtr &message_buffer() const { return message_buffer_; }
+
+ private:
+  // The data is referenced by owner, or copied into it if the write is queued without an owner.
+  struct PendingWrite {
+    std::string head;
+    const unsigned char *data{nullptr};
+    size_t size{0};
+    DataPtr owner{nullptr};
+    // The bytes of head and data written.
+    size_t offset{0};
+  };
+
+  // Return whether the socket is closed by this call.
+  bool CloseSocket();
+  void HandleEvents(uint32_t events);
+  void HandleConnected();
+  void HandleRead();
+  void HandleClose();
+  // Parse the bytes in the staging buffer, which are copied into the message buffer.
+  void ConsumeStage();
+  // The header is parsed and the buffer of the message is allocated.
+  void BeginMessage();
+  void DeliverMessage();
+
+  // Write the pending messages until all of them are written or the socket is full. write_mutex_ must be held.
+  // sendmsg with MSG_NOSIGNAL is used as writev, so a closed peer doesn't raise SIGPIPE.
+  bool FlushWrites();
+  void UpdateEvents(bool want_write);
+
+  int fd_;
+  std::shared_ptr<EpollEventLoop> loop_;
+  std::atomic<bool> closed_;
+
+  messageReceive message_callback_;
+  OnConnected connected_callback_;
+  OnClosed closed_callback_;
+
+  // The reading states, which are only used in the loop thread.
+  char header_[kHeaderLen]{0};
+  size_t header_length_;
+  MessageHeader message_header_;
+  DataPtr message_buffer_;
+  size_t message_offset_;
+  size_t message_received_;
+  std::unique_ptr<char[]> stage_;
+  size_t stage_begin_;
+  size_t stage_end_;
+
+  std::mutex write_mutex_;
+  bool connecting_;
+  bool want_write_;
+  std::deque<PendingWrite> pending_writes_;
+};
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_TCP_CHANNEL_H_
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/core/communicator/epoll_tcp_client.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace mindspore {
+namespace ps {
+namespace core {
+EpollTcpClient::~EpollTcpClient() { Stop(); }
+
+void EpollTcpClient::Init() {
+  if (!CommUtil::CheckIp(server_address_)) {
+    MS_LOG(EXCEPTION) << "The tcp client ip:" << server_address_ << " is illegal!";
+  }
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    MS_LOG(EXCEPTION) << "Create socket failed: " << strerror(errno);
+  }
+  SetTcpNoDelay(fd);
+  struct sockaddr_in sin {};
+  sin.sin_family = AF_INET;
+  sin.sin_addr.s_addr = inet_addr(server_address_.c_str());
+  sin.sin_port = htons(server_port_);
+  if (connect(fd, reinterpret_cast<struct sockaddr *>(&sin), sizeof(sin)) != 0 && errno != EINPROGRESS) {
+    close(fd);
+    MS_LOG(EXCEPTION) << "Connect server ip:" << server_address_ << " and port: " << server_port_ << " is failed!";
+  }
+
+  auto channel = std::make_shared<EpollTcpChannel>(fd, EpollEventLoopGroup::GetInstance().NextLoop());
+  channel->set_message_callback(
+    [this](std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size) {
+      if (message_callback_) {
+        message_callback_(meta, protos, data, size);
+      }
+    });
+  channel->set_connected_callback([this]() {
+    if (connected_callback_) {
+      connected_callback_();
+    }
+    NotifyConnected();
+  });
+  channel->set_closed_callback([this]() {
+    MS_LOG(WARNING) << "The connection to " << server_address_ << ":" << server_port_ << " is closed!";
+    if (disconnected_callback_) {
+      disconnected_callback_();
+    }
+  });
+
+  std::shared_ptr<EpollTcpChannel> old_channel = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(channel_mutex_);
+    old_channel = channel_;
+    channel_ = channel;
+  }
+  if (old_channel != nullptr) {
+    old_channel->Close();
+  }
+  // The messages sent before the connection is made are queued in the channel.
+  if (!channel->Open(true)) {
+    MS_LOG(EXCEPTION) << "Add the connection to server ip:" << server_address_ << " to the event loop failed!";
+  }
+}
+
+void EpollTcpClient::Stop() {
+  MS_LOG(INFO) << "Stop epoll tcp client!";
+  auto channel = this->channel();
+  if (channel != nullptr) {
+    channel->Close();
+  }
+}
+
+void EpollTcpClient::Start() { MS_LOG(INFO) << "The event loop of the epoll tcp client is already running."; }
+
+void EpollTcpClient::StartWithNoBlock() {
+  MS_LOG(INFO) << "The event loop of the epoll tcp client is already running.";
+}
+
+bool EpollTcpClient::SendMessage(const CommMessage &message) const {
+  auto channel = this->channel();
+  if (channel == nullptr) {
+    MS_LOG(ERROR) << "The tcp client is not initialized!";
+    return false;
+  }
+  MessageHeader header;
+  header.message_proto_ = Protos::PROTOBUF;
+  header.message_length_ = message.ByteSizeLong();
+  header.message_meta_length_ = SizeToUint(message.pb_meta().ByteSizeLong());
+  std::string head(reinterpret_cast<const char *>(&header), sizeof(header));
+  head.append(message.pb_meta().SerializeAsString());
+  return channel->Send(std::move(head), message.data().data(), message.data().length(), nullptr);
+}
+
+bool EpollTcpClient::WriteMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data,
+                                  size_t size, const DataPtr &owner) {
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(data);
+  auto channel = this->channel();
+  if (channel == nullptr) {
+    MS_LOG(ERROR) << "The tcp client is not initialized!";
+    return false;
+  }
+  return channel->SendMessage(meta, protos, data, size, owner);
+}
+
+std::shared_ptr<EpollTcpChannel> EpollTcpClient::channel() const {
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  return channel_;
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_TCP_CLIENT_H_
+#define MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_TCP_CLIENT_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "ps/core/communicator/epoll_event_loop.h"
+#include "ps/core/communicator/epoll_tcp_channel.h"
+#include "ps/core/communicator/tcp_client.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+// EpollTcpClient runs its connection in one of the event loops of EpollEventLoopGroup instead of the libevent base
+// shared by the tcp clients. The loops are already running, so Start doesn't block. The timers and SSL of TcpClient
+// are not supported.
+class EpollTcpClient : public TcpClient {
+ public:
+  EpollTcpClient(const std::string &address, std::uint16_t port) : TcpClient(address, port), channel_(nullptr) {}
+  ~EpollTcpClient() override;
+
+  using TcpClient::SendMessage;
+  void Init() override;
+  void Stop() override;
+  void Start() override;
+  void StartWithNoBlock() override;
+  bool SendMessage(const CommMessage &message) const override;
+
+ protected:
+  bool WriteMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size,
+                    const DataPtr &owner) override;
+
+ private:
+  std::shared_ptr<EpollTcpChannel> channel() const;
+
+  mutable std::mutex channel_mutex_;
+  std::shared_ptr<EpollTcpChannel> channel_;
+};
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_TCP_CLIENT_H_
@@ -0,0 +1,227 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/core/communicator/epoll_tcp_server.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <utility>
+
+namespace mindspore {
+namespace ps {
+namespace core {
+void EpollTcpConnection::InitConnection(const messageReceive &callback) { channel_->set_message_callback(callback); }
+
+void EpollTcpConnection::SendMessage(const void *buffer, size_t num) const {
+  if (!channel_->Send(std::string(), buffer, num, nullptr)) {
+    MS_LOG(ERROR) << "Write message to the connection failed!";
+  }
+}
+
+bool EpollTcpConnection::SendMessage(std::shared_ptr<CommMessage> message) const {
+  MS_EXCEPTION_IF_NULL(message);
+  size_t buf_size = message->ByteSizeLong();
+  std::string head(reinterpret_cast<const char *>(&buf_size), sizeof(buf_size));
+  head.append(message->SerializeAsString());
+  return channel_->Send(std::move(head), nullptr, 0, nullptr);
+}
+
+const DataPtr &EpollTcpConnection::received_buffer() const { return channel_->message_buffer(); }
+
+bool EpollTcpConnection::WriteMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data,
+                                      size_t size, const DataPtr &owner) const {
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(data);
+  return channel_->SendMessage(meta, protos, data, size, owner);
+}
+
+EpollTcpServer::EpollTcpServer(const std::string &address, std::uint16_t port, size_t loop_num)
+    : TcpServer(address, port),
+      loop_num_(loop_num == 0 ? EventLoopNum() : std::min(loop_num, kMaxEventLoopNum)),
+      next_loop_(0) {}
+
+EpollTcpServer::~EpollTcpServer() { Stop(); }
+
+void EpollTcpServer::Init() {
+  if (!CommUtil::CheckIp(server_address_)) {
+    MS_LOG(EXCEPTION) << "The tcp server ip:" << server_address_ << " is illegal!";
+  }
+  is_stop_ = false;
+  for (size_t i = 0; i < loop_num_; ++i) {
+    auto loop = std::make_shared<EpollEventLoop>();
+    loop->Initialize();
+    loops_.push_back(loop);
+  }
+
+  int listen_fd = Listen(server_port_, true);
+  bool reuse_port = listen_fd >= 0;
+  if (!reuse_port) {
+    MS_LOG(WARNING) << "Listen with SO_REUSEPORT failed, so one socket accepts the connections for all the loops.";
+    listen_fd = Listen(server_port_, false);
+  }
+  if (listen_fd < 0) {
+    MS_LOG(EXCEPTION) << "The tcp server listens on " << server_address_ << ":" << server_port_ << " failed!";
+  }
+  listen_fds_.push_back(listen_fd);
+
+  if (server_port_ == 0) {
+    struct sockaddr_in sin_bound {};
+    socklen_t addr_len = sizeof(struct sockaddr_in);
+    if (getsockname(listen_fd, reinterpret_cast<struct sockaddr *>(&sin_bound), &addr_len) != 0) {
+      MS_LOG(EXCEPTION) << "Get sock name failed!";
+    }
+    server_port_ = ntohs(sin_bound.sin_port);
+  }
+  for (size_t i = 1; reuse_port && i < loop_num_; ++i) {
+    listen_fd = Listen(server_port_, true);
+    if (listen_fd < 0) {
+      MS_LOG(WARNING) << "Only " << i << " of the " << loop_num_ << " event loops accept connections.";
+      break;
+    }
+    listen_fds_.push_back(listen_fd);
+  }
+
+  for (size_t i = 0; i < listen_fds_.size(); ++i) {
+    if (!loops_[i]->AddFd(listen_fds_[i], EPOLLIN, [this, i](uint32_t) { OnAcceptable(i); })) {
+      MS_LOG(EXCEPTION) << "Add the listen socket to the event loop failed!";
+    }
+  }
+  MS_LOG(INFO) << "The epoll tcp server listens on " << server_address_ << ":" << server_port_ << " with "
+               << listen_fds_.size() << " sockets and " << loop_num_ << " event loops.";
+}
+
+void EpollTcpServer::Start() {
+  MS_LOG(INFO) << "Start epoll tcp server!";
+  StartWithNoBlock();
+  std::unique_lock<std::mutex> lock(stop_mutex_);
+  stop_cond_.wait(lock, [this]() { return is_stop_.load(); });
+}
+
+void EpollTcpServer::StartWithNoBlock() {
+  for (auto &loop : loops_) {
+    loop->Start();
+  }
+}
+
+void EpollTcpServer::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(stop_mutex_);
+    if (is_stop_.load()) {
+      return;
+    }
+    is_stop_ = true;
+  }
+  MS_LOG(INFO) << "Stop epoll tcp server!";
+  for (size_t i = 0; i < listen_fds_.size(); ++i) {
+    loops_[i]->RemoveFd(listen_fds_[i]);
+  }
+  std::map<evutil_socket_t, std::shared_ptr<TcpConnection>> connections;
+  {
+    std::lock_guard<std::mutex> lock(connection_mutex_);
+    connections.swap(connections_);
+  }
+  for (auto &connection : connections) {
+    auto epoll_connection = std::dynamic_pointer_cast<EpollTcpConnection>(connection.second);
+    if (epoll_connection != nullptr) {
+      epoll_connection->channel()->Close();
+    }
+  }
+  // The listen sockets are closed after the loops exit, so no handler is accepting them.
+  for (auto &loop : loops_) {
+    loop->Stop();
+  }
+  for (int listen_fd : listen_fds_) {
+    close(listen_fd);
+  }
+  listen_fds_.clear();
+  stop_cond_.notify_all();
+}
+
+int EpollTcpServer::Listen(std::uint16_t port, bool reuse_port) const {
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Create socket failed: " << strerror(errno);
+    return -1;
+  }
+  const int one = 1;
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+      (reuse_port && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0)) {
+    MS_LOG(WARNING) << "Set the socket options failed: " << strerror(errno);
+    close(fd);
+    return -1;
+  }
+  struct sockaddr_in sin {};
+  sin.sin_family = AF_INET;
+  sin.sin_port = htons(port);
+  sin.sin_addr.s_addr = inet_addr(server_address_.c_str());
+  if (bind(fd, reinterpret_cast<struct sockaddr *>(&sin), sizeof(sin)) != 0 || listen(fd, SOMAXCONN) != 0) {
+    MS_LOG(WARNING) << "Listen on " << server_address_ << ":" << port << " failed: " << strerror(errno);
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+void EpollTcpServer::OnAcceptable(size_t listener_index) {
+  while (!is_stop_.load()) {
+    int fd = accept4(listen_fds_[listener_index], nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        MS_LOG(ERROR) << "Accept a connection failed: " << strerror(errno);
+      }
+      return;
+    }
+    SetTcpNoDelay(fd);
+    // With a single listen socket, the connections are handed to the loops in turn.
+    const auto &loop = listen_fds_.size() > 1 ? loops_[listener_index] : loops_[next_loop_++ % loops_.size()];
+    auto channel = std::make_shared<EpollTcpChannel>(fd, loop);
+    auto conn = std::make_shared<EpollTcpConnection>(channel, this);
+    std::weak_ptr<TcpConnection> weak_conn = conn;
+    conn->InitConnection(
+      [this, weak_conn](std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size) {
+        auto conn = weak_conn.lock();
+        OnServerReceiveMessage on_server_receive = GetServerReceive();
+        if (conn != nullptr && on_server_receive) {
+          on_server_receive(conn, meta, protos, data, size);
+        }
+      });
+    channel->set_closed_callback([this, weak_conn, fd]() {
+      MS_LOG(INFO) << "A client is disconnected from this server!";
+      auto conn = weak_conn.lock();
+      if (conn != nullptr && client_disconnection_) {
+        client_disconnection_(*this, *conn);
+      }
+      RemoveConnection(fd);
+    });
+    AddConnection(fd, conn);
+    if (!channel->Open(false)) {
+      RemoveConnection(fd);
+    }
+  }
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
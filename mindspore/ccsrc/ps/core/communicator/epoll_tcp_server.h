@@ -0,0 +1,85 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_TCP_SERVER_H_
+#define MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_TCP_SERVER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ps/core/communicator/epoll_event_loop.h"
+#include "ps/core/communicator/epoll_tcp_channel.h"
+#include "ps/core/communicator/tcp_server.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+class EpollTcpConnection : public TcpConnection {
+ public:
+  EpollTcpConnection(const std::shared_ptr<EpollTcpChannel> &channel, TcpServer *server)
+      : TcpConnection(nullptr, channel->fd(), server), channel_(channel) {}
+  ~EpollTcpConnection() override = default;
+
+  using TcpConnection::SendMessage;
+  void InitConnection(const messageReceive &callback) override;
+  void SendMessage(const void *buffer, size_t num) const override;
+  bool SendMessage(std::shared_ptr<CommMessage> message) const override;
+  const DataPtr &received_buffer() const override;
+  const std::shared_ptr<EpollTcpChannel> &channel() const { return channel_; }
+
+ protected:
+  bool WriteMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size,
+                    const DataPtr &owner) const override;
+
+ private:
+  std::shared_ptr<EpollTcpChannel> channel_;
+};
+
+// EpollTcpServer serves the connections in an event loop per core instead of a libevent base. Every loop has its own
+// listen socket on the same port with SO_REUSEPORT, so the kernel spreads the connections over the loops. The timers
+// and SSL of TcpServer are not supported.
+class EpollTcpServer : public TcpServer {
+ public:
+  // The loop number is EventLoopNum() if it's 0.
+  EpollTcpServer(const std::string &address, std::uint16_t port, size_t loop_num = 0);
+  ~EpollTcpServer() override;
+
+  void Init() override;
+  // Run the loops and block until the server is stopped.
+  void Start() override;
+  void StartWithNoBlock() override;
+  void Stop() override;
+
+ private:
+  // Return the fd of a listen socket bound to the port, or -1 if it fails.
+  int Listen(std::uint16_t port, bool reuse_port) const;
+  void OnAcceptable(size_t listener_index);
+
+  size_t loop_num_;
+  std::vector<std::shared_ptr<EpollEventLoop>> loops_;
+  std::vector<int> listen_fds_;
+  std::atomic<size_t> next_loop_;
+  std::mutex stop_mutex_;
+  std::condition_variable stop_cond_;
+};
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_EPOLL_TCP_SERVER_H_
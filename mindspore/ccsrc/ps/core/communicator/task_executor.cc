@@ -20,57 +20,27 @@ namespace mindspore {
 namespace ps {
 namespace core {
 TaskExecutor::TaskExecutor(size_t thread_num, size_t max_task_num, size_t submit_timeout)
-    : running_(true),
-      thread_num_(thread_num),
-      idle_thread_num_(0),
-      submit_timeout_(submit_timeout),
-      max_task_num_(max_task_num),
-      task_num_(0) {
+    : running_(true), thread_num_(thread_num), submit_timeout_(submit_timeout), max_task_num_(max_task_num) {
   for (size_t i = 0; i < thread_num; i++) {
     working_threads_.emplace_back([this]() {
       std::function<void()> task;
       while (true) {
-        std::unique_lock<std::mutex> lock(mtx_);
-        // Idle thread number increases when the mtx_ is locked.
-        idle_thread_num_++;
-
-        if (!running_) {
-          // To avoid thread from blocking after destructor.
-          return;
+        {
+          std::unique_lock<std::mutex> lock(mtx_);
+          // A task submitted is taken by an idle thread at once, and a spurious wakeup waits again.
+          cv_.wait(lock, [this] { return !running_ || !task_queue_.empty(); });
+          if (!running_) {
+            // To avoid thread from blocking after destructor.
+            return;
+          }
+          task = std::move(task_queue_.front());
+          task_queue_.pop();
         }
-
-        cv_.wait(lock);
-
-        if (!running_ || task_queue_.empty()) {
-          return;
-        }
-
-        task = task_queue_.front();
-        task_queue_.pop();
-        if (lock.owns_lock()) {
-          lock.unlock();
-        }
-
+        submit_cv_.notify_one();
         task();
       }
     });
   }
-  notify_thread_ = std::thread([this]() {
-    // If there is no idle thread, wait until the working thread is available.
-    while (true) {
-      {
-        std::unique_lock<std::mutex> lock(mtx_);
-        if (idle_thread_num_ > 0 && task_num_ > 0) {
-          idle_thread_num_--;
-          task_num_--;
-          lock.unlock();
-          cv_.notify_one();
-        }
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(kSubmitTaskIntervalInMs));
-    }
-  });
-  notify_thread_.detach();
 }
 
 TaskExecutor::~TaskExecutor() {
@@ -79,6 +49,7 @@ TaskExecutor::~TaskExecutor() {
     running_ = false;
   }
   cv_.notify_all();
+  submit_cv_.notify_all();
   for (auto &t : working_threads_) {
     t.join();
   }
@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_TASK_EXECUTOR_H_
 #define MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_TASK_EXECUTOR_H_
 
+#include <chrono>
 #include <functional>
 #include <queue>
 #include <mutex>
@@ -51,24 +52,18 @@ class TaskExecutor {
   bool Submit(Fun &&function, Args &&... args) {
     auto callee = std::bind(function, args...);
     std::function<void()> task = [callee]() -> void { callee(); };
-    size_t index = 0;
-    for (size_t i = 0; i < submit_timeout_; i++) {
-      std::unique_lock<std::mutex> lock(mtx_);
-      if (task_num_ >= max_task_num_) {
-        lock.unlock();
-        std::this_thread::sleep_for(std::chrono::milliseconds(kSubmitTaskIntervalInMs));
-        index++;
-      } else {
-        break;
-      }
-    }
-    if (index >= submit_timeout_) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (!submit_cv_.wait_for(lock, std::chrono::milliseconds(submit_timeout_),
+                             [this] { return !running_ || task_queue_.size() < max_task_num_; })) {
       MS_LOG(WARNING) << "Submit task failed after " << submit_timeout_ << " ms.";
       return false;
     }
-    std::unique_lock<std::mutex> lock(mtx_);
-    task_num_++;
+    if (!running_) {
+      return false;
+    }
     task_queue_.push(task);
+    lock.unlock();
+    cv_.notify_one();
     return true;
   }
 
@@ -77,8 +72,6 @@ class TaskExecutor {
 
   // The number of tasks actually running
   size_t thread_num_;
-  // The number of idle threads that can execute tasks
-  size_t idle_thread_num_;
 
   // The timeout period of the task submission, in milliseconds. default timeout is 3000 milliseconds.
   size_t submit_timeout_;
@@ -87,12 +80,12 @@ class TaskExecutor {
   // max_task_num_, the Submit function will block.Until the current number of tasks is less than max task num,or
   // timeout.
   size_t max_task_num_;
-  // The number of currently submitted to the task queue
-  size_t task_num_;
 
-  std::thread notify_thread_;
   std::mutex mtx_;
+  // The working threads wait on cv_ for the tasks submitted, and the submissions wait on submit_cv_ while the queue is
+  // full.
   std::condition_variable cv_;
+  std::condition_variable submit_cv_;
 
   std::vector<std::thread> working_threads_;
   std::queue<std::function<void()>> task_queue_;
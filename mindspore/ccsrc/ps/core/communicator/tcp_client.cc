@@ -38,10 +38,10 @@ std::mutex TcpClient::event_base_mutex_;
 bool TcpClient::is_started_ = false;
 
 TcpClient::TcpClient(const std::string &address, std::uint16_t port)
-    : event_timeout_(nullptr),
-      buffer_event_(nullptr),
-      server_address_(std::move(address)),
+    : server_address_(std::move(address)),
       server_port_(port),
+      event_timeout_(nullptr),
+      buffer_event_(nullptr),
       is_stop_(true),
       is_connected_(false) {
   message_handler_.SetCallback(
@@ -301,6 +301,16 @@ bool TcpClient::SendMessage(const CommMessage &message) const {
 }
 
 bool TcpClient::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size) {
+  return WriteMessage(meta, protos, data, size, nullptr);
+}
+
+bool TcpClient::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const DataPtr &data,
+                            size_t size) {
+  return WriteMessage(meta, protos, data.get(), size, data);
+}
+
+bool TcpClient::WriteMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size,
+                             const DataPtr &owner) {
   MS_EXCEPTION_IF_NULL(buffer_event_);
   MS_EXCEPTION_IF_NULL(meta);
   MS_EXCEPTION_IF_NULL(data);
@@ -320,7 +330,10 @@ bool TcpClient::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &pro
     MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
     res = false;
   }
-  if (bufferevent_write(buffer_event_, data, size) == -1) {
+  bool data_added = owner != nullptr
+                      ? CommUtil::AddReferenceToBuffer(bufferevent_get_output(buffer_event_), data, size, owner)
+                      : bufferevent_write(buffer_event_, data, size) != -1;
+  if (!data_added) {
     MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
     res = false;
   }
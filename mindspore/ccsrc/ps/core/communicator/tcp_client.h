@@ -59,14 +59,16 @@ class TcpClient {
   void set_connected_callback(const OnConnected &connected);
   bool WaitConnected(
     const uint32_t &connected_timeout = PSContext::instance()->cluster_config().cluster_available_timeout);
-  void Init();
+  virtual void Init();
   void StartWithDelay(int seconds);
-  void Stop();
-  void Start();
-  void StartWithNoBlock();
+  virtual void Stop();
+  virtual void Start();
+  virtual void StartWithNoBlock();
   void SetMessageCallback(const OnMessage &cb);
-  bool SendMessage(const CommMessage &message) const;
+  virtual bool SendMessage(const CommMessage &message) const;
   bool SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size);
+  // The data is referenced by the output buffer instead of being copied into it.
+  bool SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const DataPtr &data, size_t size);
   void StartTimer(const uint32_t &time);
   void set_timer_callback(const OnTimer &timer);
   const event_base &eventbase();
@@ -79,13 +81,18 @@ class TcpClient {
   virtual void OnReadHandler(const void *buf, size_t num);
   static void TimerCallback(evutil_socket_t fd, int16_t event, void *arg);
   void NotifyConnected();
+  virtual bool WriteMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size,
+                            const DataPtr &owner);
 
- private:
   OnMessage message_callback_;
-  TcpMessageHandler message_handler_;
-
   OnConnected connected_callback_;
   OnDisconnected disconnected_callback_;
+  std::string server_address_;
+  std::uint16_t server_port_;
+
+ private:
+  TcpMessageHandler message_handler_;
+
   OnRead read_callback_;
   OnTimeout timeout_callback_;
   OnTimer on_timer_callback_;
@@ -99,8 +106,6 @@ class TcpClient {
   event *event_timeout_;
   bufferevent *buffer_event_;
 
-  std::string server_address_;
-  std::uint16_t server_port_;
   std::atomic<bool> is_stop_;
   std::atomic<bool> is_connected_;
 };
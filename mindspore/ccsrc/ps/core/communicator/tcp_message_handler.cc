@@ -25,6 +25,8 @@ namespace ps {
 namespace core {
 void TcpMessageHandler::SetCallback(const messageReceive &message_receive) { message_callback_ = message_receive; }
 
+const DataPtr &TcpMessageHandler::message_buffer() const { return message_buffer_; }
+
 void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
   MS_EXCEPTION_IF_NULL(buffer);
   auto buffer_data = reinterpret_cast<const unsigned char *>(buffer);
@@ -41,7 +43,9 @@ void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
           message_header_.message_length_ = *reinterpret_cast<const size_t *>(
             header_ + sizeof(message_header_.message_proto_) + sizeof(message_header_.message_meta_length_));
           remaining_length_ = message_header_.message_length_;
-          message_buffer_.reset(new unsigned char[remaining_length_]);
+          message_buffer_.reset(new unsigned char[remaining_length_ + kMessageDataAlignment]);
+          size_t data_begin = reinterpret_cast<uintptr_t>(message_buffer_.get()) + message_header_.message_meta_length_;
+          message_offset_ = (kMessageDataAlignment - data_begin % kMessageDataAlignment) % kMessageDataAlignment;
           buffer_data += (i + 1);
           break;
         }
@@ -55,7 +59,7 @@ void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
 
       size_t dest_size = copy_len;
       size_t src_size = copy_len;
-      auto ret = memcpy_s(message_buffer_.get() + last_copy_len_, dest_size, buffer_data, src_size);
+      auto ret = memcpy_s(message_buffer_.get() + message_offset_ + last_copy_len_, dest_size, buffer_data, src_size);
       last_copy_len_ += copy_len;
       buffer_data += copy_len;
       if (ret != EOK) {
@@ -65,9 +69,9 @@ void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
       if (remaining_length_ == 0) {
         if (message_callback_) {
           std::shared_ptr<MessageMeta> pb_message = std::make_shared<MessageMeta>();
-          pb_message->ParseFromArray(message_buffer_.get(), message_header_.message_meta_length_);
-          message_callback_(pb_message, message_header_.message_proto_,
-                            message_buffer_.get() + message_header_.message_meta_length_,
+          unsigned char *message = message_buffer_.get() + message_offset_;
+          pb_message->ParseFromArray(message, message_header_.message_meta_length_);
+          message_callback_(pb_message, message_header_.message_proto_, message + message_header_.message_meta_length_,
                             message_header_.message_length_ - message_header_.message_meta_length_);
         }
         message_buffer_.reset();
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "utils/log_adapter.h"
+#include "ps/constants.h"
 #include "ps/core/communicator/message.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
@@ -33,20 +34,31 @@ namespace ps {
 namespace core {
 using messageReceive = std::function<void(std::shared_ptr<MessageMeta>, const Protos &, const void *, size_t size)>;
 constexpr int kHeaderLen = 16;
+// The data following the meta of a received message starts at a multiple of this, so the arrays in it can be used
+// in place.
+constexpr size_t kMessageDataAlignment = 64;
 
 class TcpMessageHandler {
  public:
   TcpMessageHandler()
-      : is_parsed_(false), message_buffer_(nullptr), remaining_length_(0), header_index_(-1), last_copy_len_(0) {}
+      : is_parsed_(false),
+        message_buffer_(nullptr),
+        message_offset_(0),
+        remaining_length_(0),
+        header_index_(-1),
+        last_copy_len_(0) {}
   virtual ~TcpMessageHandler() = default;
 
   void SetCallback(const messageReceive &cb);
   void ReceiveMessage(const void *buffer, size_t num);
+  const DataPtr &message_buffer() const;
 
  private:
   messageReceive message_callback_;
   bool is_parsed_;
-  std::unique_ptr<unsigned char> message_buffer_;
+  DataPtr message_buffer_;
+  // Offset of the message in message_buffer_, which aligns the data after the meta.
+  size_t message_offset_;
   size_t remaining_length_;
   char header_[16]{0};
   int header_index_;
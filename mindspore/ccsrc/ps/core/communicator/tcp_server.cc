@@ -68,6 +68,18 @@ bool TcpConnection::SendMessage(std::shared_ptr<CommMessage> message) const {
 
 bool TcpConnection::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data,
                                 size_t size) const {
+  return WriteMessage(meta, protos, data, size, nullptr);
+}
+
+bool TcpConnection::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const DataPtr &data,
+                                size_t size) const {
+  return WriteMessage(meta, protos, data.get(), size, data);
+}
+
+const DataPtr &TcpConnection::received_buffer() const { return tcp_message_handler_.message_buffer(); }
+
+bool TcpConnection::WriteMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data,
+                                 size_t size, const DataPtr &owner) const {
   MS_EXCEPTION_IF_NULL(buffer_event_);
   MS_EXCEPTION_IF_NULL(meta);
   MS_EXCEPTION_IF_NULL(data);
@@ -86,7 +98,10 @@ bool TcpConnection::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos
     MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
     res = false;
   }
-  if (bufferevent_write(buffer_event_, data, size) == -1) {
+  bool data_added = owner != nullptr
+                      ? CommUtil::AddReferenceToBuffer(bufferevent_get_output(buffer_event_), data, size, owner)
+                      : bufferevent_write(buffer_event_, data, size) != -1;
+  if (!data_added) {
     MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
     res = false;
   }
@@ -448,6 +463,14 @@ bool TcpServer::SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr
   return conn->SendMessage(meta, protos, data, size);
 }
 
+bool TcpServer::SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
+                            const Protos &protos, const DataPtr &data, size_t size) {
+  MS_EXCEPTION_IF_NULL(conn);
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(data);
+  return conn->SendMessage(meta, protos, data, size);
+}
+
 void TcpServer::SendMessage(std::shared_ptr<CommMessage> message) {
   MS_EXCEPTION_IF_NULL(message);
   std::lock_guard<std::mutex> lock(connection_mutex_);
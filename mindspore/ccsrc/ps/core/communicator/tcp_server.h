@@ -58,8 +58,12 @@ class TcpConnection {
 
   virtual void InitConnection(const messageReceive &callback);
   virtual void SendMessage(const void *buffer, size_t num) const;
-  bool SendMessage(std::shared_ptr<CommMessage> message) const;
+  virtual bool SendMessage(std::shared_ptr<CommMessage> message) const;
   bool SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size) const;
+  // The data is referenced by the output buffer instead of being copied into it.
+  bool SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const DataPtr &data, size_t size) const;
+  // The buffer of the message being delivered to the callback, which may be held to use the message without a copy.
+  virtual const DataPtr &received_buffer() const;
   virtual void OnReadHandler(const void *buffer, size_t numBytes);
   const TcpServer *GetServer() const;
   const evutil_socket_t &GetFd() const;
@@ -71,6 +75,9 @@ class TcpConnection {
   TcpServer *server_;
   TcpMessageHandler tcp_message_handler_;
   Callback callback_;
+
+  virtual bool WriteMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size,
+                    const DataPtr &owner) const;
 };
 
 using OnServerReceiveMessage =
@@ -93,12 +100,12 @@ class TcpServer {
                          const OnAccepted &client_accept);
   void set_timer_once_callback(const OnTimerOnce &timer);
   void set_timer_callback(const OnTimer &timer);
-  void Init();
-  void Start();
-  void StartWithNoBlock();
+  virtual void Init();
+  virtual void Start();
+  virtual void StartWithNoBlock();
   void StartTimerOnlyOnce(const uint32_t &time);
   void StartTimer(const uint32_t &time);
-  void Stop();
+  virtual void Stop();
   void SendToAllClients(const char *data, size_t len);
   void AddConnection(const evutil_socket_t &fd, std::shared_ptr<TcpConnection> connection);
   void RemoveConnection(const evutil_socket_t &fd);
@@ -108,6 +115,8 @@ class TcpServer {
   bool SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr<CommMessage> message);
   bool SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const Protos &protos,
                    const void *data, size_t sizee);
+  bool SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const Protos &protos,
+                   const DataPtr &data, size_t size);
   void SendMessage(std::shared_ptr<CommMessage> message);
   uint16_t BoundPort() const;
   std::string BoundIp() const;
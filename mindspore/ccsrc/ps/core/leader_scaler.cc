@@ -37,7 +37,7 @@ void LeaderScaler::ScaleOutAsync(const std::shared_ptr<TcpClient> &client, const
 }
 
 void LeaderScaler::ScaleInAsync(const std::shared_ptr<TcpClient> &client, const NodeManager &manager,
-                                bool is_node_scale_in) {
+                                bool is_node_scale_in, const std::vector<ServersMeta> &scale_in_servers_meta) {
   MS_EXCEPTION_IF_NULL(client);
   auto message_meta = std::make_shared<MessageMeta>();
   message_meta->set_cmd(NodeCommand::SCALE_IN);
@@ -46,6 +46,7 @@ void LeaderScaler::ScaleInAsync(const std::shared_ptr<TcpClient> &client, const
   scale_in_message.set_worker_num(manager.worker_num());
   scale_in_message.set_server_num(manager.server_num());
   scale_in_message.set_is_node_scale_in(is_node_scale_in);
+  *scale_in_message.mutable_scale_in_servers_meta() = {scale_in_servers_meta.begin(), scale_in_servers_meta.end()};
 
   if (!node_->SendMessageSync(client, message_meta, Protos::PROTOBUF, scale_in_message.SerializeAsString().data(),
                               scale_in_message.ByteSizeLong())) {
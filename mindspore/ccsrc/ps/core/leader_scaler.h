@@ -41,8 +41,10 @@ class LeaderScaler {
 
   // When the scheduler receives the scale out message, it will send this message to the workers and servers.
   void ScaleOutAsync(const std::shared_ptr<TcpClient> &client, const NodeManager &manager);
-  // When the scheduler receives the scale in message, it will send this message to the workers and servers.
-  void ScaleInAsync(const std::shared_ptr<TcpClient> &client, const NodeManager &manager, bool is_node_scale_in);
+  // When the scheduler receives the scale in message, it will send this message to the workers and servers. The
+  // leaving servers are sent to all the nodes, so the servers know where their keys move.
+  void ScaleInAsync(const std::shared_ptr<TcpClient> &client, const NodeManager &manager, bool is_node_scale_in,
+                    const std::vector<ServersMeta> &scale_in_servers_meta);
 
  private:
   // The node_ will only be instantiated with scheduler node.
@@ -85,6 +85,20 @@ void NodeManager::UpdateHeartbeat(const std::string &node_id) {
   heartbeats_[node_id] = current_time;
 }
 
+void NodeManager::UpdatePinnedState(const std::string &node_id, bool is_pinned) {
+  std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+  if (is_pinned) {
+    (void)pinned_nodes_id_.insert(node_id);
+  } else {
+    (void)pinned_nodes_id_.erase(node_id);
+  }
+}
+
+bool NodeManager::IsNodePinned(const std::string &node_id) {
+  std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+  return pinned_nodes_id_.count(node_id) > 0;
+}
+
 void NodeManager::UpdateNodeScaleInState(const std::string &node_id) { heartbeats_scale_in_nodes_.insert(node_id); }
 
 bool NodeManager::CheckNodesScaluOutState() { return SizeToInt(heartbeats_scale_out_nodes_.size()) == total_node_num_; }
@@ -149,6 +163,16 @@ void NodeManager::AddScaleOutDoneNode(const std::string &node_id) { scale_out_do
 
 void NodeManager::AddScaleInDoneNode(const std::string &node_id) { scale_in_done_nodes_id_.insert(node_id); }
 
+bool NodeManager::AddScaleInFailedNode(const std::string &node_id) {
+  std::lock_guard<std::mutex> lock(scale_in_failed_mutex_);
+  return scale_in_failed_nodes_id_.insert(node_id).second;
+}
+
+std::unordered_set<std::string> NodeManager::scale_in_failed_nodes_id() {
+  std::lock_guard<std::mutex> lock(scale_in_failed_mutex_);
+  return scale_in_failed_nodes_id_;
+}
+
 bool NodeManager::IsAllNodesRegistered() { return SizeToInt(nodes_info_.size()) == total_node_num_; }
 
 bool NodeManager::IsAllNodesFinished() { return SizeToInt(finish_nodes_id_.size()) == total_node_num_; }
@@ -185,6 +209,8 @@ void NodeManager::ResetMetadata() {
   heartbeats_.clear();
   next_worker_rank_id_ = -1;
   next_server_rank_id_ = -1;
+  std::lock_guard<std::mutex> lock(scale_in_failed_mutex_);
+  scale_in_failed_nodes_id_.clear();
 }
 
 void NodeManager::set_total_node_num(const int32_t &node_num) { total_node_num_ = node_num; }
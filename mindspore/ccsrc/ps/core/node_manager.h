@@ -57,6 +57,9 @@ class NodeManager {
   int NextRankId(const RegisterMessage &register_message);
 
   void UpdateHeartbeat(const std::string &node_id);
+  // The pinned state of the node is reported by its heartbeats.
+  void UpdatePinnedState(const std::string &node_id, bool is_pinned);
+  bool IsNodePinned(const std::string &node_id);
   bool CheckNodesScaluOutState();
   void UpdateNodeScaleInState(const std::string &node_id);
   bool CheckNodesScaleInState();
@@ -70,6 +73,9 @@ class NodeManager {
   void AddScaleOutDoneNode(const std::string &node_id);
   // After the scheduler receives the scale_in_done node, it will save this node.
   void AddScaleInDoneNode(const std::string &node_id);
+  // The nodes which fail to be scaled in and stay in the cluster. Returns false if the node has been added.
+  bool AddScaleInFailedNode(const std::string &node_id);
+  std::unordered_set<std::string> scale_in_failed_nodes_id();
 
   // When workers and servers registered to scheduler, the scheduler will collect the number of registered
   // nodes and Determine whether the registered number of worker and server is equal to total_node_num_.
@@ -120,6 +126,8 @@ class NodeManager {
   std::mutex heartbeat_mutex_;
 
   std::unordered_map<std::string, timeval> heartbeats_;
+  // The nodes which can't be scaled in.
+  std::unordered_set<std::string> pinned_nodes_id_;
   std::unordered_set<std::string> heartbeats_finish_nodes_;
   std::unordered_set<std::string> heartbeats_scale_out_nodes_;
   std::unordered_set<std::string> heartbeats_scale_in_nodes_;
@@ -131,6 +139,9 @@ class NodeManager {
   std::unordered_set<std::string> scale_out_done_nodes_id_;
   // The scheduler aggregates scale_in_done messages from workers/servers
   std::unordered_set<std::string> scale_in_done_nodes_id_;
+  // The scheduler records the nodes which fail to be scaled in
+  std::mutex scale_in_failed_mutex_;
+  std::unordered_set<std::string> scale_in_failed_nodes_id_;
 
   // Cluster metadata information can be dynamically changed
   std::unique_ptr<ClusterMetadata> meta_data_;
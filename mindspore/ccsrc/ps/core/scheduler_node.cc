@@ -53,6 +53,7 @@ void SchedulerNode::ProcessHeartbeat(std::shared_ptr<TcpServer> server, std::sha
   heartbeat_message.ParseFromArray(data, size);
 
   node_manager_.UpdateHeartbeat(heartbeat_message.node_id());
+  node_manager_.UpdatePinnedState(heartbeat_message.node_id(), heartbeat_message.is_pinned());
 
   HeartbeatRespMessage heartbeat_resp_message;
 
@@ -81,6 +82,7 @@ void SchedulerNode::InitCommandHandler() {
   handlers_[NodeCommand::FETCH_METADATA] = &SchedulerNode::ProcessFetchMetadata;
   handlers_[NodeCommand::SCALE_OUT_DONE] = &SchedulerNode::ProcessScaleOutDone;
   handlers_[NodeCommand::SCALE_IN_DONE] = &SchedulerNode::ProcessScaleInDone;
+  handlers_[NodeCommand::SCALE_IN_FAILED] = &SchedulerNode::ProcessScaleInFailed;
 }
 
 void SchedulerNode::CreateTcpServer() {
@@ -230,6 +232,31 @@ void SchedulerNode::ProcessScaleInDone(std::shared_ptr<TcpServer> server, std::s
   }
 }
 
+void SchedulerNode::ProcessScaleInFailed(std::shared_ptr<TcpServer> server, std::shared_ptr<TcpConnection> conn,
+                                         std::shared_ptr<MessageMeta> meta, const void *data, size_t size) {
+  MS_EXCEPTION_IF_NULL(server);
+  MS_EXCEPTION_IF_NULL(conn);
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(data);
+  ScaleInFailedMessage scale_in_failed_message;
+  scale_in_failed_message.ParseFromArray(data, size);
+  const std::string &node_id = scale_in_failed_message.node_id();
+  MS_LOG(ERROR) << "The node id:" << node_id << " fails to be scaled in and stays in the cluster, the reason is: "
+                << scale_in_failed_message.reason();
+  // The node registers again like the staying nodes, so it's counted back before its registration is answered.
+  if (node_manager_.GetClusterState() == ClusterState::CLUSTER_SCALE_IN &&
+      node_manager_.AddScaleInFailedNode(node_id)) {
+    if (scale_in_failed_message.role() == NodeRole::SERVER) {
+      node_manager_.set_server_num(node_manager_.server_num() + 1);
+    } else {
+      node_manager_.set_worker_num(node_manager_.worker_num() + 1);
+    }
+    node_manager_.set_total_node_num(node_manager_.total_node_num() + 1);
+  }
+
+  server->SendMessage(conn, meta, Protos::PROTOBUF, data, size);
+}
+
 void SchedulerNode::SendMetadata(const std::shared_ptr<TcpClient> &client) {
   MS_EXCEPTION_IF_NULL(client);
   auto message_meta = std::make_shared<MessageMeta>();
@@ -456,6 +483,7 @@ void SchedulerNode::ProcessScaleIn(std::shared_ptr<HttpMessageHandler> resp) {
   status = resp->ParsePostMessageToJson();
   if (status != RequestProcessResultCode::kSuccess) {
     resp->ErrorResponse(HTTP_BADREQUEST, status);
+    return;
   }
 
   status = CheckIfClusterReady();
@@ -473,7 +501,15 @@ void SchedulerNode::ProcessScaleIn(std::shared_ptr<HttpMessageHandler> resp) {
 
   MS_LOG(WARNING) << "The scale in node ids:" << scale_in_node_ids;
 
+  // The scale in is refused before any node is told, if a node to scale in holds the data which can't be migrated.
+  status = CheckIfNodesUnpinned(scale_in_node_ids);
+  if (status != RequestProcessResultCode::kSuccess) {
+    resp->ErrorResponse(HTTP_BADREQUEST, status);
+    return;
+  }
+
   std::unordered_map<std::string, bool> scale_in_nodes;
+  std::vector<ServersMeta> scale_in_servers_meta;
 
   int32_t scale_worker_num = 0;
   int32_t scale_server_num = 0;
@@ -487,6 +523,11 @@ void SchedulerNode::ProcessScaleIn(std::shared_ptr<HttpMessageHandler> resp) {
         scale_worker_num++;
       } else if (info.node_role_ == NodeRole::SERVER) {
         scale_server_num++;
+        ServersMeta servers_meta;
+        servers_meta.set_rank_id(info.rank_id_);
+        servers_meta.set_ip(info.ip_);
+        servers_meta.set_port(info.port_);
+        scale_in_servers_meta.push_back(servers_meta);
       }
     }
   }
@@ -506,7 +547,7 @@ void SchedulerNode::ProcessScaleIn(std::shared_ptr<HttpMessageHandler> resp) {
     if (scale_in_nodes.count(kvs.first)) {
       is_node_scale_in = true;
     }
-    leader_scaler_->ScaleInAsync(client, node_manager_, is_node_scale_in);
+    leader_scaler_->ScaleInAsync(client, node_manager_, is_node_scale_in, scale_in_servers_meta);
   }
 
   nlohmann::json js;
@@ -548,6 +589,9 @@ void SchedulerNode::ProcessGetNodesInfo(std::shared_ptr<HttpMessageHandler> resp
     res["role"] = CommUtil::NodeRoleToString(kvs.second.node_role_);
     js["node_ids"].push_back(res);
   }
+  for (const auto &node_id : node_manager_.scale_in_failed_nodes_id()) {
+    js["scale_in_failed_node_ids"].push_back(node_id);
+  }
 
   resp->AddRespString(js.dump());
 
@@ -565,6 +609,18 @@ RequestProcessResult SchedulerNode::CheckIfClusterReady() {
   return result;
 }
 
+RequestProcessResult SchedulerNode::CheckIfNodesUnpinned(const std::vector<std::string> &node_ids) {
+  RequestProcessResult result(RequestProcessResultCode::kSuccess);
+  for (const auto &node_id : node_ids) {
+    if (node_manager_.IsNodePinned(node_id)) {
+      std::string message = "The node " + node_id + " holds the shards of the embedding tables, it can't be scaled in.";
+      ERROR_STATUS(result, RequestProcessResultCode::kInvalidInputs, message);
+      return result;
+    }
+  }
+  return result;
+}
+
 void SchedulerNode::StartRestfulServer(const std::string &address, std::uint16_t port, size_t thread_num) {
   MS_LOG(INFO) << "Scheduler start https server.";
   http_server_ = std::make_shared<HttpServer>(address, port, thread_num);
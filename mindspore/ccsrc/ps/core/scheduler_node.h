@@ -85,6 +85,9 @@ class SchedulerNode : public Node {
   // Process scale_in_done messages from workers/servers
   void ProcessScaleInDone(std::shared_ptr<TcpServer> server, std::shared_ptr<TcpConnection> conn,
                           std::shared_ptr<MessageMeta> meta, const void *data, size_t size);
+  // Process scale_in_failed messages from the nodes to scale in which stay in the cluster
+  void ProcessScaleInFailed(std::shared_ptr<TcpServer> server, std::shared_ptr<TcpConnection> conn,
+                            std::shared_ptr<MessageMeta> meta, const void *data, size_t size);
 
   // After scheduler collects all registered message, it actively sends finish to the node connected by the client.
   void SendMetadata(const std::shared_ptr<TcpClient> &client);
@@ -110,6 +113,8 @@ class SchedulerNode : public Node {
 
   // check whether the cluster is in the ready state.
   RequestProcessResult CheckIfClusterReady();
+  // check whether none of the nodes is pinned, which can't be scaled in.
+  RequestProcessResult CheckIfNodesUnpinned(const std::vector<std::string> &node_ids);
 
   void StartRestfulServer(const std::string &address, std::uint16_t port, size_t thread_num = 10);
   void StopRestfulServer();
@@ -51,11 +51,23 @@ void ServerNode::Response(std::shared_ptr<TcpConnection> conn, std::shared_ptr<M
   server_->SendMessage(conn, meta, Protos::RAW, data, size);
 }
 
+void ServerNode::Response(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const DataPtr &data,
+                          size_t size) {
+  MS_EXCEPTION_IF_NULL(conn);
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(data);
+  meta->set_role(node_info_.node_role_);
+  meta->set_rank_id(node_info_.rank_id_);
+  MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
+                << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << meta->request_id();
+  server_->SendMessage(conn, meta, Protos::RAW, data, size);
+}
+
 void ServerNode::CreateTcpServer() {
   std::string interface;
   std::string server_ip;
   CommUtil::GetAvailableInterfaceAndIP(&interface, &server_ip);
-  server_ = std::make_shared<TcpServer>(server_ip, 0);
+  server_ = CreateDataTcpServer(server_ip);
   server_->SetMessageCallback([&](std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
                                   const Protos &protos, const void *data, size_t size) {
     if (server_handler_.count(meta->cmd()) == 0) {
@@ -97,12 +109,19 @@ void ServerNode::ProcessSendData(std::shared_ptr<TcpConnection> conn, std::share
   MS_EXCEPTION_IF_NULL(conn);
   MS_EXCEPTION_IF_NULL(meta);
   MS_EXCEPTION_IF_NULL(data);
-  std::shared_ptr<unsigned char[]> res(new unsigned char[size]);
-  size_t dest_size = size;
-  size_t src_size = size;
-  auto ret = memcpy_s(res.get(), dest_size, data, src_size);
-  if (ret != EOK) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+  // The request holds the buffer it was received into, so it is handled without a copy.
+  DataPtr res;
+  const DataPtr &received_buffer = conn->received_buffer();
+  if (received_buffer != nullptr) {
+    res = DataPtr(received_buffer, static_cast<unsigned char *>(const_cast<void *>(data)));
+  } else {
+    res.reset(new unsigned char[size]);
+    size_t dest_size = size;
+    size_t src_size = size;
+    auto ret = memcpy_s(res.get(), dest_size, data, src_size);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+    }
   }
   MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
                 << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << meta->request_id()
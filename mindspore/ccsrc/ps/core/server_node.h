@@ -56,6 +56,9 @@ class ServerNode : public AbstractNode {
 
   void set_handler(const RequestHandler &handler);
   void Response(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const void *data, size_t size);
+  // The data is sent without being copied, it is held until it has been written to the connection.
+  void Response(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const DataPtr &data,
+                size_t size);
 
   std::shared_ptr<CommunicatorBase> GetOrCreateHttpComm(const std::string &ip, std::int16_t port,
                                                         const std::shared_ptr<TaskExecutor> &task_executor);
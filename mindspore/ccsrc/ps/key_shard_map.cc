@@ -0,0 +1,164 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/key_shard_map.h"
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <utility>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// The hashes are computed here instead of by std::hash, so the nodes built by different compilers agree on the ring.
+uint64_t HashString(const std::string &str) {
+  constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+  constexpr uint64_t kFnvPrime = 1099511628211ULL;
+  uint64_t hash = kFnvOffsetBasis;
+  for (const char c : str) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+uint64_t HashKey(Key key) {
+  key += 0x9E3779B97F4A7C15ULL;
+  key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+  return key ^ (key >> 31);
+}
+}  // namespace
+
+void KeyShardMap::SetServers(const std::vector<std::string> &servers) {
+  servers_ = servers;
+  ring_.clear();
+  for (const auto &server : servers_) {
+    for (size_t i = 0; i < virtual_node_num_; i++) {
+      (void)ring_.emplace(HashString(server + "#" + std::to_string(i)), server);
+    }
+  }
+  for (auto iter = pins_.begin(); iter != pins_.end();) {
+    if (HasServer(iter->second)) {
+      ++iter;
+    } else {
+      iter = pins_.erase(iter);
+    }
+  }
+}
+
+const std::vector<std::string> &KeyShardMap::servers() const { return servers_; }
+
+bool KeyShardMap::HasServer(const std::string &server) const {
+  return std::find(servers_.begin(), servers_.end(), server) != servers_.end();
+}
+
+std::string KeyShardMap::RingOwner(const Key &key) const {
+  if (ring_.empty()) {
+    MS_LOG(EXCEPTION) << "There is no server to place the key " << key;
+  }
+  auto iter = ring_.lower_bound(HashKey(key));
+  if (iter == ring_.end()) {
+    iter = ring_.begin();
+  }
+  return iter->second;
+}
+
+std::string KeyShardMap::Owner(const Key &key) const {
+  auto iter = pins_.find(key);
+  if (iter != pins_.end()) {
+    return iter->second;
+  }
+  return RingOwner(key);
+}
+
+void KeyShardMap::Pin(const Key &key, const std::string &server) { pins_[key] = server; }
+
+void KeyShardMap::Unpin(const Key &key) { (void)pins_.erase(key); }
+
+void KeyShardMap::PinOwners(const std::vector<Key> &keys) {
+  if (ring_.empty()) {
+    return;
+  }
+  for (const auto &key : keys) {
+    if (pins_.count(key) == 0) {
+      pins_[key] = RingOwner(key);
+    }
+  }
+}
+
+std::map<Key, std::string> KeyShardMap::PlanRebalance(const std::unordered_map<Key, double> &key_loads,
+                                                      double tolerance) const {
+  std::map<Key, std::string> moves;
+  if (servers_.size() < 2 || key_loads.empty()) {
+    return moves;
+  }
+  std::map<std::string, double> server_loads;
+  // The keys of each server ordered by their loads, the hottest first.
+  std::map<std::string, std::set<std::pair<double, Key>, std::greater<std::pair<double, Key>>>> server_keys;
+  for (const auto &server : servers_) {
+    server_loads[server] = 0;
+  }
+  double total_load = 0;
+  for (const auto &key_load : key_loads) {
+    std::string owner = Owner(key_load.first);
+    if (server_loads.count(owner) == 0) {
+      continue;
+    }
+    server_loads[owner] += key_load.second;
+    (void)server_keys[owner].emplace(key_load.second, key_load.first);
+    total_load += key_load.second;
+  }
+  double limit = total_load / servers_.size() * (1 + tolerance);
+
+  for (size_t i = 0; i < key_loads.size(); i++) {
+    auto cmp = [](const auto &a, const auto &b) { return a.second < b.second; };
+    auto max_iter = std::max_element(server_loads.begin(), server_loads.end(), cmp);
+    auto min_iter = std::min_element(server_loads.begin(), server_loads.end(), cmp);
+    if (max_iter->second <= limit) {
+      break;
+    }
+    // The hottest key which makes the target less loaded than the source was, so the loads don't swing back and forth.
+    double gap = max_iter->second - min_iter->second;
+    auto &keys = server_keys[max_iter->first];
+    auto key_iter =
+      std::find_if(keys.begin(), keys.end(), [gap](const auto &key) { return key.first > 0 && key.first < gap; });
+    if (key_iter == keys.end()) {
+      break;
+    }
+    auto key = *key_iter;
+    (void)keys.erase(key_iter);
+    (void)server_keys[min_iter->first].insert(key);
+    max_iter->second -= key.first;
+    min_iter->second += key.first;
+    moves[key.second] = min_iter->first;
+    MS_LOG(INFO) << "Plan moving key " << key.second << " with load " << key.first << " from server " << max_iter->first
+                 << " to server " << min_iter->first;
+  }
+  for (auto iter = moves.begin(); iter != moves.end();) {
+    if (iter->second == Owner(iter->first)) {
+      iter = moves.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  return moves;
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_KEY_SHARD_MAP_H_
+#define MINDSPORE_CCSRC_PS_KEY_SHARD_MAP_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ps/constants.h"
+
+namespace mindspore {
+namespace ps {
+// KeyShardMap places the keys of the parameter servers on the servers, which are identified by their addresses, with a
+// consistent hash ring. When a server joins or leaves, only the keys of its arcs on the ring change their servers. A
+// key can be pinned to a server, which overrides the ring, so it stays where it is until it's migrated, or it's moved
+// off a server carrying too much load. The ring only depends on the addresses, so every node computes the same one.
+class KeyShardMap {
+ public:
+  explicit KeyShardMap(size_t virtual_node_num = kShardVirtualNodeNum) : virtual_node_num_(virtual_node_num) {}
+  ~KeyShardMap() = default;
+
+  // Replace the servers. The pins to the servers which are not in the servers any more are dropped.
+  void SetServers(const std::vector<std::string> &servers);
+  const std::vector<std::string> &servers() const;
+  bool HasServer(const std::string &server) const;
+
+  // The server of the key on the ring, without its pin.
+  std::string RingOwner(const Key &key) const;
+  // The server of the key, which is the server it's pinned to if any.
+  std::string Owner(const Key &key) const;
+  void Pin(const Key &key, const std::string &server);
+  void Unpin(const Key &key);
+  // Pin the keys which have no pin to their current servers, so changing the servers doesn't move them.
+  void PinOwners(const std::vector<Key> &keys);
+
+  // Plan moving the keys, the hottest first, from the most loaded server to the least loaded one, until no server has
+  // more load than the average by the tolerance ratio or no move lowers the load of the most loaded server. The returned
+  // moves map the keys to their new servers and are not applied.
+  std::map<Key, std::string> PlanRebalance(const std::unordered_map<Key, double> &key_loads, double tolerance) const;
+
+ private:
+  size_t virtual_node_num_;
+  std::vector<std::string> servers_;
+  // The hash values of the virtual nodes of the servers on the ring.
+  std::map<uint64_t, std::string> ring_;
+  std::unordered_map<Key, std::string> pins_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_KEY_SHARD_MAP_H_
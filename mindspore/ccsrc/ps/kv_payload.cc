@@ -0,0 +1,78 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ps/kv_payload.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+size_t AlignUp(size_t size) { return (size + kKVPayloadAlignment - 1) / kKVPayloadAlignment * kKVPayloadAlignment; }
+
+size_t LensOffset(size_t key_num) { return sizeof(KVPayloadHeader) + key_num * sizeof(Key); }
+
+size_t ValuesOffset(size_t key_num, size_t len_num) { return AlignUp(LensOffset(key_num) + len_num * sizeof(int)); }
+}  // namespace
+
+size_t KVPayload::Size(size_t key_num, size_t len_num, size_t value_num) {
+  return ValuesOffset(key_num, len_num) + value_num * sizeof(float);
+}
+
+KVPayload KVPayload::Create(void *buffer, size_t size, size_t key_num, size_t len_num, size_t value_num) {
+  MS_EXCEPTION_IF_NULL(buffer);
+  if (size < Size(key_num, len_num, value_num)) {
+    MS_LOG(EXCEPTION) << "The buffer size " << size << " is less than the payload size "
+                      << Size(key_num, len_num, value_num);
+  }
+  auto header = reinterpret_cast<KVPayloadHeader *>(buffer);
+  header->magic = kKVPayloadMagic;
+  header->reserved = 0;
+  header->key_num = key_num;
+  header->len_num = len_num;
+  header->value_num = value_num;
+  return KVPayload(reinterpret_cast<unsigned char *>(buffer), key_num, len_num, value_num);
+}
+
+KVPayload KVPayload::Parse(const void *buffer, size_t size) {
+  if (!IsKVPayload(buffer, size)) {
+    MS_LOG(EXCEPTION) << "The message of size " << size << " is not a kv payload.";
+  }
+  auto header = reinterpret_cast<const KVPayloadHeader *>(buffer);
+  // Each number is bounded by the size before the offsets are computed, so they can not overflow.
+  if (header->key_num > size || header->len_num > size || header->value_num > size ||
+      Size(header->key_num, header->len_num, header->value_num) != size) {
+    MS_LOG(EXCEPTION) << "The kv payload of size " << size << " is truncated, the key num:" << header->key_num
+                      << ", the len num:" << header->len_num << ", the value num:" << header->value_num;
+  }
+  return KVPayload(reinterpret_cast<unsigned char *>(const_cast<void *>(buffer)), header->key_num, header->len_num,
+                   header->value_num);
+}
+
+bool KVPayload::IsKVPayload(const void *buffer, size_t size) {
+  return buffer != nullptr && size >= sizeof(KVPayloadHeader) &&
+         reinterpret_cast<const KVPayloadHeader *>(buffer)->magic == kKVPayloadMagic;
+}
+
+KVPayload::KVPayload(unsigned char *buffer, size_t key_num, size_t len_num, size_t value_num)
+    : keys_(reinterpret_cast<Key *>(buffer + sizeof(KVPayloadHeader))),
+      lens_(reinterpret_cast<int *>(buffer + LensOffset(key_num))),
+      values_(reinterpret_cast<float *>(buffer + ValuesOffset(key_num, len_num))),
+      key_num_(key_num),
+      len_num_(len_num),
+      value_num_(value_num) {}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_CCSRC_PS_KV_PAYLOAD_H_
+#define MINDSPORE_CCSRC_PS_KV_PAYLOAD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "ps/constants.h"
+
+namespace mindspore {
+namespace ps {
+// Wire format of the keys and values of the push, pull and embedding lookup requests. Instead of protobuf repeated
+// fields, the arrays follow a fixed header as they are in memory, so the sender writes them once and the receiver
+// reads them in place. The integers are in host byte order:
+//  header : uint32 magic, uint32 reserved, uint64 number of keys, uint64 number of lengths, uint64 number of values
+//  keys   : uint64 keys[key_num]
+//  lengths: int32 lens[len_num]
+//  values : float values[value_num], starting at a multiple of kKVPayloadAlignment from the start of the payload
+constexpr uint32_t kKVPayloadMagic = 0x3150564b;
+constexpr size_t kKVPayloadAlignment = 64;
+
+struct KVPayloadHeader {
+  uint32_t magic;
+  uint32_t reserved;
+  uint64_t key_num;
+  uint64_t len_num;
+  uint64_t value_num;
+};
+
+class KVPayload {
+ public:
+  // Size in bytes of a payload with the numbers of keys, lengths and values.
+  static size_t Size(size_t key_num, size_t len_num, size_t value_num);
+
+  // Write the header of a payload into the buffer of Size() bytes. The arrays are filled through the accessors.
+  static KVPayload Create(void *buffer, size_t size, size_t key_num, size_t len_num, size_t value_num);
+
+  // View a received payload in place, raising an exception if it is malformed.
+  static KVPayload Parse(const void *buffer, size_t size);
+
+  // Whether the buffer starts with the header of a payload.
+  static bool IsKVPayload(const void *buffer, size_t size);
+
+  Key *keys() const { return keys_; }
+  int *lens() const { return lens_; }
+  float *values() const { return values_; }
+  size_t key_num() const { return key_num_; }
+  size_t len_num() const { return len_num_; }
+  size_t value_num() const { return value_num_; }
+
+ private:
+  KVPayload(unsigned char *buffer, size_t key_num, size_t len_num, size_t value_num);
+
+  Key *keys_;
+  int *lens_;
+  float *values_;
+  size_t key_num_;
+  size_t len_num_;
+  size_t value_num_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_KV_PAYLOAD_H_
@@ -39,6 +39,8 @@ size_t OptimizerInfo::grad_index() { return 0; }
 
 size_t OptimizerInfo::indices_index() { return 0; }
 
+size_t OptimizerInfo::state_num() const { return 0; }
+
 template <typename T>
 void OptimizerInfo::UpdateOptimInputValue(const std::string &optim_type, const std::string &input_name, void *data,
                                           const Lengths &lens) {
@@ -285,6 +287,8 @@ size_t MomentumOptimInfo::grad_index() {
   return ps_grad_index;
 }
 
+size_t MomentumOptimInfo::state_num() const { return kMomentumOriginIdx.at("accum"); }
+
 SparseAdamOptimInfo::SparseAdamOptimInfo(const AddressPtr &weight, const AddressPtr &m, const AddressPtr &v,
                                          const AddressPtr &beta1_power, const AddressPtr &beta2_power,
                                          const AddressPtr &learning_rate, const AddressPtr &beta1,
@@ -339,6 +343,8 @@ size_t SparseAdamOptimInfo::indices_index() {
   return ps_indices_index;
 }
 
+size_t SparseAdamOptimInfo::state_num() const { return kSparseAdamOriginIdx.at("v"); }
+
 SparseFtrlOptimInfo::SparseFtrlOptimInfo(const AddressPtr &weight, const AddressPtr &accum, const AddressPtr &linear,
                                          const AddressPtr &grad, const AddressPtr &indices, bool sharded) {
   inputs_.push_back(weight);
@@ -374,5 +380,7 @@ size_t SparseFtrlOptimInfo::indices_index() {
   size_t ps_indices_index = kSparseFtrlPSSendIdx.at("indices");
   return ps_indices_index;
 }
+
+size_t SparseFtrlOptimInfo::state_num() const { return kSparseFtrlOriginIdx.at("linear"); }
 }  // namespace ps
 }  // namespace mindspore
@@ -47,6 +47,8 @@ class OptimizerInfo {
   virtual bool IsSparse() const;
   virtual size_t grad_index();
   virtual size_t indices_index();
+  // The number of the states of the optimizer, which are the inputs following the weight and are kept across the steps.
+  virtual size_t state_num() const;
 
  protected:
   template <typename T>
@@ -95,6 +97,7 @@ class MomentumOptimInfo : public DenseOptimInfo {
   const AddressPtr &gradient();
   const AddressPtr &indices();
   size_t grad_index() override;
+  size_t state_num() const override;
 };
 
 class SparseAdamOptimInfo : public SparseOptimInfo {
@@ -111,6 +114,7 @@ class SparseAdamOptimInfo : public SparseOptimInfo {
   bool IsSparse() const override;
   size_t grad_index() override;
   size_t indices_index() override;
+  size_t state_num() const override;
 };
 
 class SparseFtrlOptimInfo : public SparseOptimInfo {
@@ -124,6 +128,7 @@ class SparseFtrlOptimInfo : public SparseOptimInfo {
   bool IsSparse() const override;
   size_t grad_index() override;
   size_t indices_index() override;
+  size_t state_num() const override;
 };
 }  // namespace ps
 }  // namespace mindspore
@@ -34,7 +34,11 @@ void ParameterServer::Run(const FuncGraphPtr &func_graph) {
   thread_->join();
   SyncEmbeddingTables();
   MS_LOG(INFO) << "PServer finished updating models, starts finalizing...";
-  server_node_->Finish();
+  if (is_scaled_in_) {
+    MS_LOG(WARNING) << "The server has been scaled in, it exits without finishing the cluster.";
+  } else {
+    server_node_->Finish();
+  }
   server_node_->Stop();
   MS_LOG(INFO) << "PServer finalized successfully.";
 }
@@ -45,6 +49,8 @@ bool ParameterServer::Init(const FuncGraphPtr &func_graph) {
   func_graph_ = func_graph;
   handler_.reset(new ServerHandler(this));
   handler_->Init();
+  executor_ = std::make_unique<core::TaskExecutor>(kServerHandlerThreadNum);
+  scale_executor_ = std::make_unique<core::TaskExecutor>(1);
 
   InitOptimInfoBuilders();
   server_node_->set_handler(*handler_);
@@ -60,6 +66,33 @@ bool ParameterServer::Init(const FuncGraphPtr &func_graph) {
     MS_LOG(ERROR) << "Trigger timeout event: NODE_TIMEOUT begin to exit the system!";
     this->Finalize();
   });
+  // The keys are migrated on the thread of scale_executor_, so the training goes on while the cluster is scaled.
+  server_node_->RegisterEventCallback(core::ClusterEvent::READY_FOR_SCALE_OUT, [this]() {
+    (void)shard_rank_id();
+    server_node_->set_ready_for_scale_out();
+  });
+  server_node_->RegisterEventCallback(core::ClusterEvent::CLUSTER_SCALE_OUT_DONE, [this]() {
+    if (!scale_executor_->Submit(&ParameterServer::ScaleOut, this)) {
+      MS_LOG(ERROR) << "Submitting the migration of the scale out failed.";
+    }
+  });
+  server_node_->RegisterEventCallback(core::ClusterEvent::READY_FOR_SCALE_IN, [this]() {
+    (void)shard_rank_id();
+    if (!scale_executor_->Submit(&ParameterServer::ScaleIn, this)) {
+      MS_LOG(ERROR) << "Submitting the migration of the scale in failed.";
+    }
+  });
+  server_node_->RegisterEventCallback(core::ClusterEvent::CLUSTER_SCALE_IN_DONE, [this]() {
+    if (server_node_->rank_id() == UINT_MAX) {
+      is_scaled_in_ = true;
+      if (!scale_executor_->Submit(&ParameterServer::Retire, this)) {
+        MS_LOG(ERROR) << "Submitting the retirement of the server failed.";
+        this->Finalize();
+      }
+    } else {
+      server_node_->set_scale_in_done();
+    }
+  });
   thread_.reset(new std::thread(&ParameterServer::UpdateWeights, this));
   GetEmbeddingTableParamPtr();
   return true;
@@ -119,22 +152,22 @@ void ParameterServer::InitOptimInputsShape(const Keys &keys, const Values &value
       MS_EXCEPTION_IF_NULL(cnode);
       if (optim_name == kSparseAdam) {
         std::shared_ptr<PServerKernel> optimizer =
-          std::make_shared<kernel::ps::SparseApplyAdamPSKernel>(server_node_->rank_id(), pserver_num_, worker_num_);
+          std::make_shared<kernel::ps::SparseApplyAdamPSKernel>(shard_rank_id(), pserver_num_, worker_num_);
         optimizer->InitKernel(cnode, optim_inputs_shape_[key]);
         optimizers_[key] = optimizer;
       } else if (optim_name == kSparseLazyAdam) {
         std::shared_ptr<PServerKernel> optimizer =
-          std::make_shared<kernel::ps::SparseApplyLazyAdamPSKernel>(server_node_->rank_id(), pserver_num_, worker_num_);
+          std::make_shared<kernel::ps::SparseApplyLazyAdamPSKernel>(shard_rank_id(), pserver_num_, worker_num_);
         optimizer->InitKernel(cnode, optim_inputs_shape_[key]);
         optimizers_[key] = optimizer;
       } else if (optim_name == kApplyMomentum) {
         std::shared_ptr<PServerKernel> optimizer =
-          std::make_shared<kernel::ps::ApplyMomentumPSKernel>(server_node_->rank_id(), pserver_num_, worker_num_);
+          std::make_shared<kernel::ps::ApplyMomentumPSKernel>(shard_rank_id(), pserver_num_, worker_num_);
         optimizer->InitKernel(cnode, optim_inputs_shape_[key]);
         optimizers_[key] = optimizer;
       } else if (optim_name == kSparseFtrl) {
         std::shared_ptr<PServerKernel> optimizer =
-          std::make_shared<kernel::ps::SparseApplyFtrlPSKernel>(server_node_->rank_id(), pserver_num_, worker_num_);
+          std::make_shared<kernel::ps::SparseApplyFtrlPSKernel>(shard_rank_id(), pserver_num_, worker_num_);
         optimizer->InitKernel(cnode, optim_inputs_shape_[key]);
         optimizers_[key] = optimizer;
       }
@@ -148,6 +181,7 @@ void ParameterServer::InitWeight(const Key &key, const WeightPtr &weight) {
     MS_LOG(INFO) << "Initializing weight for key " << key << ", server rank " << server_node_->rank_id();
     weights_[key] = weight;
     tokens_[key] = 0;
+    push_admissions_[key] = 0;
     is_embedding_[key] = false;
   }
 }
@@ -157,6 +191,8 @@ void ParameterServer::InitGrad(const Key &key, const GradPtr &grad) {
   if (grads_.count(key) == 0) {
     grads_[key] = grad;
     grads_accum_counter_[key] = 0;
+    // The entry is created here so the requests of the training never insert into the map.
+    (void)optim_infos_.emplace(key, nullptr);
   }
 }
 
@@ -166,7 +202,7 @@ void ParameterServer::InitEmbeddingTable(
   MS_EXCEPTION_IF_NULL(shapes);
   if (weights_.count(key) == 0) {
     std::shared_ptr<PServerKernel> lookup =
-      std::make_shared<kernel::ps::EmbeddingLookUpPSKernel>(server_node_->rank_id(), pserver_num_, worker_num_);
+      std::make_shared<kernel::ps::EmbeddingLookUpPSKernel>(shard_rank_id(), pserver_num_, worker_num_);
     lookup->InitKernel(shapes);
     embedding_lookup_ops_[key] = lookup;
 
@@ -195,9 +231,13 @@ void ParameterServer::InitEmbeddingTable(
     weights_[key] = embedding;
     MS_LOG(DEBUG) << "The key:" << key << " the embedding:" << *embedding;
     tokens_[key] = 0;
+    push_admissions_[key] = 0;
     is_embedding_[key] = true;
+    // The shards of the embedding tables can't be migrated, so the server can't be scaled in.
+    server_node_->set_pinned(true);
 
     grads_accum_counter_[key] = 0;
+    (void)optim_infos_.emplace(key, nullptr);
   }
 }
 
@@ -205,121 +245,162 @@ bool ParameterServer::HasWeight(const Key &key) { return (weights_.count(key) >
 
 void ParameterServer::Finalize() {
   running_ = false;
+  {
+    std::unique_lock<std::mutex> lock(migrate_mutex_);
+    migrate_done_cv_.notify_all();
+  }
+  std::unique_lock<std::mutex> lock(update_mutex_);
   apply_grads_cv_.notify_one();
 }
 
 void ParameterServer::UpdateWeights() {
   while (true) {
-    MS_LOG(INFO) << "The running is:" << running_ << " the ready is:" << this->ReadyForUpdateWeights();
-    std::unique_lock<std::mutex> lock(mutex_);
-    apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
-    if (!running_) {
-      break;
+    Key key = kInvalidKey;
+    {
+      std::unique_lock<std::mutex> update_lock(update_mutex_);
+      apply_grads_cv_.wait(update_lock, [this] { return !keys_to_update_.empty() || !running_; });
+      if (!running_) {
+        break;
+      }
+      key = keys_to_update_.front();
+      keys_to_update_.pop_front();
     }
+    // Each key is updated once the gradients of all the workers are accumulated, without waiting for the other keys.
+    UpdateWeight(key);
+  }
+}
 
-    for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
-      Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
+void ParameterServer::UpdateWeight(const Key &key) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  if (weights_.count(key) == 0) {
+    MS_LOG(WARNING) << "The key " << key << " to update is not on this server.";
+    return;
+  }
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
 
-      std::shared_ptr<PServerKernel> optimizer = nullptr;
-      if (weight_key_to_optims_.count(key) > 0) {
-        optimizer = optimizers_[key];
-      }
-      MS_EXCEPTION_IF_NULL(optimizer);
-
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info != nullptr) {
-        const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-        const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-        const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
-
-        std::vector<std::vector<size_t>> shapes = {};
-        std::vector<size_t> indices_shape = {};
-        indices_shape.emplace_back(optim_info->indice_size());
-        shapes.push_back(indices_shape);
-
-        if (original_optim_inputs_shape_.count(key) != 0) {
-          std::transform(
-            (*(original_optim_inputs_shape_[key])).begin(), (*(original_optim_inputs_shape_[key])).end(),
-            std::back_inserter(shapes),
-            [](std::shared_ptr<std::vector<size_t>> input_shapes) -> std::vector<size_t> { return *input_shapes; });
-        }
-        optimizer->ReInit(shapes);
-        optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
-        optimizer->Execute(inputs, workspaces, outputs);
-        optim_info->Reset();
-      }
-      if (!is_embedding_[key]) {
-        tokens_[key] = worker_num_;
-      }
+  std::shared_ptr<PServerKernel> optimizer = nullptr;
+  auto optimizer_iter = optimizers_.find(key);
+  if (weight_key_to_optims_.count(key) > 0 && optimizer_iter != optimizers_.end()) {
+    optimizer = optimizer_iter->second;
+  }
+  MS_EXCEPTION_IF_NULL(optimizer);
+
+  auto optim_info_iter = optim_infos_.find(key);
+  std::shared_ptr<OptimizerInfo> optim_info =
+    optim_info_iter == optim_infos_.end() ? nullptr : optim_info_iter->second;
+  if (optim_info != nullptr) {
+    const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
+    const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
+    const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
+
+    std::vector<std::vector<size_t>> shapes = {};
+    std::vector<size_t> indices_shape = {};
+    indices_shape.emplace_back(optim_info->indice_size());
+    shapes.push_back(indices_shape);
+
+    auto original_shape_iter = original_optim_inputs_shape_.find(key);
+    if (original_shape_iter != original_optim_inputs_shape_.end()) {
+      std::transform(
+        original_shape_iter->second->begin(), original_shape_iter->second->end(), std::back_inserter(shapes),
+        [](std::shared_ptr<std::vector<size_t>> input_shapes) -> std::vector<size_t> { return *input_shapes; });
     }
-    ResetGradAccumCount();
+    optimizer->ReInit(shapes);
+    optim_info->ComputeMean(shapes, worker_num_, pserver_num_, shard_rank_id());
+    optimizer->Execute(inputs, workspaces, outputs);
+    optim_info->Reset();
+  }
+  grads_accum_counter_.at(key) = 0;
+  push_admissions_.at(key) = 0;
+  if (!is_embedding_.at(key)) {
+    tokens_.at(key) = worker_num_;
   }
 }
 
 void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
   const Key &key = keys[0];
-  bool no_sparse_grad = values.size() == 1 && values[0] == -100;
-  if (!no_sparse_grad) {
-    std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-
-    // Create or update the optimizer info
-    if (optim_info == nullptr) {
-      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-      if (pserver_kernel == nullptr) {
-        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+  auto counter_iter = grads_accum_counter_.find(key);
+  auto optim_info_iter = optim_infos_.find(key);
+  if (counter_iter == grads_accum_counter_.end() || optim_info_iter == optim_infos_.end()) {
+    MS_LOG(EXCEPTION) << "Invalid grad key " << key;
+  }
+  bool ready = false;
+  {
+    std::lock_guard<std::mutex> key_lock(key_mutex(key));
+    bool no_sparse_grad = values.size() == 1 && values[0] == -100;
+    if (!no_sparse_grad) {
+      std::shared_ptr<OptimizerInfo> &optim_info = optim_info_iter->second;
+
+      // Create or update the optimizer info
+      if (optim_info == nullptr) {
+        auto optim_name_iter = weight_key_to_optims_.find(key);
+        auto optimizer_iter = optimizers_.find(key);
+        if (optim_name_iter == weight_key_to_optims_.end() || optimizer_iter == optimizers_.end() ||
+            optimizer_iter->second == nullptr) {
+          MS_LOG(EXCEPTION) << "no optimizer found for key " << key;
+        }
+        auto builder_iter = optim_info_builders_.find(optim_name_iter->second);
+        if (builder_iter == optim_info_builders_.end()) {
+          MS_LOG(EXCEPTION) << "no optimizer info builder found for optim name " << optim_name_iter->second;
+        }
+        const std::shared_ptr<OptimizerInfoBuilder> &builder = builder_iter->second;
+        MS_EXCEPTION_IF_NULL(builder);
+        auto inputs_shape_iter = optim_inputs_shape_.find(key);
+        InputsShapePtr inputs_shape =
+          inputs_shape_iter == optim_inputs_shape_.end() ? nullptr : inputs_shape_iter->second;
+        OptimizerInfo *optim = builder->Build(optimizer_iter->second, weights_.at(key), keys, values, lengths,
+                                              inputs_shape, worker_num_, is_embedding_.at(key));
+        optim_info.reset(optim);
+        RestoreOptimStates(key, optim_info);
+      } else {
+        optim_info->Update(values, lengths);
+        optim_info->Accumulate(values, lengths);
       }
-      MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim = builder->Build(pserver_kernel, weights_[key], keys, values, lengths,
-                                            optim_inputs_shape_[key], worker_num_, is_embedding_[key]);
-      optim_info.reset(optim);
-      optim_infos_[key] = optim_info;
-    } else {
-      optim_info->Update(values, lengths);
-      optim_info->Accumulate(values, lengths);
     }
-  }
 
-  grads_accum_counter_[key] += 1;
-  if (grads_accum_counter_[key] == worker_num_) {
-    grad_accum_count_++;
+    counter_iter->second += 1;
+    ready = counter_iter->second == worker_num_;
   }
-  if (ReadyForUpdateWeights()) {
+  if (ready) {
+    std::unique_lock<std::mutex> update_lock(update_mutex_);
+    keys_to_update_.push_back(key);
     apply_grads_cv_.notify_one();
   }
 }
 
 WeightPtr ParameterServer::weight(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto iter = weights_.find(key);
+  if (iter == weights_.end()) {
     MS_LOG(EXCEPTION) << "Invalid weight key " << key;
   }
-  WeightPtr weight_ptr = weights_[key];
+  // The weight is not updated again before this worker pushes its next gradients, so it is returned without a copy.
+  WeightPtr weight_ptr = iter->second;
   MS_EXCEPTION_IF_NULL(weight_ptr);
-  WeightPtr copy_weight_ptr = std::make_shared<std::vector<float>>(weight_ptr->size(), 0);
-  MS_EXCEPTION_IF_NULL(copy_weight_ptr);
-  copy_weight_ptr = weight_ptr;
-  tokens_[key] -= 1;
-  return copy_weight_ptr;
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
+  tokens_.at(key) -= 1;
+  return weight_ptr;
 }
 
-void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res) {
-  std::unique_lock<std::mutex> lock(mutex_);
+void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, VectorPtr res) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
   MS_EXCEPTION_IF_NULL(res);
-  if (weights_.count(key) == 0) {
+  auto table_iter = weights_.find(key);
+  if (table_iter == weights_.end()) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
+  auto lookup_op_iter = embedding_lookup_ops_.find(key);
+  if (lookup_op_iter == embedding_lookup_ops_.end()) {
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
+  WeightPtr table_ptr = table_iter->second;
   MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  std::shared_ptr<PServerKernel> table_lookup_op = lookup_op_iter->second;
   MS_EXCEPTION_IF_NULL(table_lookup_op);
+  // The lookup operator of the key is reinitialized with the shapes of this request.
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
 
   // Update shapes of lookup operator
   std::vector<std::vector<size_t>> shapes = {};
@@ -347,67 +428,84 @@ void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KV
   indices->addr = tmp_ids.get();
   indices->size = lookup_ids.size() * sizeof(int);
 
+  // The lookup operator writes the embeddings straight into the values of the response payload.
+  size_t value_num = output_shapes[0] / sizeof(float);
+  size_t payload_size = KVPayload::Size(lookup_ids.size(), 1, value_num);
+  res->resize(payload_size);
+  KVPayload payload = KVPayload::Create(res->data(), payload_size, lookup_ids.size(), 1, value_num);
+  for (size_t i = 0; i < lookup_ids.size(); i++) {
+    payload.keys()[i] = lookup_ids[i];
+  }
+  payload.lens()[0] = SizeToInt(value_num);
+
   std::vector<kernel::AddressPtr> workspaces;
   std::vector<kernel::AddressPtr> outputs;
   AddressPtr output = std::make_shared<kernel::Address>();
   MS_EXCEPTION_IF_NULL(output);
-  std::shared_ptr<Values> addr = std::make_shared<Values>(output_shapes[0] / sizeof(float), 0);
-  MS_EXCEPTION_IF_NULL(addr);
-
-  output->addr = addr->data();
+  output->addr = payload.values();
   output->size = output_shapes[0];
   outputs.push_back(output);
 
   table_lookup_op->Execute(inputs, workspaces, outputs);
-  *res->mutable_values() = {addr->begin(), addr->end()};
-  res->add_len(res->values_size());
 }
 
 void ParameterServer::UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals) {
-  if (weights_.count(key) == 0) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto table_iter = weights_.find(key);
+  if (table_iter == weights_.end()) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
+  auto lookup_op_iter = embedding_lookup_ops_.find(key);
+  if (lookup_op_iter == embedding_lookup_ops_.end()) {
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
+  WeightPtr table_ptr = table_iter->second;
   MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  std::shared_ptr<PServerKernel> table_lookup_op = lookup_op_iter->second;
   MS_EXCEPTION_IF_NULL(table_lookup_op);
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
   table_lookup_op->UpdateEmbeddings(table_ptr->data(), lookup_ids.data(), vals.data(), lookup_ids.size());
 }
 
-inline bool ParameterServer::ReadyForUpdateWeights() {
-  return grads_accum_counter_.size() > 0 && grad_accum_count_ == grads_accum_counter_.size();
-}
-
 inline bool ParameterServer::ReadyForPush(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
   if (weights_.empty()) {
     MS_LOG(EXCEPTION) << "The weights in server is empty. Many reasons could cause this: 1.The Worker didn't send "
                          "kInitWeightsCmd command. 2.The Server failed to initialize weights.";
   }
-  MS_LOG(INFO) << "The grad_accum_count_:" << grad_accum_count_ << " the weights_:" << weights_.size()
-               << " the token:" << (tokens_[key] <= 0);
-  return grad_accum_count_ < weights_.size() && tokens_[key] <= 0;
+  auto iter = tokens_.find(key);
+  if (iter == tokens_.end()) {
+    MS_LOG(WARNING) << "The key " << key << " is not on this server.";
+    return false;
+  }
+  bool moving = false;
+  {
+    std::lock_guard<std::mutex> migrate_lock(migrate_mutex_);
+    moving = moving_keys_.count(key) > 0;
+  }
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
+  size_t &admissions = push_admissions_.at(key);
+  // No worker is admitted to a new step of a key being migrated, while the workers of the current step finish it.
+  bool ready = iter->second == 0 && !(moving && admissions == 0);
+  if (ready) {
+    admissions++;
+  }
+  MS_LOG(INFO) << "The token:" << iter->second << " the admissions:" << admissions << " the ready:" << ready;
+  return ready;
 }
 
 inline bool ParameterServer::ReadyForPull(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (tokens_.count(key) == 0 || weights_[key] == 0) {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto iter = tokens_.find(key);
+  auto weight_iter = weights_.find(key);
+  if (iter == tokens_.end() || weight_iter == weights_.end() || weight_iter->second == nullptr) {
     MS_LOG(EXCEPTION) << "Invalid weight key " << key;
   }
-  MS_LOG(INFO) << "ReadyForPull: " << (tokens_[key] > 0);
-  return tokens_[key] > 0;
-}
-
-inline void ParameterServer::ResetGradAccumCount() {
-  grad_accum_count_ = 0;
-  for (auto iter = grads_accum_counter_.begin(); iter != grads_accum_counter_.end(); iter++) {
-    grads_accum_counter_[iter->first] = 0;
-  }
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
+  MS_LOG(INFO) << "ReadyForPull: " << (iter->second > 0);
+  return iter->second > 0;
 }
 
 const CNodePtr ParameterServer::GetCNode(const std::string &name) const {
@@ -422,7 +520,9 @@ const CNodePtr ParameterServer::GetCNode(const std::string &name) const {
   return nullptr;
 }
 
-inline std::mutex &ParameterServer::mutex() { return mutex_; }
+inline std::shared_mutex &ParameterServer::mutex() { return mutex_; }
+
+inline std::mutex &ParameterServer::key_mutex(const Key &key) { return key_mutexes_[key % kKeyLockStripeNum]; }
 
 void ParameterServer::GetEmbeddingTableParamPtr() {
   MS_EXCEPTION_IF_NULL(func_graph_);
@@ -481,6 +581,382 @@ void ParameterServer::SyncEmbeddingTables() {
   }
 }
 
+uint32_t ParameterServer::shard_rank_id() {
+  // The rank is captured before the first scaling renumbers the servers, as the shards don't move with the rank.
+  uint32_t unset_rank_id = UINT32_MAX;
+  (void)shard_rank_id_.compare_exchange_strong(unset_rank_id, server_node_->rank_id());
+  return shard_rank_id_;
+}
+
+std::vector<Key> ParameterServer::DenseKeys() {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  std::vector<Key> keys;
+  for (const auto &key_embedding : is_embedding_) {
+    if (!key_embedding.second) {
+      keys.push_back(key_embedding.first);
+    }
+  }
+  return keys;
+}
+
+bool ParameterServer::HasEmbeddingTables() {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return std::any_of(is_embedding_.begin(), is_embedding_.end(),
+                     [](const auto &key_embedding) { return key_embedding.second; });
+}
+
+bool ParameterServer::MovedKey(const Key &key, std::string *owner) {
+  MS_EXCEPTION_IF_NULL(owner);
+  std::lock_guard<std::mutex> lock(migrate_mutex_);
+  auto iter = moved_keys_.find(key);
+  if (iter == moved_keys_.end()) {
+    return false;
+  }
+  *owner = iter->second;
+  return true;
+}
+
+bool ParameterServer::MigrateKeys(const std::map<Key, std::string> &targets) {
+  std::string address = server_node_->address();
+  std::map<Key, std::string> pending_targets;
+  {
+    std::lock_guard<std::mutex> lock(migrate_mutex_);
+    for (const auto &target : targets) {
+      if (target.second != address) {
+        moving_keys_[target.first] = target.second;
+        (void)pending_targets.insert(target);
+      }
+    }
+  }
+  MS_LOG(INFO) << "Start migrating " << pending_targets.size() << " keys.";
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(kMigrateKeysTimeoutInSeconds);
+  while (!pending_targets.empty() && running_ && std::chrono::steady_clock::now() < deadline) {
+    for (auto iter = pending_targets.begin(); iter != pending_targets.end();) {
+      if (MigrateKey(iter->first, iter->second)) {
+        std::lock_guard<std::mutex> lock(migrate_mutex_);
+        (void)moving_keys_.erase(iter->first);
+        iter = pending_targets.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+    if (!pending_targets.empty()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(kMigrateKeyIntervalInMs));
+    }
+  }
+  if (!pending_targets.empty()) {
+    MS_LOG(ERROR) << pending_targets.size() << " keys are not migrated and stay on this server, as "
+                  << (running_ ? "the migration timed out." : "the server stops.");
+    std::lock_guard<std::mutex> lock(migrate_mutex_);
+    for (const auto &target : pending_targets) {
+      (void)moving_keys_.erase(target.first);
+    }
+    return false;
+  }
+  return true;
+}
+
+bool ParameterServer::MigrateKey(const Key &key, const std::string &target) {
+  KeyStateMessage state;
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto weight_iter = weights_.find(key);
+    if (weight_iter == weights_.end() || is_embedding_.at(key)) {
+      MS_LOG(WARNING) << "The key " << key << " is not a dense key on this server, it's not migrated.";
+      return true;
+    }
+    MS_EXCEPTION_IF_NULL(weight_iter->second);
+    std::lock_guard<std::mutex> key_lock(key_mutex(key));
+    if (tokens_.at(key) > 0 || push_admissions_.at(key) > 0 || grads_accum_counter_.at(key) > 0) {
+      return false;
+    }
+
+    state.set_key(key);
+    auto optim_iter = weight_key_to_optims_.find(key);
+    state.set_optim_id(optim_iter == weight_key_to_optims_.end() ? kInvalidID : Util::optimizer_id(optim_iter->second));
+    auto shape_iter = original_optim_inputs_shape_.find(key);
+    if (shape_iter != original_optim_inputs_shape_.end()) {
+      for (const auto &shape : *shape_iter->second) {
+        MS_EXCEPTION_IF_NULL(shape);
+        state.add_input_shape_len(SizeToInt(shape->size()));
+        for (const auto &dim : *shape) {
+          state.add_input_shapes(dim);
+        }
+      }
+    }
+    *state.mutable_weight() = {weight_iter->second->begin(), weight_iter->second->end()};
+
+    auto optim_info_iter = optim_infos_.find(key);
+    auto states_iter = imported_optim_states_.find(key);
+    if (optim_info_iter != optim_infos_.end() && optim_info_iter->second != nullptr) {
+      const std::vector<kernel::AddressPtr> &inputs = optim_info_iter->second->inputs();
+      for (size_t i = 1; i <= optim_info_iter->second->state_num() && i < inputs.size(); i++) {
+        MS_EXCEPTION_IF_NULL(inputs[i]);
+        const float *state_data = reinterpret_cast<const float *>(inputs[i]->addr);
+        size_t state_len = inputs[i]->size / sizeof(float);
+        state.add_optim_state_len(SizeToInt(state_len));
+        for (size_t j = 0; j < state_len; j++) {
+          state.add_optim_states(state_data[j]);
+        }
+      }
+    } else if (states_iter != imported_optim_states_.end()) {
+      // The key has not been pushed since it was migrated here, so the states it brought are passed on.
+      for (const auto &optim_state : states_iter->second) {
+        state.add_optim_state_len(SizeToInt(optim_state.size()));
+        for (const auto &value : optim_state) {
+          state.add_optim_states(value);
+        }
+      }
+    }
+  }
+
+  {
+    std::shared_lock<std::shared_mutex> metadata_lock(server_node_->metadata_mutex());
+    uint32_t rank_id = UINT32_MAX;
+    for (const auto &server : server_node_->server_addresses()) {
+      if (server.second == target) {
+        rank_id = server.first;
+      }
+    }
+    if (rank_id == UINT32_MAX) {
+      MS_LOG(ERROR) << "The server " << target << " to migrate key " << key << " to is not in the cluster.";
+      return false;
+    }
+    std::string state_data = state.SerializeAsString();
+    std::shared_ptr<unsigned char[]> data(new unsigned char[state_data.length()]);
+    int ret = memcpy_s(data.get(), state_data.length(), state_data.data(), state_data.length());
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+    }
+    // The target server responds with the key after importing it. The key stays here until the import is confirmed,
+    // and it's sent again if the request or the response is lost, which the target server ignores if it has the key.
+    bool confirmed = false;
+    for (size_t i = 0; i < kMigrateKeySendRetryNum && running_ && !confirmed; i++) {
+      VectorPtr output = nullptr;
+      if (!server_node_->Send(core::NodeRole::SERVER, rank_id, data, state_data.length(), kMigrateKeyCmd, &output,
+                              core::kTimeoutInSeconds) ||
+          output == nullptr) {
+        continue;
+      }
+      KeyStateMessage confirmation;
+      confirmed = confirmation.ParseFromArray(output->data(), SizeToInt(output->size())) && confirmation.key() == key;
+    }
+    if (!confirmed) {
+      MS_LOG(ERROR) << "Migrating key " << key << " to server " << target << " failed, it stays on this server.";
+      return false;
+    }
+  }
+
+  // The workers asking for the key from now on are told its new server.
+  {
+    std::lock_guard<std::mutex> migrate_lock(migrate_mutex_);
+    moved_keys_[key] = target;
+  }
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  (void)weights_.erase(key);
+  (void)grads_.erase(key);
+  (void)grads_accum_counter_.erase(key);
+  (void)tokens_.erase(key);
+  (void)push_admissions_.erase(key);
+  (void)is_embedding_.erase(key);
+  (void)optim_infos_.erase(key);
+  (void)optimizers_.erase(key);
+  (void)optim_inputs_shape_.erase(key);
+  (void)original_optim_inputs_shape_.erase(key);
+  (void)weight_key_to_optims_.erase(key);
+  (void)weight_key_to_optim_op_.erase(key);
+  (void)imported_optim_states_.erase(key);
+  MS_LOG(INFO) << "The key " << key << " is migrated to server " << target;
+  return true;
+}
+
+void ParameterServer::ImportKey(const KeyStateMessage &state) {
+  const Key key = state.key();
+  MS_LOG(INFO) << "Importing the key " << key << " migrated from another server.";
+  // The key is sent again when the confirmation of its import is lost. It may have been trained here since, so the
+  // state sent again is ignored.
+  if (weights_.count(key) > 0 && !is_embedding_.at(key)) {
+    MS_LOG(INFO) << "The key " << key << " has been imported.";
+    return;
+  }
+  if (state.optim_id() != kInvalidID) {
+    InitWeightKeyToOptims(key, state.optim_id());
+  }
+  if (state.input_shape_len_size() > 0) {
+    Keys keys(IntToSize(state.input_shape_len_size()), key);
+    Values values(state.input_shapes().begin(), state.input_shapes().end());
+    Lengths lens(state.input_shape_len().begin(), state.input_shape_len().end());
+    InitOptimInputsShape(keys, values, lens);
+  }
+  WeightPtr weight_ptr = std::make_shared<Weight>(state.weight().begin(), state.weight().end());
+  InitWeight(key, weight_ptr);
+  GradPtr grad_ptr = std::make_shared<Grad>(weight_ptr->size(), 0);
+  InitGrad(key, grad_ptr);
+
+  std::vector<std::vector<float>> optim_states;
+  int pos = 0;
+  for (const auto &state_len : state.optim_state_len()) {
+    if (state_len < 0 || pos + state_len > state.optim_states_size()) {
+      MS_LOG(EXCEPTION) << "The optimizer states of key " << key << " are invalid.";
+    }
+    optim_states.emplace_back(state.optim_states().begin() + pos, state.optim_states().begin() + pos + state_len);
+    pos += state_len;
+  }
+  imported_optim_states_[key] = optim_states;
+
+  std::lock_guard<std::mutex> migrate_lock(migrate_mutex_);
+  (void)moved_keys_.erase(key);
+}
+
+void ParameterServer::RestoreOptimStates(const Key &key, const std::shared_ptr<OptimizerInfo> &optim_info) {
+  MS_EXCEPTION_IF_NULL(optim_info);
+  auto states_iter = imported_optim_states_.find(key);
+  if (states_iter == imported_optim_states_.end() || states_iter->second.empty()) {
+    return;
+  }
+  const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
+  std::vector<std::vector<float>> &optim_states = states_iter->second;
+  for (size_t i = 0; i < optim_states.size() && i < optim_info->state_num() && i + 1 < inputs.size(); i++) {
+    const kernel::AddressPtr &input = inputs[i + 1];
+    MS_EXCEPTION_IF_NULL(input);
+    size_t state_size = optim_states[i].size() * sizeof(float);
+    if (input->size != state_size) {
+      MS_LOG(WARNING) << "The size of the optimizer state " << i << " of key " << key << " is " << state_size
+                      << ", but the optimizer expects " << input->size;
+      continue;
+    }
+    if (state_size == 0) {
+      continue;
+    }
+    int ret = memcpy_s(input->addr, input->size, optim_states[i].data(), state_size);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+    }
+  }
+  // The entry is cleared instead of erased, as the requests of the training hold mutex_ shared.
+  optim_states.clear();
+}
+
+void ParameterServer::ScaleOut() {
+  std::vector<std::string> servers;
+  {
+    std::shared_lock<std::shared_mutex> metadata_lock(server_node_->metadata_mutex());
+    for (const auto &server : server_node_->server_addresses()) {
+      servers.push_back(server.second);
+    }
+  }
+  KeyShardMap shard_map;
+  shard_map.SetServers(servers);
+  std::string address = server_node_->address();
+  std::map<Key, std::string> targets;
+  for (const auto &key : DenseKeys()) {
+    std::string owner = shard_map.RingOwner(key);
+    if (owner != address) {
+      targets[key] = owner;
+    }
+  }
+  MS_LOG(WARNING) << "The cluster is scaled out to " << servers.size() << " servers, " << targets.size()
+                  << " keys of this server move to the new servers.";
+  // The keys not migrated stay on this server, where the workers keep finding them.
+  (void)MigrateKeys(targets);
+  server_node_->set_scale_out_done();
+}
+
+void ParameterServer::ScaleIn() {
+  std::vector<std::string> leaving_servers;
+  std::map<uint32_t, std::string> staying_servers;
+  {
+    std::shared_lock<std::shared_mutex> metadata_lock(server_node_->metadata_mutex());
+    leaving_servers = server_node_->scale_in_servers();
+    for (const auto &server : server_node_->server_addresses()) {
+      if (std::find(leaving_servers.begin(), leaving_servers.end(), server.second) == leaving_servers.end()) {
+        (void)staying_servers.insert(server);
+      }
+    }
+  }
+
+  std::string address = server_node_->address();
+  if (std::find(leaving_servers.begin(), leaving_servers.end(), address) != leaving_servers.end()) {
+    if (staying_servers.empty()) {
+      MS_LOG(ERROR) << "No server stays in the cluster, the keys of this server are dropped.";
+      server_node_->set_ready_for_scale_in();
+      return;
+    }
+    // The scheduler refuses to scale in the servers holding the shards of the embedding tables, as reported by their
+    // heartbeats. The shards initialized after the last heartbeat are checked here, before any key moves.
+    std::string failure;
+    if (HasEmbeddingTables()) {
+      failure = "The shards of the embedding tables on server " + address + " can't be migrated.";
+    } else {
+      std::vector<std::string> servers;
+      for (const auto &server : staying_servers) {
+        servers.push_back(server.second);
+      }
+      KeyShardMap shard_map;
+      shard_map.SetServers(servers);
+      std::map<Key, std::string> targets;
+      for (const auto &key : DenseKeys()) {
+        targets[key] = shard_map.RingOwner(key);
+      }
+      MS_LOG(WARNING) << "The server is scaled in, its " << targets.size() << " keys move to the staying servers.";
+      if (!MigrateKeys(targets)) {
+        failure = "The keys of server " + address + " are not all migrated.";
+      }
+    }
+    // The server failing to be scaled in keeps serving the keys not migrated, and the keys migrated are redirected to
+    // their new servers. It registers again with the scheduler like the staying servers, so the training goes on.
+    if (!failure.empty()) {
+      MS_LOG(ERROR) << failure << " The server stays in the cluster and the scale in fails.";
+      if (!server_node_->set_scale_in_failed(failure)) {
+        MS_LOG(ERROR) << "Telling the scheduler the scale in fails failed, the server leaves the cluster.";
+      }
+    }
+
+    // The staying servers register again with the scheduler only after the keys of the leaving servers have moved.
+    KVMessage done;
+    done.set_owner(address);
+    std::string done_data = done.SerializeAsString();
+    std::shared_lock<std::shared_mutex> metadata_lock(server_node_->metadata_mutex());
+    for (const auto &server : staying_servers) {
+      std::shared_ptr<unsigned char[]> data(new unsigned char[done_data.length()]);
+      int ret = memcpy_s(data.get(), done_data.length(), done_data.data(), done_data.length());
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+      }
+      if (!server_node_->Send(core::NodeRole::SERVER, server.first, data, done_data.length(), kMigrateDoneCmd)) {
+        MS_LOG(ERROR) << "Telling server " << server.second << " the keys have been migrated failed.";
+      }
+    }
+  } else if (!leaving_servers.empty()) {
+    std::unique_lock<std::mutex> lock(migrate_mutex_);
+    bool done = migrate_done_cv_.wait_for(lock, std::chrono::seconds(kScaleInMigrateTimeoutInSeconds), [&]() {
+      return !running_ || std::all_of(leaving_servers.begin(), leaving_servers.end(), [this](const auto &server) {
+               return migrate_done_servers_.count(server) > 0;
+             });
+    });
+    for (const auto &server : leaving_servers) {
+      (void)migrate_done_servers_.erase(server);
+    }
+    if (!running_) {
+      return;
+    }
+    // A leaving server tells the staying servers even if its keys are not all migrated, well before the timeout, so
+    // the leaving servers not heard from are gone. The staying servers keep training without their keys.
+    if (!done) {
+      MS_LOG(ERROR) << "Waiting for the leaving servers to migrate their keys timed out, the keys not migrated of "
+                    << "the leaving servers are lost.";
+    }
+  }
+  server_node_->set_ready_for_scale_in();
+}
+
+void ParameterServer::Retire() {
+  // The leaving server keeps telling the workers the new servers of its keys, until they have all got the new metadata.
+  std::this_thread::sleep_for(std::chrono::seconds(kScaleInRetireDelayInSeconds));
+  MS_LOG(WARNING) << "The server has been scaled in, it stops serving.";
+  Finalize();
+}
+
 void ParameterServer::ServerHandler::Init() {
   handlers_[kInitWeightsCmd] = &ServerHandler::HandleInitWeights;
   handlers_[kInitWeightToOptimIdCmd] = &ServerHandler::HandleInitWeightToOptimId;
@@ -493,6 +969,9 @@ void ParameterServer::ServerHandler::Init() {
   handlers_[kFinalizeCmd] = &ServerHandler::HandleFinalize;
   handlers_[kPushCmd] = &ServerHandler::HandlePushReq;
   handlers_[kPullCmd] = &ServerHandler::HandlePullReq;
+  handlers_[kMigrateKeyCmd] = &ServerHandler::HandleMigrateKey;
+  handlers_[kRebalanceKeysCmd] = &ServerHandler::HandleRebalanceKeys;
+  handlers_[kMigrateDoneCmd] = &ServerHandler::HandleMigrateDone;
   commands_[kInitWeightsCmd] = "kInitWeightsCmd";
   commands_[kInitWeightToOptimIdCmd] = "kInitWeightToOptimIdCmd";
   commands_[kInitOptimInputsShapeCmd] = "kInitOptimInputsShapeCmd";
@@ -504,22 +983,38 @@ void ParameterServer::ServerHandler::Init() {
   commands_[kFinalizeCmd] = "kFinalizeCmd";
   commands_[kPushCmd] = "kPushCmd";
   commands_[kPullCmd] = "kPullCmd";
+  commands_[kMigrateKeyCmd] = "kMigrateKeyCmd";
+  commands_[kRebalanceKeysCmd] = "kRebalanceKeysCmd";
+  commands_[kMigrateDoneCmd] = "kMigrateDoneCmd";
 }
 
 void ParameterServer::ServerHandler::operator()(std::shared_ptr<core::TcpConnection> conn,
                                                 std::shared_ptr<core::MessageMeta> meta, DataPtr data, size_t size) {
-  auto output = std::make_shared<std::vector<unsigned char>>();
   if (commands_.count(meta->user_cmd()) == 0) {
     MS_LOG(EXCEPTION) << "The command:" << meta->user_cmd() << " is not supported!";
   }
   MS_LOG(INFO) << "The command is:" << commands_[meta->user_cmd()];
 
-  auto &handler_ptr = handlers_[meta->user_cmd()];
+  // The requests are served by the threads of the executor, so the requests of different keys are not serialized on
+  // the thread of the tcp server. A worker waits for the response of each request, so its own requests keep in order.
+  MS_EXCEPTION_IF_NULL(ps_->executor_);
+  if (!ps_->executor_->Submit(&ServerHandler::HandleRequest, this, conn, meta, data, size)) {
+    MS_LOG(WARNING) << "Submitting the command:" << commands_[meta->user_cmd()] << " failed, run it in place.";
+    HandleRequest(conn, meta, data, size);
+  }
+}
+
+void ParameterServer::ServerHandler::HandleRequest(std::shared_ptr<core::TcpConnection> conn,
+                                                   std::shared_ptr<core::MessageMeta> meta, DataPtr data,
+                                                   size_t size) {
+  auto output = std::make_shared<std::vector<unsigned char>>();
+  const auto &handler_ptr = handlers_.at(meta->user_cmd());
   (this->*handler_ptr)(data, size, output);
   MS_LOG(DEBUG) << "The output size is:" << output->size();
 
   if (output->size() > 0) {
-    ps_->server_node_->Response(conn, meta, output->data(), output->size());
+    // The output is referenced by the send buffer of the connection until it is written, instead of being copied.
+    ps_->server_node_->Response(conn, meta, DataPtr(output, output->data()), output->size());
   } else {
     // If the size of the output is 0, then constructed an empty string, Because the Response function is a synchronous,
     // the res variable  will be automatically recycled after calling the Response function
@@ -534,35 +1029,40 @@ void ParameterServer::ServerHandler::operator()(std::shared_ptr<core::TcpConnect
 
 void ParameterServer::ServerHandler::HandlePushReq(DataPtr data, size_t size, VectorPtr res) {
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  input.ParseFromArray(data.get(), size);
-  Keys keys = {input.keys().begin(), input.keys().end()};
-  Values values = {input.values().begin(), input.values().end()};
-  Lengths lens = {input.len().begin(), input.len().end()};
+  KVPayload input = KVPayload::Parse(data.get(), size);
+  Keys keys(input.keys(), input.keys() + input.key_num());
+  Values values(input.values(), input.values() + input.value_num());
+  Lengths lens(input.lens(), input.lens() + input.len_num());
   MS_LOG(DEBUG) << "The keys:" << keys << " the values:" << values << " the len:" << lens;
   ps_->AccumGrad(keys, values, lens);
 }
 
 void ParameterServer::ServerHandler::HandlePullReq(DataPtr data, size_t size, VectorPtr res) {
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  input.ParseFromArray(data.get(), size);
-  KVMessage res_data;
-  *res_data.mutable_keys() = input.keys();
+  KVPayload input = KVPayload::Parse(data.get(), size);
+  if (input.key_num() == 0) {
+    MS_LOG(EXCEPTION) << "The pull request has no key.";
+  }
   Key key = input.keys()[0];
   auto weight = ps_->weight(key);
-  *res_data.mutable_values() = {weight->begin(), weight->end()};
-  res->resize(res_data.ByteSizeLong());
-  size_t dest_size = res_data.ByteSizeLong();
-  size_t src_size = res_data.ByteSizeLong();
-  int ret = memcpy_s(res->data(), dest_size, res_data.SerializeAsString().data(), src_size);
+  MS_EXCEPTION_IF_NULL(weight);
+  size_t payload_size = KVPayload::Size(1, 1, weight->size());
+  res->resize(payload_size);
+  KVPayload res_data = KVPayload::Create(res->data(), payload_size, 1, 1, weight->size());
+  res_data.keys()[0] = key;
+  res_data.lens()[0] = SizeToInt(weight->size());
+  if (weight->empty()) {
+    return;
+  }
+  size_t weight_size = weight->size() * sizeof(float);
+  int ret = memcpy_s(res_data.values(), weight_size, weight->data(), weight_size);
   if (ret != 0) {
     MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
   }
 }
 
 void ParameterServer::ServerHandler::HandleInitWeights(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
@@ -587,7 +1087,7 @@ void ParameterServer::ServerHandler::HandleInitWeights(DataPtr data, size_t size
 }
 
 void ParameterServer::ServerHandler::HandleInitWeightToOptimId(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
@@ -605,7 +1105,7 @@ void ParameterServer::ServerHandler::HandleInitWeightToOptimId(DataPtr data, siz
 }
 
 void ParameterServer::ServerHandler::HandleInitInputsShape(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
@@ -622,7 +1122,7 @@ void ParameterServer::ServerHandler::HandleInitInputsShape(DataPtr data, size_t
 }
 
 void ParameterServer::ServerHandler::HandleInitEmbeddings(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   EmbeddingTableMeta embedding_table_meta;
   embedding_table_meta.ParseFromArray(data.get(), size);
   const Key &key = embedding_table_meta.key();
@@ -662,11 +1162,14 @@ void ParameterServer::ServerHandler::HandleCheckReadyForPush(DataPtr data, size_
   KVMessage input;
   input.ParseFromArray(data.get(), size);
   const Key &key = input.keys()[0];
-  bool ready = ps_->ReadyForPush(key);
+  // A key which has moved is not ready on this server, and the worker is told its new server.
+  std::string owner;
+  bool ready = !ps_->MovedKey(key, &owner) && ps_->ReadyForPush(key);
   MS_LOG(INFO) << "The ready is:" << ready;
   KVMessage res_data;
   res_data.add_keys(key);
   res_data.add_values(ready);
+  res_data.set_owner(owner);
   res->resize(res_data.ByteSizeLong());
   size_t dest_size = res_data.ByteSizeLong();
   size_t src_size = res_data.ByteSizeLong();
@@ -681,10 +1184,13 @@ void ParameterServer::ServerHandler::HandleCheckReadyForPull(DataPtr data, size_
   KVMessage input;
   input.ParseFromArray(data.get(), size);
   const Key &key = input.keys()[0];
-  bool ready = ps_->ReadyForPull(key);
+  // A key which has moved is not ready on this server, and the worker is told its new server.
+  std::string owner;
+  bool ready = !ps_->MovedKey(key, &owner) && ps_->ReadyForPull(key);
   KVMessage res_data;
   res_data.add_keys(key);
   res_data.add_values(ready);
+  res_data.set_owner(owner);
   res->resize(res_data.ByteSizeLong());
   size_t dest_size = res_data.ByteSizeLong();
   size_t src_size = res_data.ByteSizeLong();
@@ -699,13 +1205,37 @@ void ParameterServer::ServerHandler::HandleEmbeddingLookup(DataPtr data, size_t
   EmbeddingTableLookup input;
   input.ParseFromArray(data.get(), size);
   const Key &key = input.key();
-
-  KVMessage res_data;
   std::vector<Key> keys = {input.keys().begin(), input.keys().end()};
-  *res_data.mutable_keys() = {input.keys().begin(), input.keys().end()};
+  ps_->DoEmbeddingLookup(key, keys, res);
+}
+
+void ParameterServer::ServerHandler::HandleUpdateEmbeddings(DataPtr data, size_t size, VectorPtr res) {
+  MS_EXCEPTION_IF_NULL(res);
+  KVMessage input;
+  input.ParseFromArray(data.get(), size);
+  const Key &key = input.keys()[0];
+  const LookupIds &lookup_ids = {input.keys().begin() + 1, input.keys().end()};
+  const Values &update_vals = {input.values().begin(), input.values().end()};
+  ps_->UpdateEmbeddings(key, lookup_ids, update_vals);
+}
 
-  ps_->DoEmbeddingLookup(key, keys, &res_data);
+void ParameterServer::ServerHandler::HandleFinalize(DataPtr data, size_t size, VectorPtr res) {
+  MS_EXCEPTION_IF_NULL(res);
+  ps_->Finalize();
+}
+
+void ParameterServer::ServerHandler::HandleMigrateKey(DataPtr data, size_t size, VectorPtr res) {
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
+  MS_EXCEPTION_IF_NULL(res);
+  KeyStateMessage input;
+  input.ParseFromArray(data.get(), size);
+  init_weight_to_optim_[input.key()] = true;
+  init_optim_info_[input.key()] = true;
+  ps_->ImportKey(input);
 
+  // The key is responded to confirm the import.
+  KeyStateMessage res_data;
+  res_data.set_key(input.key());
   res->resize(res_data.ByteSizeLong());
   size_t dest_size = res_data.ByteSizeLong();
   size_t src_size = res_data.ByteSizeLong();
@@ -715,20 +1245,31 @@ void ParameterServer::ServerHandler::HandleEmbeddingLookup(DataPtr data, size_t
   }
 }
 
-void ParameterServer::ServerHandler::HandleUpdateEmbeddings(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+void ParameterServer::ServerHandler::HandleRebalanceKeys(DataPtr data, size_t size, VectorPtr res) {
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
-  const Key &key = input.keys()[0];
-  const LookupIds &lookup_ids = {input.keys().begin() + 1, input.keys().end()};
-  const Values &update_vals = {input.values().begin(), input.values().end()};
-  ps_->UpdateEmbeddings(key, lookup_ids, update_vals);
+  std::map<Key, std::string> targets;
+  for (const auto &key : input.keys()) {
+    targets[key] = input.owner();
+  }
+  MS_LOG(INFO) << "Rebalancing " << targets.size() << " keys to server " << input.owner();
+  MS_EXCEPTION_IF_NULL(ps_->scale_executor_);
+  if (!ps_->scale_executor_->Submit(&ParameterServer::MigrateKeys, ps_, targets)) {
+    MS_LOG(WARNING) << "Submitting the migration of the rebalanced keys failed.";
+  }
 }
 
-void ParameterServer::ServerHandler::HandleFinalize(DataPtr data, size_t size, VectorPtr res) {
+void ParameterServer::ServerHandler::HandleMigrateDone(DataPtr data, size_t size, VectorPtr res) {
   MS_EXCEPTION_IF_NULL(res);
-  ps_->Finalize();
+  KVMessage input;
+  input.ParseFromArray(data.get(), size);
+  MS_LOG(INFO) << "The leaving server " << input.owner() << " has migrated its keys.";
+  {
+    std::lock_guard<std::mutex> lock(ps_->migrate_mutex_);
+    (void)ps_->migrate_done_servers_.insert(input.owner());
+  }
+  ps_->migrate_done_cv_.notify_all();
 }
 }  // namespace ps
 }  // namespace mindspore
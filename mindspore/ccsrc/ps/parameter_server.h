@@ -24,6 +24,9 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <array>
 #include <condition_variable>
 #include <thread>
 #include <cmath>
@@ -31,6 +34,8 @@
 #include <utility>
 #include <list>
 #include <map>
+#include <set>
+#include <deque>
 #include <functional>
 #include "ir/func_graph.h"
 #include "backend/session/session_basic.h"
@@ -53,13 +58,16 @@
 #include "ps/random_normal/random_normal.h"
 
 #include "ps/constants.h"
+#include "ps/kv_payload.h"
 #include "ps/util.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/key_shard_map.h"
 #include "utils/log_adapter.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/core/server_node.h"
 #include "ps/core/node.h"
+#include "ps/core/communicator/task_executor.h"
 
 namespace mindspore {
 namespace ps {
@@ -76,13 +84,16 @@ class ParameterServer {
   ParameterServer()
       : pserver_num_(0),
         worker_num_(0),
-        grad_accum_count_(0),
         handler_(nullptr),
         func_graph_(nullptr),
         sess_(nullptr),
         running_(true),
         thread_(nullptr),
-        server_node_(nullptr) {}
+        server_node_(nullptr),
+        executor_(nullptr),
+        scale_executor_(nullptr),
+        shard_rank_id_(UINT32_MAX),
+        is_scaled_in_(false) {}
   ~ParameterServer() = default;
   ParameterServer(const ParameterServer &) = delete;
   ParameterServer &operator=(const ParameterServer &) = delete;
@@ -105,6 +116,12 @@ class ParameterServer {
     void HandleEmbeddingLookup(DataPtr data, size_t size, VectorPtr res);
     void HandleUpdateEmbeddings(DataPtr data, size_t size, VectorPtr res);
     void HandleFinalize(DataPtr data, size_t size, VectorPtr res);
+    void HandleMigrateKey(DataPtr data, size_t size, VectorPtr res);
+    void HandleRebalanceKeys(DataPtr data, size_t size, VectorPtr res);
+    void HandleMigrateDone(DataPtr data, size_t size, VectorPtr res);
+    // Run the handler of the request and send its response, on a thread of the executor.
+    void HandleRequest(std::shared_ptr<core::TcpConnection> conn, std::shared_ptr<core::MessageMeta> meta,
+                       DataPtr data, size_t size);
 
    private:
     ParameterServer *ps_;
@@ -128,26 +145,44 @@ class ParameterServer {
   bool HasWeight(const Key &key);
   void Finalize();
   void UpdateWeights();
+  void UpdateWeight(const Key &key);
   void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
   WeightPtr weight(const Key &key);
-  void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res);
+  void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, VectorPtr res);
   void UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals);
-  bool ReadyForUpdateWeights();
   bool ReadyForPush(const Key &key);
   bool ReadyForPull(const Key &key);
-  void ResetGradAccumCount();
   const CNodePtr GetCNode(const std::string &name) const;
-  std::mutex &mutex();
+  std::shared_mutex &mutex();
+  std::mutex &key_mutex(const Key &key);
   void GetEmbeddingTableParamPtr();
   void SyncEmbeddingTables();
 
+  // The rank the embedding tables are sharded by, which stays the rank of the server before any scaling.
+  uint32_t shard_rank_id();
+  std::vector<Key> DenseKeys();
+  bool HasEmbeddingTables();
+  // Whether the key has moved to another server, which is returned in owner.
+  bool MovedKey(const Key &key, std::string *owner);
+  // Migrate the dense keys to their target servers, each at the boundary of its steps: all the workers have pulled
+  // the weight of the last step and none is admitted to push the next one. Returns false if some keys are not migrated
+  // in time or the server stops, and these keys stay on this server.
+  bool MigrateKeys(const std::map<Key, std::string> &targets);
+  // Returns false if the key is not at the boundary of its steps yet, or its target server doesn't confirm it.
+  bool MigrateKey(const Key &key, const std::string &target);
+  // The import of a key which is already on this server is ignored, so the key can be sent again.
+  void ImportKey(const KeyStateMessage &state);
+  void RestoreOptimStates(const Key &key, const std::shared_ptr<OptimizerInfo> &optim_info);
+  void ScaleOut();
+  void ScaleIn();
+  void Retire();
+
   size_t pserver_num_;
   size_t worker_num_;
-  size_t grad_accum_count_;
   std::unique_ptr<ServerHandler> handler_;
   FuncGraphPtr func_graph_;
   std::shared_ptr<session::SessionBasic> sess_;
-  bool running_;
+  std::atomic<bool> running_;
 
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> optimizers_;
   std::unordered_map<Key, InputsShapePtr> optim_inputs_shape_;
@@ -162,13 +197,36 @@ class ParameterServer {
   std::unordered_map<Key, size_t> grads_accum_counter_;
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
   std::unordered_map<Key, uint64_t> tokens_;
+  // Number of the workers admitted to push the gradients of the current step of the key.
+  std::unordered_map<Key, size_t> push_admissions_;
+  // The states of the optimizers of the keys migrated here, which are restored when their optimizer infos are built.
+  std::unordered_map<Key, std::vector<std::vector<float>>> imported_optim_states_;
 
-  std::mutex mutex_;
+  // The maps above are only inserted into with mutex_ held exclusively. The requests of the training hold it shared
+  // and lock the stripe of their key, so the requests of different keys run in parallel.
+  std::shared_mutex mutex_;
+  std::array<std::mutex, kKeyLockStripeNum> key_mutexes_;
+  std::mutex update_mutex_;
   std::condition_variable apply_grads_cv_;
+  // The keys whose gradients of all the workers are accumulated, which are updated one by one.
+  std::deque<Key> keys_to_update_;
+
+  // The keys being migrated and the keys which have moved to other servers, mapped to their new servers, and the
+  // leaving servers which have migrated all their keys in a scale in.
+  std::mutex migrate_mutex_;
+  std::condition_variable migrate_done_cv_;
+  std::unordered_map<Key, std::string> moving_keys_;
+  std::unordered_map<Key, std::string> moved_keys_;
+  std::set<std::string> migrate_done_servers_;
 
   std::unique_ptr<std::thread> thread_;
   std::shared_ptr<core::ServerNode> server_node_;
   std::map<Key, ParameterPtr> embedding_tables_;
+  std::unique_ptr<core::TaskExecutor> executor_;
+  // Runs the migrations and the scaling, so they don't block the requests of the training.
+  std::unique_ptr<core::TaskExecutor> scale_executor_;
+  std::atomic<uint32_t> shard_rank_id_;
+  std::atomic<bool> is_scaled_in_;
 
   friend class ServerHandler;
 };
@@ -15,9 +15,158 @@
  */
 
 #include "ps/ps_cache/embedding_hash_map.h"
+#include <algorithm>
 
 namespace mindspore {
 namespace ps {
+namespace {
+// The least frequent element is chosen among this many elements that may be swapped out.
+constexpr size_t kFrequencySampleNum = 8;
+// The frequencies of lfu are halved every time the accesses reach this many times the capacity.
+constexpr size_t kFrequencyDecayFactor = 10;
+constexpr uint32_t kMaxFrequency = UINT32_MAX;
+constexpr uint8_t kMaxSketchCounter = 15;
+constexpr size_t kSketchDepth = 4;
+constexpr size_t kSketchSampleFactor = 10;
+constexpr size_t kMinTableSize = 16;
+constexpr uint64_t kSketchSeeds[kSketchDepth] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+                                                 0xcbf29ce484222325ULL};
+
+size_t RoundUpPowerOfTwo(size_t size) {
+  size_t power = kMinTableSize;
+  while (power < size) {
+    power <<= 1;
+  }
+  return power;
+}
+}  // namespace
+
+CachePolicy CachePolicyFromName(const std::string &name) {
+  if (name == "step") {
+    return CachePolicy::kStep;
+  } else if (name == "clock") {
+    return CachePolicy::kClock;
+  } else if (name == "lfu") {
+    return CachePolicy::kLfu;
+  } else if (name == "tinylfu") {
+    return CachePolicy::kTinyLfu;
+  }
+  MS_LOG(EXCEPTION) << "The cache policy " << name << " is invalid, it should be one of step, clock, lfu and tinylfu.";
+}
+
+std::string CachePolicyName(CachePolicy policy) {
+  switch (policy) {
+    case CachePolicy::kClock:
+      return "clock";
+    case CachePolicy::kLfu:
+      return "lfu";
+    case CachePolicy::kTinyLfu:
+      return "tinylfu";
+    default:
+      return "step";
+  }
+}
+
+HashIdToIndexMap::HashIdToIndexMap(size_t capacity) {
+  slots_.resize(RoundUpPowerOfTwo(capacity * 2));
+  mask_ = slots_.size() - 1;
+}
+
+size_t HashIdToIndexMap::Home(int id) const {
+  // Fibonacci hashing spreads the consecutive ids of an embedding table over the slots.
+  constexpr uint64_t kGoldenRatio = 0x9e3779b97f4a7c15ULL;
+  return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(id)) * kGoldenRatio) >> 32) & mask_;
+}
+
+int HashIdToIndexMap::Find(int id) const {
+  for (size_t pos = Home(id);; pos = (pos + 1) & mask_) {
+    const auto &slot = slots_[pos];
+    if (slot.index_ == INVALID_INDEX_VALUE) {
+      return INVALID_INDEX_VALUE;
+    }
+    if (slot.id_ == id) {
+      return slot.index_;
+    }
+  }
+}
+
+void HashIdToIndexMap::Insert(int id, int index) {
+  if (size_ >= mask_) {
+    MS_LOG(EXCEPTION) << "The id to index map of " << slots_.size() << " slots is full.";
+  }
+  for (size_t pos = Home(id);; pos = (pos + 1) & mask_) {
+    auto &slot = slots_[pos];
+    if (slot.index_ == INVALID_INDEX_VALUE) {
+      slot.id_ = id;
+      slot.index_ = index;
+      size_++;
+      return;
+    }
+    if (slot.id_ == id) {
+      slot.index_ = index;
+      return;
+    }
+  }
+}
+
+void HashIdToIndexMap::Erase(int id) {
+  size_t hole = Home(id);
+  while (slots_[hole].id_ != id) {
+    if (slots_[hole].index_ == INVALID_INDEX_VALUE) {
+      return;
+    }
+    hole = (hole + 1) & mask_;
+  }
+  if (slots_[hole].index_ == INVALID_INDEX_VALUE) {
+    return;
+  }
+  // Move back each following entry of the probe sequence whose home is not between the hole and itself.
+  for (size_t pos = (hole + 1) & mask_; slots_[pos].index_ != INVALID_INDEX_VALUE; pos = (pos + 1) & mask_) {
+    size_t home = Home(slots_[pos].id_);
+    if (((pos - home) & mask_) >= ((pos - hole) & mask_)) {
+      slots_[hole] = slots_[pos];
+      hole = pos;
+    }
+  }
+  slots_[hole].index_ = INVALID_INDEX_VALUE;
+  size_--;
+}
+
+FrequencySketch::FrequencySketch(size_t capacity) {
+  size_t width = RoundUpPowerOfTwo(capacity);
+  counters_.resize(width * kSketchDepth, 0);
+  width_mask_ = width - 1;
+  sample_size_ = width * kSketchSampleFactor;
+}
+
+size_t FrequencySketch::Index(int id, size_t row) const {
+  uint64_t hash = (static_cast<uint64_t>(static_cast<uint32_t>(id)) + 1) * kSketchSeeds[row];
+  return row * (width_mask_ + 1) + (static_cast<size_t>(hash >> 32) & width_mask_);
+}
+
+void FrequencySketch::Increment(int id) {
+  for (size_t row = 0; row < kSketchDepth; ++row) {
+    auto &counter = counters_[Index(id, row)];
+    if (counter < kMaxSketchCounter) {
+      counter++;
+    }
+  }
+  if (++additions_ >= sample_size_) {
+    for (auto &counter : counters_) {
+      counter >>= 1;
+    }
+    additions_ /= 2;
+  }
+}
+
+uint32_t FrequencySketch::Estimate(int id) const {
+  uint32_t estimate = kMaxSketchCounter;
+  for (size_t row = 0; row < kSketchDepth; ++row) {
+    estimate = std::min(estimate, static_cast<uint32_t>(counters_[Index(id, row)]));
+  }
+  return estimate;
+}
+
 int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *const swap_out_ids,
                                 const size_t data_step, const size_t graph_running_step, size_t *const swap_out_size,
                                 bool *const need_wait_graph) {
@@ -32,47 +181,102 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
 
   if (!need_swap) {
     hash_count_++;
-    (void)hash_id_to_index_.emplace(id, hash_index);
-    hash_map_elements_[hash_index].set_id(id);
-    hash_map_elements_[hash_index].set_step(data_step);
-    return hash_index;
+  } else {
+    swap_out_index[*swap_out_size] = hash_index;
+    swap_out_ids[*swap_out_size] = hash_map_elements_[hash_index].id_;
+    (*swap_out_size)++;
+    hash_id_to_index_.Erase(hash_map_elements_[hash_index].id_);
   }
-
-  swap_out_index[*swap_out_size] = hash_index;
-  swap_out_ids[*swap_out_size] = hash_map_elements_[hash_index].id_;
-  (*swap_out_size)++;
-  (void)hash_id_to_index_.erase(hash_map_elements_[hash_index].id_);
-  (void)hash_id_to_index_.emplace(id, hash_index);
-  hash_map_elements_[hash_index].set_id(id);
-  hash_map_elements_[hash_index].set_step(data_step);
+  hash_id_to_index_.Insert(id, hash_index);
+  auto &element = hash_map_elements_[hash_index];
+  element.set_id(id);
+  element.set_step(data_step);
+  element.frequency_ = 0;
+  element.referenced_ = false;
+  RecordAccess(id, hash_index);
   return hash_index;
 }
 
+void EmbeddingHashMap::RecordAccess(const int id, const int hash_index) {
+  auto &element = hash_map_elements_[hash_index];
+  switch (policy_) {
+    case CachePolicy::kClock:
+      element.referenced_ = true;
+      break;
+    case CachePolicy::kLfu:
+      if (element.frequency_ < kMaxFrequency) {
+        element.frequency_++;
+      }
+      if (++access_num_ >= kFrequencyDecayFactor * hash_capacity_) {
+        for (auto &item : hash_map_elements_) {
+          item.frequency_ >>= 1;
+        }
+        access_num_ = 0;
+      }
+      break;
+    case CachePolicy::kTinyLfu:
+      MS_EXCEPTION_IF_NULL(sketch_);
+      sketch_->Increment(id);
+      break;
+    default:
+      break;
+  }
+}
+
+uint32_t EmbeddingHashMap::Frequency(const HashMapElement &element) const {
+  if (policy_ == CachePolicy::kTinyLfu) {
+    return sketch_->Estimate(element.id_);
+  }
+  return element.frequency_;
+}
+
 int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_step, bool *const need_swap,
                                        bool *const need_wait_graph) {
   MS_EXCEPTION_IF_NULL(need_swap);
   MS_EXCEPTION_IF_NULL(need_wait_graph);
-  int hash_index = INVALID_INDEX_VALUE;
+  bool sample_frequency = policy_ == CachePolicy::kLfu || policy_ == CachePolicy::kTinyLfu;
+  // The elements skipped by clock or by the sampling of lfu are reconsidered in a second round of the scan.
+  size_t max_scanned_num = policy_ == CachePolicy::kStep ? hash_capacity_ : 2 * hash_capacity_;
+  int victim = INVALID_INDEX_VALUE;
+  size_t sampled_num = 0;
+  size_t scanned_num = 0;
   while (!expired_element_full_) {
-    if (hash_map_elements_[current_pos_].IsEmpty()) {
-      hash_index = current_pos_;
+    size_t pos = current_pos_;
+    auto &element = hash_map_elements_[pos];
+    current_pos_ = (current_pos_ + 1) % hash_capacity_;
+    scanned_num++;
+    scanned_num_++;
+    if (element.IsEmpty()) {
       hash_count_++;
-    } else if (hash_map_elements_[current_pos_].IsExpired(graph_running_step)) {
-      hash_index = current_pos_;
-      *need_swap = true;
-    } else if (hash_map_elements_[current_pos_].IsStep(graph_running_step)) {
-      graph_running_index_[graph_running_index_num_++] = current_pos_;
+      return SizeToInt(pos);
     }
-    current_pos_ = (current_pos_ + 1) % hash_capacity_;
-    if (hash_index != INVALID_INDEX_VALUE) {
-      return hash_index;
+    if (element.IsExpired(graph_running_step)) {
+      if (policy_ == CachePolicy::kClock && element.referenced_) {
+        element.referenced_ = false;
+      } else {
+        sampled_num++;
+        if (victim == INVALID_INDEX_VALUE || Frequency(element) < Frequency(hash_map_elements_[victim])) {
+          victim = SizeToInt(pos);
+        }
+      }
+    } else if (element.IsStep(graph_running_step) && scanned_num_ <= hash_capacity_) {
+      graph_running_index_[graph_running_index_num_++] = pos;
+    }
+    if (victim != INVALID_INDEX_VALUE &&
+        (!sample_frequency || sampled_num >= kFrequencySampleNum || scanned_num >= hash_capacity_)) {
+      break;
     }
-    if (current_pos_ == current_batch_start_pos_) {
+    // A whole scan without a victim means no element is left to swap out in this step.
+    if (scanned_num >= max_scanned_num) {
       expired_element_full_ = true;
       MS_LOG(INFO) << "Running step:" << graph_running_step << "(num:" << graph_running_index_num_
                    << ") will be used, index swap will wait until the graph completed.";
     }
   }
+  if (victim != INVALID_INDEX_VALUE) {
+    *need_swap = true;
+    return victim;
+  }
 
   if (graph_running_index_pos_ != graph_running_index_num_) {
     *need_swap = true;
@@ -83,23 +287,22 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
 }
 
 void EmbeddingHashMap::DumpHashMap() {
-  MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_ << " hash_count: " << hash_count_;
+  MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_ << " hash_count: " << hash_count_
+               << " policy: " << CachePolicyName(policy_);
   MS_LOG(INFO) << "Dump hash_id_to_index: ";
-  for (auto iter = hash_id_to_index_.begin(); iter != hash_id_to_index_.end(); ++iter) {
-    MS_LOG(INFO) << "  id: " << iter->first << " index: " << iter->second;
-  }
+  hash_id_to_index_.ForEach([](int id, int index) { MS_LOG(INFO) << "  id: " << id << " index: " << index; });
   MS_LOG(INFO) << "Dump hash_map_unit: ";
   for (size_t i = 0; i < hash_map_elements_.size(); i++) {
     if (!hash_map_elements_[i].IsEmpty()) {
       MS_LOG(INFO) << "  index: " << i << " id: " << hash_map_elements_[i].id_
-                   << " step: " << hash_map_elements_[i].step_;
+                   << " step: " << hash_map_elements_[i].step_ << " frequency: " << Frequency(hash_map_elements_[i]);
     }
   }
   MS_LOG(INFO) << "Dump hash map info end.";
 }
 
 void EmbeddingHashMap::Reset() {
-  current_batch_start_pos_ = current_pos_;
+  scanned_num_ = 0;
   graph_running_index_num_ = 0;
   graph_running_index_pos_ = 0;
   expired_element_full_ = false;
@@ -18,10 +18,11 @@
 #define MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_HASH_MAP_H_
 
 #include <math.h>
+#include <cstdint>
+#include <string>
 #include <utility>
 #include <memory>
 #include <vector>
-#include <unordered_map>
 #include "utils/convert_utils_base.h"
 
 namespace mindspore {
@@ -29,9 +30,22 @@ namespace ps {
 static const size_t INVALID_STEP_VALUE = 0;
 static const int INVALID_INDEX_VALUE = -1;
 
+// Replacement policy of the hash map, which chooses the element to swap out among the ones the graph no longer uses.
+//  step   : the first one found by the scan position, regardless of how often it is used.
+//  clock  : as step, but an element accessed since the scan last passed it gets a second chance.
+//  lfu    : the least frequently accessed one among a few sampled, the frequencies are halved periodically.
+//  tinylfu: as lfu, but the frequencies are estimated by a sketch over all the ids seen, so an id keeps its history
+//           while it is out of the cache, and an id seen once enters colder than the resident hot ones.
+enum class CachePolicy { kStep, kClock, kLfu, kTinyLfu };
+
+CachePolicy CachePolicyFromName(const std::string &name);
+std::string CachePolicyName(CachePolicy policy);
+
 struct HashMapElement {
   int id_{INVALID_INDEX_VALUE};
   size_t step_{INVALID_STEP_VALUE};
+  uint32_t frequency_{0};
+  bool referenced_{false};
   bool IsEmpty() const { return step_ == INVALID_STEP_VALUE; }
   bool IsExpired(size_t graph_running_step) const { return graph_running_step > step_; }
   bool IsStep(size_t step) const { return step_ == step; }
@@ -39,16 +53,72 @@ struct HashMapElement {
   void set_step(size_t step) { step_ = step; }
 };
 
+// Open addressing map from the ids to the indexes of the hash map. It has at least twice the slots of the hash map
+// so the probes stay short, and an erase shifts the following entries back instead of leaving a tombstone.
+class HashIdToIndexMap {
+ public:
+  explicit HashIdToIndexMap(size_t capacity);
+  ~HashIdToIndexMap() = default;
+
+  // Return INVALID_INDEX_VALUE if the id is not in the map.
+  int Find(int id) const;
+  void Insert(int id, int index);
+  void Erase(int id);
+  size_t size() const { return size_; }
+
+  template <typename Func>
+  void ForEach(Func &&func) const {
+    for (const auto &slot : slots_) {
+      if (slot.index_ != INVALID_INDEX_VALUE) {
+        func(slot.id_, slot.index_);
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    int id_{0};
+    int index_{INVALID_INDEX_VALUE};
+  };
+  size_t Home(int id) const;
+
+  std::vector<Slot> slots_;
+  size_t mask_;
+  size_t size_{0};
+};
+
+// Count-min sketch of the access frequencies of the ids. The counters saturate at 15 and are halved every time the
+// accesses reach ten times the width, so the old accesses fade.
+class FrequencySketch {
+ public:
+  explicit FrequencySketch(size_t capacity);
+  ~FrequencySketch() = default;
+
+  void Increment(int id);
+  uint32_t Estimate(int id) const;
+
+ private:
+  size_t Index(int id, size_t row) const;
+
+  std::vector<uint8_t> counters_;
+  size_t width_mask_;
+  size_t additions_{0};
+  size_t sample_size_;
+};
+
 // Hash table is held in device, HashMap is used to manage hash table in host.
 class EmbeddingHashMap {
  public:
-  EmbeddingHashMap(size_t hash_count, size_t hash_capacity)
+  EmbeddingHashMap(size_t hash_count, size_t hash_capacity, CachePolicy policy = CachePolicy::kStep)
       : hash_count_(hash_count),
         hash_capacity_(hash_capacity),
+        policy_(policy),
+        hash_id_to_index_(hash_capacity),
         current_pos_(0),
-        current_batch_start_pos_(0),
         graph_running_index_num_(0),
         graph_running_index_pos_(0),
+        scanned_num_(0),
+        access_num_(0),
         expired_element_full_(false) {
     hash_map_elements_.resize(hash_capacity);
     // In multi-device mode, embedding table are distributed on different devices by ID interval,
@@ -57,29 +127,39 @@ class EmbeddingHashMap {
     hash_map_elements_.front().set_step(SIZE_MAX);
     hash_map_elements_.back().set_step(SIZE_MAX);
     graph_running_index_ = std::make_unique<int[]>(hash_capacity);
+    if (policy_ == CachePolicy::kTinyLfu) {
+      sketch_ = std::make_unique<FrequencySketch>(hash_capacity);
+    }
   }
   virtual ~EmbeddingHashMap() = default;
   int ParseData(const int id, int *const swap_out_index, int *const swap_out_ids, const size_t data_step,
                 const size_t graph_running_step, size_t *const swap_out_size, bool *const need_wait_graph);
+  // Count an access of the id, which is in the map at hash_index, for the replacement policy.
+  void RecordAccess(const int id, const int hash_index);
   size_t hash_step(const int hash_index) const { return hash_map_elements_[hash_index].step_; }
   void set_hash_step(const int hash_index, const size_t step) { hash_map_elements_[hash_index].set_step(step); }
-  const std::unordered_map<int, int> &hash_id_to_index() const { return hash_id_to_index_; }
+  const HashIdToIndexMap &hash_id_to_index() const { return hash_id_to_index_; }
   size_t hash_capacity() const { return hash_capacity_; }
+  CachePolicy policy() const { return policy_; }
   void DumpHashMap();
   void Reset();
 
  private:
   int FindInsertionPos(const size_t data_step, const size_t graph_running_step, bool *const need_swap,
                        bool *const need_wait_graph);
+  uint32_t Frequency(const HashMapElement &element) const;
   size_t hash_count_;
   size_t hash_capacity_;
+  CachePolicy policy_;
   std::vector<HashMapElement> hash_map_elements_;
-  std::unordered_map<int, int> hash_id_to_index_;
+  HashIdToIndexMap hash_id_to_index_;
+  std::unique_ptr<FrequencySketch> sketch_;
   size_t current_pos_;
-  size_t current_batch_start_pos_;
   size_t graph_running_index_num_;
   size_t graph_running_index_pos_;
   std::unique_ptr<int[]> graph_running_index_;
+  size_t scanned_num_;
+  size_t access_num_;
   bool expired_element_full_;
 };
 }  // namespace ps
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/ps_cache/pending_push_queue.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+void PendingPushQueue::Start(const PushFunc &push_func) {
+  MS_EXCEPTION_IF_NULL(push_func);
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (running_ || push_thread_.joinable()) {
+    MS_LOG(EXCEPTION) << "The pending push queue has been started.";
+  }
+  push_func_ = push_func;
+  running_ = true;
+  failed_ = false;
+  push_thread_ = std::thread(&PendingPushQueue::PushTask, this);
+}
+
+void PendingPushQueue::Stop() {
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    running_ = false;
+  }
+  cond_.notify_all();
+  if (push_thread_.joinable()) {
+    push_thread_.join();
+  }
+}
+
+bool PendingPushQueue::Add(const std::shared_ptr<PendingPush> &push) {
+  MS_EXCEPTION_IF_NULL(push);
+  std::unique_lock<std::mutex> locker(mutex_);
+  cond_.wait(locker, [this] { return pushes_.size() < max_push_num_ || !running_; });
+  if (!running_) {
+    return false;
+  }
+  pushes_.push_back(push);
+  locker.unlock();
+  cond_.notify_all();
+  return true;
+}
+
+bool PendingPushQueue::WaitEmpty() {
+  std::unique_lock<std::mutex> locker(mutex_);
+  cond_.wait(locker, [this] { return pushes_.empty() || failed_; });
+  return pushes_.empty();
+}
+
+void PendingPushQueue::LookUp(size_t key, const int *ids, size_t id_num, size_t embedding_size, float *output,
+                              std::vector<int> *missing_ids, std::vector<size_t> *missing_positions) {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(output);
+  MS_EXCEPTION_IF_NULL(missing_ids);
+  MS_EXCEPTION_IF_NULL(missing_positions);
+  std::lock_guard<std::mutex> locker(mutex_);
+  for (size_t i = 0; i < id_num; ++i) {
+    int id = ids[i];
+    auto iter = std::find_if(pushes_.rbegin(), pushes_.rend(), [key, id](const std::shared_ptr<PendingPush> &push) {
+      return push->key == key && push->id_to_row.count(id) > 0;
+    });
+    if (iter == pushes_.rend()) {
+      missing_ids->push_back(id);
+      missing_positions->push_back(i);
+      continue;
+    }
+    auto src = (*iter)->values.begin() + (*iter)->id_to_row.at(id) * embedding_size;
+    (void)std::copy(src, src + embedding_size, output + i * embedding_size);
+  }
+}
+
+void PendingPushQueue::RemovePendingIds(size_t key, std::vector<int> *ids) {
+  MS_EXCEPTION_IF_NULL(ids);
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto end = std::remove_if(ids->begin(), ids->end(), [this, key](int id) {
+    return std::any_of(pushes_.begin(), pushes_.end(), [key, id](const std::shared_ptr<PendingPush> &push) {
+      return push->key == key && push->id_to_row.count(id) > 0;
+    });
+  });
+  (void)ids->erase(end, ids->end());
+}
+
+bool PendingPushQueue::running() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  return running_;
+}
+
+size_t PendingPushQueue::size() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  return pushes_.size();
+}
+
+void PendingPushQueue::PushTask() {
+  while (true) {
+    std::shared_ptr<PendingPush> push;
+    {
+      std::unique_lock<std::mutex> locker(mutex_);
+      cond_.wait(locker, [this] { return !pushes_.empty() || !running_; });
+      if (pushes_.empty()) {
+        return;
+      }
+      push = pushes_.front();
+    }
+    // The push is only removed once the server has the rows, so they are looked up in it meanwhile.
+    bool success = false;
+    for (size_t i = 0; i <= retry_num_ && !success; ++i) {
+      if (i > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(retry_interval_in_ms_));
+      }
+      try {
+        success = push_func_(*push);
+      } catch (const std::exception &e) {
+        MS_LOG(ERROR) << "Pushing the rows of key " << push->key << " to the server failed: " << e.what();
+      }
+    }
+    std::unique_lock<std::mutex> locker(mutex_);
+    if (!success) {
+      MS_LOG(ERROR) << "Pushing the rows of key " << push->key << " to the server failed after " << retry_num_
+                    << " retries, the pushes stop and " << pushes_.size() << " pushes are kept.";
+      running_ = false;
+      failed_ = true;
+      locker.unlock();
+      cond_.notify_all();
+      return;
+    }
+    pushes_.pop_front();
+    locker.unlock();
+    cond_.notify_all();
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_PS_CACHE_PENDING_PUSH_QUEUE_H_
+#define MINDSPORE_CCSRC_PS_PS_CACHE_PENDING_PUSH_QUEUE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// The data processing waits for the pushes to the server once this many of them are in flight.
+constexpr size_t kMaxPendingPushNum = 16;
+// A push failed is tried again this many times before the pushes stop.
+constexpr size_t kPushRetryNum = 3;
+constexpr int64_t kPushRetryIntervalInMs = 100;
+
+// The rows of a table swapped out of the host cache in one step, which are pushed to the server in the background.
+// Until the push completes, a row swapped in again is taken from here instead of the server.
+struct PendingPush {
+  size_t key{0};
+  std::vector<int> ids;
+  std::vector<float> values;
+  std::unordered_map<int, size_t> id_to_row;
+};
+
+// The pushes are sent in order by a thread of the queue, and a push stays in the queue until the server has its rows.
+// When a push still fails after the retries, it's kept and the queue stops, so the rows are not lost silently.
+class PendingPushQueue {
+ public:
+  // Send the rows of the push to the server, returns false if failed.
+  using PushFunc = std::function<bool(const PendingPush &push)>;
+
+  explicit PendingPushQueue(size_t max_push_num = kMaxPendingPushNum, size_t retry_num = kPushRetryNum,
+                            int64_t retry_interval_in_ms = kPushRetryIntervalInMs)
+      : max_push_num_(max_push_num), retry_num_(retry_num), retry_interval_in_ms_(retry_interval_in_ms) {}
+  ~PendingPushQueue() { Stop(); }
+
+  void Start(const PushFunc &push_func);
+  // The pushes added before are sent before the thread exits, unless one of them fails.
+  void Stop();
+
+  // Blocks while the queue is full. Returns false if the queue is stopped, by Stop or by a push failed.
+  bool Add(const std::shared_ptr<PendingPush> &push);
+  // Wait for all the pushes added to complete. Returns false if a push has failed and the pushes are left.
+  bool WaitEmpty();
+
+  // Copy the rows of the ids which are in the pushes of the key to the output, the last push has the newest rows. The
+  // ids not found and their positions are returned to be looked up in the server.
+  void LookUp(size_t key, const int *ids, size_t id_num, size_t embedding_size, float *output,
+              std::vector<int> *missing_ids, std::vector<size_t> *missing_positions);
+  // Remove the ids which are in the pushes of the key, the server doesn't have their newest rows yet.
+  void RemovePendingIds(size_t key, std::vector<int> *ids);
+
+  bool running();
+  size_t size();
+
+ private:
+  void PushTask();
+
+  size_t max_push_num_;
+  size_t retry_num_;
+  int64_t retry_interval_in_ms_;
+  PushFunc push_func_;
+  std::thread push_thread_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<std::shared_ptr<PendingPush>> pushes_;
+  bool running_{false};
+  // A push has failed after the retries, and the thread has exited.
+  bool failed_{false};
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_PS_CACHE_PENDING_PUSH_QUEUE_H_
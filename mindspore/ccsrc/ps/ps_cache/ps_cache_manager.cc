@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include "ps/ps_cache/ps_cache_manager.h"
+#include "backend/kernel_compiler/cpu/embedding_rows.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_utils.h"
 
@@ -147,8 +148,10 @@ void PsCacheManager::Initialize() {
   if (!Worker::GetInstance().running()) {
     Worker::GetInstance().Run();
   }
-  embedding_device_cache_ = std::make_shared<EmbeddingDeviceCache>(batch_elements_, vocab_cache_size_);
-  embedding_host_cache_ = std::make_shared<EmbeddingHostCache>(batch_elements_, host_vocab_cache_size_);
+  MS_LOG(INFO) << "PS cache replacement policy: " << CachePolicyName(cache_policy_);
+  embedding_device_cache_ = std::make_shared<EmbeddingDeviceCache>(batch_elements_, vocab_cache_size_, cache_policy_);
+  embedding_host_cache_ =
+    std::make_shared<EmbeddingHostCache>(batch_elements_, host_vocab_cache_size_, cache_policy_);
   AddEmbeddingTable();
   AllocMemForHashTable();
   SetLocalIdRank();
@@ -324,6 +327,24 @@ void PsCacheManager::ProcessDataTask(uint32_t device_id, const void *context) {
   embedding_device_cache_->cache_->InitDevice(device_id, context);
   InitParameterServer();
   InitDataChannel();
+  push_queue_.Start([](const PendingPush &push) {
+    return Worker::GetInstance().UpdateEmbeddingTable({push.key}, push.ids, push.values);
+  });
+  std::vector<size_t> keys;
+  std::unordered_map<size_t, size_t> embedding_sizes;
+  for (const auto &item : hash_tables_) {
+    auto key = Worker::GetInstance().GetParamKey(item.first);
+    keys.push_back(key);
+    embedding_sizes[key] = item.second.embedding_size;
+  }
+  prefetcher_.Start(
+    keys,
+    [embedding_sizes](size_t key, const std::vector<int> &ids, std::vector<float> *values) {
+      values->resize(ids.size() * embedding_sizes.at(key), 0);
+      Worker::GetInstance().DoPSEmbeddingLookup(key, ids, values, mindspore::ps::kEmbeddingLookupCmd);
+      return true;
+    },
+    [this](size_t key, std::vector<int> *ids) { push_queue_.RemovePendingIds(key, ids); });
   while (running_) {
     if (!ProcessData()) {
       running_ = false;
@@ -343,6 +364,8 @@ void PsCacheManager::Finalize() {
   if (process_data_thread_.joinable()) {
     process_data_thread_.join();
   }
+  prefetcher_.Stop();
+  push_queue_.Stop();
 }
 
 bool PsCacheManager::ProcessData() {
@@ -380,14 +403,7 @@ bool PsCacheManager::ProcessData() {
     MS_LOG(ERROR) << "Ps cache wait graph finish failed.";
     return false;
   }
-  for (const auto &item : hash_tables_) {
-    auto key = Worker::GetInstance().GetParamKey(item.first);
-    auto hash_info = item.second;
-    RETURN_IF_FALSE(HashSwapHostToServer(key, hash_info));
-    RETURN_IF_FALSE(HashSwapDeviceToHost(hash_info));
-    RETURN_IF_FALSE(HashSwapServerToHost(key, hash_info));
-    RETURN_IF_FALSE(HashSwapHostToDevice(hash_info));
-  }
+  RETURN_IF_FALSE(SwapHashTables());
   size_t dest_len = data_size;
   // Replace the batch_ids by hash index for getNext-op getting hash index as input.
   if (memcpy_s(data, dest_len, hash_index.get(), data_size) != EOK) {
@@ -397,6 +413,7 @@ bool PsCacheManager::ProcessData() {
   RETURN_IF_FALSE(embedding_device_cache_->cache_->SynchronizeStream());
   // Finish the data process and notify data prefetch.
   RETURN_IF_FALSE(PsDataPrefetch::GetInstance().FinalizeData(channel_name_));
+  PrefetchLookaheadRows();
   (void)gettimeofday(&end_time, nullptr);
   uint64_t cost = kUSecondInSecond * static_cast<uint64_t>(end_time.tv_sec - start_time.tv_sec);
   cost += static_cast<uint64_t>(end_time.tv_usec - start_time.tv_usec);
@@ -407,6 +424,37 @@ bool PsCacheManager::ProcessData() {
   return true;
 }
 
+void PsCacheManager::PrefetchLookaheadRows() {
+  // The rows of the ids of the batches looked ahead which are in neither the device nor the host are pulled in the
+  // background, each id once across the batches, while the graph runs the current batch.
+  const auto &device_id_to_index = embedding_device_cache_->device_hash_map_->hash_id_to_index();
+  const auto &host_id_to_index = embedding_host_cache_->host_hash_map_->hash_id_to_index();
+  std::vector<int> batch_ids;
+  while (PsDataPrefetch::GetInstance().FetchLookaheadData(channel_name_, &batch_ids)) {
+    size_t seq = ++lookahead_step_;
+    if (seq <= data_step_) {
+      continue;
+    }
+    std::unordered_set<int> unique_ids;
+    std::vector<int> ids;
+    for (auto id : batch_ids) {
+      if (id < emb_table_slice_bounds_.first || id >= emb_table_slice_bounds_.second) {
+        continue;
+      }
+      if (device_id_to_index.Find(id) != INVALID_INDEX_VALUE || host_id_to_index.Find(id) != INVALID_INDEX_VALUE) {
+        continue;
+      }
+      if (unique_ids.insert(id).second) {
+        ids.push_back(id);
+      }
+    }
+    if (!ids.empty() && !prefetcher_.Add(seq, ids)) {
+      MS_LOG(DEBUG) << "The rows of the batch " << seq << " are not prefetched, the prefetch queue is full.";
+    }
+  }
+  prefetcher_.Finish(data_step_);
+}
+
 bool PsCacheManager::CheckCacheHitOrOutRangeTask(const int *batch_ids, const size_t batch_ids_len, int *hash_index,
                                                  bool *in_device, bool *out_range, size_t *hash_hit_count) {
   MS_ERROR_IF_NULL(batch_ids);
@@ -429,12 +477,12 @@ bool PsCacheManager::CheckCacheHitOrOutRangeTask(const int *batch_ids, const siz
       out_range[i] = true;
       continue;
     }
-    auto iter = hash_id_to_index.find(batch_ids[i]);
-    if (iter != hash_id_to_index.end()) {
-      hash_index[i] = iter->second + cache_indices_bounds_.first;
-      if (device_hash_map->hash_step(iter->second) != data_step_) {
+    auto index = hash_id_to_index.Find(batch_ids[i]);
+    if (index != INVALID_INDEX_VALUE) {
+      hash_index[i] = index + cache_indices_bounds_.first;
+      if (device_hash_map->hash_step(index) != data_step_) {
         ++(*hash_hit_count);
-        device_hash_map->set_hash_step(iter->second, data_step_);
+        device_hash_map->set_hash_step(index, data_step_);
       }
       in_device[i] = true;
     }
@@ -507,8 +555,14 @@ bool PsCacheManager::ParseData(const int *batch_ids, const size_t batch_ids_len,
   }
   RETURN_IF_FALSE(CheckCacheHitOrOutRange(batch_ids, batch_ids_len, hash_index, in_device.get(), out_range.get()));
   RETURN_IF_FALSE(ResetEmbeddingHashMap());
+  auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   for (size_t i = 0; i < batch_ids_len; i++) {
-    if (in_device[i] || out_range[i]) {
+    if (out_range[i]) {
+      continue;
+    }
+    if (in_device[i]) {
+      // The hits are counted for the replacement policy here, not by the threads checking them.
+      device_hash_map->RecordAccess(batch_ids[i], hash_index[i] - cache_indices_bounds_.first);
       continue;
     }
     bool need_swap_host_to_device = true;
@@ -549,17 +603,15 @@ bool PsCacheManager::ParseDeviceData(size_t id, bool *need_swap_device_to_host,
   auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
 
-  int index = INVALID_INDEX_VALUE;
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
+  int index = device_hash_map->hash_id_to_index().Find(id);
+  if (index != INVALID_INDEX_VALUE) {
     *need_swap_device_to_host = false;
     *need_swap_host_to_device = false;
-    index = iter->second;
     if (device_hash_map->hash_step(index) != data_step_) {
       statistics_info_.hash_hit_count_++;
       device_hash_map->set_hash_step(index, data_step_);
     }
+    device_hash_map->RecordAccess(id, index);
   } else {
     int *device_to_host_index = embedding_device_cache_->device_to_host_index.get();
     int *device_to_host_ids = embedding_device_cache_->device_to_host_ids.get();
@@ -595,13 +647,12 @@ bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
 
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  auto index = host_hash_map->hash_id_to_index().Find(id);
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
     }
+    host_hash_map->RecordAccess(id, index);
     host_to_device_index[statistics_info_.host_to_device_size_ - 1] = index;
   } else {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
@@ -611,9 +662,8 @@ bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
     MS_ERROR_IF_NULL(server_to_host_index);
     MS_ERROR_IF_NULL(server_to_host_ids);
     while (true) {
-      auto index =
-        host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step_, graph_running_step_,
-                                 &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
+      index = host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step_, graph_running_step_,
+                                       &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE(WaitGraphRun());
         continue;
@@ -637,10 +687,8 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
   int swap_device_to_host_id = device_to_host_ids[statistics_info_.device_to_host_size_ - 1];
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(swap_device_to_host_id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  auto index = host_hash_map->hash_id_to_index().Find(swap_device_to_host_id);
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
     }
@@ -649,9 +697,9 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
     int *host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
     while (true) {
-      auto index =
-        host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step_,
-                                 graph_running_step_, &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
+      index = host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step_,
+                                       graph_running_step_, &statistics_info_.host_to_server_size_,
+                                       &host_need_wait_graph_);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE(WaitGraphRun());
         continue;
@@ -665,28 +713,8 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
 
 void PsCacheManager::LookUpTableTask(size_t indices_lens, size_t outer_dim_size, size_t first_dim_size,
                                      const float *input_addr, const int *indices_addr, float *output_addr) {
-  auto type_size = sizeof(float);
-  size_t lens = outer_dim_size * type_size;
-  for (size_t i = 0; i < indices_lens; ++i) {
-    int index = indices_addr[i];
-    if (index >= 0 && index < SizeToInt(first_dim_size)) {
-      size_t pos = index * outer_dim_size;
-      auto ret = memcpy_s(output_addr, (indices_lens - i) * lens, input_addr + pos, lens);
-      if (ret != EOK) {
-        MS_LOG(ERROR) << "LookUpTable task memcpy failed.";
-        running_ = false;
-        return;
-      }
-    } else {
-      auto ret = memset_s(output_addr, (indices_lens - i) * lens, 0, lens);
-      if (ret != EOK) {
-        MS_LOG(ERROR) << "LookUpTable task memset failed.";
-        running_ = false;
-        return;
-      }
-    }
-    output_addr += outer_dim_size;
-  }
+  kernel::GatherEmbeddingRows<int>(input_addr, first_dim_size, outer_dim_size, indices_addr, indices_lens, 0,
+                                   output_addr);
 }
 
 bool PsCacheManager::LookUpHostHashTable(size_t embedding_size, size_t indices_lens, const float *hash_table_addr,
@@ -721,49 +749,9 @@ bool PsCacheManager::LookUpHostHashTable(size_t embedding_size, size_t indices_l
 
 bool PsCacheManager::InsertHostHashTable(size_t embedding_size, size_t insert_indices_size, const int *insert_indices,
                                          const float *insert_data, float *hash_table_addr) {
-  size_t first_dim_size = host_vocab_cache_size_;
-  size_t thread_num = insert_indices_size / kMaxIdsPerThread + 1;
-  thread_num = thread_num > kMaxThreadNum ? kMaxThreadNum : thread_num;
-  std::thread threads[kMaxThreadNum];
-  size_t task_proc_lens = (insert_indices_size + thread_num - 1) / thread_num;
-  size_t i = 0;
-  size_t task_offset = 0;
-
-  auto insert_hash_table_task = [this](size_t insert_indices_size, size_t outer_dim_size, size_t first_dim_size,
-                                       const int *insert_indices, const float *insert_data, float *hash_table_addr) {
-    auto type_size = sizeof(float);
-    size_t copy_len = outer_dim_size * type_size;
-    size_t dest_len = copy_len;
-    for (size_t i = 0; i < insert_indices_size; ++i) {
-      int index = insert_indices[i];
-      if (index >= 0 && index < SizeToInt(first_dim_size)) {
-        auto ret =
-          memcpy_s(hash_table_addr + index * outer_dim_size, dest_len, insert_data + i * outer_dim_size, copy_len);
-        if (ret != EOK) {
-          MS_LOG(ERROR) << "Insert hash table task memcpy failed.";
-          running_ = false;
-          return;
-        }
-      }
-    }
-  };
-
-  for (; i < thread_num; i++) {
-    if (task_offset >= insert_indices_size) {
-      break;
-    }
-    MS_LOG(DEBUG) << "Task offset: " << task_offset << ", task process lens:" << task_proc_lens;
-    threads[i] = std::thread(insert_hash_table_task, task_proc_lens, embedding_size, first_dim_size,
-                             insert_indices + task_offset, insert_data + task_offset * embedding_size, hash_table_addr);
-    task_offset += task_proc_lens;
-    if (task_offset + task_proc_lens > insert_indices_size) {
-      task_proc_lens = insert_indices_size - task_offset;
-    }
-  }
-
-  for (size_t j = 0; j < i; j++) {
-    threads[j].join();
-  }
+  // The rows are split among the threads by range, so the ids inserted twice are not written by two threads at once.
+  kernel::ScatterEmbeddingRows<int>(hash_table_addr, host_vocab_cache_size_, embedding_size, insert_indices,
+                                    insert_indices_size, 0, insert_data);
   return running_;
 }
 
@@ -835,50 +823,120 @@ bool PsCacheManager::HashSwapHostToServer(size_t key, const HashTableInfo &hash_
   if (swap_indices_size == 0) {
     return true;
   }
-  std::vector<int> lookup_ids(swap_indices_size, 0);
-  std::vector<float> swap_out_data;
+  auto push = std::make_shared<PendingPush>();
+  push->key = key;
   auto embedding_size = hash_info.embedding_size;
-  swap_out_data.resize(swap_indices_size * embedding_size);
+  push->values.resize(swap_indices_size * embedding_size);
   auto host_hash_table_addr = reinterpret_cast<float *>(hash_info.host_address.get());
   RETURN_IF_FALSE(LookUpHostHashTable(embedding_size, swap_indices_size, host_hash_table_addr, host_to_server_index,
-                                      swap_out_data.data()));
+                                      push->values.data()));
+  push->ids.assign(host_to_server_ids, host_to_server_ids + swap_indices_size);
+  for (size_t i = 0; i < swap_indices_size; ++i) {
+    push->id_to_row[push->ids[i]] = i;
+  }
+  // The rows prefetched of the ids are older than the ones pushed now.
+  prefetcher_.Invalidate(key, push->ids);
 
-  size_t copy_len = swap_indices_size * sizeof(int);
-  size_t dest_len = copy_len;
-  auto ret = memcpy_s(lookup_ids.data(), dest_len, host_to_server_ids, copy_len);
-  if (ret != EOK) {
-    MS_LOG(ERROR) << "Lookup id memcpy failed.";
+  // The queue stops when a push still fails after the retries, and the data processing stops with it.
+  if (!push_queue_.Add(push)) {
+    MS_LOG(ERROR) << "PS embedding cache push thread isn't running.";
     return false;
   }
-  Worker::GetInstance().UpdateEmbeddingTable({key}, lookup_ids, swap_out_data);
   return true;
 }
 
-bool PsCacheManager::HashSwapServerToHost(size_t key, const HashTableInfo &hash_info) {
-  MS_ERROR_IF_NULL(embedding_host_cache_);
+bool PsCacheManager::WaitPendingPush() { return push_queue_.WaitEmpty(); }
+
+void PsCacheManager::LookUpServerEmbeddingTask(size_t key, const HashTableInfo &hash_info,
+                                               std::vector<float> *lookup_result, bool *success) {
   auto swap_indices_size = statistics_info_.server_to_host_size_;
   auto server_to_host_ids = embedding_host_cache_->server_to_host_ids.get();
+  auto embedding_size = hash_info.embedding_size;
+  lookup_result->resize(swap_indices_size * embedding_size, 0);
+  // The rows of the pushes still in flight are newer than the ones of the server, the last push has the newest.
+  std::vector<int> lookup_ids;
+  std::vector<size_t> lookup_rows;
+  push_queue_.LookUp(key, server_to_host_ids, swap_indices_size, embedding_size, lookup_result->data(), &lookup_ids,
+                     &lookup_rows);
+  // The rows prefetched for the batch are taken next, only the ones left are pulled from the server now.
+  (void)prefetcher_.Take(key, embedding_size, lookup_result->data(), &lookup_ids, &lookup_rows);
+  try {
+    if (lookup_ids.size() == swap_indices_size) {
+      Worker::GetInstance().DoPSEmbeddingLookup(key, lookup_ids, lookup_result, mindspore::ps::kEmbeddingLookupCmd);
+    } else if (!lookup_ids.empty()) {
+      std::vector<float> server_result(lookup_ids.size() * embedding_size, 0);
+      Worker::GetInstance().DoPSEmbeddingLookup(key, lookup_ids, &server_result, mindspore::ps::kEmbeddingLookupCmd);
+      for (size_t i = 0; i < lookup_rows.size(); ++i) {
+        auto src = server_result.begin() + i * embedding_size;
+        (void)std::copy(src, src + embedding_size, lookup_result->begin() + lookup_rows[i] * embedding_size);
+      }
+    }
+    *success = true;
+  } catch (const std::exception &e) {
+    MS_LOG(ERROR) << "PS embedding cache lookup from server failed: " << e.what();
+    *success = false;
+  }
+}
+
+bool PsCacheManager::HashSwapServerToHost(const HashTableInfo &hash_info, const std::vector<float> &lookup_result) {
+  MS_ERROR_IF_NULL(embedding_host_cache_);
+  auto swap_indices_size = statistics_info_.server_to_host_size_;
   auto server_to_host_index = embedding_host_cache_->server_to_host_index.get();
   if (swap_indices_size == 0) {
     return true;
   }
   auto host_hash_table_addr = reinterpret_cast<float *>(hash_info.host_address.get());
   auto embedding_size = hash_info.embedding_size;
-  std::vector<float> lookup_result(swap_indices_size * embedding_size, 0);
-  std::vector<int> lookup_ids(swap_indices_size, 0);
-  size_t copy_len = swap_indices_size * sizeof(int);
-  size_t dest_len = copy_len;
-  auto ret = memcpy_s(lookup_ids.data(), dest_len, server_to_host_ids, copy_len);
-  if (ret != EOK) {
-    MS_LOG(ERROR) << "Lookup id memcpy failed.";
-    return false;
-  }
-  Worker::GetInstance().DoPSEmbeddingLookup(key, lookup_ids, &lookup_result, mindspore::ps::kEmbeddingLookupCmd);
   RETURN_IF_FALSE(InsertHostHashTable(embedding_size, IntToSize(swap_indices_size), server_to_host_index,
                                       lookup_result.data(), host_hash_table_addr));
   return true;
 }
 
+bool PsCacheManager::SwapHashTables() {
+  // The rows swapped out of the host are pushed to the server in the background, and the rows swapped in from the
+  // server are pulled for all the tables at once, while the rows swapped out of the device are copied to the host.
+  std::vector<size_t> keys;
+  for (const auto &item : hash_tables_) {
+    auto key = Worker::GetInstance().GetParamKey(item.first);
+    RETURN_IF_FALSE(HashSwapHostToServer(key, item.second));
+    keys.push_back(key);
+  }
+  size_t table_num = hash_tables_.size();
+  std::vector<std::vector<float>> lookup_results(table_num);
+  std::unique_ptr<bool[]> lookup_success = std::make_unique<bool[]>(table_num);
+  std::vector<std::thread> threads;
+  if (statistics_info_.server_to_host_size_ > 0) {
+    size_t i = 0;
+    for (const auto &item : hash_tables_) {
+      threads.emplace_back(&PsCacheManager::LookUpServerEmbeddingTask, this, keys[i], std::cref(item.second),
+                           &lookup_results[i], &lookup_success[i]);
+      ++i;
+    }
+  }
+  bool device_to_host_success = true;
+  for (const auto &item : hash_tables_) {
+    if (!HashSwapDeviceToHost(item.second)) {
+      device_to_host_success = false;
+      break;
+    }
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  RETURN_IF_FALSE(device_to_host_success);
+
+  size_t i = 0;
+  for (const auto &item : hash_tables_) {
+    if (!threads.empty()) {
+      RETURN_IF_FALSE(lookup_success[i]);
+      RETURN_IF_FALSE(HashSwapServerToHost(item.second, lookup_results[i]));
+    }
+    RETURN_IF_FALSE(HashSwapHostToDevice(item.second));
+    ++i;
+  }
+  return true;
+}
+
 bool PsCacheManager::HashSwapDeviceOut(int *swap_out_index, std::vector<float> *swap_out_data,
                                        const HashTableInfo &hash_info) {
   MS_ERROR_IF_NULL(swap_out_index);
@@ -960,7 +1018,7 @@ bool PsCacheManager::UpdataEmbeddingTable(const std::vector<float> &swap_out_dat
   }
   // Need synchronize event to ensure that the swap-out in device is completed.
   RETURN_IF_FALSE(embedding_device_cache_->cache_->SynchronizeEvent());
-  Worker::GetInstance().UpdateEmbeddingTable({key}, lookup_ids, swap_out_data);
+  RETURN_IF_FALSE(Worker::GetInstance().UpdateEmbeddingTable({key}, lookup_ids, swap_out_data));
   return true;
 }
 
@@ -971,6 +1029,10 @@ void PsCacheManager::SyncEmbeddingTable() {
   if (!initialized_ps_cache_) {
     return;
   }
+  // The rows pushed in the background are older than the ones synchronized here.
+  if (!WaitPendingPush()) {
+    MS_LOG(ERROR) << "Wait for the ps cache pushes to server failed.";
+  }
   if (!SyncHostEmbeddingTable()) {
     MS_LOG(ERROR) << "SyncHostEmbeddingTable failed.";
   }
@@ -993,10 +1055,10 @@ bool PsCacheManager::SyncHostEmbeddingTable() {
   std::unique_ptr<int[]> host_to_server_indices_ptr = std::make_unique<int[]>(swap_indices_lens);
   MS_ERROR_IF_NULL(host_to_server_indices_ptr);
   size_t idx = 0;
-  for (const auto &item : hash_id_to_index) {
-    host_to_server_ids_ptr[idx] = item.first;
-    host_to_server_indices_ptr[idx++] = item.second;
-  }
+  hash_id_to_index.ForEach([&host_to_server_ids_ptr, &host_to_server_indices_ptr, &idx](int id, int index) {
+    host_to_server_ids_ptr[idx] = id;
+    host_to_server_indices_ptr[idx++] = index;
+  });
   for (const auto &item : hash_tables_) {
     const auto &hash_info = item.second;
     if (hash_info.param_init_info_.param_type_ != kWeight) {
@@ -1019,7 +1081,7 @@ bool PsCacheManager::SyncHostEmbeddingTable() {
       MS_LOG(ERROR) << "Lookup id memcpy failed.";
       return false;
     }
-    Worker::GetInstance().UpdateEmbeddingTable({key}, lookup_ids, swap_out_data);
+    RETURN_IF_FALSE(Worker::GetInstance().UpdateEmbeddingTable({key}, lookup_ids, swap_out_data));
   }
   return true;
 }
@@ -1038,10 +1100,10 @@ bool PsCacheManager::SyncDeviceEmbeddingTable() {
   std::unique_ptr<int[]> device_to_server_indices_ptr = std::make_unique<int[]>(swap_indices_lens);
   MS_ERROR_IF_NULL(device_to_server_indices_ptr);
   size_t idx = 0;
-  for (const auto &item : hash_id_to_index) {
-    device_to_server_ids_ptr[idx] = item.first;
-    device_to_server_indices_ptr[idx++] = item.second;
-  }
+  hash_id_to_index.ForEach([&device_to_server_ids_ptr, &device_to_server_indices_ptr, &idx](int id, int index) {
+    device_to_server_ids_ptr[idx] = id;
+    device_to_server_indices_ptr[idx++] = index;
+  });
   for (const auto &item : hash_tables_) {
     const auto &hash_info = item.second;
     if (hash_info.param_init_info_.param_type_ != kWeight) {
@@ -1072,7 +1134,7 @@ bool PsCacheManager::SyncDeviceEmbeddingTable() {
       MS_LOG(ERROR) << "Lookup id memcpy failed.";
       return false;
     }
-    Worker::GetInstance().UpdateEmbeddingTable({key}, lookup_ids, swap_out_data);
+    RETURN_IF_FALSE(Worker::GetInstance().UpdateEmbeddingTable({key}, lookup_ids, swap_out_data));
   }
   return true;
 }
@@ -1109,8 +1171,16 @@ void PsCacheManager::DumpHashTables(bool dump_device_tables) const {
 void PsCacheManager::DumpStatisticsInfo(size_t each_print_step) {
   // Default each 1000 step prints ps cache hit rate.
   const size_t kFloatToPercentSign = 100;
+  statistics_info_.batch_id_unique_count_ = statistics_info_.hash_hit_count_ + statistics_info_.host_to_device_size_;
+  total_statistics_info_.step_count_++;
+  total_statistics_info_.batch_id_count_ += statistics_info_.batch_id_count_;
+  total_statistics_info_.batch_id_unique_count_ += statistics_info_.batch_id_unique_count_;
+  total_statistics_info_.hash_hit_count_ += statistics_info_.hash_hit_count_;
+  total_statistics_info_.device_to_host_size_ += statistics_info_.device_to_host_size_;
+  total_statistics_info_.host_to_device_size_ += statistics_info_.host_to_device_size_;
+  total_statistics_info_.host_to_server_size_ += statistics_info_.host_to_server_size_;
+  total_statistics_info_.server_to_host_size_ += statistics_info_.server_to_host_size_;
   if (data_step_ % each_print_step == 0) {
-    statistics_info_.batch_id_unique_count_ = statistics_info_.hash_hit_count_ + statistics_info_.host_to_device_size_;
     auto repeat_rate = SizeToFloat(statistics_info_.batch_id_count_ - statistics_info_.batch_id_unique_count_) /
                        statistics_info_.batch_id_count_;
     auto device_hit_rate = SizeToFloat(statistics_info_.hash_hit_count_) / statistics_info_.batch_id_unique_count_;
@@ -1125,6 +1195,28 @@ void PsCacheManager::DumpStatisticsInfo(size_t each_print_step) {
                  << ", data repeat rate:" << (repeat_rate * kFloatToPercentSign)
                  << "%, device cache hit rate:" << (device_hit_rate * kFloatToPercentSign)
                  << "%, host cache hit rate:" << (host_hit_rate * kFloatToPercentSign) << ").";
+
+    // The swap volume counts the rows of every table moved between the device, the host and the server.
+    size_t row_bytes = 0;
+    for (const auto &item : hash_tables_) {
+      row_bytes += item.second.embedding_size * sizeof(float);
+    }
+    const auto &total = total_statistics_info_;
+    size_t total_swap_num =
+      total.host_to_device_size_ + total.device_to_host_size_ + total.host_to_server_size_ + total.server_to_host_size_;
+    auto total_device_hit_rate = SizeToFloat(total.hash_hit_count_) / total.batch_id_unique_count_;
+    auto total_host_hit_rate =
+      SizeToFloat(total.batch_id_unique_count_ - total.server_to_host_size_) / total.batch_id_unique_count_;
+    MS_LOG(INFO) << "PS embedding cache total statistics info(policy:" << CachePolicyName(cache_policy_)
+                 << ", step num:" << total.step_count_ << ", device cache hit rate:"
+                 << (total_device_hit_rate * kFloatToPercentSign)
+                 << "%, host cache hit rate:" << (total_host_hit_rate * kFloatToPercentSign)
+                 << "%, device swap in num:" << total.host_to_device_size_
+                 << ", device swap out num:" << total.device_to_host_size_
+                 << ", host swap in num:" << total.server_to_host_size_
+                 << ", host swap out num:" << total.host_to_server_size_
+                 << ", server prefetch hit num:" << prefetcher_.hit_num()
+                 << ", swap bytes per step:" << (total_swap_num * row_bytes / total.step_count_) << ").";
   }
 }
 }  // namespace ps
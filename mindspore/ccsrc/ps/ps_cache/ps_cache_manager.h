@@ -24,6 +24,8 @@
 #include <atomic>
 #include <utility>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <condition_variable>
 #include "utils/ms_context.h"
 #include "backend/kernel_compiler/kernel.h"
@@ -34,6 +36,8 @@
 #include "ps/ps_context.h"
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
 #include "ps/ps_cache/embedding_hash_map.h"
+#include "ps/ps_cache/pending_push_queue.h"
+#include "ps/ps_cache/server_row_prefetcher.h"
 #include "ps/ps_cache/ps_cache_factory.h"
 
 namespace mindspore {
@@ -54,13 +58,13 @@ struct HashTableInfo {
 };
 
 struct EmbeddingDeviceCache {
-  EmbeddingDeviceCache(size_t batch_elements, size_t cache_vocab_size)
+  EmbeddingDeviceCache(size_t batch_elements, size_t cache_vocab_size, CachePolicy cache_policy)
       : hash_swap_index_addr_(nullptr), hash_swap_value_addr_(nullptr) {
     device_to_host_index = std::make_unique<int[]>(batch_elements);
     device_to_host_ids = std::make_unique<int[]>(batch_elements);
     host_to_device_index = std::make_unique<int[]>(batch_elements);
     host_to_device_ids = std::make_unique<int[]>(batch_elements);
-    device_hash_map_ = std::make_shared<EmbeddingHashMap>(0, cache_vocab_size);
+    device_hash_map_ = std::make_shared<EmbeddingHashMap>(0, cache_vocab_size, cache_policy);
     auto context_ptr = MsContext::GetInstance();
     MS_EXCEPTION_IF_NULL(context_ptr);
     auto devcie_target = context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET);
@@ -77,14 +81,14 @@ struct EmbeddingDeviceCache {
 };
 
 struct EmbeddingHostCache {
-  EmbeddingHostCache(size_t batch_elements, size_t host_cache_vocab_size) {
+  EmbeddingHostCache(size_t batch_elements, size_t host_cache_vocab_size, CachePolicy cache_policy) {
     host_to_server_index = std::make_unique<int[]>(batch_elements);
     host_to_server_ids = std::make_unique<int[]>(batch_elements);
     server_to_host_index = std::make_unique<int[]>(batch_elements);
     server_to_host_ids = std::make_unique<int[]>(batch_elements);
     host_to_device_index = std::make_unique<int[]>(batch_elements);
     device_to_host_index = std::make_unique<int[]>(batch_elements);
-    host_hash_map_ = std::make_shared<EmbeddingHashMap>(0, host_cache_vocab_size);
+    host_hash_map_ = std::make_shared<EmbeddingHashMap>(0, host_cache_vocab_size, cache_policy);
   }
   std::unique_ptr<int[]> host_to_server_index;
   std::unique_ptr<int[]> host_to_server_ids;
@@ -108,6 +112,18 @@ struct PsCacheStatisticsInfo {
   size_t mem_cache_hit_count_{0};
 };
 
+// The statistics accumulated since the cache started, the ones above are of the current step.
+struct PsCacheTotalStatisticsInfo {
+  size_t step_count_{0};
+  size_t batch_id_count_{0};
+  size_t batch_id_unique_count_{0};
+  size_t hash_hit_count_{0};
+  size_t device_to_host_size_{0};
+  size_t host_to_device_size_{0};
+  size_t host_to_server_size_{0};
+  size_t server_to_host_size_{0};
+};
+
 class PsCacheManager {
  public:
   static PsCacheManager &GetInstance() {
@@ -127,6 +143,7 @@ class PsCacheManager {
   bool IsHashTable(const std::string &param_name) { return hash_tables_.count(param_name) != 0; }
   void set_batch_elements(size_t batch_elements) { batch_elements_ = batch_elements; }
   void set_rank_id(int rank_id) { rank_id_ = rank_id; }
+  void set_cache_policy(CachePolicy cache_policy) { cache_policy_ = cache_policy; }
   bool initialized_ps_cache() const { return initialized_ps_cache_; }
   size_t vocab_cache_size() const { return vocab_cache_size_; }
   int cache_indices_lower_bound() const;
@@ -151,6 +168,7 @@ class PsCacheManager {
   void SetLocalIdRank();
   void ProcessDataTask(uint32_t device_id, const void *context);
   bool ProcessData();
+  void PrefetchLookaheadRows();
   bool ParseData(const int *batch_ids, const size_t batch_ids_len, int *hash_index);
   bool WaitGraphRun();
   bool ParseDeviceData(size_t id, bool *need_swap_device_to_host, bool *need_swap_host_to_device, int *hash_index);
@@ -161,7 +179,11 @@ class PsCacheManager {
   bool HashSwapHostToDevice(const HashTableInfo &hash_info);
   bool HashSwapDeviceToHost(const HashTableInfo &hash_info);
   bool HashSwapHostToServer(size_t key, const HashTableInfo &hash_info);
-  bool HashSwapServerToHost(size_t key, const HashTableInfo &hash_info);
+  void LookUpServerEmbeddingTask(size_t key, const HashTableInfo &hash_info, std::vector<float> *lookup_result,
+                                 bool *success);
+  bool HashSwapServerToHost(const HashTableInfo &hash_info, const std::vector<float> &lookup_result);
+  bool SwapHashTables();
+  bool WaitPendingPush();
   bool InsertHostHashTable(size_t embedding_size, size_t insert_indices_size, const int *insert_indices,
                            const float *insert_data, float *hash_table_addr);
   bool LookUpHostHashTable(size_t embedding_size, size_t indices_lens, const float *hash_table_addr,
@@ -190,6 +212,10 @@ class PsCacheManager {
   std::condition_variable data_prase_;
   std::condition_variable insert_init_info_;
   std::thread process_data_thread_;
+  PendingPushQueue push_queue_;
+  ServerRowPrefetcher prefetcher_;
+  // The number of the batches looked ahead, the seq of the next one.
+  size_t lookahead_step_{0};
 
   std::map<std::string, HashTableInfo> hash_tables_;
   std::shared_ptr<EmbeddingDeviceCache> embedding_device_cache_;
@@ -200,6 +226,8 @@ class PsCacheManager {
   size_t host_vocab_cache_size_{0};
   size_t batch_elements_{0};
   PsCacheStatisticsInfo statistics_info_;
+  PsCacheTotalStatisticsInfo total_statistics_info_;
+  CachePolicy cache_policy_{CachePolicy::kStep};
   std::pair<int, int> emb_table_slice_bounds_;
   std::pair<int, int> cache_indices_bounds_;
   int vocab_cache_size_diff_{0};
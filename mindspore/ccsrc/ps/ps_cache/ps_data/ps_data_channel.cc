@@ -15,6 +15,7 @@
  */
 
 #include "ps/ps_cache/ps_data/ps_data_channel.h"
+#include <utility>
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -48,5 +49,26 @@ void PsDataChannel::set_data(const void *data, const size_t data_size) {
   data_ = const_cast<void *>(data);
   data_size_ = data_size;
 }
+
+void PsDataChannel::AddLookaheadData(const void *data, const size_t data_size) {
+  MS_EXCEPTION_IF_NULL(data);
+  auto ids = reinterpret_cast<const int *>(data);
+  std::lock_guard<std::mutex> locker(lookahead_mutex_);
+  if (lookahead_data_.size() >= kMaxLookaheadBatchNum) {
+    lookahead_data_.pop_front();
+  }
+  lookahead_data_.emplace_back(ids, ids + data_size / sizeof(int));
+}
+
+bool PsDataChannel::FetchLookaheadData(std::vector<int> *ids) {
+  MS_EXCEPTION_IF_NULL(ids);
+  std::lock_guard<std::mutex> locker(lookahead_mutex_);
+  if (lookahead_data_.empty()) {
+    return false;
+  }
+  *ids = std::move(lookahead_data_.front());
+  lookahead_data_.pop_front();
+  return true;
+}
 }  // namespace ps
 }  // namespace mindspore
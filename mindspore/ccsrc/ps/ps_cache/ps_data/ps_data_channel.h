@@ -18,10 +18,15 @@
 
 #include <memory>
 #include <string>
+#include <deque>
+#include <vector>
 #include <condition_variable>
 
 namespace mindspore {
 namespace ps {
+// The dataset hands the ids of this many batches to the cache ahead of the batch being processed.
+constexpr size_t kMaxLookaheadBatchNum = 4;
+
 class PsDataChannel {
  public:
   PsDataChannel(const std::string &channel_name, size_t step_num)
@@ -39,6 +44,9 @@ class PsDataChannel {
   void ResetData() { data_ = nullptr; }
   void set_step_num(size_t step_num) { step_num_ = step_num; }
   void TryWakeChannel(bool force_wake = false);
+  // The ids of a batch coming after the current one, the oldest batch is dropped once kMaxLookaheadBatchNum are kept.
+  void AddLookaheadData(const void *data, const size_t data_size);
+  bool FetchLookaheadData(std::vector<int> *ids);
 
  private:
   void TryLockChannel();
@@ -52,6 +60,8 @@ class PsDataChannel {
   std::condition_variable channel_;
   void *data_;
   size_t data_size_;
+  std::mutex lookahead_mutex_;
+  std::deque<std::vector<int>> lookahead_data_;
 };
 }  // namespace ps
 }  // namespace mindspore
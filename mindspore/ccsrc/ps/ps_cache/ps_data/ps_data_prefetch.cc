@@ -111,6 +111,33 @@ bool PsDataPrefetch::FinalizeData(const std::string &channel_name) {
   return false;
 }
 
+bool PsDataPrefetch::HintData(const std::string &channel_name, const void *data, const size_t data_size,
+                              const std::string &data_type) {
+  if (cache_enable_ == false || data == nullptr || data_size == 0) {
+    return true;
+  }
+  // The ids of the wrong type are reported by PrefetchData when their batch comes.
+  const std::string supported_data_type = "int32";
+  if (data_type != supported_data_type) {
+    return true;
+  }
+  auto channel = ps_data_channel(channel_name);
+  MS_ERROR_IF_NULL(channel);
+  channel->AddLookaheadData(data, data_size);
+  return true;
+}
+
+bool PsDataPrefetch::FetchLookaheadData(const std::string &channel_name, std::vector<int> *ids) const {
+  if (cache_enable_ == false || ids == nullptr) {
+    return false;
+  }
+  auto channel = ps_data_channel(channel_name);
+  if (channel == nullptr) {
+    return false;
+  }
+  return channel->FetchLookaheadData(ids);
+}
+
 bool PsDataPrefetch::QueryData(const std::string &channel_name, void **data_ptr) const {
   if (invalid_data_type_) {
     return false;
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <memory>
 #include <atomic>
 #include <condition_variable>
@@ -40,6 +41,10 @@ class EXPORT PsDataPrefetch {
   EXPORT bool PrefetchData(const std::string &channel_name, void *data, const size_t data_size,
                            const std::string &data_type);
   EXPORT bool FinalizeData(const std::string &channel_name);
+  // Hand the ids of a batch coming after the one prefetched to the cache, which pulls their rows ahead. Never blocks.
+  EXPORT bool HintData(const std::string &channel_name, const void *data, const size_t data_size,
+                       const std::string &data_type);
+  EXPORT bool FetchLookaheadData(const std::string &channel_name, std::vector<int> *ids) const;
   EXPORT void NotifyFinalize();
   EXPORT bool QueryData(const std::string &channel_name, void **data_ptr) const;
   EXPORT size_t data_size(const std::string &channel_name) const;
@@ -0,0 +1,215 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/ps_cache/server_row_prefetcher.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+void ServerRowPrefetcher::Start(const std::vector<size_t> &keys, const PullFunc &pull_func,
+                                const PendingFilter &pending_filter) {
+  MS_EXCEPTION_IF_NULL(pull_func);
+  MS_EXCEPTION_IF_NULL(pending_filter);
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (running_ || prefetch_thread_.joinable()) {
+    MS_LOG(EXCEPTION) << "The server row prefetcher has been started.";
+  }
+  keys_ = keys;
+  pull_func_ = pull_func;
+  pending_filter_ = pending_filter;
+  running_ = true;
+  prefetch_thread_ = std::thread(&ServerRowPrefetcher::PrefetchTask, this);
+}
+
+void ServerRowPrefetcher::Stop() {
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    running_ = false;
+  }
+  cond_.notify_all();
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+  std::lock_guard<std::mutex> locker(mutex_);
+  requests_.clear();
+  wanted_ids_.clear();
+  invalidated_ids_.clear();
+  staged_rows_.clear();
+  staged_ids_.clear();
+}
+
+bool ServerRowPrefetcher::Add(size_t seq, const std::vector<int> &ids) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  if (!running_ || requests_.size() >= max_request_num_) {
+    return false;
+  }
+  std::vector<int> request_ids;
+  for (auto id : ids) {
+    auto staged_iter = staged_ids_.find(id);
+    if (staged_iter != staged_ids_.end()) {
+      staged_iter->second = std::max(staged_iter->second, seq);
+      continue;
+    }
+    auto wanted_iter = wanted_ids_.find(id);
+    if (wanted_iter != wanted_ids_.end()) {
+      wanted_iter->second = std::max(wanted_iter->second, seq);
+      continue;
+    }
+    wanted_ids_[id] = seq;
+    request_ids.push_back(id);
+  }
+  if (request_ids.empty()) {
+    return true;
+  }
+  requests_.emplace_back(seq, std::move(request_ids));
+  locker.unlock();
+  cond_.notify_all();
+  return true;
+}
+
+void ServerRowPrefetcher::Invalidate(size_t key, const std::vector<int> &ids) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto &staged_rows = staged_rows_[key];
+  for (auto id : ids) {
+    (void)staged_rows.erase(id);
+    if (wanted_ids_.count(id) > 0) {
+      (void)invalidated_ids_[key].insert(id);
+    }
+  }
+}
+
+size_t ServerRowPrefetcher::Take(size_t key, size_t embedding_size, float *output, std::vector<int> *ids,
+                                 std::vector<size_t> *positions) {
+  MS_EXCEPTION_IF_NULL(output);
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(positions);
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto rows_iter = staged_rows_.find(key);
+  if (rows_iter == staged_rows_.end() || rows_iter->second.empty()) {
+    return 0;
+  }
+  auto &staged_rows = rows_iter->second;
+  size_t left_num = 0;
+  for (size_t i = 0; i < ids->size(); ++i) {
+    auto iter = staged_rows.find((*ids)[i]);
+    if (iter == staged_rows.end() || iter->second.size() != embedding_size) {
+      (*ids)[left_num] = (*ids)[i];
+      (*positions)[left_num++] = (*positions)[i];
+      continue;
+    }
+    (void)std::copy(iter->second.begin(), iter->second.end(), output + (*positions)[i] * embedding_size);
+    (void)staged_rows.erase(iter);
+  }
+  size_t taken_num = ids->size() - left_num;
+  ids->resize(left_num);
+  positions->resize(left_num);
+  hit_num_ += taken_num;
+  return taken_num;
+}
+
+void ServerRowPrefetcher::Finish(size_t seq) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  for (auto iter = staged_ids_.begin(); iter != staged_ids_.end();) {
+    if (iter->second > seq) {
+      ++iter;
+      continue;
+    }
+    for (auto &item : staged_rows_) {
+      (void)item.second.erase(iter->first);
+    }
+    iter = staged_ids_.erase(iter);
+  }
+}
+
+size_t ServerRowPrefetcher::staged_size() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  return staged_ids_.size();
+}
+
+size_t ServerRowPrefetcher::hit_num() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  return hit_num_;
+}
+
+void ServerRowPrefetcher::PrefetchTask() {
+  while (true) {
+    std::vector<int> request_ids;
+    {
+      std::unique_lock<std::mutex> locker(mutex_);
+      cond_.wait(locker, [this] { return !requests_.empty() || !running_; });
+      if (!running_) {
+        return;
+      }
+      request_ids = std::move(requests_.front().second);
+      requests_.pop_front();
+    }
+    // The ids are pulled for all the keys, as the tables are all looked up by the same ids.
+    size_t key_num = keys_.size();
+    std::vector<std::vector<int>> pulled_ids(key_num, request_ids);
+    std::vector<std::vector<float>> pulled_values(key_num);
+    std::vector<bool> pulled(key_num, false);
+    for (size_t i = 0; i < key_num; ++i) {
+      pending_filter_(keys_[i], &pulled_ids[i]);
+      if (pulled_ids[i].empty()) {
+        continue;
+      }
+      try {
+        pulled[i] = pull_func_(keys_[i], pulled_ids[i], &pulled_values[i]);
+      } catch (const std::exception &e) {
+        MS_LOG(WARNING) << "Prefetching the rows of key " << keys_[i] << " from the server failed: " << e.what();
+      }
+    }
+    StageRows(request_ids, pulled_ids, pulled_values, pulled);
+  }
+}
+
+void ServerRowPrefetcher::StageRows(const std::vector<int> &request_ids,
+                                    const std::vector<std::vector<int>> &pulled_ids,
+                                    const std::vector<std::vector<float>> &pulled_values,
+                                    const std::vector<bool> &pulled) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    auto &invalidated_ids = invalidated_ids_[keys_[i]];
+    const auto &ids = pulled_ids[i];
+    if (pulled[i] && !ids.empty() && pulled_values[i].size() % ids.size() == 0) {
+      size_t embedding_size = pulled_values[i].size() / ids.size();
+      auto &staged_rows = staged_rows_[keys_[i]];
+      for (size_t j = 0; j < ids.size(); ++j) {
+        if (invalidated_ids.count(ids[j]) > 0) {
+          continue;
+        }
+        auto src = pulled_values[i].begin() + j * embedding_size;
+        staged_rows[ids[j]].assign(src, src + embedding_size);
+      }
+    }
+    for (auto id : request_ids) {
+      (void)invalidated_ids.erase(id);
+    }
+  }
+  for (auto id : request_ids) {
+    auto iter = wanted_ids_.find(id);
+    if (iter == wanted_ids_.end()) {
+      continue;
+    }
+    staged_ids_[id] = iter->second;
+    (void)wanted_ids_.erase(iter);
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_PS_CACHE_SERVER_ROW_PREFETCHER_H_
+#define MINDSPORE_CCSRC_PS_PS_CACHE_SERVER_ROW_PREFETCHER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "ps/ps_cache/ps_data/ps_data_channel.h"
+
+namespace mindspore {
+namespace ps {
+// The rows of the batches looked ahead are pulled from the server in the background, before the data processing of
+// their batch needs them. An id wanted by several of the batches is pulled once, and the rows are staged here until
+// they're taken by the swap from the server to the host, or until the last batch wanting them has been processed.
+// A row pushed to the server after it's pulled is dropped, so a row taken is never older than the one of the server.
+class ServerRowPrefetcher {
+ public:
+  // Pull the rows of the ids of the key from the server into the values, returns false if failed.
+  using PullFunc = std::function<bool(size_t key, const std::vector<int> &ids, std::vector<float> *values)>;
+  // Remove the ids whose rows are still being pushed to the server, the server doesn't have them yet.
+  using PendingFilter = std::function<void(size_t key, std::vector<int> *ids)>;
+
+  explicit ServerRowPrefetcher(size_t max_request_num = kMaxLookaheadBatchNum) : max_request_num_(max_request_num) {}
+  ~ServerRowPrefetcher() { Stop(); }
+
+  void Start(const std::vector<size_t> &keys, const PullFunc &pull_func, const PendingFilter &pending_filter);
+  // The requests not pulled yet and the rows staged are dropped.
+  void Stop();
+
+  // Request the rows of the ids wanted by the batch of the seq. The ids staged or requested before are not pulled
+  // again, only the batch wanting them last is updated. The data processing is never held up by the prefetch, so the
+  // request is dropped if the queue is full, returns false then.
+  bool Add(size_t seq, const std::vector<int> &ids);
+  // Drop the rows of the ids of the key staged or being pulled, the rows of the server are changed by a push.
+  void Invalidate(size_t key, const std::vector<int> &ids);
+  // Copy the rows staged of the ids of the key to the output at their positions, the rows taken are removed from the
+  // stage and the ids and positions left are returned to be looked up in the server. Returns the number of rows taken.
+  size_t Take(size_t key, size_t embedding_size, float *output, std::vector<int> *ids, std::vector<size_t> *positions);
+  // Drop the rows staged which are wanted by the batches up to the seq only, they've all been processed.
+  void Finish(size_t seq);
+
+  size_t staged_size();
+  size_t hit_num();
+
+ private:
+  void PrefetchTask();
+  void StageRows(const std::vector<int> &request_ids, const std::vector<std::vector<int>> &pulled_ids,
+                 const std::vector<std::vector<float>> &pulled_values, const std::vector<bool> &pulled);
+
+  size_t max_request_num_;
+  std::vector<size_t> keys_;
+  PullFunc pull_func_;
+  PendingFilter pending_filter_;
+  std::thread prefetch_thread_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool running_{false};
+  // The ids requested and not pulled yet of each batch, in the order of the batches.
+  std::deque<std::pair<size_t, std::vector<int>>> requests_;
+  // The ids requested or being pulled, and the last batch wanting them.
+  std::unordered_map<int, size_t> wanted_ids_;
+  // The ids of each key pushed to the server while they're requested or being pulled, whose rows pulled are dropped.
+  std::unordered_map<size_t, std::unordered_set<int>> invalidated_ids_;
+  // The rows staged of each key, and the last batch wanting the ids staged.
+  std::unordered_map<size_t, std::unordered_map<int, std::vector<float>>> staged_rows_;
+  std::unordered_map<int, size_t> staged_ids_;
+  size_t hit_num_{0};
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_PS_CACHE_SERVER_ROW_PREFETCHER_H_
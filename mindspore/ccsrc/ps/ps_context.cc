@@ -172,6 +172,12 @@ void PSContext::set_rank_id(int rank_id) const {
 #endif
 }
 
+void PSContext::set_cache_policy(const std::string &cache_policy) const {
+#if (ENABLE_CPU && !_WIN32)
+  ps_cache_instance.set_cache_policy(CachePolicyFromName(cache_policy));
+#endif
+}
+
 void PSContext::set_server_mode(const std::string &server_mode) {
   if (server_mode != kServerModePS && server_mode != kServerModeFL && server_mode != kServerModeHybrid) {
     MS_LOG(EXCEPTION) << server_mode << " is invalid. Server mode must be " << kServerModePS << " or " << kServerModeFL
@@ -307,6 +313,23 @@ bool PSContext::enable_ssl() const { return enable_ssl_; }
 
 void PSContext::set_enable_ssl(bool enabled) { enable_ssl_ = enabled; }
 
+void PSContext::set_tcp_transport(const std::string &tcp_transport) {
+  if (tcp_transport != kTcpTransportLibevent && tcp_transport != kTcpTransportEpoll) {
+    MS_LOG(EXCEPTION) << tcp_transport << " is invalid. Tcp transport must be " << kTcpTransportLibevent << " or "
+                      << kTcpTransportEpoll;
+    return;
+  }
+  tcp_transport_ = tcp_transport;
+}
+
+const std::string &PSContext::tcp_transport() const { return tcp_transport_; }
+
+void PSContext::set_load_rebalance_interval(uint64_t load_rebalance_interval) {
+  load_rebalance_interval_ = load_rebalance_interval;
+}
+
+uint64_t PSContext::load_rebalance_interval() const { return load_rebalance_interval_; }
+
 core::ClusterConfig &PSContext::cluster_config() {
   if (cluster_config_ == nullptr) {
     MS_LOG(EXCEPTION) << "The cluster config is empty.";
@@ -314,6 +337,12 @@ core::ClusterConfig &PSContext::cluster_config() {
   return *cluster_config_;
 }
 
+void PSContext::set_model_store_memory_budget(uint64_t model_store_memory_budget) {
+  model_store_memory_budget_ = model_store_memory_budget;
+}
+
+uint64_t PSContext::model_store_memory_budget() const { return model_store_memory_budget_; }
+
 void PSContext::set_scheduler_manage_port(uint16_t sched_port) { scheduler_manage_port_ = sched_port; }
 
 uint16_t PSContext::scheduler_manage_port() const { return scheduler_manage_port_; }
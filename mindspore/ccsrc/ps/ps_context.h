@@ -35,6 +35,8 @@ constexpr char kEnvRoleOfServer[] = "MS_SERVER";
 constexpr char kEnvRoleOfWorker[] = "MS_WORKER";
 constexpr char kEnvRoleOfScheduler[] = "MS_SCHED";
 constexpr char kEnvRoleOfNotPS[] = "MS_NOT_PS";
+constexpr char kTcpTransportLibevent[] = "libevent";
+constexpr char kTcpTransportEpoll[] = "epoll";
 
 // Use binary data to represent federated learning server's context so that we can judge which round resets the
 // iteration. From right to left, each bit stands for:
@@ -78,9 +80,19 @@ class PSContext {
   void CloneHashTable(const std::string &dest_param_name, const std::string &src_param_name) const;
   void set_cache_enable(bool cache_enable) const;
   void set_rank_id(int rank_id) const;
+  void set_cache_policy(const std::string &cache_policy) const;
   bool enable_ssl() const;
   void set_enable_ssl(bool enabled);
 
+  // Set the transport of the tcp servers and clients between the workers and the servers, which is libevent or epoll.
+  void set_tcp_transport(const std::string &tcp_transport);
+  const std::string &tcp_transport() const;
+
+  // Set the number of the pushes per dense key after which the first worker moves the hot keys off the most loaded
+  // servers. The keys are not rebalanced if it's 0.
+  void set_load_rebalance_interval(uint64_t load_rebalance_interval);
+  uint64_t load_rebalance_interval() const;
+
   // In new server framework, process role, worker number, server number, scheduler ip and scheduler port should be set
   // by ps_context.
   void set_server_mode(const std::string &server_mode);
@@ -143,6 +155,10 @@ class PSContext {
   void set_client_learning_rate(float client_learning_rate);
   float client_learning_rate() const;
 
+  // Set the memory budget in bytes of the models stored by the federated learning server.
+  void set_model_store_memory_budget(uint64_t model_store_memory_budget);
+  uint64_t model_store_memory_budget() const;
+
   core::ClusterConfig &cluster_config();
 
   void set_scheduler_manage_port(uint16_t sched_port);
@@ -155,6 +171,8 @@ class PSContext {
         is_pserver_(false),
         is_sched_(false),
         enable_ssl_(false),
+        tcp_transport_(kTcpTransportLibevent),
+        load_rebalance_interval_(0),
         rank_id_(-1),
         worker_num_(0),
         server_num_(0),
@@ -174,6 +192,7 @@ class PSContext {
         client_epoch_num_(25),
         client_batch_size_(32),
         client_learning_rate_(0.001),
+        model_store_memory_budget_(0),
         secure_aggregation_(false),
         cluster_config_(nullptr),
         scheduler_manage_port_(0) {}
@@ -182,6 +201,8 @@ class PSContext {
   bool is_pserver_;
   bool is_sched_;
   bool enable_ssl_;
+  std::string tcp_transport_;
+  uint64_t load_rebalance_interval_;
   int rank_id_;
   uint32_t worker_num_;
   uint32_t server_num_;
@@ -230,6 +251,9 @@ class PSContext {
   // Client training learning rate. Used in federated learning for now.
   float client_learning_rate_;
 
+  // The memory budget of the stored models, which is unlimited if it's 0. Used in federated learning for now.
+  uint64_t model_store_memory_budget_;
+
   // Whether to use secure aggregation algorithm. Used in federated learning for now.
   bool secure_aggregation_;
 
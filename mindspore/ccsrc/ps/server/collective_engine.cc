@@ -0,0 +1,253 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/server/collective_engine.h"
+#include <algorithm>
+#include <type_traits>
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+#include "securec/include/securec.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+namespace {
+template <typename T>
+constexpr bool IsFloat() {
+  return std::is_same<T, float>::value;
+}
+}  // namespace
+
+template <typename T>
+bool CollectiveEngine::Send(uint32_t rank_id, T *data, size_t count, std::vector<uint64_t> *send_ids) {
+  MS_ERROR_IF_NULL(data);
+  MS_ERROR_IF_NULL(send_ids);
+  if constexpr (IsFloat<T>()) {
+    if (fp16_compression_) {
+      std::vector<float16> wire(count);
+      for (size_t i = 0; i < count; ++i) {
+        wire[i] = float16(data[i]);
+        data[i] = static_cast<float>(wire[i]);
+      }
+      send_ids->push_back(transport_->SendAsync(rank_id, wire.data(), count * sizeof(float16)));
+      return true;
+    }
+  }
+  send_ids->push_back(transport_->SendAsync(rank_id, data, count * sizeof(T)));
+  return true;
+}
+
+template <typename T>
+bool CollectiveEngine::Receive(uint32_t rank_id, T *data, size_t count, bool reduce) {
+  MS_ERROR_IF_NULL(data);
+  VectorPtr recv;
+  if (!transport_->Receive(rank_id, &recv) || recv == nullptr) {
+    MS_LOG(ERROR) << "Receive from rank " << rank_id << " failed.";
+    return false;
+  }
+  if constexpr (IsFloat<T>()) {
+    if (fp16_compression_) {
+      if (recv->size() != count * sizeof(float16)) {
+        MS_LOG(ERROR) << "Receive " << recv->size() << " bytes from rank " << rank_id << ", but " << count
+                      << " float16 values are expected.";
+        return false;
+      }
+      auto wire = reinterpret_cast<const float16 *>(recv->data());
+      for (size_t i = 0; i < count; ++i) {
+        data[i] = reduce ? data[i] + static_cast<float>(wire[i]) : static_cast<float>(wire[i]);
+      }
+      return true;
+    }
+  }
+  if (recv->size() != count * sizeof(T)) {
+    MS_LOG(ERROR) << "Receive " << recv->size() << " bytes from rank " << rank_id << ", but " << count * sizeof(T)
+                  << " bytes are expected.";
+    return false;
+  }
+  auto wire = reinterpret_cast<const T *>(recv->data());
+  if (reduce) {
+    for (size_t i = 0; i < count; ++i) {
+      data[i] += wire[i];
+    }
+  } else if (count > 0 && memcpy_s(data, count * sizeof(T), wire, recv->size()) != EOK) {
+    MS_LOG(ERROR) << "Copy the data received from rank " << rank_id << " failed.";
+    return false;
+  }
+  return true;
+}
+
+bool CollectiveEngine::WaitSends(std::vector<uint64_t> *send_ids) {
+  MS_ERROR_IF_NULL(send_ids);
+  bool success = true;
+  for (auto send_id : *send_ids) {
+    if (!transport_->WaitSend(send_id)) {
+      MS_LOG(ERROR) << "Wait for the send request " << send_id << " failed.";
+      success = false;
+    }
+  }
+  send_ids->clear();
+  return success;
+}
+
+template <typename T>
+bool CollectiveEngine::RecursiveDoublingAllReduce(T *buff, size_t count) {
+  uint32_t rank_size = transport_->rank_size();
+  uint32_t rank = transport_->rank_id();
+  // With a rank size which is not a power of two, each of the first 2 * remainder even ranks hands its data to the
+  // next odd rank, and gets the result back from it in the end.
+  uint32_t pof2 = 1;
+  while ((pof2 << 1) <= rank_size) {
+    pof2 <<= 1;
+  }
+  uint32_t remainder = rank_size - pof2;
+  bool folded = rank < 2 * remainder && rank % 2 == 0;
+  uint32_t new_rank = rank < 2 * remainder ? rank / 2 : rank - remainder;
+  MS_LOG(DEBUG) << "Recursive doubling AllReduce count:" << count << ", rank_size:" << rank_size
+                << ", rank:" << rank << ", pof2:" << pof2;
+
+  std::vector<uint64_t> send_ids;
+  if (rank < 2 * remainder) {
+    if (folded) {
+      if (!Send(rank + 1, buff, count, &send_ids)) {
+        return false;
+      }
+      if (!WaitSends(&send_ids)) {
+        return false;
+      }
+    } else {
+      if (!Receive(rank - 1, buff, count, true)) {
+        return false;
+      }
+    }
+  }
+  if (!folded) {
+    for (uint32_t mask = 1; mask < pof2; mask <<= 1) {
+      uint32_t new_partner = new_rank ^ mask;
+      uint32_t partner = new_partner < remainder ? new_partner * 2 + 1 : new_partner + remainder;
+      // Both ranks add the same two values, so they get the same result.
+      if (!Send(partner, buff, count, &send_ids)) {
+        return false;
+      }
+      if (!Receive(partner, buff, count, true)) {
+        return false;
+      }
+      if (!WaitSends(&send_ids)) {
+        return false;
+      }
+    }
+  }
+  if constexpr (IsFloat<T>()) {
+    // The sum is rounded like the values the folded ranks receive.
+    if (fp16_compression_) {
+      for (size_t i = 0; i < count; ++i) {
+        buff[i] = static_cast<float>(float16(buff[i]));
+      }
+    }
+  }
+  if (rank < 2 * remainder) {
+    if (folded) {
+      if (!Receive(rank + 1, buff, count, false)) {
+        return false;
+      }
+    } else {
+      if (!Send(rank - 1, buff, count, &send_ids)) {
+        return false;
+      }
+    }
+  }
+  return WaitSends(&send_ids);
+}
+
+template <typename T>
+bool CollectiveEngine::RingAllReduce(T *buff, size_t count) {
+  uint32_t rank_size = transport_->rank_size();
+  uint32_t rank = transport_->rank_id();
+  std::vector<size_t> chunk_sizes(rank_size, count / rank_size);
+  // The rest of the data should be assigned to each chunk.
+  for (size_t i = 0; i < count % rank_size; i++) {
+    chunk_sizes[i]++;
+  }
+  std::vector<size_t> chunk_offsets(rank_size, 0);
+  for (size_t i = 1; i < rank_size; i++) {
+    chunk_offsets[i] = chunk_offsets[i - 1] + chunk_sizes[i - 1];
+  }
+  size_t segment_count = std::max(segment_size_ / sizeof(T), static_cast<size_t>(1));
+  uint32_t send_to_rank = (rank + 1) % rank_size;
+  uint32_t recv_from_rank = (rank + rank_size - 1) % rank_size;
+  MS_LOG(DEBUG) << "Ring AllReduce count:" << count << ", rank_size:" << rank_size << ", rank:" << rank
+                << ", segment_count:" << segment_count;
+
+  // The ring takes rank_size - 1 steps of reduce-scatter and rank_size - 1 steps of all-gather. In both, the chunk
+  // received in one step is the one sent in the next, so each segment is forwarded as soon as it is reduced or copied,
+  // and the last step of reduce-scatter sends the fully reduced chunk of this rank to start the all-gather.
+  std::vector<uint64_t> send_ids;
+  for (size_t offset = 0; offset < chunk_sizes[rank]; offset += segment_count) {
+    size_t size = std::min(segment_count, chunk_sizes[rank] - offset);
+    if (!Send(send_to_rank, buff + chunk_offsets[rank] + offset, size, &send_ids)) {
+      return false;
+    }
+  }
+  size_t step_num = 2 * (rank_size - 1);
+  for (size_t step = 0; step < step_num; ++step) {
+    bool reduce = step < rank_size - 1;
+    size_t chunk = (rank + 2 * rank_size - step - 1) % rank_size;
+    for (size_t offset = 0; offset < chunk_sizes[chunk]; offset += segment_count) {
+      size_t size = std::min(segment_count, chunk_sizes[chunk] - offset);
+      T *segment = buff + chunk_offsets[chunk] + offset;
+      if (!Receive(recv_from_rank, segment, size, reduce)) {
+        return false;
+      }
+      if (step + 1 < step_num) {
+        if (!Send(send_to_rank, segment, size, &send_ids)) {
+          return false;
+        }
+      }
+    }
+  }
+  return WaitSends(&send_ids);
+}
+
+template <typename T>
+bool CollectiveEngine::AllReduce(const void *sendbuff, void *recvbuff, size_t count) {
+  MS_ERROR_IF_NULL(transport_);
+  if (sendbuff == nullptr || recvbuff == nullptr) {
+    MS_LOG(ERROR) << "AllReduce sendbuff or recvbuff is nullptr.";
+    return false;
+  }
+  if (sendbuff != recvbuff && count > 0) {
+    int ret = memcpy_s(recvbuff, count * sizeof(T), sendbuff, count * sizeof(T));
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  uint32_t rank_size = transport_->rank_size();
+  if (rank_size <= 1 || count == 0) {
+    return true;
+  }
+  T *buff = reinterpret_cast<T *>(recvbuff);
+  if (count < rank_size || count * sizeof(T) <= kRecursiveDoublingMaxSize) {
+    return RecursiveDoublingAllReduce<T>(buff, count);
+  }
+  return RingAllReduce<T>(buff, count);
+}
+
+template bool CollectiveEngine::AllReduce<float>(const void *sendbuff, void *recvbuff, size_t count);
+template bool CollectiveEngine::AllReduce<size_t>(const void *sendbuff, void *recvbuff, size_t count);
+template bool CollectiveEngine::AllReduce<int>(const void *sendbuff, void *recvbuff, size_t count);
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
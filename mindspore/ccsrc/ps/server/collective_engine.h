@@ -0,0 +1,89 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_SERVER_COLLECTIVE_ENGINE_H_
+#define MINDSPORE_CCSRC_PS_SERVER_COLLECTIVE_ENGINE_H_
+
+#include <memory>
+#include <vector>
+#include "ps/constants.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+// AllReduce of at most this many bytes uses recursive doubling, which takes log2(rank size) steps.
+constexpr size_t kRecursiveDoublingMaxSize = 64 * 1024;
+// The chunks of the ring are sent in segments of this many bytes, so a rank forwards the first segments of a chunk
+// while the next ones are still arriving.
+constexpr size_t kRingSegmentSize = 1024 * 1024;
+
+// The point to point communication the collective algorithms run on, which is the server node in the cluster.
+class CollectiveTransport {
+ public:
+  virtual ~CollectiveTransport() = default;
+
+  virtual uint32_t rank_id() const = 0;
+  virtual uint32_t rank_size() const = 0;
+
+  // Send the data to the rank without waiting for it. The data is copied before this returns.
+  virtual uint64_t SendAsync(uint32_t rank_id, const void *data, size_t size) = 0;
+  virtual bool WaitSend(uint64_t request_id) = 0;
+
+  // Receive the next message of the rank, the messages of one rank are received in the order they are sent.
+  virtual bool Receive(uint32_t rank_id, VectorPtr *output) = 0;
+};
+
+// CollectiveEngine implements AllReduce on a transport: recursive halving and doubling for small messages, where
+// the latency dominates, and a segmented ring whose reduce-scatter and all-gather are pipelined for large ones, where
+// the bandwidth does. With fp16 compression the float values are sent as float16 and reduced in float, and every rank
+// rounds its own values the same way before sending them, so all the ranks still get the same result.
+class CollectiveEngine {
+ public:
+  explicit CollectiveEngine(const std::shared_ptr<CollectiveTransport> &transport) : transport_(transport) {}
+  ~CollectiveEngine() = default;
+
+  void set_fp16_compression(bool fp16_compression) { fp16_compression_ = fp16_compression; }
+  void set_segment_size(size_t segment_size) { segment_size_ = segment_size; }
+
+  template <typename T>
+  bool AllReduce(const void *sendbuff, void *recvbuff, size_t count);
+
+ private:
+  template <typename T>
+  bool RecursiveDoublingAllReduce(T *buff, size_t count);
+
+  template <typename T>
+  bool RingAllReduce(T *buff, size_t count);
+
+  // Send the values to the rank and record the request to wait for. With fp16 compression the values are rounded to
+  // the precision sent.
+  template <typename T>
+  bool Send(uint32_t rank_id, T *data, size_t count, std::vector<uint64_t> *send_ids);
+
+  // Receive count values from the rank, and add them to the data or copy them into it.
+  template <typename T>
+  bool Receive(uint32_t rank_id, T *data, size_t count, bool reduce);
+
+  bool WaitSends(std::vector<uint64_t> *send_ids);
+
+  std::shared_ptr<CollectiveTransport> transport_;
+  bool fp16_compression_{false};
+  size_t segment_size_{kRingSegmentSize};
+};
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_SERVER_COLLECTIVE_ENGINE_H_
@@ -25,13 +25,14 @@
 #include "ps/ps_context.h"
 #include "ps/core/server_node.h"
 #include "ps/server/common.h"
+#include "ps/server/collective_engine.h"
 
 namespace mindspore {
 namespace ps {
 namespace server {
-// CollectiveOpsImpl is the collective communication API of the server.
-// For now, it implements two AllReduce algorithms: RingAllReduce and BroadcastAllReduce. Elastic AllReduce is also
-// supported for the elastic scaling feature of the server.
+// CollectiveOpsImpl is the collective communication API of the server, which runs the algorithms of CollectiveEngine
+// over the server node. Setting the environment variable MS_SERVER_ALLREDUCE_FP16 to 1 sends the float values as
+// float16.
 class CollectiveOpsImpl {
  public:
   static CollectiveOpsImpl &GetInstance() {
@@ -50,17 +51,8 @@ class CollectiveOpsImpl {
   CollectiveOpsImpl(const CollectiveOpsImpl &) = delete;
   CollectiveOpsImpl &operator=(const CollectiveOpsImpl &) = delete;
 
-  // Implementation of RingAllReduce.
-  template <typename T>
-  bool RingAllReduce(const void *sendbuff, void *recvbuff, size_t count);
-
-  // Implementation of BroadcastAllReduce.
-  template <typename T>
-  bool ReduceBroadcastAllReduce(const void *sendbuff, void *recvbuff, size_t count);
-
   std::shared_ptr<core::ServerNode> server_node_;
-  uint32_t local_rank_;
-  uint32_t server_num_;
+  std::unique_ptr<CollectiveEngine> engine_;
 
   // The mutex to ensure that collective communication is threadsafe.
   std::mutex mtx_;
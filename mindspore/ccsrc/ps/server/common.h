@@ -82,6 +82,12 @@ using UploadData = std::map<std::string, Address>;
 
 constexpr auto kWeight = "weight";
 constexpr auto kNewWeight = "new_weight";
+// An update could be compressed: the int8 values with the scales and the size of their blocks, or the top-k values in
+// kNewWeight with their indices.
+constexpr auto kNewWeightInt8 = "new_weight_int8";
+constexpr auto kNewWeightQuantScales = "new_weight_quant_scales";
+constexpr auto kNewWeightQuantBlockSize = "new_weight_quant_block_size";
+constexpr auto kNewWeightIndices = "new_weight_indices";
 constexpr auto kAccumulation = "accum";
 constexpr auto kLearningRate = "lr";
 constexpr auto kGradient = "grad";
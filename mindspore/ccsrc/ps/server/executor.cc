@@ -93,9 +93,19 @@ bool Executor::HandleModelUpdate(const std::string &param_name, const UploadData
     return true;
   }
 
+  // A streaming aggregator accumulates the update without the lock of the parameter, so the updates of many clients
+  // are aggregated at the same time.
+  auto &param_aggr = param_aggrs_.at(param_name);
+  if (param_aggr->IsStreaming()) {
+    if (!param_aggr->AccumulateUploadData(upload_data)) {
+      MS_LOG(ERROR) << "Accumulating data for parameter " << param_name << " failed.";
+      return false;
+    }
+    return true;
+  }
+
   std::mutex &mtx = parameter_mutex_[param_name];
   std::unique_lock<std::mutex> lock(mtx);
-  auto &param_aggr = param_aggrs_[param_name];
 
   if (!param_aggr->UpdateData(upload_data)) {
     MS_LOG(ERROR) << "Updating data for parameter " << param_name << " failed.";
@@ -118,11 +128,18 @@ bool Executor::HandleModelUpdateAsync(const std::map<std::string, UploadData> &f
       continue;
     }
 
+    const UploadData &upload_data = trainable_param.second;
+    auto &param_aggr = param_aggrs_.at(param_name);
+    if (param_aggr->IsStreaming()) {
+      if (!param_aggr->AccumulateUploadData(upload_data)) {
+        MS_LOG(ERROR) << "Accumulating data for parameter " << param_name << " failed.";
+        return false;
+      }
+      continue;
+    }
+
     std::mutex &mtx = parameter_mutex_[param_name];
     std::unique_lock<std::mutex> lock(mtx);
-    auto &param_aggr = param_aggrs_[param_name];
-
-    const UploadData &upload_data = trainable_param.second;
     if (!param_aggr->UpdateData(upload_data)) {
       MS_LOG(ERROR) << "Updating data for parameter " << param_name << " failed.";
       return false;
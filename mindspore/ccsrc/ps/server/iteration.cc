@@ -64,8 +64,7 @@ void Iteration::ProceedToNextIter(bool is_iteration_valid) {
     MS_LOG(INFO) << "Iteration " << iteration_num_ << " is successfully finished.";
   } else {
     // Store last iteration's model because this iteration is considered as invalid.
-    const auto &model = ModelStore::GetInstance().GetModelByIterNum(iteration_num_ - 1);
-    ModelStore::GetInstance().StoreModelByIterNum(iteration_num_, model);
+    ModelStore::GetInstance().CopyModelByIterNum(iteration_num_ - 1, iteration_num_);
     MS_LOG(WARNING) << "Iteration " << iteration_num_ << " is invalid.";
   }
 
@@ -45,6 +45,14 @@ class AggregationKernel : public CPUKernel {
     return true;
   }
 
+  // Some kernels accumulate the uploaded data directly instead of their inputs, so the data needn't be copied to the
+  // inputs first and the kernel could be called concurrently. For example, FedAvgKernel.
+  virtual bool IsStreaming() const { return false; }
+  virtual bool Accumulate(const UploadData &upload_data) {
+    MS_LOG(ERROR) << "Aggregation kernel " << name_ << " can't accumulate the uploaded data directly.";
+    return false;
+  }
+
   // Server kernel's memory allocation method, which is different from the workflow in
   // Session(GPUSession/CPUSession/AscendSession).
   // virtual void AssignMemory(const CNodePtr &kernel_node, std::shared_ptr<MemoryRegister> memory_register) = 0;
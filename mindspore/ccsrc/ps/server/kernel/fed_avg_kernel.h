@@ -19,6 +19,8 @@
 
 #include <memory>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <functional>
@@ -27,6 +29,7 @@
 #include "ps/server/collective_ops_impl.h"
 #include "ps/server/distributed_count_service.h"
 #include "ps/server/local_meta_store.h"
+#include "ps/server/update_accumulator.h"
 #include "ps/server/kernel/aggregation_kernel.h"
 #include "ps/server/kernel/aggregation_kernel_factory.h"
 
@@ -39,8 +42,13 @@ namespace kernel {
 
 // Pay attention that this kernel is the distributed version of federated average, which means each server node in the
 // cluster in invalved in the aggragation process. So the DistributedCountService and CollectiveOpsImpl are called.
+
+// The updates are summed by an UpdateAccumulator, so the updates of many clients are accumulated concurrently and the
+// compressed ones are decompressed on the fly. The sum is written to the weight only when the round ends.
 template <typename T, typename S>
 class FedAvgKernel : public AggregationKernel {
+  static_assert(std::is_same<T, float>::value, "FedAvgKernel only accumulates float weights.");
+
  public:
   FedAvgKernel() : participated_(false) {}
   ~FedAvgKernel() override = default;
@@ -63,6 +71,7 @@ class FedAvgKernel : public AggregationKernel {
     input_size_list_.push_back(sizeof(size_t));
     input_size_list_.push_back(new_weight_size);
     input_size_list_.push_back(sizeof(size_t));
+    accumulator_.Initialize(weight_size / sizeof(T), std::thread::hardware_concurrency());
 
     auto weight_node =
       AnfAlgo::VisitKernelWithReturnType(AnfAlgo::GetInputNode(kernel_node, cnode_weight_idx_), 0).first;
@@ -79,6 +88,7 @@ class FedAvgKernel : public AggregationKernel {
       T *weight_addr = reinterpret_cast<T *>(weight_addr_->addr);
       size_t weight_size = weight_addr_->size;
       S *data_size_addr = reinterpret_cast<S *>(data_size_addr_->addr);
+      data_size_addr[0] = accumulator_.Merge(weight_addr);
       if (!CollectiveOpsImpl::GetInstance().AllReduce<T>(weight_addr, weight_addr, weight_size / sizeof(T))) {
         MS_LOG(ERROR) << "Federated average allreduce failed.";
         return;
@@ -100,35 +110,74 @@ class FedAvgKernel : public AggregationKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override {
-    std::unique_lock<std::mutex> lock(weight_mutex_);
     // The weight and new_weight values should be multiplied by clients already, so we don't need to do multiplication
     // again.
-    T *weight_addr = reinterpret_cast<T *>(inputs[0]->addr);
-    S *data_size_addr = reinterpret_cast<S *>(inputs[1]->addr);
     T *new_weight_addr = reinterpret_cast<T *>(inputs[2]->addr);
     S *new_data_size_addr = reinterpret_cast<S *>(inputs[3]->addr);
-    if (accum_count_ == 0) {
-      ClearWeightAndDataSize();
-    }
-
     MS_LOG(DEBUG) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
-                  << name_ << " new data size is " << new_data_size_addr[0] << ", current total data size is "
-                  << data_size_addr[0];
-    for (size_t i = 0; i < inputs[2]->size / sizeof(T); i++) {
-      weight_addr[i] += new_weight_addr[i];
+                  << name_ << " new data size is " << new_data_size_addr[0];
+    if (!accumulator_.AccumulateDense(new_weight_addr, inputs[2]->size / sizeof(T), new_data_size_addr[0])) {
+      MS_LOG(ERROR) << "Accumulating the new weight of " << name_ << " failed.";
+      return false;
     }
-    data_size_addr[0] += new_data_size_addr[0];
-    lock.unlock();
+    CountUpdate();
+    return true;
+  }
 
-    accum_count_++;
-    participated_ = true;
-    DistributedCountService::GetInstance().Count(
-      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(accum_count_));
-    GenerateReuseKernelNodeInfo();
+  bool IsStreaming() const override { return true; }
+
+  // Accumulate an update straight from the uploaded data, which is the float new weight, its top-k values with the
+  // indices or the int8 values with the scales.
+  bool Accumulate(const UploadData &upload_data) override {
+    auto new_data_size = upload_data.find(kNewDataSize);
+    if (new_data_size == upload_data.end() || new_data_size->second.addr == nullptr) {
+      MS_LOG(ERROR) << "The new data size of " << name_ << " is not uploaded.";
+      return false;
+    }
+    S data_size = *reinterpret_cast<S *>(new_data_size->second.addr);
+    bool ret = false;
+    if (upload_data.count(kNewWeightInt8) != 0) {
+      const Address &int8_data = upload_data.at(kNewWeightInt8);
+      auto block_size = upload_data.find(kNewWeightQuantBlockSize);
+      if (upload_data.count(kNewWeightQuantScales) == 0 || block_size == upload_data.end() ||
+          block_size->second.addr == nullptr) {
+        MS_LOG(ERROR) << "The int8 new weight of " << name_ << " has no scales or block size.";
+        return false;
+      }
+      const Address &scales = upload_data.at(kNewWeightQuantScales);
+      ret = accumulator_.AccumulateInt8(reinterpret_cast<int8_t *>(int8_data.addr), int8_data.size / sizeof(int8_t),
+                                        reinterpret_cast<float *>(scales.addr), scales.size / sizeof(float),
+                                        *reinterpret_cast<size_t *>(block_size->second.addr), data_size);
+    } else if (upload_data.count(kNewWeight) != 0) {
+      const Address &new_weight = upload_data.at(kNewWeight);
+      if (upload_data.count(kNewWeightIndices) != 0) {
+        const Address &indices = upload_data.at(kNewWeightIndices);
+        if (indices.size / sizeof(int) != new_weight.size / sizeof(T)) {
+          MS_LOG(ERROR) << "The sparse new weight of " << name_ << " has " << new_weight.size / sizeof(T)
+                        << " values but " << indices.size / sizeof(int) << " indices.";
+          return false;
+        }
+        ret = accumulator_.AccumulateSparse(reinterpret_cast<int *>(indices.addr),
+                                            reinterpret_cast<float *>(new_weight.addr), indices.size / sizeof(int),
+                                            data_size);
+      } else {
+        ret = accumulator_.AccumulateDense(reinterpret_cast<float *>(new_weight.addr), new_weight.size / sizeof(T),
+                                           data_size);
+      }
+    } else {
+      MS_LOG(ERROR) << "The new weight of " << name_ << " is not uploaded.";
+      return false;
+    }
+    if (!ret) {
+      MS_LOG(ERROR) << "Accumulating the new weight of " << name_ << " failed.";
+      return false;
+    }
+    CountUpdate();
     return true;
   }
 
   void Reset() override {
+    accumulator_.Reset();
     accum_count_ = 0;
     done_ = false;
     participated_ = false;
@@ -155,6 +204,19 @@ class FedAvgKernel : public AggregationKernel {
     return;
   }
 
+  // Report the accumulated update to the counter, whose last count merges the updates of this round.
+  void CountUpdate() {
+    size_t accum_count;
+    {
+      std::unique_lock<std::mutex> lock(weight_mutex_);
+      accum_count = ++accum_count_;
+      participated_ = true;
+      GenerateReuseKernelNodeInfo();
+    }
+    DistributedCountService::GetInstance().Count(
+      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(accum_count));
+  }
+
   // In some cases, the Launch method is not called and the weights involved in AllReduce should be set to 0.
   void ClearWeightAndDataSize() {
     int ret = memset_s(weight_addr_->addr, weight_addr_->size, 0x00, weight_addr_->size);
@@ -182,6 +244,9 @@ class FedAvgKernel : public AggregationKernel {
   // Whether the kernel's Launch method is called.
   bool participated_;
 
+  // The sum of the updates of this round.
+  UpdateAccumulator accumulator_;
+
   // The kernel could be called concurrently so we need lock to ensure threadsafe.
   std::mutex weight_mutex_;
 };
@@ -62,53 +62,109 @@ bool GetModelKernel::Reset() {
 }
 
 void GetModelKernel::GetModel(const schema::RequestGetModel *get_model_req, const std::shared_ptr<FBBuilder> &fbb) {
-  std::map<std::string, AddressPtr> feature_maps;
+  ModelVersionPtr model = nullptr;
   size_t current_iter = LocalMetaStore::GetInstance().curr_iter_num();
   size_t get_model_iter = static_cast<size_t>(get_model_req->iteration());
-  const auto &iter_to_model = ModelStore::GetInstance().iteration_to_model();
-  size_t latest_iter_num = iter_to_model.rbegin()->first;
+  size_t latest_iter_num = ModelStore::GetInstance().latest_iteration();
+  std::string timestamp =
+    std::to_string(LocalMetaStore::GetInstance().value<uint64_t>(kCtxIterationNextRequestTimestamp));
 
   // If this iteration is not finished yet, return ResponseCode_SucNotReady so that clients could get model later.
   if ((current_iter == get_model_iter && latest_iter_num != current_iter) || current_iter == get_model_iter - 1) {
     std::string reason = "The model is not ready yet for iteration " + std::to_string(get_model_iter);
-    BuildGetModelRsp(fbb, schema::ResponseCode_SucNotReady, reason, current_iter, feature_maps,
-                     std::to_string(LocalMetaStore::GetInstance().value<uint64_t>(kCtxIterationNextRequestTimestamp)));
+    (void)BuildGetModelRsp(fbb, schema::ResponseCode_SucNotReady, reason, current_iter, model, nullptr, timestamp);
     MS_LOG(WARNING) << reason;
     return;
   }
 
-  if (iter_to_model.count(get_model_iter) == 0) {
+  // The models could be evicted at any time, so each one is looked up only once and a missing one is handled after.
+  model = ModelStore::GetInstance().GetModelByIterNum(get_model_iter);
+  if (model == nullptr) {
     // If the model of get_model_iter is not stored, return the latest version of model and current iteration number.
     MS_LOG(WARNING) << "The iteration of GetModel request " << std::to_string(get_model_iter)
                     << " is invalid. Current iteration is " << std::to_string(current_iter);
-    feature_maps = ModelStore::GetInstance().GetModelByIterNum(latest_iter_num);
-  } else {
-    feature_maps = ModelStore::GetInstance().GetModelByIterNum(get_model_iter);
+    model = ModelStore::GetInstance().GetModelByIterNum(ModelStore::GetInstance().latest_iteration());
+  }
+  if (model == nullptr) {
+    std::string reason = "No model is stored for iteration " + std::to_string(get_model_iter);
+    (void)BuildGetModelRsp(fbb, schema::ResponseCode_SucNotReady, reason, current_iter, nullptr, nullptr, timestamp);
+    MS_LOG(WARNING) << reason;
+    return;
+  }
+
+  // If the client still has the model of a stored iteration, only the pages changed since then are returned.
+  // Otherwise the whole model is returned.
+  ModelVersionPtr base_model = nullptr;
+  int base_iter = get_model_req->base_iteration();
+  if (base_iter >= 0) {
+    base_model = ModelStore::GetInstance().GetModelByIterNum(static_cast<size_t>(base_iter));
   }
 
   // If the iteration of this model is invalid, return ResponseCode_OutOfTime to the clients could startFLJob according
   // to next_req_time.
   auto response_code =
     Iteration::GetInstance().is_last_iteration_valid() ? schema::ResponseCode_SUCCEED : schema::ResponseCode_OutOfTime;
-  BuildGetModelRsp(fbb, response_code, "Get model for iteration " + std::to_string(get_model_iter), current_iter,
-                   feature_maps,
-                   std::to_string(LocalMetaStore::GetInstance().value<uint64_t>(kCtxIterationNextRequestTimestamp)));
+  if (!BuildGetModelRsp(fbb, response_code, "Get model for iteration " + std::to_string(get_model_iter), current_iter,
+                        model, base_model, timestamp)) {
+    // The response built so far has weights which are not copied, so it's dropped and only the error is returned.
+    std::string reason = "Copying the model of iteration " + std::to_string(model->iteration()) + " failed.";
+    fbb->Clear();
+    (void)BuildGetModelRsp(fbb, schema::ResponseCode_SystemError, reason, current_iter, nullptr, nullptr, timestamp);
+    MS_LOG(ERROR) << reason;
+  }
   return;
 }
 
-void GetModelKernel::BuildGetModelRsp(const std::shared_ptr<FBBuilder> &fbb, const schema::ResponseCode retcode,
-                                      const std::string &reason, const size_t iter,
-                                      const std::map<std::string, AddressPtr> &feature_maps,
-                                      const std::string &timestamp) {
+bool GetModelKernel::BuildGetModelRsp(const std::shared_ptr<FBBuilder> &fbb, const schema::ResponseCode retcode,
+                                      const std::string &reason, const size_t iter, const ModelVersionPtr &model,
+                                      const ModelVersionPtr &base_model, const std::string &timestamp) {
   auto fbs_reason = fbb->CreateString(reason);
   auto fbs_timestamp = fbb->CreateString(timestamp);
+  constexpr size_t kPageElementNum = kModelPageSize / sizeof(float);
   std::vector<flatbuffers::Offset<schema::FeatureMap>> fbs_feature_maps;
-  for (const auto &feature_map : feature_maps) {
-    auto fbs_weight_fullname = fbb->CreateString(feature_map.first);
-    auto fbs_weight_data =
-      fbb->CreateVector(reinterpret_cast<float *>(feature_map.second->addr), feature_map.second->size / sizeof(float));
-    auto fbs_feature_map = schema::CreateFeatureMap(*(fbb.get()), fbs_weight_fullname, fbs_weight_data);
-    fbs_feature_maps.push_back(fbs_feature_map);
+  size_t sent_size = 0;
+  if (model != nullptr) {
+    for (const auto &weight : model->weights()) {
+      const std::string &weight_name = weight.first;
+      const WeightPages &pages = weight.second;
+      // The pages are copied into the response buffer directly.
+      float *weight_data = nullptr;
+      if (base_model == nullptr) {
+        auto fbs_weight_fullname = fbb->CreateString(weight_name);
+        auto fbs_weight_data = fbb->CreateUninitializedVector(pages.size / sizeof(float), &weight_data);
+        if (!model->CopyWeight(weight_name, weight_data, pages.size)) {
+          MS_LOG(ERROR) << "Copying weight " << weight_name << " to the response failed.";
+          return false;
+        }
+        fbs_feature_maps.push_back(schema::CreateFeatureMap(*(fbb.get()), fbs_weight_fullname, fbs_weight_data));
+        sent_size += pages.size;
+        continue;
+      }
+
+      std::vector<size_t> changed_pages = model->ChangedPages(weight_name, *base_model);
+      if (changed_pages.empty()) {
+        continue;
+      }
+      std::vector<int> indices;
+      size_t delta_size = 0;
+      for (size_t page : changed_pages) {
+        indices.push_back(static_cast<int>(page * kPageElementNum));
+        delta_size += pages.pages[page]->size();
+      }
+      auto fbs_weight_fullname = fbb->CreateString(weight_name);
+      auto fbs_weight_data = fbb->CreateUninitializedVector(delta_size / sizeof(float), &weight_data);
+      if (!model->CopyPages(weight_name, changed_pages, weight_data, delta_size)) {
+        MS_LOG(ERROR) << "Copying the changed pages of weight " << weight_name << " to the response failed.";
+        return false;
+      }
+      auto fbs_indices = fbb->CreateVector(indices);
+      fbs_feature_maps.push_back(
+        schema::CreateFeatureMap(*(fbb.get()), fbs_weight_fullname, fbs_weight_data, 0, 0, fbs_indices));
+      sent_size += delta_size;
+    }
+    MS_LOG(DEBUG) << "Return " << sent_size << " bytes of the model of iteration " << model->iteration()
+                  << (base_model == nullptr ? "" : " as the delta from iteration " +
+                                                     std::to_string(base_model->iteration()));
   }
   auto fbs_feature_maps_vector = fbb->CreateVector(fbs_feature_maps);
 
@@ -118,9 +174,13 @@ void GetModelKernel::BuildGetModelRsp(const std::shared_ptr<FBBuilder> &fbb, con
   rsp_get_model_builder.add_iteration(static_cast<int>(iter));
   rsp_get_model_builder.add_feature_map(fbs_feature_maps_vector);
   rsp_get_model_builder.add_timestamp(fbs_timestamp);
+  if (base_model != nullptr) {
+    rsp_get_model_builder.add_base_iteration(static_cast<int>(base_model->iteration()));
+    rsp_get_model_builder.add_delta_page_size(static_cast<int>(kPageElementNum));
+  }
   auto rsp_get_model = rsp_get_model_builder.Finish();
   fbb->Finish(rsp_get_model);
-  return;
+  return true;
 }
 
 REG_ROUND_KERNEL(getModel, GetModelKernel)
@@ -23,6 +23,7 @@
 #include <vector>
 #include "ps/server/common.h"
 #include "ps/server/executor.h"
+#include "ps/server/model_version.h"
 #include "ps/server/kernel/round/round_kernel.h"
 #include "ps/server/kernel/round/round_kernel_factory.h"
 
@@ -42,9 +43,11 @@ class GetModelKernel : public RoundKernel {
 
  private:
   void GetModel(const schema::RequestGetModel *get_model_req, const std::shared_ptr<FBBuilder> &fbb);
-  void BuildGetModelRsp(const std::shared_ptr<FBBuilder> &fbb, const schema::ResponseCode retcode,
-                        const std::string &reason, const size_t iter,
-                        const std::map<std::string, AddressPtr> &feature_maps, const std::string &timestamp);
+  // Build the response with the model, or with the delta from the base model if the base isn't nullptr. Returns false
+  // if the model could not be copied into the response, in which case the builder must be cleared.
+  bool BuildGetModelRsp(const std::shared_ptr<FBBuilder> &fbb, const schema::ResponseCode retcode,
+                        const std::string &reason, const size_t iter, const ModelVersionPtr &model,
+                        const ModelVersionPtr &base_model, const std::string &timestamp);
 
   // The executor is for getting model for getModel request.
   Executor *executor_;
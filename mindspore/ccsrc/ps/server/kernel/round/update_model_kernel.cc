@@ -139,7 +139,8 @@ bool UpdateModelKernel::UpdateModel(const schema::RequestUpdateModel *update_mod
   }
 
   size_t data_size = fl_id_to_meta.fl_id_to_meta().at(update_model_fl_id).data_size();
-  auto feature_map = ParseFeatureMap(update_model_req);
+  std::map<std::string, size_t> quant_block_sizes;
+  auto feature_map = ParseFeatureMap(update_model_req, &quant_block_sizes);
   if (feature_map.empty()) {
     std::string reason = "Feature map is empty.";
     BuildUpdateModelRsp(
@@ -174,17 +175,41 @@ bool UpdateModelKernel::UpdateModel(const schema::RequestUpdateModel *update_mod
 }
 
 std::map<std::string, UploadData> UpdateModelKernel::ParseFeatureMap(
-  const schema::RequestUpdateModel *update_model_req) {
+  const schema::RequestUpdateModel *update_model_req, std::map<std::string, size_t> *quant_block_sizes) {
   RETURN_IF_NULL(update_model_req, {});
+  RETURN_IF_NULL(quant_block_sizes, {});
   std::map<std::string, UploadData> feature_map;
   auto fbs_feature_map = update_model_req->feature_map();
   for (size_t i = 0; i < fbs_feature_map->size(); i++) {
-    std::string weight_full_name = fbs_feature_map->Get(i)->weight_fullname()->str();
-    float *weight_data = const_cast<float *>(fbs_feature_map->Get(i)->data()->data());
-    size_t weight_size = fbs_feature_map->Get(i)->data()->size() * sizeof(float);
+    auto fbs_weight = fbs_feature_map->Get(i);
+    std::string weight_full_name = fbs_weight->weight_fullname()->str();
     UploadData upload_data;
-    upload_data[kNewWeight].addr = weight_data;
-    upload_data[kNewWeight].size = weight_size;
+    // The compressed updates point to the request buffer as well, and are decompressed by the aggregation kernels.
+    if (fbs_weight->int8_data() != nullptr && fbs_weight->int8_data()->size() != 0) {
+      RETURN_IF_NULL(fbs_weight->quant_scales(), {});
+      if (fbs_weight->quant_block_size() <= 0) {
+        MS_LOG(ERROR) << "The int8 weight " << weight_full_name << " has invalid block size "
+                      << fbs_weight->quant_block_size();
+        return {};
+      }
+      size_t &quant_block_size = (*quant_block_sizes)[weight_full_name];
+      quant_block_size = static_cast<size_t>(fbs_weight->quant_block_size());
+      upload_data[kNewWeightQuantBlockSize].addr = &quant_block_size;
+      upload_data[kNewWeightQuantBlockSize].size = sizeof(size_t);
+      upload_data[kNewWeightInt8].addr = const_cast<int8_t *>(fbs_weight->int8_data()->data());
+      upload_data[kNewWeightInt8].size = fbs_weight->int8_data()->size() * sizeof(int8_t);
+      upload_data[kNewWeightQuantScales].addr = const_cast<float *>(fbs_weight->quant_scales()->data());
+      upload_data[kNewWeightQuantScales].size = fbs_weight->quant_scales()->size() * sizeof(float);
+      feature_map[weight_full_name] = upload_data;
+      continue;
+    }
+    RETURN_IF_NULL(fbs_weight->data(), {});
+    upload_data[kNewWeight].addr = const_cast<float *>(fbs_weight->data()->data());
+    upload_data[kNewWeight].size = fbs_weight->data()->size() * sizeof(float);
+    if (fbs_weight->indices() != nullptr && fbs_weight->indices()->size() != 0) {
+      upload_data[kNewWeightIndices].addr = const_cast<int *>(fbs_weight->indices()->data());
+      upload_data[kNewWeightIndices].size = fbs_weight->indices()->size() * sizeof(int);
+    }
     feature_map[weight_full_name] = upload_data;
   }
   return feature_map;
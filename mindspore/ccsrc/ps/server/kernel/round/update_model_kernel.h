@@ -49,7 +49,9 @@ class UpdateModelKernel : public RoundKernel {
  private:
   bool ReachThresholdForUpdateModel(const std::shared_ptr<FBBuilder> &fbb);
   bool UpdateModel(const schema::RequestUpdateModel *update_model_req, const std::shared_ptr<FBBuilder> &fbb);
-  std::map<std::string, UploadData> ParseFeatureMap(const schema::RequestUpdateModel *update_model_req);
+  // The block sizes of the int8 weights are kept in quant_block_sizes, which the upload data points to.
+  std::map<std::string, UploadData> ParseFeatureMap(const schema::RequestUpdateModel *update_model_req,
+                                                    std::map<std::string, size_t> *quant_block_sizes);
   bool CountForUpdateModel(const std::shared_ptr<FBBuilder> &fbb, const schema::RequestUpdateModel *update_model_req);
   void BuildUpdateModelRsp(const std::shared_ptr<FBBuilder> &fbb, const schema::ResponseCode retcode,
                            const std::string &reason, const std::string &next_req_time);
@@ -18,24 +18,38 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <unordered_set>
 #include "ps/server/executor.h"
 
 namespace mindspore {
 namespace ps {
 namespace server {
-void ModelStore::Initialize(uint32_t max_count) {
+void ModelStore::Initialize(uint32_t max_count, size_t memory_budget) {
   if (!Executor::GetInstance().initialized()) {
     MS_LOG(EXCEPTION) << "Server's executor must be initialized before model storage.";
     return;
   }
 
+  std::map<std::string, AddressPtr> model = Executor::GetInstance().GetModel();
+  if (model.empty()) {
+    MS_LOG(EXCEPTION) << "Model feature map is empty.";
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
   max_model_count_ = max_count;
-  initial_model_ = AssignNewModelMemory();
-  iteration_to_model_[kInitIterationNum] = initial_model_;
+  memory_budget_ = memory_budget;
+  iteration_to_model_.clear();
+  AddModel(kInitIterationNum, ModelVersion::Build(kInitIterationNum, model, nullptr));
   model_size_ = ComputeModelSize();
+  if (memory_budget_ == 0) {
+    MS_LOG(INFO) << "Model store keeps at most " << max_model_count_ << " models.";
+  } else {
+    MS_LOG(INFO) << "Model store keeps the models within " << memory_budget_ << " bytes.";
+  }
 }
 
 bool ModelStore::StoreModelByIterNum(size_t iteration, const std::map<std::string, AddressPtr> &new_model) {
+  std::unique_lock<std::mutex> lock(mutex_);
   if (iteration_to_model_.count(iteration) != 0) {
     MS_LOG(WARNING) << "Model for iteration " << iteration << " is already stored";
     return false;
@@ -45,99 +59,116 @@ bool ModelStore::StoreModelByIterNum(size_t iteration, const std::map<std::strin
     return false;
   }
 
-  std::shared_ptr<MemoryRegister> memory_register;
-  if (iteration_to_model_.size() < max_model_count_) {
-    // If iteration_to_model_.size() is not max_model_count_, need to assign new memory for the model.
-    memory_register = AssignNewModelMemory();
-    if (memory_register == nullptr) {
-      MS_LOG(ERROR) << "Memory for the new model is nullptr.";
-      return false;
-    }
-    iteration_to_model_[iteration] = memory_register;
-  } else {
-    // If iteration_to_model_ size is already max_model_count_, we need to replace earliest model with the newest model.
-    memory_register = iteration_to_model_.begin()->second;
-    if (memory_register == nullptr) {
-      MS_LOG(ERROR) << "Earliest model is nullptr.";
-      return false;
-    }
-    iteration_to_model_.erase(iteration_to_model_.begin());
-  }
-
-  // Copy new model data to the the stored model.
-  auto &stored_model = memory_register->addresses();
-  for (const auto &weight : new_model) {
-    const std::string &weight_name = weight.first;
-    if (stored_model.count(weight_name) == 0) {
-      MS_LOG(ERROR) << "The stored model has no weight " << weight_name;
-      continue;
-    }
+  // The pages not changed since the latest model are shared with it. The model is built without the lock so the
+  // clients could still get the stored models meanwhile.
+  ModelVersionPtr latest_model = iteration_to_model_.empty() ? nullptr : iteration_to_model_.rbegin()->second.model;
+  lock.unlock();
+  ModelVersionPtr model = ModelVersion::Build(iteration, new_model, latest_model);
+  lock.lock();
+  AddModel(iteration, model);
+  return true;
+}
 
-    void *dst_addr = stored_model[weight_name]->addr;
-    size_t dst_size = stored_model[weight_name]->size;
-    void *src_addr = weight.second->addr;
-    size_t src_size = weight.second->size;
-    int ret = memcpy_s(dst_addr, dst_size, src_addr, src_size);
-    if (ret != 0) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-      return false;
-    }
+bool ModelStore::CopyModelByIterNum(size_t source_iteration, size_t iteration) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (iteration_to_model_.count(iteration) != 0) {
+    MS_LOG(WARNING) << "Model for iteration " << iteration << " is already stored";
+    return false;
+  }
+  if (iteration_to_model_.count(source_iteration) == 0) {
+    MS_LOG(ERROR) << "Model for iteration " << source_iteration << " is not stored.";
+    return false;
   }
-  iteration_to_model_[iteration] = memory_register;
+  AddModel(iteration, ModelVersion::Share(iteration, *iteration_to_model_[source_iteration].model));
   return true;
 }
 
-std::map<std::string, AddressPtr> ModelStore::GetModelByIterNum(size_t iteration) {
-  std::map<std::string, AddressPtr> model = {};
-  if (iteration_to_model_.count(iteration) == 0) {
-    MS_LOG(ERROR) << "Model for iteration " << iteration << " is not stored.";
-    return model;
+ModelVersionPtr ModelStore::GetModelByIterNum(size_t iteration) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto iter = iteration_to_model_.find(iteration);
+  if (iter == iteration_to_model_.end()) {
+    MS_LOG(INFO) << "Model for iteration " << iteration << " is not stored.";
+    return nullptr;
   }
-  model = iteration_to_model_[iteration]->addresses();
-  return model;
+  iter->second.last_access = ++access_clock_;
+  return iter->second.model;
 }
 
 void ModelStore::Reset() {
-  initial_model_ = iteration_to_model_.rbegin()->second;
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (iteration_to_model_.empty()) {
+    return;
+  }
+  ModelVersionPtr initial_model = ModelVersion::Share(kInitIterationNum, *iteration_to_model_.rbegin()->second.model);
   iteration_to_model_.clear();
-  iteration_to_model_[kInitIterationNum] = initial_model_;
+  AddModel(kInitIterationNum, initial_model);
 }
 
-const std::map<size_t, std::shared_ptr<MemoryRegister>> &ModelStore::iteration_to_model() const {
-  return iteration_to_model_;
+bool ModelStore::HasModel(size_t iteration) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return iteration_to_model_.count(iteration) != 0;
+}
+
+size_t ModelStore::latest_iteration() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (iteration_to_model_.empty()) {
+    MS_LOG(EXCEPTION) << "Model store is not initialized.";
+  }
+  return iteration_to_model_.rbegin()->first;
 }
 
 size_t ModelStore::model_size() const { return model_size_; }
 
-std::shared_ptr<MemoryRegister> ModelStore::AssignNewModelMemory() {
-  std::map<std::string, AddressPtr> model = Executor::GetInstance().GetModel();
-  if (model.empty()) {
-    MS_LOG(EXCEPTION) << "Model feature map is empty.";
-    return nullptr;
-  }
+size_t ModelStore::memory_usage() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return ComputeMemoryUsage();
+}
 
-  // Assign new memory for the model.
-  std::shared_ptr<MemoryRegister> memory_register = std::make_shared<MemoryRegister>();
-  for (const auto &weight : model) {
-    const std::string weight_name = weight.first;
-    size_t weight_size = weight.second->size;
-    auto weight_data = std::make_unique<char[]>(weight_size);
-    if (weight_data == nullptr) {
-      MS_LOG(EXCEPTION) << "Assign memory for weight failed.";
-      return nullptr;
-    }
+void ModelStore::AddModel(size_t iteration, const ModelVersionPtr &model) {
+  MS_EXCEPTION_IF_NULL(model);
+  iteration_to_model_[iteration] = {model, ++access_clock_};
+  EvictModels();
+}
 
-    auto src_data_size = weight_size;
-    auto dst_data_size = weight_size;
-    int ret = memcpy_s(weight_data.get(), dst_data_size, weight.second->addr, src_data_size);
-    if (ret != 0) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-      return nullptr;
+void ModelStore::EvictModels() {
+  size_t memory_usage = ComputeMemoryUsage();
+  while (iteration_to_model_.size() > 1) {
+    bool over_limit =
+      memory_budget_ == 0 ? iteration_to_model_.size() > max_model_count_ : memory_usage > memory_budget_;
+    if (!over_limit) {
+      break;
+    }
+    size_t latest_iteration = iteration_to_model_.rbegin()->first;
+    auto victim = iteration_to_model_.end();
+    for (auto iter = iteration_to_model_.begin(); iter != iteration_to_model_.end(); ++iter) {
+      if (iter->first == latest_iteration) {
+        continue;
+      }
+      if (victim == iteration_to_model_.end() || iter->second.last_access < victim->second.last_access) {
+        victim = iter;
+      }
     }
+    MS_LOG(INFO) << "Evict the model of iteration " << victim->first << ", the memory of all models is "
+                 << memory_usage << " bytes.";
+    iteration_to_model_.erase(victim);
+    memory_usage = ComputeMemoryUsage();
+  }
+}
 
-    memory_register->RegisterArray(weight_name, &weight_data, weight_size);
+size_t ModelStore::ComputeMemoryUsage() const {
+  // A page shared by several models is counted once.
+  std::unordered_set<const ModelPage *> counted_pages;
+  size_t memory_usage = 0;
+  for (const auto &stored_model : iteration_to_model_) {
+    for (const auto &weight : stored_model.second.model->weights()) {
+      for (const auto &page : weight.second.pages) {
+        if (counted_pages.insert(page.get()).second) {
+          memory_usage += page->size();
+        }
+      }
+    }
   }
-  return memory_register;
+  return memory_usage;
 }
 
 size_t ModelStore::ComputeModelSize() {
@@ -146,10 +177,10 @@ size_t ModelStore::ComputeModelSize() {
     return 0;
   }
 
-  const auto &model = iteration_to_model_[kInitIterationNum];
+  const auto &model = iteration_to_model_[kInitIterationNum].model;
   MS_EXCEPTION_IF_NULL(model);
-  size_t model_size = std::accumulate(model->addresses().begin(), model->addresses().end(), static_cast<size_t>(0),
-                                      [](size_t s, const auto &weight) { return s + weight.second->size; });
+  size_t model_size = std::accumulate(model->weights().begin(), model->weights().end(), static_cast<size_t>(0),
+                                      [](size_t s, const auto &weight) { return s + weight.second.size; });
   MS_LOG(INFO) << "Model size in byte is " << model_size;
   return model_size;
 }
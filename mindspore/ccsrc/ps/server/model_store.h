@@ -19,9 +19,10 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "ps/server/common.h"
-#include "ps/server/memory_register.h"
+#include "ps/server/model_version.h"
 #include "ps/server/executor.h"
 
 namespace mindspore {
@@ -30,8 +31,16 @@ namespace server {
 // The initial iteration number is 0 in server.
 constexpr size_t kInitIterationNum = 0;
 
+// The number of models stored if there's no memory budget.
+constexpr uint32_t kDefaultModelCount = 3;
+
 // Server framework use ModelStore to store and query models.
 // ModelStore stores multiple models because worker could get models of the previous iterations.
+
+// The models are stored as ModelVersion, whose pages are shared with the previous model when they're not changed, so a
+// model costs only the memory of its changed pages. With a memory budget, the models are kept until the memory of all
+// their pages exceeds the budget, otherwise at most max_model_count_ models are kept. Either way, the model which is
+// least recently stored or requested is evicted first, and the latest model is never evicted.
 class ModelStore {
  public:
   static ModelStore &GetInstance() {
@@ -39,46 +48,62 @@ class ModelStore {
     return instance;
   }
 
-  // Initialize ModelStore with max count of models need to be stored.
-  void Initialize(uint32_t max_count = 3);
+  // Initialize ModelStore with max count of models need to be stored and the memory budget in bytes, which is
+  // unlimited if it's 0.
+  void Initialize(uint32_t max_count = kDefaultModelCount, size_t memory_budget = 0);
 
-  // Store the model of the given iteration. The model is acquired from Executor. If the current model count is already
-  // max_model_count_, the earliest model will be replaced.
+  // Store the model of the given iteration. The model is acquired from Executor.
   bool StoreModelByIterNum(size_t iteration, const std::map<std::string, AddressPtr> &model);
 
-  // Get model of the given iteration.
-  std::map<std::string, AddressPtr> GetModelByIterNum(size_t iteration);
+  // Store the model of the source iteration as the model of the given iteration as well. They share all the pages.
+  bool CopyModelByIterNum(size_t source_iteration, size_t iteration);
+
+  // Get model of the given iteration, or nullptr if it's not stored.
+  ModelVersionPtr GetModelByIterNum(size_t iteration);
 
   // Reset the stored models. Called when federated learning job finishes.
   void Reset();
 
-  // Returns all models stored in ModelStore.
-  const std::map<size_t, std::shared_ptr<MemoryRegister>> &iteration_to_model() const;
+  // Returns whether the model of the given iteration is stored.
+  bool HasModel(size_t iteration);
+
+  // Returns the iteration of the latest model.
+  size_t latest_iteration();
 
   // Returns the model size, which could be calculated at the initializing phase.
   size_t model_size() const;
 
+  // Returns the memory of the pages of all models stored.
+  size_t memory_usage();
+
  private:
-  ModelStore() : max_model_count_(0), model_size_(0), iteration_to_model_({}) {}
+  ModelStore() : max_model_count_(0), memory_budget_(0), model_size_(0), access_clock_(0), iteration_to_model_({}) {}
   ~ModelStore() = default;
   ModelStore(const ModelStore &) = delete;
   ModelStore &operator=(const ModelStore &) = delete;
 
-  // To store multiple models, new memory must assigned. The max memory size assigned for models is max_model_count_ *
-  // model_size_.
-  std::shared_ptr<MemoryRegister> AssignNewModelMemory();
+  struct StoredModel {
+    ModelVersionPtr model;
+    // The access clock when the model is stored or requested last time.
+    uint64_t last_access;
+  };
+
+  // Add the model and evict the models beyond the count or the memory budget. The caller must hold mutex_.
+  void AddModel(size_t iteration, const ModelVersionPtr &model);
+  void EvictModels();
+  size_t ComputeMemoryUsage() const;
 
   // Calculate the model size. This method should be called after iteration_to_model_ is initialized.
   size_t ComputeModelSize();
 
   size_t max_model_count_;
+  size_t memory_budget_;
   size_t model_size_;
+  uint64_t access_clock_;
 
-  // Initial model which is the model of iteration 0.
-  std::shared_ptr<MemoryRegister> initial_model_;
-
-  // The number of all models stpred is max_model_count_.
-  std::map<size_t, std::shared_ptr<MemoryRegister>> iteration_to_model_;
+  // The models are stored by the iteration thread and requested by the clients concurrently.
+  std::mutex mutex_;
+  std::map<size_t, StoredModel> iteration_to_model_;
 };
 }  // namespace server
 }  // namespace ps
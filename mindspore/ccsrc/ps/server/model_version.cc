@@ -0,0 +1,134 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/server/model_version.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "utils/log_adapter.h"
+#include "securec/include/securec.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+ModelVersionPtr ModelVersion::Build(size_t iteration, const std::map<std::string, AddressPtr> &model,
+                                    const ModelVersionPtr &base) {
+  std::map<std::string, WeightPages> weights;
+  size_t shared_page_num = 0;
+  size_t page_num = 0;
+  for (const auto &weight : model) {
+    const std::string &name = weight.first;
+    const AddressPtr &address = weight.second;
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->size != 0) {
+      MS_EXCEPTION_IF_NULL(address->addr);
+    }
+    const WeightPages *base_weight = nullptr;
+    if (base != nullptr && base->weights_.count(name) != 0 && base->weights_.at(name).size == address->size) {
+      base_weight = &base->weights_.at(name);
+    }
+
+    WeightPages &pages = weights[name];
+    pages.size = address->size;
+    auto data = reinterpret_cast<const char *>(address->addr);
+    for (size_t offset = 0, index = 0; offset < address->size; offset += kModelPageSize, ++index) {
+      size_t size = std::min(kModelPageSize, address->size - offset);
+      page_num++;
+      if (base_weight != nullptr && std::memcmp(base_weight->pages[index]->data(), data + offset, size) == 0) {
+        pages.pages.push_back(base_weight->pages[index]);
+        shared_page_num++;
+        continue;
+      }
+      pages.pages.push_back(std::make_shared<const ModelPage>(data + offset, data + offset + size));
+    }
+  }
+  MS_LOG(INFO) << "Build the model of iteration " << iteration << " with " << page_num << " pages, " << shared_page_num
+               << " of which are shared with the model of iteration " << (base == nullptr ? 0 : base->iteration_);
+  return std::make_shared<const ModelVersion>(iteration, std::move(weights));
+}
+
+ModelVersionPtr ModelVersion::Share(size_t iteration, const ModelVersion &source) {
+  return std::make_shared<const ModelVersion>(iteration, source.weights_);
+}
+
+std::vector<size_t> ModelVersion::ChangedPages(const std::string &name, const ModelVersion &base) const {
+  std::vector<size_t> changed_pages;
+  auto iter = weights_.find(name);
+  if (iter == weights_.end()) {
+    return changed_pages;
+  }
+  const WeightPages &pages = iter->second;
+  auto base_iter = base.weights_.find(name);
+  bool comparable = base_iter != base.weights_.end() && base_iter->second.size == pages.size;
+  for (size_t index = 0; index < pages.pages.size(); ++index) {
+    // The shared pages are the same, and the others are compared because a page could be changed back.
+    if (comparable) {
+      const ModelPagePtr &base_page = base_iter->second.pages[index];
+      if (base_page == pages.pages[index] || *base_page == *pages.pages[index]) {
+        continue;
+      }
+    }
+    changed_pages.push_back(index);
+  }
+  return changed_pages;
+}
+
+bool ModelVersion::CopyPages(const std::string &name, const std::vector<size_t> &page_indexes, void *dst,
+                             size_t dst_size) const {
+  MS_ERROR_IF_NULL(dst);
+  auto iter = weights_.find(name);
+  if (iter == weights_.end()) {
+    MS_LOG(ERROR) << "The model of iteration " << iteration_ << " has no weight " << name;
+    return false;
+  }
+  const WeightPages &pages = iter->second;
+  auto dst_data = reinterpret_cast<char *>(dst);
+  size_t offset = 0;
+  for (size_t index : page_indexes) {
+    if (index >= pages.pages.size()) {
+      MS_LOG(ERROR) << "The weight " << name << " has no page " << index;
+      return false;
+    }
+    const ModelPage &page = *pages.pages[index];
+    if (offset + page.size() > dst_size) {
+      MS_LOG(ERROR) << "The pages of weight " << name << " exceed the destination of " << dst_size << " bytes.";
+      return false;
+    }
+    int ret = memcpy_s(dst_data + offset, dst_size - offset, page.data(), page.size());
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+    offset += page.size();
+  }
+  return true;
+}
+
+bool ModelVersion::CopyWeight(const std::string &name, void *dst, size_t dst_size) const {
+  auto iter = weights_.find(name);
+  if (iter == weights_.end()) {
+    MS_LOG(ERROR) << "The model of iteration " << iteration_ << " has no weight " << name;
+    return false;
+  }
+  std::vector<size_t> page_indexes(iter->second.pages.size());
+  for (size_t i = 0; i < page_indexes.size(); ++i) {
+    page_indexes[i] = i;
+  }
+  return CopyPages(name, page_indexes, dst, dst_size);
+}
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_SERVER_MODEL_VERSION_H_
+#define MINDSPORE_CCSRC_PS_SERVER_MODEL_VERSION_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "backend/kernel_compiler/kernel.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+using mindspore::kernel::AddressPtr;
+
+// The weights of a model are stored in pages of this many bytes. A page whose content doesn't change between two
+// models is shared by them, and the delta between two models is made of the pages which differ.
+constexpr size_t kModelPageSize = 4096;
+
+using ModelPage = std::vector<char>;
+using ModelPagePtr = std::shared_ptr<const ModelPage>;
+
+// The pages of a weight. All the pages have kModelPageSize bytes except the last one.
+struct WeightPages {
+  size_t size{0};
+  std::vector<ModelPagePtr> pages;
+};
+
+class ModelVersion;
+using ModelVersionPtr = std::shared_ptr<const ModelVersion>;
+
+// ModelVersion is the model of an iteration. It's never modified after it's built, so it could be read without a lock
+// and kept by a reader after ModelStore drops it.
+class ModelVersion {
+ public:
+  ModelVersion(size_t iteration, std::map<std::string, WeightPages> weights)
+      : iteration_(iteration), weights_(std::move(weights)) {}
+  ~ModelVersion() = default;
+
+  // Build the model of the iteration from the weights. The pages with the same content as the base model's are shared
+  // with it instead of copied. The base could be nullptr.
+  static ModelVersionPtr Build(size_t iteration, const std::map<std::string, AddressPtr> &model,
+                               const ModelVersionPtr &base);
+
+  // Build the model of the iteration which shares all the pages of the source.
+  static ModelVersionPtr Share(size_t iteration, const ModelVersion &source);
+
+  size_t iteration() const { return iteration_; }
+  const std::map<std::string, WeightPages> &weights() const { return weights_; }
+
+  // The indexes of the pages of the weight which differ from the base model. If the base has no such weight or its
+  // size is different, all the pages are returned.
+  std::vector<size_t> ChangedPages(const std::string &name, const ModelVersion &base) const;
+
+  // Copy the pages of the weight one after another into dst, which has dst_size bytes.
+  bool CopyPages(const std::string &name, const std::vector<size_t> &page_indexes, void *dst, size_t dst_size) const;
+
+  // Copy the whole weight into dst, which has dst_size bytes.
+  bool CopyWeight(const std::string &name, void *dst, size_t dst_size) const;
+
+ private:
+  size_t iteration_;
+  std::map<std::string, WeightPages> weights_;
+};
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_SERVER_MODEL_VERSION_H_
@@ -75,6 +75,28 @@ bool ParameterAggregator::LaunchAggregators() {
   return true;
 }
 
+bool ParameterAggregator::IsStreaming() const {
+  if (aggregation_kernel_parameters_.empty()) {
+    return false;
+  }
+  return std::all_of(aggregation_kernel_parameters_.begin(), aggregation_kernel_parameters_.end(),
+                     [](const auto &aggregator_with_params) {
+                       return aggregator_with_params.first != nullptr && aggregator_with_params.first->IsStreaming();
+                     });
+}
+
+bool ParameterAggregator::AccumulateUploadData(const UploadData &upload_data) {
+  for (auto &aggregator_with_params : aggregation_kernel_parameters_) {
+    std::shared_ptr<kernel::AggregationKernel> aggr_kernel = aggregator_with_params.first;
+    RETURN_IF_NULL(aggr_kernel, false);
+    if (!aggr_kernel->Accumulate(upload_data)) {
+      MS_LOG(ERROR) << "Accumulating the uploaded data with " << typeid(aggr_kernel.get()).name() << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
 bool ParameterAggregator::LaunchOptimizers() {
   for (auto &optimizer_with_params : optimizer_kernel_parameters_) {
     KernelParams &params = optimizer_with_params.second;
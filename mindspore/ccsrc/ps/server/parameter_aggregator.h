@@ -40,7 +40,8 @@ typedef struct {
 
 // ParameterAggregator includes methods for aggregating gradients and optimizing weights(launching aggregation and
 // optimizer kernels), getting weights, etc. It's not thread-safe, which means the caller must acquire lock before
-// calling ParameterAggregator methods concurrently.
+// calling ParameterAggregator methods concurrently. The only exception is AccumulateUploadData of a streaming
+// ParameterAggregator.
 
 // Each ParameterAggregator is corresponding to one weight for now.
 
@@ -72,6 +73,12 @@ class ParameterAggregator {
   bool LaunchAggregators();
   bool LaunchOptimizers();
 
+  // Whether all the aggregation kernels accumulate the uploaded data directly. The uploaded data of such a
+  // ParameterAggregator is passed to AccumulateUploadData instead of UpdateData and LaunchAggregators, which could be
+  // called concurrently.
+  bool IsStreaming() const;
+  bool AccumulateUploadData(const UploadData &upload_data);
+
   // The implementation for primitive Pull in parameter server training mode.
   // Every call of this method will increase the count for pull by 1.
   AddressPtr Pull();
@@ -203,7 +203,7 @@ void Server::InitExecutor() {
   // so the required_cnt of these kernels must be the same as update_model_threshold_.
   MS_LOG(INFO) << "Required count for push-type and pull-type kernels is " << executor_threshold_;
   Executor::GetInstance().Initialize(func_graph_, executor_threshold_);
-  ModelStore::GetInstance().Initialize();
+  ModelStore::GetInstance().Initialize(kDefaultModelCount, PSContext::instance()->model_store_memory_budget());
   return;
 }
 
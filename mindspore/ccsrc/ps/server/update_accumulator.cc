@@ -0,0 +1,155 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/server/update_accumulator.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <utility>
+#include "backend/kernel_compiler/cpu/vector_accumulate.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+void UpdateAccumulator::Initialize(size_t count, size_t stripe_num) {
+  count_ = count;
+  stripe_num = std::max(std::min(stripe_num, kMaxAccumulatorStripeNum), static_cast<size_t>(1));
+  stripes_.clear();
+  for (size_t i = 0; i < stripe_num; ++i) {
+    stripes_.emplace_back(std::make_unique<Stripe>());
+  }
+  MS_LOG(INFO) << "Initialize update accumulator of " << count_ << " elements with " << stripe_num << " stripes.";
+}
+
+void UpdateAccumulator::Reset() {
+  for (auto &stripe : stripes_) {
+    std::unique_lock<std::mutex> lock(stripe->mtx);
+    if (stripe->dirty) {
+      std::fill(stripe->sum.begin(), stripe->sum.end(), 0.0f);
+    }
+    stripe->data_size = 0;
+    stripe->dirty = false;
+  }
+}
+
+bool UpdateAccumulator::AccumulateDense(const float *data, size_t count, size_t data_size) {
+  MS_ERROR_IF_NULL(data);
+  if (count != count_) {
+    MS_LOG(ERROR) << "The update has " << count << " elements, but the weight has " << count_;
+    return false;
+  }
+  std::unique_lock<std::mutex> lock;
+  Stripe *stripe = AcquireStripe(&lock);
+  MS_ERROR_IF_NULL(stripe);
+  kernel::AccumulateVector(data, count, stripe->sum.data());
+  stripe->data_size += data_size;
+  return true;
+}
+
+bool UpdateAccumulator::AccumulateInt8(const int8_t *data, size_t count, const float *scales, size_t scale_num,
+                                       size_t block_size, size_t data_size) {
+  MS_ERROR_IF_NULL(data);
+  MS_ERROR_IF_NULL(scales);
+  if (count != count_) {
+    MS_LOG(ERROR) << "The int8 update has " << count << " elements, but the weight has " << count_;
+    return false;
+  }
+  // The blocks must cover the values exactly, with a scale for each of them.
+  if (block_size == 0 || scale_num != std::max((count + block_size - 1) / block_size, static_cast<size_t>(1))) {
+    MS_LOG(ERROR) << "The int8 update of " << count << " elements has " << scale_num << " scales for blocks of "
+                  << block_size << " elements.";
+    return false;
+  }
+  std::unique_lock<std::mutex> lock;
+  Stripe *stripe = AcquireStripe(&lock);
+  MS_ERROR_IF_NULL(stripe);
+  for (size_t begin = 0, block = 0; begin < count; begin += block_size, ++block) {
+    size_t size = std::min(block_size, count - begin);
+    kernel::AccumulateInt8Vector(data + begin, size, scales[block], stripe->sum.data() + begin);
+  }
+  stripe->data_size += data_size;
+  return true;
+}
+
+bool UpdateAccumulator::AccumulateSparse(const int *indices, const float *values, size_t size, size_t data_size) {
+  MS_ERROR_IF_NULL(indices);
+  MS_ERROR_IF_NULL(values);
+  // The indices are checked before any value is added, so a bad update leaves the sum as it is.
+  for (size_t i = 0; i < size; ++i) {
+    if (indices[i] < 0 || static_cast<size_t>(indices[i]) >= count_) {
+      MS_LOG(ERROR) << "The index " << indices[i] << " of the sparse update is out of range [0, " << count_ << ").";
+      return false;
+    }
+  }
+  std::unique_lock<std::mutex> lock;
+  Stripe *stripe = AcquireStripe(&lock);
+  MS_ERROR_IF_NULL(stripe);
+  kernel::AccumulateSparseVector(indices, values, size, stripe->sum.data());
+  stripe->data_size += data_size;
+  return true;
+}
+
+size_t UpdateAccumulator::Merge(float *output) {
+  MS_EXCEPTION_IF_NULL(output);
+  std::fill(output, output + count_, 0.0f);
+  size_t data_size = 0;
+  for (auto &stripe : stripes_) {
+    std::unique_lock<std::mutex> lock(stripe->mtx);
+    if (!stripe->dirty) {
+      continue;
+    }
+    kernel::AccumulateVector(stripe->sum.data(), count_, output);
+    data_size += stripe->data_size;
+  }
+  return data_size;
+}
+
+UpdateAccumulator::Stripe *UpdateAccumulator::AcquireStripe(std::unique_lock<std::mutex> *lock) {
+  MS_EXCEPTION_IF_NULL(lock);
+  if (stripes_.empty()) {
+    MS_LOG(ERROR) << "The update accumulator is not initialized.";
+    return nullptr;
+  }
+  // The stripe a thread used last time is likely still in its cache, so it's tried first.
+  static thread_local size_t preferred_stripe = std::hash<std::thread::id>()(std::this_thread::get_id());
+  size_t stripe_num = stripes_.size();
+  size_t index = preferred_stripe % stripe_num;
+  for (size_t i = 0; i < stripe_num; ++i) {
+    size_t candidate = (preferred_stripe + i) % stripe_num;
+    std::unique_lock<std::mutex> stripe_lock(stripes_[candidate]->mtx, std::try_to_lock);
+    if (stripe_lock.owns_lock()) {
+      index = candidate;
+      *lock = std::move(stripe_lock);
+      break;
+    }
+  }
+  // All the stripes are busy, so wait for the preferred one.
+  if (!lock->owns_lock()) {
+    *lock = std::unique_lock<std::mutex>(stripes_[index]->mtx);
+  }
+  preferred_stripe = index;
+
+  Stripe *stripe = stripes_[index].get();
+  if (stripe->sum.size() != count_) {
+    stripe->sum.assign(count_, 0.0f);
+  }
+  stripe->dirty = true;
+  return stripe;
+}
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
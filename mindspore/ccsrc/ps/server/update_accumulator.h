@@ -0,0 +1,81 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_SERVER_UPDATE_ACCUMULATOR_H_
+#define MINDSPORE_CCSRC_PS_SERVER_UPDATE_ACCUMULATOR_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+namespace server {
+// The most partial sums an UpdateAccumulator keeps, each of which costs as much memory as the weight.
+constexpr size_t kMaxAccumulatorStripeNum = 8;
+
+// UpdateAccumulator sums the weights uploaded by the clients of a round, which could arrive on many threads at once.
+// The updates are added into a few partial sums, the stripes, and a thread takes the stripe it used last time or any
+// free one, so the threads rarely wait for each other. The stripes are merged once when the round ends.
+
+// Besides the float values, an update could be int8 values with a scale per block, or the top-k values of the weight
+// with their indices. They are decompressed while they are added, so the float update is never built.
+class UpdateAccumulator {
+ public:
+  UpdateAccumulator() : count_(0) {}
+  ~UpdateAccumulator() = default;
+
+  // Prepare stripe_num partial sums of count elements. The memory of a stripe is allocated when it's first used.
+  void Initialize(size_t count, size_t stripe_num);
+
+  // Clear the partial sums and the data size for the next round.
+  void Reset();
+
+  // Add a float update.
+  bool AccumulateDense(const float *data, size_t count, size_t data_size);
+
+  // Add an int8 update, whose values are split into scale_num blocks of block_size values, except the last one which
+  // may be shorter. The values of a block are multiplied by its scale.
+  bool AccumulateInt8(const int8_t *data, size_t count, const float *scales, size_t scale_num, size_t block_size,
+                      size_t data_size);
+
+  // Add a sparse update, which has the values of the weight at the indices.
+  bool AccumulateSparse(const int *indices, const float *values, size_t size, size_t data_size);
+
+  // Write the sum of all the updates to the output, which has count elements, and return the total data size.
+  size_t Merge(float *output);
+
+  size_t count() const { return count_; }
+
+ private:
+  struct Stripe {
+    std::mutex mtx;
+    std::vector<float> sum;
+    size_t data_size{0};
+    // Whether any update is added to the stripe since the last Reset.
+    bool dirty{false};
+  };
+
+  // Lock a stripe for the calling thread and return it. The stripe's memory is allocated here if needed.
+  Stripe *AcquireStripe(std::unique_lock<std::mutex> *lock);
+
+  size_t count_;
+  std::vector<std::unique_ptr<Stripe>> stripes_;
+};
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_SERVER_UPDATE_ACCUMULATOR_H_
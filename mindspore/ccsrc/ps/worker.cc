@@ -19,6 +19,33 @@
 
 namespace mindspore {
 namespace ps {
+namespace {
+// The push and pull payloads are written as they are in memory, without the serialization of a KVMessage.
+DataPtr BuildKVPayload(const std::vector<Key> &keys, const std::vector<int> &lens, const std::vector<float> &vals,
+                       size_t *size) {
+  MS_EXCEPTION_IF_NULL(size);
+  *size = KVPayload::Size(keys.size(), lens.size(), vals.size());
+  DataPtr data(new unsigned char[*size]);
+  KVPayload payload = KVPayload::Create(data.get(), *size, keys.size(), lens.size(), vals.size());
+  (void)std::copy(keys.begin(), keys.end(), payload.keys());
+  (void)std::copy(lens.begin(), lens.end(), payload.lens());
+  (void)std::copy(vals.begin(), vals.end(), payload.values());
+  return data;
+}
+
+DataPtr BuildKVPayload(const KVMessage &kvs, size_t *size) {
+  MS_EXCEPTION_IF_NULL(size);
+  *size = KVPayload::Size(IntToSize(kvs.keys_size()), IntToSize(kvs.len_size()), IntToSize(kvs.values_size()));
+  DataPtr data(new unsigned char[*size]);
+  KVPayload payload = KVPayload::Create(data.get(), *size, IntToSize(kvs.keys_size()), IntToSize(kvs.len_size()),
+                                        IntToSize(kvs.values_size()));
+  (void)std::copy(kvs.keys().begin(), kvs.keys().end(), payload.keys());
+  (void)std::copy(kvs.len().begin(), kvs.len().end(), payload.lens());
+  (void)std::copy(kvs.values().begin(), kvs.values().end(), payload.values());
+  return data;
+}
+}  // namespace
+
 void Worker::Run() {
   std::lock_guard<std::mutex> lock(running_mutex_);
 
@@ -48,6 +75,20 @@ void Worker::Run() {
     this->Finalize();
     exit(0);
   });
+  // The workers keep training while the servers are scaled, and learn the new servers of the keys as they move.
+  worker_node_.RegisterEventCallback(core::ClusterEvent::READY_FOR_SCALE_OUT,
+                                     [this]() { worker_node_.set_ready_for_scale_out(); });
+  worker_node_.RegisterEventCallback(core::ClusterEvent::READY_FOR_SCALE_IN,
+                                     [this]() { worker_node_.set_ready_for_scale_in(); });
+  worker_node_.RegisterEventCallback(core::ClusterEvent::CLUSTER_SCALE_OUT_DONE,
+                                     [this]() { worker_node_.set_scale_out_done(); });
+  worker_node_.RegisterEventCallback(core::ClusterEvent::CLUSTER_SCALE_IN_DONE, [this]() {
+    if (worker_node_.rank_id() == UINT_MAX) {
+      MS_LOG(WARNING) << "Scaling in the workers is not supported, this worker stays out of the cluster.";
+      return;
+    }
+    worker_node_.set_scale_in_done();
+  });
 
   MS_LOG(INFO) << "Worker starts connecting to scheduler and server...";
   worker_node_.Start();
@@ -110,6 +151,9 @@ void Worker::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> addrs,
   std::vector<int> sizes_int;
   (void)std::transform(sizes.begin(), sizes.end(), std::back_inserter(sizes_int),
                        [](const int64_t &value) { return static_cast<int>(value); });
+  if (embedding_table_ranges_.count(key) == 0) {
+    RecordLoad(key, total_size * sizeof(float));
+  }
   if (!is_sparse) {
     PushData(std::vector<Key>(keys), total_buffer, std::vector<int>(sizes_int), kPushCmd);
   } else {
@@ -240,7 +284,7 @@ void Worker::InitPSEmbeddingTable(const size_t &key, const std::vector<size_t> &
     return;
   }
 
-  worker_node_.Broadcast(core::NodeRole::SERVER, res, kv_data.length(), kInitEmbeddingsCmd);
+  SendToEmbeddingShards(res, kv_data.length(), kInitEmbeddingsCmd);
 }
 
 void Worker::InitPSParamAndOptim(const AnfNodePtr &input_node, const tensor::TensorPtr &tensor) {
@@ -267,7 +311,7 @@ void Worker::InitPSParamAndOptim(const AnfNodePtr &input_node, const tensor::Ten
   if (!init) {
     MS_LOG(INFO) << "Init parameter key " << param_key << " and optimizer in parameter server side for " << param_name
                  << ", whether init in server: " << init_in_server;
-    AddKeyToServerId(param_key);
+    AddKeyToShardMap(param_key);
     if (!PsDataPrefetch::GetInstance().cache_enable()) {
       if (!init_in_server) {
         if (param_size > INT_MAX) {
@@ -289,6 +333,8 @@ void Worker::DoPSEmbeddingLookup(const Key &key, const std::vector<int> &lookup_
   embedding_table_lookup.set_key(key);
   *embedding_table_lookup.mutable_keys() = {lookup_ids.begin(), lookup_ids.end()};
 
+  std::shared_lock<std::shared_mutex> metadata_lock(worker_node_.metadata_mutex());
+  RefreshServers();
   PartitionEmbeddingMessages messages;
   lookup_partitioner_(embedding_table_lookup, &messages, {});
   std::vector<uint32_t> rank_ids;
@@ -313,28 +359,24 @@ void Worker::DoPSEmbeddingLookup(const Key &key, const std::vector<int> &lookup_
 
   std::vector<VectorPtr> resp;
   worker_node_.Send(core::NodeRole::SERVER, rank_ids, data, sizes, cmd, &resp);
+  metadata_lock.unlock();
   int64_t single_id_len = SizeToLong(lookup_result->size() / lookup_ids.size());
+  // The embeddings are copied into the result straight from the responses, which are viewed in place.
   std::unordered_map<Key, std::shared_ptr<std::pair<float *, int64_t>>> id_addr_map;
-  std::shared_ptr<std::vector<float>> values = std::make_shared<std::vector<float>>();
-  std::shared_ptr<std::vector<Key>> keys = std::make_shared<std::vector<Key>>();
-  int64_t value_offset = 0;
   for (size_t i = 0; i < resp.size(); ++i) {
-    KVMessage message;
-    message.ParseFromArray(resp.at(i)->data(), resp.at(i)->size());
-    for (auto j = 0; j < message.values_size(); j++) {
-      values->push_back(message.values(j));
+    if (resp.at(i)->empty()) {
+      continue;
     }
-    for (auto k = 0; k < message.keys_size(); k++) {
-      const Key &key = message.keys(k);
-      keys->push_back(key);
+    KVPayload payload = KVPayload::Parse(resp.at(i)->data(), resp.at(i)->size());
+    if (payload.value_num() < payload.key_num() * LongToSize(single_id_len)) {
+      MS_LOG(EXCEPTION) << "The embedding lookup response has " << payload.value_num() << " values for "
+                        << payload.key_num() << " ids.";
+    }
+    for (size_t k = 0; k < payload.key_num(); k++) {
+      float *addr = payload.values() + k * LongToSize(single_id_len);
+      id_addr_map[payload.keys()[k]] =
+        std::make_shared<std::pair<float *, int64_t>>(std::make_pair(addr, single_id_len));
     }
-  }
-
-  for (size_t i = 0; i < keys->size(); i++) {
-    const Key &key = keys->at(i);
-    float *addr = values->data() + value_offset;
-    value_offset += single_id_len;
-    id_addr_map[key] = std::make_shared<std::pair<float *, int64_t>>(std::make_pair(addr, single_id_len));
   }
 
   float *result_addr = lookup_result->data();
@@ -367,12 +409,14 @@ void Worker::DoPSEmbeddingLookup(const Key &key, const std::vector<int> &lookup_
   }
 }
 
-void Worker::UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
+bool Worker::UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
                                   const std::vector<float> &vals) {
   KVMessage kvs;
   *kvs.mutable_keys() = {keys.begin(), keys.end()};
   *kvs.mutable_len() = {lookup_ids.begin(), lookup_ids.end()};
   *kvs.mutable_values() = {vals.begin(), vals.end()};
+  std::shared_lock<std::shared_mutex> metadata_lock(worker_node_.metadata_mutex());
+  RefreshServers();
   PartitionKVMessages messages;
   update_embedding_partitioner_(kvs, &messages, {});
   std::vector<uint32_t> rank_ids;
@@ -388,13 +432,17 @@ void Worker::UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vecto
       int ret = memcpy_s(res.get(), dest_size, kv_data.data(), kv_data.length());
       if (ret != 0) {
         MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-        return;
+        return false;
       }
       data.push_back(res);
       sizes.push_back(kv_data.length());
     }
   }
-  worker_node_.Send(core::NodeRole::SERVER, rank_ids, data, sizes, kUpdateEmbeddingsCmd);
+  if (!worker_node_.Send(core::NodeRole::SERVER, rank_ids, data, sizes, kUpdateEmbeddingsCmd)) {
+    MS_LOG(ERROR) << "Sending the rows of the embedding table to the servers failed.";
+    return false;
+  }
+  return true;
 }
 
 void Worker::Finalize() {
@@ -447,14 +495,55 @@ bool Worker::IsKeyInit(const size_t key) {
   return true;
 }
 
-void Worker::AddKeyToServerId(const Key &key) { AddKeyByHashMod(key); }
+void Worker::AddKeyToShardMap(const Key &key) {
+  std::lock_guard<std::mutex> lock(shard_map_mutex_);
+  dense_keys_.push_back(key);
+}
 
-void Worker::AddKeyByHashMod(const Key &key) {
-  if (server_num_ == 0) {
-    MS_LOG(EXCEPTION) << "Server number is invalid:0";
+void Worker::RefreshServers() {
+  std::lock_guard<std::mutex> lock(shard_map_mutex_);
+  uint64_t metadata_version = worker_node_.metadata_version();
+  if (metadata_version == metadata_version_) {
+    return;
   }
-  key_to_server_id_[key] = static_cast<int64_t>(key % server_num_);
-  MS_LOG(INFO) << "The server id of key " << key << " is " << key_to_server_id_[key];
+  std::vector<std::string> servers;
+  server_ranks_.clear();
+  for (const auto &server : worker_node_.server_addresses()) {
+    server_ranks_[server.second] = server.first;
+    servers.push_back(server.second);
+  }
+  if (embedding_shard_servers_.empty()) {
+    embedding_shard_servers_ = servers;
+  }
+  // The keys stay on their servers until the servers migrate them and tell the worker, so they are pinned before the
+  // ring changes. The pins to the servers which have left are dropped, and their keys follow the new ring.
+  shard_map_.PinOwners(dense_keys_);
+  shard_map_.SetServers(servers);
+  metadata_version_ = metadata_version;
+  MS_LOG(INFO) << "The servers of the shard map are refreshed, the server number is " << servers.size();
+}
+
+uint32_t Worker::KeyServerRank(const Key &key) {
+  std::lock_guard<std::mutex> lock(shard_map_mutex_);
+  std::string owner = shard_map_.Owner(key);
+  auto iter = server_ranks_.find(owner);
+  if (iter == server_ranks_.end()) {
+    MS_LOG(EXCEPTION) << "The server " << owner << " of key " << key << " is not in the cluster.";
+  }
+  return iter->second;
+}
+
+std::vector<uint32_t> Worker::EmbeddingShardRanks() {
+  std::lock_guard<std::mutex> lock(shard_map_mutex_);
+  std::vector<uint32_t> rank_ids;
+  for (const auto &server : embedding_shard_servers_) {
+    auto iter = server_ranks_.find(server);
+    if (iter == server_ranks_.end()) {
+      MS_LOG(EXCEPTION) << "The server " << server << " holding a shard of the embedding tables has left the cluster.";
+    }
+    rank_ids.push_back(iter->second);
+  }
+  return rank_ids;
 }
 
 void Worker::InitPSOptimId(const size_t param_key) {
@@ -511,6 +600,9 @@ void Worker::InitPSParamData(const std::vector<size_t> &keys, void *const origin
 }
 
 bool Worker::IsReadyForPush(const Key &key) {
+  if (embedding_table_ranges_.count(key) == 0) {
+    return IsReady(key, kCheckReadyForPushCmd);
+  }
   std::vector<float> result(1, 0);
   PullData({key}, &result, nullptr, kCheckReadyForPushCmd);
   MS_LOG(INFO) << "key:" << key;
@@ -524,6 +616,9 @@ bool Worker::IsReadyForPush(const Key &key) {
 }
 
 bool Worker::IsReadyForPull(const Key &key) {
+  if (embedding_table_ranges_.count(key) == 0) {
+    return IsReady(key, kCheckReadyForPullCmd);
+  }
   std::vector<float> result(1, 0);
   PullData({key}, &result, nullptr, kCheckReadyForPullCmd);
   if (result[0] > 0) {
@@ -535,6 +630,95 @@ bool Worker::IsReadyForPull(const Key &key) {
   }
 }
 
+bool Worker::IsReady(const Key &key, int cmd) {
+  KVMessage kvs;
+  kvs.add_keys(key);
+  std::string kv_data = kvs.SerializeAsString();
+  std::shared_ptr<unsigned char[]> res(new unsigned char[kv_data.length()]);
+  int ret = memcpy_s(res.get(), kv_data.length(), kv_data.data(), kv_data.length());
+  if (ret != 0) {
+    MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+  }
+  VectorPtr output = nullptr;
+  {
+    std::shared_lock<std::shared_mutex> metadata_lock(worker_node_.metadata_mutex());
+    RefreshServers();
+    if (!worker_node_.Send(core::NodeRole::SERVER, KeyServerRank(key), res, kv_data.length(), cmd, &output) ||
+        output == nullptr) {
+      return false;
+    }
+  }
+  KVMessage message;
+  message.ParseFromArray(output->data(), output->size());
+  if (!message.owner().empty()) {
+    std::unique_lock<std::mutex> lock(shard_map_mutex_);
+    if (server_ranks_.count(message.owner()) > 0) {
+      MS_LOG(INFO) << "The key " << key << " has moved to server " << message.owner();
+      shard_map_.Pin(key, message.owner());
+    } else {
+      // The key has moved to a server which joins the cluster, and the worker waits for the new metadata.
+      lock.unlock();
+      std::this_thread::sleep_for(std::chrono::milliseconds(kRetryIntervalInMs));
+    }
+    return false;
+  }
+  return message.values_size() > 0 && message.values(0) > 0;
+}
+
+void Worker::RecordLoad(const Key &key, size_t size) {
+  uint64_t rebalance_interval = PSContext::instance()->load_rebalance_interval();
+  // The workers push all the dense keys in each step, so the loads seen by the first worker stand for all of them.
+  if (rebalance_interval == 0 || worker_node_.rank_id() != 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(shard_map_mutex_);
+    key_loads_[key] += size;
+    push_count_++;
+    if (push_count_ < rebalance_interval * dense_keys_.size()) {
+      return;
+    }
+  }
+  Rebalance();
+}
+
+void Worker::Rebalance() {
+  if (worker_node_.cluster_state() != core::ClusterState::CLUSTER_READY) {
+    return;
+  }
+  std::shared_lock<std::shared_mutex> metadata_lock(worker_node_.metadata_mutex());
+  RefreshServers();
+  // The keys to move are grouped by their current servers and their new servers.
+  std::map<std::pair<uint32_t, std::string>, std::vector<Key>> moves;
+  {
+    std::lock_guard<std::mutex> lock(shard_map_mutex_);
+    for (const auto &move : shard_map_.PlanRebalance(key_loads_, kRebalanceLoadTolerance)) {
+      auto iter = server_ranks_.find(shard_map_.Owner(move.first));
+      if (iter != server_ranks_.end()) {
+        moves[std::make_pair(iter->second, move.second)].push_back(move.first);
+      }
+    }
+    key_loads_.clear();
+    push_count_ = 0;
+  }
+  for (const auto &move : moves) {
+    KVMessage kvs;
+    *kvs.mutable_keys() = {move.second.begin(), move.second.end()};
+    kvs.set_owner(move.first.second);
+    std::string kv_data = kvs.SerializeAsString();
+    std::shared_ptr<unsigned char[]> res(new unsigned char[kv_data.length()]);
+    int ret = memcpy_s(res.get(), kv_data.length(), kv_data.data(), kv_data.length());
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+    }
+    MS_LOG(INFO) << "Move " << move.second.size() << " keys from server rank " << move.first.first << " to server "
+                 << move.first.second;
+    if (!worker_node_.Send(core::NodeRole::SERVER, move.first.first, res, kv_data.length(), kRebalanceKeysCmd)) {
+      MS_LOG(WARNING) << "Sending the keys to rebalance to server rank " << move.first.first << " failed.";
+    }
+  }
+}
+
 void Worker::PrepareSparseGradient(const size_t begin, const size_t end, const std::unordered_set<int> &distinct_ids,
                                    const std::vector<std::pair<int, float *>> &indice_to_grads, const int *all_indice,
                                    const size_t segment_size, float *gradient, int *indices) {
@@ -636,6 +820,16 @@ void Worker::BuildSparseValue(const std::vector<int> &lengths, const size_t grad
 
 void Worker::PushData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
                       int cmd, int64_t priority) {
+  if (cmd == kPushCmd) {
+    if (embedding_table_ranges_.count(keys[0])) {
+      size_t size = 0;
+      DataPtr payload = BuildKVPayload(keys, lens, vals, &size);
+      SendToEmbeddingShards(payload, size, cmd);
+    } else {
+      SendPayloadForPush(keys, vals, lens);
+    }
+    return;
+  }
   KVMessage kvs;
   *kvs.mutable_keys() = {keys.begin(), keys.end()};
   *kvs.mutable_values() = {vals.begin(), vals.end()};
@@ -653,7 +847,7 @@ void Worker::PushData(const std::vector<Key> &keys, const std::vector<float> &va
         MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
         return;
       }
-      worker_node_.Broadcast(core::NodeRole::SERVER, res, kv_data.length(), cmd);
+      SendToEmbeddingShards(res, kv_data.length(), cmd);
     }
   } else {
     SendForPush(cmd, kvs, round_robin_partitioner_, {});
@@ -662,16 +856,16 @@ void Worker::PushData(const std::vector<Key> &keys, const std::vector<float> &va
 
 void Worker::PushSparseData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
                             size_t grad_index, size_t indice_index, size_t first_dim_size, size_t outer_dim_size) {
+  if (!embedding_table_ranges_.count(keys[0])) {
+    SendPayloadForPush(keys, vals, lens);
+    return;
+  }
   KVMessage kvs;
   *kvs.mutable_keys() = {keys.begin(), keys.end()};
   *kvs.mutable_values() = {vals.begin(), vals.end()};
   *kvs.mutable_len() = {lens.begin(), lens.end()};
-  if (embedding_table_ranges_.count(keys[0])) {
-    std::map<int64_t, int64_t> attrs{{0, grad_index}, {1, indice_index}, {2, first_dim_size}, {3, outer_dim_size}};
-    SendForPush(kPushCmd, kvs, sparse_partitioner_, attrs);
-  } else {
-    SendForPush(kPushCmd, kvs, round_robin_partitioner_, {});
-  }
+  std::map<int64_t, int64_t> attrs{{0, grad_index}, {1, indice_index}, {2, first_dim_size}, {3, outer_dim_size}};
+  SendForPush(kPushCmd, kvs, sparse_partitioner_, attrs);
 }
 
 void Worker::PullData(const std::vector<Key> &keys, std::vector<float> *const vals, std::vector<int> *lens, int cmd,
@@ -692,14 +886,15 @@ void Worker::LookupIdPartitioner(const EmbeddingTableLookup &send, PartitionEmbe
 
   const Key &key = send.key();
   const std::vector<EmbeddingTableShardMetadata> &ranges = *(embedding_table_ranges_[key]);
-  partition->resize(ranges.size());
+  std::vector<uint32_t> shard_ranks = EmbeddingShardRanks();
+  partition->resize(IntToSize(worker_node_.server_num()));
 
   for (size_t i = 0; i < ranges.size(); i++) {
     const EmbeddingTableShardMetadata &range = ranges[i];
     const auto &begin = range.begin();
     const auto &end = range.end();
     std::unordered_set<int32_t> unique_ids;
-    auto &kvs = partition->at(i).second;
+    auto &kvs = partition->at(shard_ranks.at(i)).second;
 
     kvs.set_key(key);
 
@@ -715,11 +910,7 @@ void Worker::LookupIdPartitioner(const EmbeddingTableLookup &send, PartitionEmbe
       kvs.add_values(0.0f);
     }
 
-    if (kvs.keys().empty()) {
-      partition->at(i).first = false;
-    } else {
-      partition->at(i).first = true;
-    }
+    partition->at(shard_ranks.at(i)).first = !kvs.keys().empty();
   }
 }
 
@@ -768,14 +959,15 @@ void Worker::SparsePartitioner(const KVMessage &send, PartitionKVMessages *parti
 
   const Key &key = send.keys()[0];
   const std::vector<EmbeddingTableShardMetadata> &ranges = *(embedding_table_ranges_[key]);
-  partition->resize(ranges.size());
+  std::vector<uint32_t> shard_ranks = EmbeddingShardRanks();
+  partition->resize(IntToSize(worker_node_.server_num()));
 
   // Construct reduced sparse data for each server
   for (size_t i = 0; i < ranges.size(); i++) {
     const EmbeddingTableShardMetadata &range = ranges[i];
     const auto &begin = range.begin();
     const auto &end = range.end();
-    auto &kvs = partition->at(i).second;
+    auto &kvs = partition->at(shard_ranks.at(i)).second;
     *kvs.mutable_keys() = {send.keys().begin(), send.keys().end()};
     *kvs.mutable_len() = {send.len().begin(), send.len().end()};
 
@@ -829,14 +1021,14 @@ void Worker::SparsePartitioner(const KVMessage &send, PartitionKVMessages *parti
       *kvs.mutable_values() = {no_vals.begin(), no_vals.end()};
       *kvs.mutable_len() = {no_lens.begin(), no_lens.end()};
     }
-    partition->at(i).first = true;
+    partition->at(shard_ranks.at(i)).first = true;
   }
 }
 
 void Worker::RoundRobinPartitioner(const KVMessage &send, PartitionKVMessages *partition,
                                    const std::map<int64_t, int64_t> &attrs) {
   MS_EXCEPTION_IF_NULL(partition);
-  partition->resize(server_num_);
+  partition->resize(IntToSize(worker_node_.server_num()));
   auto keys = send.keys();
   auto values = send.values();
   auto lens = send.len();
@@ -847,7 +1039,7 @@ void Worker::RoundRobinPartitioner(const KVMessage &send, PartitionKVMessages *p
   Key param_key;
   for (int i = 0; i < send.keys_size(); i++) {
     param_key = keys[i];
-    int64_t server_id = key_to_server_id_[param_key];
+    uint32_t server_id = KeyServerRank(param_key);
     if (!partition->at(server_id).first) {
       partition->at(server_id).first = true;
     }
@@ -871,13 +1063,14 @@ void Worker::RoundRobinPartitioner(const KVMessage &send, PartitionKVMessages *p
 void Worker::WorkerInitEmbeddingPartitioner(const KVMessage &send, std::vector<std::pair<bool, KVMessage>> *partition,
                                             const std::map<int64_t, int64_t> &attrs) {
   MS_EXCEPTION_IF_NULL(partition);
-  partition->resize(server_num_);
+  partition->resize(IntToSize(worker_node_.server_num()));
   auto keys = send.keys();
   auto values = send.values();
   auto lens = send.len();
 
   size_t col_cnt = lens[0] / embedding_row_cnt_[keys[0]];
   const std::vector<EmbeddingTableShardMetadata> &ranges = *(embedding_table_ranges_[keys[0]]);
+  std::vector<uint32_t> shard_ranks = EmbeddingShardRanks();
   for (size_t i = 0; i < ranges.size(); i++) {
     size_t offset_begin = ranges[i].begin() * col_cnt;
     size_t offset_end = (ranges[i].end() + 1) * col_cnt;
@@ -885,8 +1078,8 @@ void Worker::WorkerInitEmbeddingPartitioner(const KVMessage &send, std::vector<s
     *kvs.mutable_keys() = keys;
     *kvs.mutable_values() = {values.begin() + offset_begin, values.begin() + offset_end};
     kvs.add_len(offset_end - offset_begin);
-    partition->at(i).first = true;
-    partition->at(i).second = kvs;
+    partition->at(shard_ranks.at(i)).first = true;
+    partition->at(shard_ranks.at(i)).second = kvs;
   }
 }
 void Worker::UpdateEmbeddingPartitioner(const KVMessage &send, PartitionKVMessages *partition,
@@ -900,13 +1093,14 @@ void Worker::UpdateEmbeddingPartitioner(const KVMessage &send, PartitionKVMessag
 
   const Key &key = send.keys()[0];
   const std::vector<EmbeddingTableShardMetadata> &ranges = *(embedding_table_ranges_[key]);
-  partition->resize(ranges.size());
+  std::vector<uint32_t> shard_ranks = EmbeddingShardRanks();
+  partition->resize(IntToSize(worker_node_.server_num()));
 
   for (size_t i = 0; i < ranges.size(); i++) {
     const EmbeddingTableShardMetadata &range = ranges[i];
     const auto &begin = range.begin();
     const auto &end = range.end();
-    auto &kvs = partition->at(i).second;
+    auto &kvs = partition->at(shard_ranks.at(i)).second;
     kvs.add_keys(key);
     for (size_t j = 0; j < id_size; j++) {
       auto lookup_id = static_cast<uint64_t>(lookup_ids[j]);
@@ -918,26 +1112,24 @@ void Worker::UpdateEmbeddingPartitioner(const KVMessage &send, PartitionKVMessag
       }
     }
 
-    if (kvs.keys_size() <= 1) {
-      partition->at(i).first = false;
-    } else {
-      partition->at(i).first = true;
-    }
+    partition->at(shard_ranks.at(i)).first = kvs.keys_size() > 1;
   }
 }
 
 void Worker::BroadcastPartitioner(const KVMessage &send, PartitionKVMessages *partition,
                                   const std::map<int64_t, int64_t> &attrs) {
   MS_EXCEPTION_IF_NULL(partition);
-  partition->resize(server_num_);
-  for (int64_t i = 0; i < server_num_; i++) {
-    partition->at(i).first = true;
-    partition->at(i).second = send;
+  partition->resize(IntToSize(worker_node_.server_num()));
+  for (const auto &rank_id : EmbeddingShardRanks()) {
+    partition->at(rank_id).first = true;
+    partition->at(rank_id).second = send;
   }
 }
 
 void Worker::SendForPush(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
                          const std::map<int64_t, int64_t> &attrs) {
+  std::shared_lock<std::shared_mutex> metadata_lock(worker_node_.metadata_mutex());
+  RefreshServers();
   PartitionKVMessages messages;
   partitioner(send, &messages, attrs);
   std::vector<uint32_t> rank_ids;
@@ -946,6 +1138,12 @@ void Worker::SendForPush(int cmd, const KVMessage &send, const KVPartitioner &pa
   for (size_t i = 0; i < messages.size(); i++) {
     if (messages.at(i).first) {
       rank_ids.push_back(i);
+      if (cmd == kPushCmd) {
+        size_t size = 0;
+        data.push_back(BuildKVPayload(messages.at(i).second, &size));
+        sizes.push_back(size);
+        continue;
+      }
       std::string kv_data = messages.at(i).second.SerializeAsString();
 
       std::shared_ptr<unsigned char[]> res(new unsigned char[kv_data.length()]);
@@ -962,9 +1160,68 @@ void Worker::SendForPush(int cmd, const KVMessage &send, const KVPartitioner &pa
   worker_node_.Send(core::NodeRole::SERVER, rank_ids, data, sizes, cmd);
 }
 
+void Worker::SendPayloadForPush(const std::vector<Key> &keys, const std::vector<float> &vals,
+                                const std::vector<int> &lens) {
+  std::shared_lock<std::shared_mutex> metadata_lock(worker_node_.metadata_mutex());
+  RefreshServers();
+  std::vector<std::vector<size_t>> server_key_indices(IntToSize(worker_node_.server_num()));
+  std::vector<size_t> value_offsets(keys.size(), 0);
+  size_t value_offset = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    value_offsets[i] = value_offset;
+    if (!vals.empty()) {
+      value_offset += IntToSize(lens.at(i));
+    }
+    server_key_indices.at(KeyServerRank(keys[i])).push_back(i);
+  }
+
+  std::vector<uint32_t> rank_ids;
+  std::vector<DataPtr> data;
+  std::vector<size_t> sizes;
+  for (size_t server_id = 0; server_id < server_key_indices.size(); server_id++) {
+    const auto &indices = server_key_indices[server_id];
+    if (indices.empty()) {
+      continue;
+    }
+    size_t len_num = vals.empty() ? 0 : indices.size();
+    size_t value_num = 0;
+    for (size_t j = 0; j < len_num; j++) {
+      value_num += IntToSize(lens[indices[j]]);
+    }
+    size_t size = KVPayload::Size(indices.size(), len_num, value_num);
+    DataPtr buffer(new unsigned char[size]);
+    KVPayload payload = KVPayload::Create(buffer.get(), size, indices.size(), len_num, value_num);
+    float *dst = payload.values();
+    for (size_t j = 0; j < indices.size(); j++) {
+      size_t i = indices[j];
+      payload.keys()[j] = keys[i];
+      if (vals.empty()) {
+        continue;
+      }
+      payload.lens()[j] = lens[i];
+      dst = std::copy(vals.begin() + value_offsets[i], vals.begin() + value_offsets[i] + lens[i], dst);
+    }
+    rank_ids.push_back(server_id);
+    data.push_back(buffer);
+    sizes.push_back(size);
+  }
+  worker_node_.Send(core::NodeRole::SERVER, rank_ids, data, sizes, kPushCmd);
+}
+
+void Worker::SendToEmbeddingShards(const DataPtr &data, size_t size, int cmd) {
+  std::shared_lock<std::shared_mutex> metadata_lock(worker_node_.metadata_mutex());
+  RefreshServers();
+  std::vector<uint32_t> rank_ids = EmbeddingShardRanks();
+  std::vector<DataPtr> shard_data(rank_ids.size(), data);
+  std::vector<size_t> sizes(rank_ids.size(), size);
+  worker_node_.Send(core::NodeRole::SERVER, rank_ids, shard_data, sizes, cmd);
+}
+
 void Worker::SendForPull(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
                          const std::map<int64_t, int64_t> &attrs, std::vector<float> *vals, std::vector<int> *lens) {
   MS_EXCEPTION_IF_NULL(vals);
+  std::shared_lock<std::shared_mutex> metadata_lock(worker_node_.metadata_mutex());
+  RefreshServers();
   PartitionKVMessages messages;
   partitioner(send, &messages, {});
   std::vector<uint32_t> rank_ids;
@@ -988,8 +1245,17 @@ void Worker::SendForPull(int cmd, const KVMessage &send, const KVPartitioner &pa
   }
   std::vector<VectorPtr> resp;
   worker_node_.Send(core::NodeRole::SERVER, rank_ids, data, sizes, cmd, &resp);
+  metadata_lock.unlock();
   vals->clear();
   for (size_t i = 0; i < resp.size(); ++i) {
+    if (cmd == kPullCmd) {
+      KVPayload payload = KVPayload::Parse(resp.at(i)->data(), resp.at(i)->size());
+      vals->insert(vals->end(), payload.values(), payload.values() + payload.value_num());
+      if (lens) {
+        lens->assign(payload.lens(), payload.lens() + payload.len_num());
+      }
+      continue;
+    }
     KVMessage message;
     message.ParseFromArray(resp.at(i)->data(), resp.at(i)->size());
     std::copy(message.values().begin(), message.values().end(), std::back_inserter(*vals));
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -37,6 +38,8 @@
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
 #include "ps/core/worker_node.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/kv_payload.h"
+#include "ps/key_shard_map.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/ps_context.h"
@@ -74,27 +77,38 @@ class Worker {
   void InitPSParamAndOptim(const AnfNodePtr &input_node, const tensor::TensorPtr &tensor);
   void DoPSEmbeddingLookup(const Key &key, const std::vector<int> &lookup_ids, std::vector<float> *lookup_result,
                            int64_t cmd);
-  void UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
+  // Returns false if the rows are not sent to all their servers.
+  bool UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
                             const std::vector<float> &vals);
 
   bool running() { return running_; }
   void Finalize();
 
  private:
-  Worker() : server_num_(-1), running_(false), key_cnt_(0) {}
+  Worker() : server_num_(-1), running_(false), key_cnt_(0), metadata_version_(UINT64_MAX), push_count_(0) {}
   ~Worker() = default;
   Worker(const Worker &) = delete;
   Worker &operator=(const Worker &) = delete;
 
   void Initialize();
   bool IsKeyInit(const size_t key);
-  void AddKeyToServerId(const Key &key);
-  void AddKeyByHashMod(const Key &key);
+  void AddKeyToShardMap(const Key &key);
+  // Update the servers of the shard map when the servers of the cluster change. The callers of it and of the two
+  // functions below hold the metadata mutex of the node shared, so the ranks don't change under them.
+  void RefreshServers();
+  uint32_t KeyServerRank(const Key &key);
+  // The ranks of the servers holding the shards of the embedding tables, in the order of the shards.
+  std::vector<uint32_t> EmbeddingShardRanks();
   void InitPSOptimId(const size_t param_key);
   void InitPSOptimInputShapes(const size_t key);
   void InitPSParamData(const std::vector<size_t> &keys, void *const origin_addr, size_t size);
   bool IsReadyForPush(const Key &key);
   bool IsReadyForPull(const Key &key);
+  // Ask the server of the dense key whether it's ready. If the key has moved, the new server is pinned and it's not.
+  bool IsReady(const Key &key, int cmd);
+  // Count the bytes pushed for the dense key, and rebalance the keys every load_rebalance_interval pushes per key.
+  void RecordLoad(const Key &key, size_t size);
+  void Rebalance();
   void PrepareSparseGradient(const size_t begin, const size_t end, const std::unordered_set<int> &distinct_ids,
                              const std::vector<std::pair<int, float *>> &indice_to_grads, const int *all_indice,
                              const size_t segment_size, float *gradient, int *indices);
@@ -123,6 +137,9 @@ class Worker {
                             const std::map<int64_t, int64_t> &attrs);
   void SendForPush(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
                    const std::map<int64_t, int64_t> &attrs);
+  // Push the gradients of the keys, partitioned round robin, copying them once into the payload of each server.
+  void SendPayloadForPush(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens);
+  void SendToEmbeddingShards(const DataPtr &data, size_t size, int cmd);
   void SendForPull(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
                    const std::map<int64_t, int64_t> &attrs, std::vector<float> *vals, std::vector<int> *lens);
 
@@ -143,7 +160,18 @@ class Worker {
   KVPartitioner worker_init_embedding_partitioner_;
   KVPartitioner update_embedding_partitioner_;
   KVPartitioner broadcast_partitioner_;
-  std::unordered_map<Key, int64_t> key_to_server_id_;
+
+  // The dense keys are placed on the servers by the shard map. The embedding tables stay sharded by range over the
+  // servers the cluster started with.
+  std::mutex shard_map_mutex_;
+  KeyShardMap shard_map_;
+  std::map<std::string, uint32_t> server_ranks_;
+  std::vector<Key> dense_keys_;
+  std::vector<std::string> embedding_shard_servers_;
+  uint64_t metadata_version_;
+  std::unordered_map<Key, double> key_loads_;
+  uint64_t push_count_;
+
   std::unordered_map<Key, size_t> embedding_row_cnt_;
 
   std::unordered_map<Key, std::shared_ptr<std::vector<EmbeddingTableShardMetadata>>> embedding_table_ranges_;
@@ -0,0 +1,44 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include "utils/checkpoint/checkpoint_engine.h"
+#include "pybind_api/api_register.h"
+
+namespace mindspore {
+namespace checkpoint {
+REGISTER_PYBIND_DEFINE(CheckpointEngine, ([](const py::module *m) {
+                         (void)py::class_<CheckpointWriter, std::shared_ptr<CheckpointWriter>>(*m, "CheckpointWriter_")
+                           .def(py::init<const std::string &>())
+                           .def("snapshot", &CheckpointWriter::Snapshot, "Copy the host data of the tensors.")
+                           .def("write", &CheckpointWriter::Write, py::call_guard<py::gil_scoped_release>(),
+                                "Write the snapshot into the checkpoint file.")
+                           .def("write_async", &CheckpointWriter::WriteAsync,
+                                "Write the snapshot into the checkpoint file in the background.")
+                           .def("wait", &CheckpointWriter::Wait, py::call_guard<py::gil_scoped_release>(),
+                                "Wait for the background write.");
+                         (void)py::class_<CheckpointReader, std::shared_ptr<CheckpointReader>>(*m, "CheckpointReader_")
+                           .def(py::init<const std::string &>())
+                           .def("names", &CheckpointReader::Names, "Get the names of the tensors.")
+                           .def("read", &CheckpointReader::Read, py::call_guard<py::gil_scoped_release>(),
+                                "Read a tensor from the checkpoint file.")
+                           .def("read_all", &CheckpointReader::ReadAll, py::call_guard<py::gil_scoped_release>(),
+                                "Read the tensors from the checkpoint file with worker threads.");
+                         (void)m->def("_is_native_checkpoint", &IsCheckpointFile,
+                                      "Whether the file is a checkpoint in the native format.");
+                       }));
+}  // namespace checkpoint
+}  // namespace mindspore
@@ -16,12 +16,19 @@
 
 #include "runtime/device/bucket.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include "runtime/device/kernel_runtime_manager.h"
 #include "frontend/parallel/context.h"
 #include "utils/profile.h"
+#include "utils/convert_utils_base.h"
 
 namespace mindspore::device {
+namespace {
+constexpr double kSecondToMicroSecond = 1e6;
+}  // namespace
+
 void Bucket::AddGradTensor(const tensor::TensorPtr &tensor) {
   if (grad_tensor_list_.size() >= bucket_size_) {
     MS_LOG(EXCEPTION) << "bucket is full";
@@ -124,6 +131,61 @@ void Bucket::LazyDeleteOldAddr() {
   tensor_old_addr_list_.clear();
 }
 
+std::vector<uint32_t> PlanBucketSizesByTiming(const std::vector<double> &ready_times,
+                                              const std::vector<size_t> &grad_sizes, double latency, double bandwidth) {
+  if (ready_times.size() != grad_sizes.size()) {
+    MS_LOG(EXCEPTION) << "The ready times size " << ready_times.size() << " is not equal to the grad sizes size "
+                      << grad_sizes.size();
+  }
+  if (bandwidth <= 0) {
+    MS_LOG(EXCEPTION) << "The AllReduce bandwidth should be positive, but got " << bandwidth;
+  }
+  size_t grad_num = ready_times.size();
+  if (grad_num == 0) {
+    return {};
+  }
+  std::vector<double> prefix_bytes(grad_num + 1, 0);
+  for (size_t i = 0; i < grad_num; ++i) {
+    prefix_bytes[i + 1] = prefix_bytes[i] + grad_sizes[i];
+  }
+  // finish_time[j] is the earliest time the first j gradients are all reduced, with a bucket ending at gradient j.
+  std::vector<double> finish_time(grad_num + 1, std::numeric_limits<double>::max());
+  std::vector<size_t> bucket_begin(grad_num + 1, 0);
+  finish_time[0] = 0;
+  for (size_t j = 1; j <= grad_num; ++j) {
+    for (size_t i = 0; i < j; ++i) {
+      auto launch_time = std::max(finish_time[i], ready_times[j - 1]);
+      auto time = launch_time + latency + (prefix_bytes[j] - prefix_bytes[i]) / bandwidth;
+      if (time < finish_time[j]) {
+        finish_time[j] = time;
+        bucket_begin[j] = i;
+      }
+    }
+  }
+  std::vector<uint32_t> bucket_sizes;
+  for (size_t j = grad_num; j > 0; j = bucket_begin[j]) {
+    bucket_sizes.push_back(SizeToUint(j - bucket_begin[j]));
+  }
+  std::reverse(bucket_sizes.begin(), bucket_sizes.end());
+  return bucket_sizes;
+}
+
+void BucketTimingProfiler::RecordGrad(double time, size_t size) {
+  if (!profiling()) {
+    return;
+  }
+  ready_times_.push_back((time - step_start_time_) * kSecondToMicroSecond);
+  grad_sizes_.push_back(size);
+}
+
+std::vector<uint32_t> BucketTimingProfiler::Plan(double latency, double bandwidth) {
+  planned_ = true;
+  auto bucket_sizes = PlanBucketSizesByTiming(ready_times_, grad_sizes_, latency, bandwidth);
+  ready_times_.clear();
+  grad_sizes_.clear();
+  return bucket_sizes;
+}
+
 void Bucket::Release() {
   MS_LOG(INFO) << "Clear bucket:" << id_;
   grad_tensor_list_.clear();
@@ -46,6 +46,7 @@ class Bucket {
   virtual ~Bucket() = default;
 
   uint32_t id() const { return id_; }
+  uint32_t bucket_size() const { return bucket_size_; }
   bool full() const { return full_; }
   void Launch();
   void Release();
@@ -87,6 +88,46 @@ class Bucket {
   void UpdateTensorOutputAddr(uint8_t *addr);
   void LazyDeleteOldAddr();
 };
+
+// Plan the sizes, in number of gradients, of the buckets that gradients fill in the order they become ready.
+// ready_times are the times the gradients are produced during the backward pass, and each bucket is launched once its
+// last gradient is ready and costs latency + bytes / bandwidth on a single communication stream. The plan minimizes
+// the time the last AllReduce finishes, keeping the later buckets as large as possible among equal plans.
+std::vector<uint32_t> PlanBucketSizesByTiming(const std::vector<double> &ready_times,
+                                              const std::vector<size_t> &grad_sizes, double latency, double bandwidth);
+
+// Collects the times, in us from the start of the step, at which the gradients are computed on device in one step, and
+// plans the buckets by them in the step after. The first step builds every single op, so the second one is profiled.
+class BucketTimingProfiler {
+ public:
+  BucketTimingProfiler() = default;
+  ~BucketTimingProfiler() = default;
+
+  // Called at the start of every step.
+  void NextStep() { ++step_; }
+  // The time in seconds the step running starts at, whose gradients are timed from it.
+  void set_step_start_time(double start_time) { step_start_time_ = start_time; }
+  // Whether the gradients of the step running are recorded.
+  bool profiling() const { return !planned_ && step_ == kProfileStep; }
+  // Whether the profiled step has finished and its buckets are not planned yet.
+  bool ready_to_plan() const { return !planned_ && step_ > kProfileStep; }
+  // time is in seconds, when the gradient has been computed on device, and size is in bytes.
+  void RecordGrad(double time, size_t size);
+  size_t grad_num() const { return ready_times_.size(); }
+  // Plan the bucket sizes by the timing recorded, with AllReduce costing latency us + bytes / bandwidth bytes per us.
+  // The buckets are planned once only, so the timing recorded is released.
+  std::vector<uint32_t> Plan(double latency, double bandwidth);
+
+ private:
+  static constexpr size_t kProfileStep = 2;
+
+  // The number of steps started, so the step running is the step_-th one.
+  size_t step_{0};
+  bool planned_{false};
+  double step_start_time_{0};
+  std::vector<double> ready_times_;
+  std::vector<size_t> grad_sizes_;
+};
 }  // namespace mindspore::device
 
 #endif  // MINDSPORE_MINDSPORE_CCSRC_RUNTIME_DEVICE_BUCKET_H_
@@ -48,6 +48,9 @@ class GPUMemoryManager;
 class GPUDeviceContext;
 }  // namespace gpu
 }  // namespace device
+namespace runtime {
+class GraphScheduler;
+}  // namespace runtime
 }  // namespace mindspore
 
 namespace mindspore {
@@ -124,6 +127,7 @@ class DeviceAddress : public mindspore::DeviceSync {
   friend class mindspore::device::ascend::AscendMemoryManager;
   friend class mindspore::device::ascend::DataDumper;
   friend class mindspore::device::Bucket;
+  friend class mindspore::runtime::GraphScheduler;
 };
 
 using DeviceAddressPtr = std::shared_ptr<DeviceAddress>;
@@ -116,11 +116,20 @@ void KernelActor::RunOpControlWithInputTensor(AID *input_control, OpContext<Devi
 }
 
 void KernelActor::SendMemoryAllocReq(OpContext<DeviceTensor> *context) {
+  // The static memory has been allocated before running, so launch the kernel directly without the message of memory
+  // manager actor.
+  if (is_static_memory_) {
+    OnMemoryAllocFinish(context);
+    return;
+  }
   Async(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, &memory_alloc_list_, device_context_, context,
         GetAID());
 }
 
 void KernelActor::SendMemoryFreeReq(OpContext<DeviceTensor> *context) {
+  if (is_memory_free_skipped_) {
+    return;
+  }
   Async(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &memory_free_list_, device_context_, context);
 }
 
@@ -291,10 +300,14 @@ void KernelActor::PostLaunchKernel(OpContext<DeviceTensor> *context) {
 
 void KernelActor::SendOutput(OpContext<DeviceTensor> *context) const {
   MS_EXCEPTION_IF_NULL(context);
-  // Send output data.
+  // Send output data. The successor in the linear chain runs inline in the current thread.
   for (auto &output_data : output_data_) {
     MS_EXCEPTION_IF_NULL(output_data);
-    Async(output_data->op_id_, &OpActor::RunOpData, output_data, context);
+    if (inline_output_actor_ != nullptr) {
+      inline_output_actor_->RunOpData(output_data, context);
+    } else {
+      Async(output_data->op_id_, &OpActor::RunOpData, output_data, context);
+    }
   }
 
   // Send graph output result.
@@ -54,7 +54,10 @@ class KernelActor : public DebugAwareActor {
         recorder_aid_(recorder_aid),
         input_datas_num_(0),
         input_controls_num_(0),
-        real_input_num_(0) {}
+        real_input_num_(0),
+        is_static_memory_(false),
+        is_memory_free_skipped_(false),
+        inline_output_actor_(nullptr) {}
   ~KernelActor() override = default;
 
   void Init() override;
@@ -120,6 +123,17 @@ class KernelActor : public DebugAwareActor {
   // The real input number of kernel launch.
   size_t real_input_num_;
 
+  // The output and workspace memory of static memory kernel is planned and allocated by the graph scheduler before
+  // running, so the kernel actor skips the memory alloc request to the memory manager actor.
+  bool is_static_memory_;
+  // All the inputs, outputs and workspaces of the kernel actor are static memory or persistent device tensor, so the
+  // kernel actor skips the memory free request to the memory manager actor.
+  bool is_memory_free_skipped_;
+
+  // The successor kernel actor in the linear chain, which only depends on the output data of this kernel actor. The
+  // output data is sent to it by the direct function call in the current thread instead of the actor message.
+  KernelActor *inline_output_actor_;
+
   // The dependent input actors.
   std::vector<AID> input_data_arrow_aids_;
   std::vector<AID> input_control_arrow_aids_;
@@ -15,6 +15,7 @@
  */
 
 #include "runtime/framework/graph_scheduler.h"
+#include "runtime/framework/static_memory_planner.h"
 #include "runtime/framework/actor/memory_manager_actor.h"
 #include "runtime/framework/actor/debug_actor.h"
 #include "runtime/framework/actor/recorder_actor.h"
@@ -35,6 +36,11 @@
 namespace mindspore {
 namespace runtime {
 namespace {
+// The max number of kernel actors which run inline in one chain, to limit the depth of call stack.
+constexpr size_t kMaxInlineChainLength = 64;
+// The max number of kernel actors in the static memory plan of one graph, to limit the memory of the plan.
+constexpr size_t kMaxStaticMemoryPlanKernelNum = 8192;
+
 bool IsNeedInsertCopyActor(const DeviceContext *from_devcie_context, const DeviceContext *to_devcie_context) {
   MS_EXCEPTION_IF_NULL(from_devcie_context);
   MS_EXCEPTION_IF_NULL(to_devcie_context);
@@ -506,7 +512,10 @@ void GraphScheduler::PrepareRun(const ActorSet *actor_set, const GraphCompilerIn
     }
   }
 
-  // 3.Fill host tensors for non weighted parameters which belongs to control node.
+  // 3.Prepare the static memory for the kernel actors, which is allocated only once before the first step.
+  AllocateStaticMemory(actor_set);
+
+  // 4.Fill host tensors for non weighted parameters which belongs to control node.
   std::vector<AnfNodePtr> control_node_parameters =
     ControlNodeParser::FetchControlNodeParameter(graph_compiler_info.control_nodes_);
   const auto &tensors = input_tensors.back();
@@ -523,7 +532,7 @@ void GraphScheduler::PrepareRun(const ActorSet *actor_set, const GraphCompilerIn
     }
   }
 
-  // 4.Prepare the data of host tensor queue(non weighted parameters of graph).
+  // 5.Prepare the data of host tensor queue(non weighted parameters of graph).
   if (host_data_source_actor != nullptr) {
     const auto &host_tensor_queue = FetchHostQueue(actor_set->name_);
     MS_EXCEPTION_IF_NULL(host_tensor_queue);
@@ -694,6 +703,13 @@ void GraphScheduler::Link(ActorSet *actor_set, const GraphCompilerInfo &graph_co
 
   // Link the output result arrows for output actors.
   LinkOutputResultArrowForOutputActor(actor_set->output_actor_.get(), graph_compiler_info);
+
+  // The static memory plan depends on the output result arrows and input data arrows of kernel actors, so must be the
+  // last in the link.
+  PlanStaticMemory(actor_set, graph_compiler_info, strategy);
+
+  // The chain of kernel actors depends on all the arrows of kernel actors, so must be after all the arrows linked.
+  LinkKernelActorChain(graph_compiler_info, strategy);
 }
 
 std::vector<DataSourceActorPtr> GraphScheduler::BuildDataSourceActor(const GraphCompilerInfo &graph_compiler_info,
@@ -1774,6 +1790,253 @@ void GraphScheduler::PersistDeviceTensor(const GraphCompilerInfo &graph_compiler
   }
 }
 
+void GraphScheduler::PlanStaticMemory(ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info,
+                                      GraphExecutionStrategy strategy) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  // The kernel actor of step mode runs once, and the memory is released after running.
+  if (strategy == GraphExecutionStrategy::kStep) {
+    return;
+  }
+
+  for (size_t i = 0; i < graph_compiler_info.graphs_.size(); ++i) {
+    const auto &graph = graph_compiler_info.graphs_[i];
+    MS_EXCEPTION_IF_NULL(graph);
+    // The memory size of dynamic shape graph is variable, so it can't be planned statically.
+    if (graph->is_dynamic_shape()) {
+      continue;
+    }
+
+    // The kernel actors are indexed by the execution order, which is a topological order of their arrows.
+    std::vector<KernelActor *> kernel_actors;
+    std::unordered_map<std::string, size_t> kernel_actor_indexes;
+    for (const auto &kernel : graph->execution_order()) {
+      if (IsSkippedKernelActor(kernel) || (!IsKernelActor(kernel))) {
+        continue;
+      }
+      const auto &kernel_actor = dynamic_cast<KernelActor *>(FetchActor(kernel->fullname_with_scope()));
+      MS_EXCEPTION_IF_NULL(kernel_actor);
+      kernel_actor_indexes[kernel_actor->GetAID().Name()] = kernel_actors.size();
+      kernel_actors.emplace_back(kernel_actor);
+    }
+    // The lifetimes of the memory blocks are compared by the ancestors of kernels, whose size is square of the kernels.
+    if (kernel_actors.size() > kMaxStaticMemoryPlanKernelNum) {
+      MS_LOG(INFO) << "The kernel number " << kernel_actors.size() << " of graph " << graph->graph_id()
+                   << " exceeds the limit of static memory plan: " << kMaxStaticMemoryPlanKernelNum;
+      continue;
+    }
+
+    StaticMemoryPlanner planner(kernel_actors.size());
+    for (size_t to = 0; to < kernel_actors.size(); ++to) {
+      for (const auto &input_aids : {kernel_actors[to]->input_data_arrow_aids_,
+                                     kernel_actors[to]->input_control_arrow_aids_}) {
+        for (const auto &input_aid : input_aids) {
+          const auto &iter = kernel_actor_indexes.find(input_aid.Name());
+          if (iter != kernel_actor_indexes.end()) {
+            planner.AddDependency(iter->second, to);
+          }
+        }
+      }
+    }
+
+    auto arena = std::make_shared<StaticMemoryArena>();
+    arena->device_context_ = graph_compiler_info.device_contexts_[i];
+    std::vector<DeviceTensor *> device_tensors;
+    for (size_t index = 0; index < kernel_actors.size(); ++index) {
+      auto &kernel_actor = kernel_actors[index];
+      const auto &kernel = kernel_actor->kernel_;
+      // The memory of communication kernel is allocated continuously in the prepare of running.
+      if (AnfAlgo::IsDynamicShape(kernel) || AnfAlgo::IsCommunicationOp(kernel)) {
+        continue;
+      }
+      // The output device tensor of graph output may be replaced by the output actor in each step.
+      if (kernel_actor->output_result_arrows_.size() > 0) {
+        continue;
+      }
+      size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+      bool is_ref_output = false;
+      for (size_t j = 0; j < output_num; ++j) {
+        if (graph->IsInRefOutputMap(std::make_pair(kernel, j))) {
+          is_ref_output = true;
+          break;
+        }
+      }
+      if (is_ref_output) {
+        continue;
+      }
+
+      // The output is read by the kernel actors which it is sent to. It's also read by the other actors like copy
+      // actor, whose launch order is unknown, so it keeps its own memory.
+      for (size_t j = 0; j < output_num; ++j) {
+        std::vector<size_t> consumers;
+        bool is_live_forever = false;
+        for (const auto &data_arrow : kernel_actor->output_data_arrows_) {
+          MS_EXCEPTION_IF_NULL(data_arrow);
+          if (IntToSize(data_arrow->from_output_index_) != j) {
+            continue;
+          }
+          const auto &iter = kernel_actor_indexes.find(data_arrow->to_op_id_.Name());
+          if (iter == kernel_actor_indexes.end()) {
+            is_live_forever = true;
+          } else {
+            consumers.emplace_back(iter->second);
+          }
+        }
+        auto device_tensor = AnfAlgo::GetMutableOutputAddr(kernel, j, false).get();
+        (void)planner.AddBlock(device_tensor->GetSize(), index, consumers, is_live_forever);
+        device_tensors.emplace_back(device_tensor);
+      }
+      // The workspace is only used in the launch of its kernel.
+      auto kernel_info = static_cast<KernelInfo *>(kernel->kernel_info());
+      MS_EXCEPTION_IF_NULL(kernel_info);
+      for (const auto &workspace_address : kernel_info->workspace_address_list()) {
+        MS_EXCEPTION_IF_NULL(workspace_address);
+        (void)planner.AddBlock(workspace_address->GetSize(), index, {}, false);
+        device_tensors.emplace_back(workspace_address.get());
+      }
+      kernel_actor->is_static_memory_ = true;
+      arena->kernel_actors_.emplace_back(kernel_actor);
+    }
+    if (arena->kernel_actors_.empty()) {
+      continue;
+    }
+
+    arena->size_ = planner.Plan();
+    const auto &blocks = planner.blocks();
+    for (size_t j = 0; j < device_tensors.size(); ++j) {
+      auto &device_tensor = device_tensors[j];
+      MS_EXCEPTION_IF_NULL(device_tensor);
+      arena->device_tensor_offsets_.emplace_back(device_tensor, blocks[j].offset_);
+      arena->original_ref_counts_.emplace_back(device_tensor->original_ref_count());
+      // The static memory is persistent, so set the max reference count to avoid freeing by the memory manager actor.
+      UpdateRefCount(device_tensor, true);
+    }
+    MS_LOG(INFO) << "Graph(" << graph_compiler_info.name_ << ") plans static memory for "
+                 << arena->kernel_actors_.size() << " kernel actors of graph " << graph->graph_id() << ", arena size "
+                 << arena->size_ << ", total size of device tensors " << planner.total_block_size();
+    actor_set->static_memory_arenas_.emplace_back(arena);
+  }
+  UpdateMemoryFreeSkipped(actor_set);
+}
+
+void GraphScheduler::AllocateStaticMemory(const ActorSet *actor_set) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  bool is_fallback = false;
+  for (const auto &arena : actor_set->static_memory_arenas_) {
+    MS_EXCEPTION_IF_NULL(arena);
+    if ((arena->arena_ != nullptr) || (arena->kernel_actors_.empty())) {
+      continue;
+    }
+    const auto &device_context = arena->device_context_;
+    MS_EXCEPTION_IF_NULL(device_context);
+    arena->arena_ =
+      device_context->CreateDeviceAddress(nullptr, arena->size_, kOpFormat_DEFAULT, TypeId::kNumberTypeUInt8);
+    MS_EXCEPTION_IF_NULL(arena->arena_);
+    if (device_context->AllocateMemory(arena->arena_.get(), arena->size_)) {
+      auto base = static_cast<uint8_t *>(arena->arena_->GetMutablePtr());
+      for (const auto &device_tensor_offset : arena->device_tensor_offsets_) {
+        auto &device_tensor = device_tensor_offset.first;
+        // The device tensor may have been allocated as the continuous memory of communication kernel.
+        if ((device_tensor->GetPtr() != nullptr) || (device_tensor->GetSize() == 0)) {
+          continue;
+        }
+        device_tensor->set_ptr(base + device_tensor_offset.second);
+      }
+      continue;
+    }
+
+    MS_LOG(WARNING) << "Device memory isn't enough for the static memory arena of size " << arena->size_
+                    << ", and the kernel actors fall back to the dynamic memory.";
+    is_fallback = true;
+    for (size_t i = 0; i < arena->device_tensor_offsets_.size(); ++i) {
+      auto &device_tensor = arena->device_tensor_offsets_[i].first;
+      device_tensor->set_original_ref_count(arena->original_ref_counts_[i]);
+      device_tensor->ResetRefCount();
+    }
+    for (auto &kernel_actor : arena->kernel_actors_) {
+      kernel_actor->is_static_memory_ = false;
+    }
+    arena->kernel_actors_.clear();
+    arena->device_tensor_offsets_.clear();
+    arena->original_ref_counts_.clear();
+    arena->arena_ = nullptr;
+  }
+  if (is_fallback) {
+    UpdateMemoryFreeSkipped(actor_set);
+  }
+}
+
+void GraphScheduler::UpdateMemoryFreeSkipped(const ActorSet *actor_set) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  // The memory free request is needless when all the input device tensors are from the static memory actors, and the
+  // input device tensors from device tensor store are persistent.
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    if ((!kernel_actor->is_static_memory_) ||
+        (kernel_actor->input_data_arrow_aids_.size() != kernel_actor->input_datas_num_)) {
+      kernel_actor->is_memory_free_skipped_ = false;
+      continue;
+    }
+    kernel_actor->is_memory_free_skipped_ =
+      std::all_of(kernel_actor->input_data_arrow_aids_.begin(), kernel_actor->input_data_arrow_aids_.end(),
+                  [this](const AID &input_aid) {
+                    const auto &from_actor = dynamic_cast<KernelActor *>(FetchActor(input_aid.Name()));
+                    return (from_actor != nullptr) && from_actor->is_static_memory_;
+                  });
+  }
+}
+
+void GraphScheduler::LinkKernelActorChain(const GraphCompilerInfo &graph_compiler_info,
+                                          GraphExecutionStrategy strategy) {
+  // The kernel actor of step mode is triggered by the control of each kernel actor.
+  if (strategy == GraphExecutionStrategy::kStep) {
+    return;
+  }
+
+  // The length of chain which the kernel actor is in.
+  std::unordered_map<KernelActor *, size_t> chain_lengths;
+  size_t inline_actor_num = 0;
+  for (const auto &graph : graph_compiler_info.graphs_) {
+    MS_EXCEPTION_IF_NULL(graph);
+    for (const auto &kernel : graph->execution_order()) {
+      if (IsSkippedKernelActor(kernel) || (!IsKernelActor(kernel))) {
+        continue;
+      }
+      const auto &from_actor = dynamic_cast<KernelActor *>(FetchActor(kernel->fullname_with_scope()));
+      MS_EXCEPTION_IF_NULL(from_actor);
+      // Only the kernel actor which outputs data to the unique kernel actor can be the predecessor in the chain.
+      if ((from_actor->output_data_arrows_.size() == 0) || (from_actor->output_control_arrows_.size() > 0) ||
+          (from_actor->output_result_arrows_.size() > 0)) {
+        continue;
+      }
+      const auto &to_aid = from_actor->output_data_arrows_[0]->to_op_id_;
+      bool is_unique_successor =
+        std::all_of(from_actor->output_data_arrows_.begin(), from_actor->output_data_arrows_.end(),
+                    [&to_aid](const DataArrowPtr &data_arrow) { return data_arrow->to_op_id_ == to_aid; });
+      if (!is_unique_successor) {
+        continue;
+      }
+
+      // The successor must depend on the predecessor only, so that it is ready immediately after the predecessor.
+      const auto &to_actor = dynamic_cast<KernelActor *>(FetchActor(to_aid.Name()));
+      if ((to_actor == nullptr) || (to_actor->input_controls_num_ > 0) ||
+          (to_actor->input_datas_num_ != from_actor->output_data_arrows_.size()) ||
+          (to_actor->device_context_ != from_actor->device_context_)) {
+        continue;
+      }
+
+      auto chain_length = chain_lengths[from_actor] + 1;
+      if (chain_length >= kMaxInlineChainLength) {
+        continue;
+      }
+      from_actor->inline_output_actor_ = to_actor;
+      chain_lengths[to_actor] = chain_length;
+      ++inline_actor_num;
+    }
+  }
+  MS_LOG(INFO) << "Graph(" << graph_compiler_info.name_ << ") links " << inline_actor_num
+               << " kernel actors to run inline in the chain.";
+}
+
 HostTensorQueue *GraphScheduler::FetchHostQueue(const ActorInfo &actor_info) const {
   const auto &iter = actor_to_host_queue_.find(actor_info);
   if (iter != actor_to_host_queue_.end()) {
@@ -1946,7 +2209,8 @@ void GraphScheduler::DumpKernelActor(const KernelActor *actor, std::ofstream &of
   ofs << "\tactor_name:" << actor->GetAID().Name()
       << "\tdevice_context:" << actor->device_context_->device_context_key().ToString()
       << "\tinput_data_num:" << actor->input_datas_num_ << "\tinput_controls_num:" << actor->input_controls_num_
-      << "\n";
+      << "\tis_static_memory:" << actor->is_static_memory_
+      << "\tis_memory_free_skipped:" << actor->is_memory_free_skipped_ << "\n";
 
   const auto &kernel = actor->kernel_;
   MS_EXCEPTION_IF_NULL(kernel);
@@ -1975,6 +2239,10 @@ void GraphScheduler::DumpKernelActor(const KernelActor *actor, std::ofstream &of
         << "\tto_actor_name:" << result_arrow->to_op_id_.Name()
         << "\toutput_node_position:" << result_arrow->to_input_index_ << "\n";
   }
+
+  if (actor->inline_output_actor_ != nullptr) {
+    ofs << "\t\tinline_output_actor:" << actor->inline_output_actor_->GetAID().Name() << "\n ";
+  }
   ofs << "\n";
 }
 
@@ -98,6 +98,19 @@ struct GraphCompilerInfo {
   std::string name_;
 };
 
+// The static memory of the kernel actors in a graph. The output and workspace device tensors of these kernel actors
+// share one arena at the offsets planned by their lifetimes, and the arena is allocated once before the first step.
+struct StaticMemoryArena {
+  const DeviceContext *device_context_{nullptr};
+  size_t size_{0};
+  DeviceTensorPtr arena_{nullptr};
+  std::vector<KernelActor *> kernel_actors_;
+  std::vector<std::pair<DeviceTensor *, size_t>> device_tensor_offsets_;
+  // The reference counts of the device tensors before planning, which are restored when the arena can't be allocated.
+  std::vector<size_t> original_ref_counts_;
+};
+using StaticMemoryArenaPtr = std::shared_ptr<StaticMemoryArena>;
+
 // The actor set generated by graph transformer is the execution unit of actor runtime.
 // It includes data source actor, kernel actor, switch actor, copy actor, loop count actor and output actor.
 // The data source actor is used to obtain data and process them into device tensors, and send them to kernel actor.
@@ -121,6 +134,7 @@ struct ActorSet {
   std::vector<CopyActorPtr> copy_actors_;
   LoopCountActorPtr loop_count_actor_{nullptr};
   OutputActorPtr output_actor_{nullptr};
+  std::vector<StaticMemoryArenaPtr> static_memory_arenas_;
   ActorInfo name_;
 };
 using ActorSetPtr = std::shared_ptr<ActorSet>;
@@ -241,6 +255,21 @@ class GraphScheduler {
   // new DataArrow and send output data back, the method must execute after calling Schedule.
   void LinkDataArrowForKernelActorDynamicly(const ActorSet *actor_set);
 
+  // Plan the static memory of kernel actors in the static shape graphs. The output and workspace memory of these kernel
+  // actors is allocated once before running, so that they don't need send the memory alloc and free requests to the
+  // memory manager actor in each step.
+  void PlanStaticMemory(ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info,
+                        GraphExecutionStrategy strategy);
+  // Allocate the arenas of static memory in the first step. The kernel actors of the arena which can't be allocated
+  // fall back to the memory alloc and free requests to the memory manager actor.
+  void AllocateStaticMemory(const ActorSet *actor_set);
+  // The kernel actor skips the memory free request when all its inputs are from the static memory kernel actors.
+  void UpdateMemoryFreeSkipped(const ActorSet *actor_set);
+
+  // Link the kernel actors of linear chain to run inline, the successor kernel actor which only depends on the output
+  // data of the predecessor kernel actor is called in the thread of predecessor directly without the actor message.
+  void LinkKernelActorChain(const GraphCompilerInfo &graph_compiler_info, GraphExecutionStrategy strategy);
+
   // Check whether the actor set is valid.
   bool CheckActorValid(const ActorSet *actor_set,
                        GraphExecutionStrategy strategy = GraphExecutionStrategy::kPipeline) const;
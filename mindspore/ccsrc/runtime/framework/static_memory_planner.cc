@@ -0,0 +1,153 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/framework/static_memory_planner.h"
+#include <algorithm>
+#include <utility>
+#include "utils/log_adapter.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kBitsPerWord = 64;
+
+size_t AlignMemorySize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+}  // namespace
+
+void StaticMemoryPlanner::AddDependency(size_t from, size_t to) {
+  if ((from >= to) || (to >= kernel_num_)) {
+    return;
+  }
+  kernel_inputs_[to].emplace_back(from);
+}
+
+size_t StaticMemoryPlanner::AddBlock(size_t size, size_t producer, const std::vector<size_t> &consumers,
+                                     bool is_live_forever) {
+  if (producer >= kernel_num_) {
+    MS_LOG(EXCEPTION) << "The producer index " << producer << " is out of the kernel number " << kernel_num_;
+  }
+  StaticMemoryBlock block;
+  block.size_ = AlignMemorySize(size);
+  block.producer_ = producer;
+  block.is_live_forever_ = is_live_forever;
+  size_t last_kernel = producer;
+  for (auto consumer : consumers) {
+    if (consumer >= kernel_num_) {
+      MS_LOG(EXCEPTION) << "The consumer index " << consumer << " is out of the kernel number " << kernel_num_;
+    }
+    // The consumer before the producer in the topological order reads the block of the previous step.
+    if (consumer < producer) {
+      block.is_live_forever_ = true;
+    }
+    last_kernel = std::max(last_kernel, consumer);
+  }
+  block.consumers_ = consumers;
+  total_block_size_ += block.size_;
+  blocks_.emplace_back(std::move(block));
+  block_last_kernels_.emplace_back(last_kernel);
+  return blocks_.size() - 1;
+}
+
+void StaticMemoryPlanner::ComputeAncestors() {
+  size_t word_num = (kernel_num_ + kBitsPerWord - 1) / kBitsPerWord;
+  kernel_ancestors_.assign(kernel_num_, std::vector<uint64_t>(word_num, 0));
+  for (size_t kernel = 0; kernel < kernel_num_; ++kernel) {
+    auto &ancestors = kernel_ancestors_[kernel];
+    for (auto input : kernel_inputs_[kernel]) {
+      const auto &input_ancestors = kernel_ancestors_[input];
+      for (size_t i = 0; i < word_num; ++i) {
+        ancestors[i] |= input_ancestors[i];
+      }
+      ancestors[input / kBitsPerWord] |= (static_cast<uint64_t>(1) << (input % kBitsPerWord));
+    }
+  }
+}
+
+bool StaticMemoryPlanner::IsAncestor(size_t ancestor, size_t kernel) const {
+  return (kernel_ancestors_[kernel][ancestor / kBitsPerWord] >> (ancestor % kBitsPerWord)) & 1;
+}
+
+bool StaticMemoryPlanner::IsEndBefore(const StaticMemoryBlock &block, size_t writer) const {
+  if (!IsAncestor(block.producer_, writer)) {
+    return false;
+  }
+  return std::all_of(block.consumers_.begin(), block.consumers_.end(),
+                     [this, writer](size_t consumer) { return IsAncestor(consumer, writer); });
+}
+
+bool StaticMemoryPlanner::IsLifetimeOverlapped(size_t first_block, size_t second_block) const {
+  const auto &first = blocks_[first_block];
+  const auto &second = blocks_[second_block];
+  if (first.is_live_forever_ || second.is_live_forever_) {
+    return true;
+  }
+  // Only the block used up earlier in the topological order can be launched before the other one by the dependencies.
+  if (block_last_kernels_[first_block] < second.producer_) {
+    return !IsEndBefore(first, second.producer_);
+  }
+  if (block_last_kernels_[second_block] < first.producer_) {
+    return !IsEndBefore(second, first.producer_);
+  }
+  return true;
+}
+
+size_t StaticMemoryPlanner::Plan() {
+  ComputeAncestors();
+  // Place the larger blocks first, and put each block into the smallest gap between the overlapped blocks placed.
+  std::vector<size_t> block_order(blocks_.size());
+  for (size_t i = 0; i < block_order.size(); ++i) {
+    block_order[i] = i;
+  }
+  std::stable_sort(block_order.begin(), block_order.end(),
+                   [this](size_t left, size_t right) { return blocks_[left].size_ > blocks_[right].size_; });
+
+  size_t arena_size = 0;
+  std::vector<size_t> placed_blocks;
+  std::vector<std::pair<size_t, size_t>> overlapped_ranges;
+  for (auto block_index : block_order) {
+    auto &block = blocks_[block_index];
+    if (block.size_ == 0) {
+      continue;
+    }
+    overlapped_ranges.clear();
+    for (auto placed_index : placed_blocks) {
+      if (IsLifetimeOverlapped(block_index, placed_index)) {
+        const auto &placed = blocks_[placed_index];
+        overlapped_ranges.emplace_back(placed.offset_, placed.offset_ + placed.size_);
+      }
+    }
+    std::sort(overlapped_ranges.begin(), overlapped_ranges.end());
+
+    size_t gap_start = 0;
+    size_t best_offset = SIZE_MAX;
+    size_t best_gap = SIZE_MAX;
+    for (const auto &range : overlapped_ranges) {
+      if ((range.first > gap_start) && (range.first - gap_start >= block.size_) &&
+          (range.first - gap_start < best_gap)) {
+        best_offset = gap_start;
+        best_gap = range.first - gap_start;
+      }
+      gap_start = std::max(gap_start, range.second);
+    }
+    block.offset_ = (best_offset == SIZE_MAX) ? gap_start : best_offset;
+    arena_size = std::max(arena_size, block.offset_ + block.size_);
+    placed_blocks.emplace_back(block_index);
+  }
+  return arena_size;
+}
+}  // namespace runtime
+}  // namespace mindspore
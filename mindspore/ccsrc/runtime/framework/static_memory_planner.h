@@ -0,0 +1,79 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STATIC_MEMORY_PLANNER_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STATIC_MEMORY_PLANNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+namespace runtime {
+// The memory block of a device tensor in the static memory plan. It's written by the launch of its producer kernel and
+// read by the launches of its consumer kernels. The kernels are indexed in a topological order of the dependencies.
+struct StaticMemoryBlock {
+  size_t size_{0};
+  size_t producer_{0};
+  std::vector<size_t> consumers_;
+  // The block is read by a consumer out of the plan, whose launch order is unknown, so it never shares the memory.
+  bool is_live_forever_{false};
+  size_t offset_{0};
+};
+
+// Assign the offsets of memory blocks in one arena, where the blocks whose lifetimes don't overlap share the memory.
+// The kernels are launched asynchronously by the actors in any order consistent with the dependencies, so the lifetime
+// of a block ends only when all its readers are launched before the writer of the other block by the dependencies. The
+// kernels launch on the same stream, so the kernel launched earlier finishes before the kernel launched later starts.
+class StaticMemoryPlanner {
+ public:
+  explicit StaticMemoryPlanner(size_t kernel_num) : kernel_num_(kernel_num), kernel_inputs_(kernel_num) {}
+  ~StaticMemoryPlanner() = default;
+
+  // The kernel 'to' is launched after the launch of the kernel 'from'. The dependency which is not consistent with the
+  // topological order is ignored, which only makes the plan share less memory.
+  void AddDependency(size_t from, size_t to);
+  // Return the index of the added block.
+  size_t AddBlock(size_t size, size_t producer, const std::vector<size_t> &consumers, bool is_live_forever);
+
+  // Assign the offsets of all the blocks and return the arena size, which is the peak memory of the plan.
+  size_t Plan();
+
+  const std::vector<StaticMemoryBlock> &blocks() const { return blocks_; }
+  // The memory size when every block is allocated separately.
+  size_t total_block_size() const { return total_block_size_; }
+
+ private:
+  // Compute the kernels which are launched before each kernel by the dependencies.
+  void ComputeAncestors();
+  bool IsAncestor(size_t ancestor, size_t kernel) const;
+  // Whether the producer and all the consumers of the block are launched before the kernel 'writer'.
+  bool IsEndBefore(const StaticMemoryBlock &block, size_t writer) const;
+  bool IsLifetimeOverlapped(size_t first_block, size_t second_block) const;
+
+  size_t kernel_num_;
+  std::vector<std::vector<size_t>> kernel_inputs_;
+  // The bitmap of the ancestors of each kernel.
+  std::vector<std::vector<uint64_t>> kernel_ancestors_;
+  std::vector<StaticMemoryBlock> blocks_;
+  // The last kernel which uses the block in the topological order.
+  std::vector<size_t> block_last_kernels_;
+  size_t total_block_size_{0};
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STATIC_MEMORY_PLANNER_H_
@@ -0,0 +1,333 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/checkpoint/checkpoint_engine.h"
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+#include "utils/system/crc32c.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace {
+constexpr size_t kMaxWorkerNum = 8;
+constexpr size_t kHeaderSize = kCheckpointMagicSize + 2 * sizeof(uint64_t);
+
+uint64_t Align(uint64_t size) { return (size + kCheckpointAlignment - 1) / kCheckpointAlignment * kCheckpointAlignment; }
+
+uint32_t DataCrc(const void *data, size_t size) {
+  if (size == 0) {
+    return system::Crc32c::GetMaskCrc32cValue("", 0);
+  }
+  return system::Crc32c::GetMaskCrc32cValue(static_cast<const char *>(data), size);
+}
+
+template <typename T>
+void AppendValue(std::string *buf, T value) {
+  (void)buf->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void AppendEntry(std::string *buf, const CheckpointEntry &entry) {
+  AppendValue<uint32_t>(buf, entry.name.size());
+  (void)buf->append(entry.name);
+  AppendValue<int32_t>(buf, static_cast<int32_t>(entry.data_type));
+  AppendValue<uint32_t>(buf, entry.shape.size());
+  for (auto dim : entry.shape) {
+    AppendValue<int64_t>(buf, dim);
+  }
+  AppendValue<uint64_t>(buf, entry.offset);
+  AppendValue<uint64_t>(buf, entry.size);
+  AppendValue<uint32_t>(buf, entry.crc);
+}
+
+size_t EntrySize(const CheckpointEntry &entry) {
+  return sizeof(uint32_t) + entry.name.size() + sizeof(int32_t) + sizeof(uint32_t) +
+         entry.shape.size() * sizeof(int64_t) + 2 * sizeof(uint64_t) + sizeof(uint32_t);
+}
+
+// Reads the values of the index in order, failing on a truncated index.
+class IndexCursor {
+ public:
+  IndexCursor(const std::string &file_name, const std::string &buf) : file_name_(file_name), buf_(buf) {}
+  ~IndexCursor() = default;
+
+  template <typename T>
+  T Read() {
+    T value;
+    auto ret = memcpy_s(&value, sizeof(T), Take(sizeof(T)), sizeof(T));
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Read the index of checkpoint file " << file_name_ << " failed, memcpy_s error " << ret;
+    }
+    return value;
+  }
+
+  std::string ReadString(size_t size) { return std::string(Take(size), size); }
+
+ private:
+  const char *Take(size_t size) {
+    if (size > buf_.size() - pos_) {
+      MS_LOG(EXCEPTION) << "The index of checkpoint file " << file_name_ << " is truncated.";
+    }
+    auto data = buf_.data() + pos_;
+    pos_ += size;
+    return data;
+  }
+
+  const std::string &file_name_;
+  const std::string &buf_;
+  size_t pos_ = 0;
+};
+
+// Run func over [0, count) with worker threads, and return the first error reported by it.
+std::string ParallelRun(size_t count, const std::function<std::string(size_t)> &func) {
+  std::atomic<size_t> next{0};
+  std::mutex error_mutex;
+  std::string error;
+  auto worker = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      std::string ret;
+      try {
+        ret = func(i);
+      } catch (const std::exception &e) {
+        ret = e.what();
+      }
+      if (!ret.empty()) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (error.empty()) {
+          error = ret;
+        }
+      }
+    }
+  };
+  size_t thread_num = std::min({count, kMaxWorkerNum, static_cast<size_t>(std::thread::hardware_concurrency())});
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return error;
+}
+}  // namespace
+
+bool IsCheckpointFile(const std::string &file_name) {
+  std::ifstream ifs(file_name, std::ios::in | std::ios::binary);
+  char magic[kCheckpointMagicSize] = {0};
+  if (!ifs.read(magic, kCheckpointMagicSize)) {
+    return false;
+  }
+  return std::string(magic, kCheckpointMagicSize) == kCheckpointMagic;
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  if (write_thread_.joinable()) {
+    write_thread_.join();
+  }
+  if (!write_error_.empty()) {
+    MS_LOG(ERROR) << "Save checkpoint file " << file_name_ << " failed: " << write_error_;
+  }
+}
+
+void CheckpointWriter::Snapshot(const std::vector<std::pair<std::string, tensor::TensorPtr>> &tensors) {
+  Wait();
+  snapshot_.clear();
+  for (auto &[name, tensor] : tensors) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    tensor->data_sync();
+    auto copy = std::make_shared<tensor::Tensor>(tensor->data_type(), tensor->shape(), tensor->data_c(),
+                                                 tensor->data().nbytes());
+    snapshot_.emplace_back(name, copy);
+  }
+}
+
+void CheckpointWriter::Write() {
+  std::vector<CheckpointEntry> entries;
+  uint64_t index_size = 0;
+  for (auto &[name, tensor] : snapshot_) {
+    auto size = static_cast<uint64_t>(tensor->data().nbytes());
+    CheckpointEntry entry{name, tensor->data_type(), tensor->shape(), 0, size, 0};
+    index_size += EntrySize(entry);
+    entries.push_back(std::move(entry));
+  }
+  uint64_t offset = Align(kHeaderSize + index_size);
+  for (auto &entry : entries) {
+    entry.offset = offset;
+    offset = Align(offset + entry.size);
+  }
+
+  // Write into a temporary file, so a failed or interrupted save never leaves a broken checkpoint behind.
+  auto tmp_file = file_name_ + ".tmp";
+  {
+    std::ofstream ofs(tmp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+      MS_LOG(EXCEPTION) << "Create checkpoint file " << tmp_file << " failed.";
+    }
+  }
+  auto error = ParallelRun(entries.size(), [this, &entries, &tmp_file](size_t i) -> std::string {
+    auto &entry = entries[i];
+    const void *data = snapshot_[i].second->data_c();
+    entry.crc = DataCrc(data, entry.size);
+    if (entry.size == 0) {
+      return "";
+    }
+    std::fstream fs(tmp_file, std::ios::in | std::ios::out | std::ios::binary);
+    (void)fs.seekp(static_cast<std::streamoff>(entry.offset));
+    (void)fs.write(static_cast<const char *>(data), static_cast<std::streamsize>(entry.size));
+    fs.close();
+    return fs ? "" : "Write tensor " + entry.name + " failed.";
+  });
+  if (error.empty()) {
+    std::string header(kCheckpointMagic, kCheckpointMagicSize);
+    AppendValue<uint64_t>(&header, entries.size());
+    AppendValue<uint64_t>(&header, index_size);
+    for (auto &entry : entries) {
+      AppendEntry(&header, entry);
+    }
+    std::fstream fs(tmp_file, std::ios::in | std::ios::out | std::ios::binary);
+    (void)fs.write(header.data(), static_cast<std::streamsize>(header.size()));
+    fs.close();
+    if (!fs) {
+      error = "Write the index failed.";
+    }
+  }
+  snapshot_.clear();
+  if (!error.empty()) {
+    (void)std::remove(tmp_file.c_str());
+    MS_LOG(EXCEPTION) << "Save checkpoint file " << file_name_ << " failed: " << error;
+  }
+  (void)std::remove(file_name_.c_str());
+  if (std::rename(tmp_file.c_str(), file_name_.c_str()) != 0) {
+    MS_LOG(EXCEPTION) << "Rename " << tmp_file << " to checkpoint file " << file_name_ << " failed.";
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  (void)chmod(file_name_.c_str(), S_IRUSR);
+#endif
+  MS_LOG(INFO) << "Save " << entries.size() << " tensors into checkpoint file " << file_name_ << ".";
+}
+
+void CheckpointWriter::WriteAsync() {
+  Wait();
+  write_thread_ = std::thread([this]() {
+    try {
+      Write();
+    } catch (const std::exception &e) {
+      write_error_ = e.what();
+    }
+  });
+}
+
+void CheckpointWriter::Wait() {
+  if (write_thread_.joinable()) {
+    write_thread_.join();
+  }
+  if (!write_error_.empty()) {
+    auto error = write_error_;
+    write_error_.clear();
+    MS_LOG(EXCEPTION) << error;
+  }
+}
+
+CheckpointReader::CheckpointReader(const std::string &file_name) : file_name_(file_name) {
+  std::ifstream ifs(file_name_, std::ios::in | std::ios::binary);
+  if (!ifs) {
+    MS_LOG(EXCEPTION) << "Open checkpoint file " << file_name_ << " failed.";
+  }
+  std::string header(kHeaderSize, '\0');
+  if (!ifs.read(&header[0], static_cast<std::streamsize>(kHeaderSize)) ||
+      header.compare(0, kCheckpointMagicSize, kCheckpointMagic) != 0) {
+    MS_LOG(EXCEPTION) << "The file " << file_name_ << " is not a checkpoint in the native format.";
+  }
+  IndexCursor header_cursor(file_name_, header);
+  (void)header_cursor.ReadString(kCheckpointMagicSize);
+  auto count = header_cursor.Read<uint64_t>();
+  auto index_size = header_cursor.Read<uint64_t>();
+  std::string index(index_size, '\0');
+  if (!ifs.read(&index[0], static_cast<std::streamsize>(index_size))) {
+    MS_LOG(EXCEPTION) << "The index of checkpoint file " << file_name_ << " is truncated.";
+  }
+  IndexCursor cursor(file_name_, index);
+  for (uint64_t i = 0; i < count; ++i) {
+    CheckpointEntry entry;
+    entry.name = cursor.ReadString(cursor.Read<uint32_t>());
+    entry.data_type = static_cast<TypeId>(cursor.Read<int32_t>());
+    auto rank = cursor.Read<uint32_t>();
+    for (uint32_t j = 0; j < rank; ++j) {
+      entry.shape.push_back(cursor.Read<int64_t>());
+    }
+    entry.offset = cursor.Read<uint64_t>();
+    entry.size = cursor.Read<uint64_t>();
+    entry.crc = cursor.Read<uint32_t>();
+    entry_index_[entry.name] = entries_.size();
+    entries_.push_back(std::move(entry));
+  }
+}
+
+std::vector<std::string> CheckpointReader::Names() const {
+  std::vector<std::string> names;
+  (void)std::transform(entries_.begin(), entries_.end(), std::back_inserter(names),
+                       [](const CheckpointEntry &entry) { return entry.name; });
+  return names;
+}
+
+tensor::TensorPtr CheckpointReader::Read(const std::string &name) const {
+  auto iter = entry_index_.find(name);
+  if (iter == entry_index_.end()) {
+    MS_LOG(EXCEPTION) << "There is no tensor " << name << " in checkpoint file " << file_name_ << ".";
+  }
+  const auto &entry = entries_[iter->second];
+  auto tensor = std::make_shared<tensor::Tensor>(entry.data_type, entry.shape);
+  if (static_cast<uint64_t>(tensor->data().nbytes()) != entry.size) {
+    MS_LOG(EXCEPTION) << "The size of tensor " << name << " in checkpoint file " << file_name_ << " is " << entry.size
+                      << ", but its shape and type need " << tensor->data().nbytes() << ".";
+  }
+  void *data = tensor->data_c();
+  if (entry.size > 0) {
+    std::ifstream ifs(file_name_, std::ios::in | std::ios::binary);
+    (void)ifs.seekg(static_cast<std::streamoff>(entry.offset));
+    if (!ifs.read(static_cast<char *>(data), static_cast<std::streamsize>(entry.size))) {
+      MS_LOG(EXCEPTION) << "Read tensor " << name << " from checkpoint file " << file_name_ << " failed.";
+    }
+  }
+  if (DataCrc(data, entry.size) != entry.crc) {
+    MS_LOG(EXCEPTION) << "The data of tensor " << name << " in checkpoint file " << file_name_
+                      << " does not match its checksum.";
+  }
+  return tensor;
+}
+
+std::vector<tensor::TensorPtr> CheckpointReader::ReadAll(const std::vector<std::string> &names) const {
+  std::vector<tensor::TensorPtr> tensors(names.size());
+  auto error = ParallelRun(names.size(), [this, &names, &tensors](size_t i) -> std::string {
+    tensors[i] = Read(names[i]);
+    return "";
+  });
+  if (!error.empty()) {
+    MS_LOG(EXCEPTION) << error;
+  }
+  return tensors;
+}
+}  // namespace checkpoint
+}  // namespace mindspore
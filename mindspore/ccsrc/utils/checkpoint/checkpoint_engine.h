@@ -0,0 +1,97 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_ENGINE_H_
+#define MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_ENGINE_H_
+
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace checkpoint {
+// Native checkpoint format, the integers are in host byte order:
+//  1 header : magic "MSCKPTv1", uint64 count of tensors, uint64 size of the index
+//  2 index  : for each tensor, uint32 name length, name, int32 type id, uint32 rank, int64 dims[rank],
+//             uint64 data offset, uint64 data size, uint32 mask crc value of the data
+//  3 data   : the data of each tensor, starting at a multiple of kCheckpointAlignment so it can be mapped in place
+constexpr char kCheckpointMagic[] = "MSCKPTv1";
+constexpr size_t kCheckpointMagicSize = sizeof(kCheckpointMagic) - 1;
+constexpr size_t kCheckpointAlignment = 64;
+
+struct CheckpointEntry {
+  std::string name;
+  TypeId data_type;
+  ShapeVector shape;
+  uint64_t offset;
+  uint64_t size;
+  uint32_t crc;
+};
+
+// Whether the file is in the native checkpoint format.
+bool IsCheckpointFile(const std::string &file_name);
+
+class CheckpointWriter {
+ public:
+  explicit CheckpointWriter(const std::string &file_name) : file_name_(file_name) {}
+  ~CheckpointWriter();
+
+  // Copy the host data of the tensors, so they may be updated by training as soon as this returns.
+  void Snapshot(const std::vector<std::pair<std::string, tensor::TensorPtr>> &tensors);
+
+  // Write the snapshot, with the tensors spread over worker threads. The file is replaced only once complete.
+  void Write();
+
+  // Write the snapshot in the background.
+  void WriteAsync();
+
+  // Wait for the background write, raising its error if it failed.
+  void Wait();
+
+ private:
+  std::string file_name_;
+  std::vector<std::pair<std::string, tensor::TensorPtr>> snapshot_;
+  std::thread write_thread_;
+  std::string write_error_;
+};
+
+class CheckpointReader {
+ public:
+  // Only the index is read here, the data of a tensor is read when it is requested.
+  explicit CheckpointReader(const std::string &file_name);
+  ~CheckpointReader() = default;
+
+  std::vector<std::string> Names() const;
+
+  // Build the tensor from the file, verifying the checksum of its data.
+  tensor::TensorPtr Read(const std::string &name) const;
+
+  // Build the tensors with worker threads.
+  std::vector<tensor::TensorPtr> ReadAll(const std::vector<std::string> &names) const;
+
+ private:
+  std::string file_name_;
+  std::vector<CheckpointEntry> entries_;
+  std::unordered_map<std::string, size_t> entry_index_;
+};
+}  // namespace checkpoint
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_ENGINE_H_
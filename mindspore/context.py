@@ -645,11 +645,12 @@ def set_context(**kwargs):
             - ga_tune: Genetic Algorithm tune.
         grad_for_scalar (bool): Whether to get gradient for scalar. If set, the gradient of scalar input parameter
             can be calculated. Now, only part of the scalar operators support this calculation. Default: False.
-        save_compile_cache (bool): Experimental. Whether to cache the graph compiled by frontend. Default: False.
+        save_compile_cache (bool): Experimental. Whether to cache the graph compiled by frontend. The cache files
+            are saved in the directory 'compile_cache' of the current working directory. Default: False.
         load_compile_cache (bool): Experimental. Whether to use the cache of the graph compiled by frontend.
-            When it is true, the graph compilation will skip the frontend compilation process. It means that
-            you should make sure the network has not been changed since the last execution. Currently we have
-            not support automatic checking the changes yet. Default: False.
+            When it is true and a cache is found, the graph compilation will skip the frontend compilation process.
+            The cache is keyed on the python sources and structure of the network, the input signature and the
+            build options, so a changed network or context compiles from scratch. Default: False.
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -770,6 +771,14 @@ def set_ps_context(**kwargs):
         enable_ps (bool): Whether to enable parameter server training mode.
                           Only after enable_ps is set True, the environment variables will be effective.
                           Default: False.
+        cache_policy (str): The replacement policy of the embedding cache in parameter server training mode,
+                            one of "step", "clock", "lfu" and "tinylfu". Default: "step".
+        tcp_transport (str): The transport of the tcp communication between workers and servers, "libevent" or
+                             "epoll". The epoll transport runs an event loop per core and isn't used with SSL.
+                             Default: "libevent".
+        load_rebalance_interval (int): The number of pushes per dense parameter after which the hot parameters are
+                                       moved off the most loaded servers. The parameters are not rebalanced if it's
+                                       0. Default: 0.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
@@ -836,6 +845,9 @@ def set_fl_context(**kwargs):
         client_epoch_num (int): Client training epoch number. Default: 25.
         client_batch_size (int): Client training data batch size. Default: 32.
         client_learning_rate (float): Client training learning rate. Default: 0.001.
+        model_store_memory_budget (int): The memory in bytes for the models of the previous iterations the server
+                                         stores. The models share their unchanged pages, and at most 3 models are
+                                         stored if it's 0. Default: 0.
 
     Raises:
         ValueError: If input key is not the attribute in federated learning mode context.
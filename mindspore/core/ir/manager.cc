@@ -206,7 +206,9 @@ void FuncGraphManager::AddFuncGraph(FuncGraphPtr func_graph, bool is_root) {
   new_nodes.emplace_back(func_graph->get_return());
 
   // Acquire all nodes from func_graph.
+  BatchInvalidationGuard batch_guard(this);
   AcquireNodes(new_nodes);
+  batch_guard.Flush();
 }
 
 // Clear the all information in manager
@@ -293,6 +295,7 @@ void FuncGraphManager::AddIntoManaged(const FuncGraphPtr &fg) {
 }
 
 void FuncGraphManager::MaybeDropFuncGraphs(const FuncGraphSet &func_graphs, bool ignore_users) {
+  BatchInvalidationGuard batch_guard(this);
   FuncGraphSet todo(func_graphs);
   std::set<FuncGraphPtr> dropped;
   while (!todo.empty()) {
@@ -325,6 +328,11 @@ void FuncGraphManager::MaybeDropFuncGraphs(const FuncGraphSet &func_graphs, bool
     }
     MS_LOG(DEBUG) << "Func graph dropped " << fg->ToString();
   }
+  batch_guard.Flush();
+  // The func graphs dropped in spite of their users may still be in the analyses of the users.
+  if (ignore_users && !dropped.empty()) {
+    signals_->InvalidateComputer();
+  }
 }
 
 void FuncGraphManager::ProcessEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) {
@@ -509,15 +517,16 @@ void FuncGraphManager::AddEdge(AnfNodePtr node, int index, AnfNodePtr input) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->AddFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->AddFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        OnFuncGraphsUsedChanged(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ)) {
       fg->AddJValueNode(input);
+      OnFuncGraphsUsedChanged(fg);
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->AddFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      OnFreeVariablesChanged(fg);
     }
   }
 }
@@ -530,15 +539,16 @@ void FuncGraphManager::DropEdge(AnfNodePtr node, int index, AnfNodePtr input) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->DropFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->DropFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        OnFuncGraphsUsedChanged(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ)) {
       fg->DropJValueNode(input);
+      OnFuncGraphsUsedChanged(fg);
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->DropFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      OnFreeVariablesChanged(fg);
     }
   }
 }
@@ -554,6 +564,134 @@ void FuncGraphManager::MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target) {
   signals_->InvalidateComputer();
 }
 
+FuncGraphManager::BatchInvalidationGuard::BatchInvalidationGuard(FuncGraphManager *manager)
+    : manager_(manager), outermost_(!manager->is_batching_invalidation_) {
+  manager_->is_batching_invalidation_ = true;
+}
+
+FuncGraphManager::BatchInvalidationGuard::~BatchInvalidationGuard() {
+  if (!outermost_ || !manager_->is_batching_invalidation_) {
+    return;
+  }
+  // The batch is not flushed as it failed, so the changed func graphs may be incomplete and all analyses are dropped.
+  manager_->is_batching_invalidation_ = false;
+  manager_->used_changed_graphs_.clear();
+  manager_->fv_changed_graphs_.clear();
+  manager_->signals_->InvalidateComputer();
+}
+
+void FuncGraphManager::BatchInvalidationGuard::Flush() {
+  if (outermost_) {
+    manager_->FlushInvalidation();
+  }
+}
+
+void FuncGraphManager::OnFuncGraphsUsedChanged(const FuncGraphPtr &fg) {
+  if (is_batching_invalidation_) {
+    used_changed_graphs_.add(fg);
+    return;
+  }
+  FuncGraphSet used_changed;
+  used_changed.add(fg);
+  InvalidateComputers(used_changed, FuncGraphSet());
+}
+
+void FuncGraphManager::OnFreeVariablesChanged(const FuncGraphPtr &fg) {
+  if (is_batching_invalidation_) {
+    fv_changed_graphs_.add(fg);
+    return;
+  }
+  FuncGraphSet fv_changed;
+  fv_changed.add(fg);
+  InvalidateComputers(FuncGraphSet(), fv_changed);
+}
+
+void FuncGraphManager::FlushInvalidation() {
+  is_batching_invalidation_ = false;
+  FuncGraphSet used_changed = std::move(used_changed_graphs_);
+  FuncGraphSet fv_changed = std::move(fv_changed_graphs_);
+  used_changed_graphs_.clear();
+  fv_changed_graphs_.clear();
+  InvalidateComputers(used_changed, fv_changed);
+}
+
+FuncGraphSet FuncGraphManager::UsersTotal(const FuncGraphSet &fgs) const {
+  FuncGraphSet users(fgs);
+  std::vector<FuncGraphPtr> todo(fgs.begin(), fgs.end());
+  while (!todo.empty()) {
+    auto fg = todo.back();
+    todo.pop_back();
+    for (auto &item : fg->func_graph_cnodes_index()) {
+      MS_EXCEPTION_IF_NULL(item.first);
+      auto user_node = item.first->first;
+      auto user = user_node == nullptr ? nullptr : user_node->func_graph();
+      if (user == nullptr || users.contains(user) || !func_graphs_.contains(user)) {
+        continue;
+      }
+      users.add(user);
+      todo.push_back(user);
+    }
+  }
+  return users;
+}
+
+// Only the analyses of the func graphs which may see the changes are updated or invalidated, the others are kept:
+// - The func graphs used total, the recursion and the J total of a func graph depend on the func graphs it uses
+//   directly or indirectly, so they are invalidated for the users of the func graphs whose used func graphs changed.
+// - The parents total of a func graph also depends on the free variables of the func graphs it uses, so it's recomputed
+//   for the users of the func graphs whose used func graphs or free variables changed, if it has been computed.
+// - The nearest parent of a func graph depends on its parents total and the parents total of its parents, so it's
+//   invalidated only if one of them really changed.
+// - The children and the scope of a func graph depend on the func graphs it uses and their nearest parents.
+// The free variables total is computed for all func graphs at once, so it's reset as before.
+void FuncGraphManager::InvalidateComputers(const FuncGraphSet &used_changed, const FuncGraphSet &fv_changed) {
+  if (used_changed.empty() && fv_changed.empty()) {
+    return;
+  }
+  FuncGraphSet changed(used_changed);
+  changed.update(fv_changed);
+  // The analyses of the func graphs dropped from the manager are dropped too.
+  FuncGraphSet dropped;
+  for (auto &fg : changed) {
+    if (!func_graphs_.contains(fg)) {
+      dropped.add(fg);
+    }
+  }
+
+  FuncGraphSet used_affected;
+  if (!used_changed.empty()) {
+    used_affected = UsersTotal(used_changed);
+    func_graphs_used_total_->Invalidate(used_affected);
+    recursive_->Invalidate(used_affected);
+    j_total_->Invalidate(used_affected);
+  }
+
+  FuncGraphSet parents_changed(dropped);
+  for (auto &fg : UsersTotal(changed)) {
+    if (!dropped.contains(fg) && func_graph_parents_total_->Update(fg)) {
+      parents_changed.add(fg);
+    }
+  }
+  func_graph_parents_total_->Invalidate(dropped);
+  FuncGraphSet parent_affected(parents_changed);
+  if (!parents_changed.empty()) {
+    for (auto &item : func_graph_parents_total_->func_graph_parents_total_analysis()) {
+      auto &parents = item.second;
+      if (std::any_of(parents.begin(), parents.end(),
+                      [&parents_changed](const FuncGraphPtr &p) { return parents_changed.contains(p); })) {
+        parent_affected.add(item.first);
+      }
+    }
+  }
+  func_graph_parent_->Invalidate(parent_affected);
+
+  auto children_affected = UsersTotal(parent_affected);
+  children_affected.update(used_affected);
+  children_->Invalidate(children_affected);
+  scopes_->Invalidate(children_affected);
+  free_variables_total_->Reset();
+}
+
 FuncGraphTransaction FuncGraphManager::Transact() {
   auto tr = FuncGraphTransaction(this);
   return tr;
@@ -612,6 +750,8 @@ void FuncGraphManager::CommitChanges(const std::vector<Change> &changes) {
   Counter<AnfNodePtr> adds;
   Counter<AnfNodePtr> rms;
   ParseChanges(changes, &add_edges, &rm_edges, &adds, &rms);
+  // Nothing reads the analyses while the edges are processed, so invalidate them once for the whole transaction.
+  BatchInvalidationGuard batch_guard(this);
 
   auto sub_edges = add_edges - rm_edges;
   for (auto &iter : sub_edges) {
@@ -644,14 +784,18 @@ void FuncGraphManager::CommitChanges(const std::vector<Change> &changes) {
 
   auto drop_func_graphs = MaybeDropNodes(nodes_reverse);
   MaybeDropFuncGraphs(*drop_func_graphs);
+  batch_guard.Flush();
 }
 
 void FuncGraphManager::EraseOneGraph(FuncGraph *fg) {
   MS_EXCEPTION_IF_NULL(fg);
-  size_t erase_cnt = func_graphs_.erase(fg->shared_from_base<FuncGraph>());
+  auto func_graph = fg->shared_from_base<FuncGraph>();
+  size_t erase_cnt = func_graphs_.erase(func_graph);
   if (!erase_cnt) {
     return;
   }
+  // Drop the analyses of the graph, which hold it.
+  OnFuncGraphsUsedChanged(func_graph);
   fg->DecAttachedMngCnt();
   if (fg->attached_mng_cnt() == 0) {
     fg->ClearAllManagerInfo();
@@ -757,6 +901,25 @@ void FuncGraphParentsTotalComputer::RealRecompute(FuncGraphPtr fg) {
   func_graph_parents_total_analysis_[fg].update(SeekParents(fg, NewFgSeenGeneration()));
 }
 
+bool FuncGraphParentsTotalComputer::Update(const FuncGraphPtr &fg) {
+  MS_EXCEPTION_IF_NULL(fg);
+  auto iter = func_graph_parents_total_analysis_.find(fg);
+  if (iter == func_graph_parents_total_analysis_.end() || !IsValidate(fg)) {
+    return false;
+  }
+  auto parents = SeekParents(fg, NewFgSeenGeneration());
+  auto &old_parents = iter->second;
+  if (parents->size() == old_parents.size() &&
+      std::all_of(parents->begin(), parents->end(), [&old_parents](const FuncGraphPtr &p) {
+        return old_parents.contains(p);
+      })) {
+    return false;
+  }
+  // The copy assignment of OrderedSet merges into it, so the new parents are moved in.
+  old_parents = std::move(*parents);
+  return true;
+}
+
 bool set_len_compare(const FuncGraphSetPair &lhs, const FuncGraphSetPair &rhs) {
   auto l1 = lhs.second.size();
   auto l2 = rhs.second.size();
@@ -113,6 +113,14 @@ class DepComputer {
 
   void OnInvalidateComputer() { Reset(); }
 
+  // Invalidate the analyses of the given func graphs only, the analyses of the others are kept.
+  void Invalidate(const FuncGraphSet &fgs) {
+    for (auto &fg : fgs) {
+      ExtraInvalidate(fg);
+      (void)func_graphs_validate_.erase(fg);
+    }
+  }
+
   void Recompute();
 
   void Recompute(const FuncGraphPtr &fg);
@@ -124,6 +132,8 @@ class DepComputer {
  protected:
   // subclass can reset their own member;
   virtual void ExtraReset() {}
+  // subclass can drop their own analysis of a func graph;
+  virtual void ExtraInvalidate(const FuncGraphPtr &) {}
   // subclass do the real compute
   virtual void RealRecompute() {}
   virtual void RealRecompute(FuncGraphPtr) {}
@@ -146,10 +156,14 @@ class FuncGraphParentsTotalComputer final : public DepComputer {
 
   size_t size() const override { return func_graph_parents_total_analysis_.size(); }
 
+  // Recompute the parents total of fg if it has been computed, return whether it changed.
+  bool Update(const FuncGraphPtr &fg);
+
   FuncGraphToFuncGraphSetMap func_graph_parents_total_analysis_;
 
  protected:
   void ExtraReset() override { func_graph_parents_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)func_graph_parents_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 
@@ -173,6 +187,7 @@ class ParentComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { parent_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)parent_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -191,6 +206,7 @@ class ChildrenComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { children_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)children_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -209,6 +225,7 @@ class ScopeComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { scope_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)scope_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -245,6 +262,7 @@ class FuncGraphsUsedTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_used_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)func_graph_used_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -272,6 +290,11 @@ class RecursiveComputer final : public DepComputer {
     recursive_analysis_.clear();
     recursive_map_.clear();
   }
+  // The traces of recursive graphs are shared by the graphs in them, so they are all dropped.
+  void ExtraInvalidate(const FuncGraphPtr &fg) override {
+    (void)recursive_analysis_.erase(fg);
+    recursive_map_.clear();
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -289,6 +312,7 @@ class FuncGraphJTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { j_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)j_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
   bool SeekJ(const FuncGraphPtr &fg, size_t seen_num);
@@ -372,6 +396,14 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
   void AddEdge(AnfNodePtr node, int index, AnfNodePtr input);
   void DropEdge(AnfNodePtr node, int index, AnfNodePtr input);
   void MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target);
+  // Record that the func graphs used or the free variables of fg changed, and invalidate the analyses depending on
+  // them unless the invalidation is batched.
+  void OnFuncGraphsUsedChanged(const FuncGraphPtr &fg);
+  void OnFreeVariablesChanged(const FuncGraphPtr &fg);
+  void FlushInvalidation();
+  void InvalidateComputers(const FuncGraphSet &used_changed, const FuncGraphSet &fv_changed);
+  // The func graphs and the managed func graphs using them directly or indirectly.
+  FuncGraphSet UsersTotal(const FuncGraphSet &fgs) const;
 
   FuncGraphSet roots_;        // Managed roots.
   FuncGraphSet func_graphs_;  // Managed func graphs.
@@ -389,6 +421,25 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
 
   bool is_manage_;
   std::function<IncludeType(AnfNodePtr)> limit_;
+
+  // While a transaction is being committed or func graphs are added or dropped, the changed func graphs are collected
+  // and the analyses depending on them are invalidated once at the end.
+  class BatchInvalidationGuard {
+   public:
+    explicit BatchInvalidationGuard(FuncGraphManager *manager);
+    ~BatchInvalidationGuard();
+    // Invalidate the analyses of the collected func graphs and stop batching.
+    void Flush();
+
+   private:
+    FuncGraphManager *manager_;
+    // Only the outermost guard flushes.
+    bool outermost_;
+  };
+
+  bool is_batching_invalidation_{false};
+  FuncGraphSet used_changed_graphs_;
+  FuncGraphSet fv_changed_graphs_;
 };
 
 class FuncGraphTransaction {
@@ -83,14 +83,14 @@ class WaitEvent : public ExceptionListener {
  public:
   void OnException() override { set_need_wait(false); }
 
+  // The exception of the worker is raised even if it has finished before the wait, as the data is not written then.
   void Wait() const {
     std::unique_lock<std::mutex> lock(mutex_);
-    if (!need_wait_) {
-      return;
+    if (need_wait_) {
+      MsException::Instance().SetExceptionListener(const_cast<WaitEvent *>(this));
+      cond_var_.wait(lock, [this] { return !need_wait_; });
+      MsException::Instance().SetExceptionListener(nullptr);
     }
-    MsException::Instance().SetExceptionListener(const_cast<WaitEvent *>(this));
-    cond_var_.wait(lock, [this] { return !need_wait_; });
-    MsException::Instance().SetExceptionListener(nullptr);
     MsException::Instance().CheckException();
   }
 
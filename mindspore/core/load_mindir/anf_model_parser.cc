@@ -15,12 +15,15 @@
  */
 
 #include "load_mindir/anf_model_parser.h"
+#include <algorithm>
+#include <atomic>
 #include <climits>
 #include <functional>
 #include <map>
 #include <memory>
 #include <stack>
 #include <string>
+#include <thread>
 #include <vector>
 #include <unordered_map>
 #include <utility>
@@ -38,6 +41,60 @@ namespace mindspore {
 static constexpr char kConstantValueNode[] = "Constant";
 static constexpr char kCNodeShapeAttr[] = "shape";
 static constexpr char kCNodeShape1Attr[] = "shape1";
+// Parameters at least this large are copied by the worker threads, the smaller ones by the caller.
+static constexpr size_t kParallelCopyMinBytes = 1 << 20;
+
+namespace {
+bool CopyParameterData(const tensor::TensorPtr &tensor, const std::string &raw_data) {
+  auto *tensor_data_buf = reinterpret_cast<uint8_t *>(tensor->data_c());
+  if (tensor_data_buf == nullptr) {
+    MS_LOG(ERROR) << "Build parameter failed to allocate " << tensor->data().nbytes() << " bytes.";
+    return false;
+  }
+  auto ret = memcpy_s(tensor_data_buf, tensor->data().nbytes(), raw_data.data(), raw_data.size());
+  if (ret != 0) {
+    MS_LOG(ERROR) << "Build parameter occur memcpy_s error.";
+    return false;
+  }
+  return true;
+}
+
+// Copy the raw data of the parameters into their tensors, spreading the large parameters over worker threads.
+bool CopyParametersData(const std::vector<std::pair<tensor::TensorPtr, const std::string *>> &copies) {
+  bool success = true;
+  std::vector<const std::pair<tensor::TensorPtr, const std::string *> *> large_copies;
+  for (auto &copy : copies) {
+    if (copy.second->size() >= kParallelCopyMinBytes) {
+      large_copies.push_back(&copy);
+    } else {
+      success = CopyParameterData(copy.first, *copy.second) && success;
+    }
+  }
+  if (large_copies.empty()) {
+    return success;
+  }
+  size_t thread_num =
+    std::min(large_copies.size(), std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(1)));
+  std::atomic<size_t> next_copy{0};
+  std::atomic<bool> failed{false};
+  auto worker = [&large_copies, &next_copy, &failed]() {
+    for (size_t i = next_copy++; i < large_copies.size(); i = next_copy++) {
+      if (!CopyParameterData(large_copies[i]->first, *large_copies[i]->second)) {
+        failed = true;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return success && !failed;
+}
+}  // namespace
 static constexpr char kCNodeShape2Attr[] = "shape2";
 enum ParseForm : int {
   FORM_PARSE_TYPE = 0,
@@ -254,7 +311,18 @@ bool MSANFModelParser::BuildParameterForFuncGraph(const ParameterPtr &node,
   node->set_debug_info(debug_info_ptr);
   node->set_name(debug_info_name);
 
-  tensor::TensorPtr tensor_info = BuildTensorInfoForFuncGraph(parameter_proto);
+  tensor::TensorPtr tensor_info;
+  auto iter = preloaded_param_tensors_.find(parameter_proto.name());
+  if (iter != preloaded_param_tensors_.end()) {
+    tensor_info = iter->second;
+    preloaded_param_tensors_.erase(iter);
+  } else {
+    tensor_info = BuildTensorInfoForFuncGraph(parameter_proto);
+    // The data is copied after all the parameters of the graph are built.
+    if (!parameter_proto.raw_data().empty()) {
+      param_data_copies_.emplace_back(tensor_info, &parameter_proto.raw_data());
+    }
+  }
   MS_EXCEPTION_IF_NULL(tensor_info);
   ParamInfoPtr param_info = std::make_shared<ParamInfo>();
   param_info->set_name(debug_info_name);
@@ -264,15 +332,6 @@ bool MSANFModelParser::BuildParameterForFuncGraph(const ParameterPtr &node,
   MS_EXCEPTION_IF_NULL(tensor_abstract);
   node->set_abstract(tensor_abstract);
 
-  std::string initial_data = parameter_proto.raw_data();
-  auto *tensor_data_buf = reinterpret_cast<uint8_t *>(tensor_info->data_c());
-  MS_EXCEPTION_IF_NULL(tensor_data_buf);
-  auto ret = memcpy_s(tensor_data_buf, tensor_info->data().nbytes(), initial_data.data(), initial_data.size());
-  if (ret != 0) {
-    MS_LOG(ERROR) << "Build parameter occur memcpy_s error.";
-    return false;
-  }
-
   node->set_default_param(tensor_info);
 
   anfnode_build_map_[parameter_proto.name()] = node;
@@ -315,6 +374,7 @@ bool MSANFModelParser::ImportParametersForGraph(const FuncGraphPtr &outputFuncGr
   }
 
   MS_LOG(INFO) << "All Parameters size is: " << importProto.parameter_size();
+  param_data_copies_.clear();
   for (int i = 0; i < importProto.parameter_size(); ++i) {
     const mind_ir::TensorProto &parameter_proto = importProto.parameter(i);
     if (!BuildParameterForFuncGraph(outputFuncGraph->add_parameter(), parameter_proto)) {
@@ -322,7 +382,25 @@ bool MSANFModelParser::ImportParametersForGraph(const FuncGraphPtr &outputFuncGr
       return false;
     }
   }
-  return true;
+  bool success = CopyParametersData(param_data_copies_);
+  param_data_copies_.clear();
+  return success;
+}
+
+bool MSANFModelParser::LoadParameterTensors(const mind_ir::GraphProto &param_graph) {
+  std::vector<std::pair<tensor::TensorPtr, const std::string *>> copies;
+  for (int i = 0; i < param_graph.parameter_size(); ++i) {
+    const mind_ir::TensorProto &parameter_proto = param_graph.parameter(i);
+    if (!parameter_proto.has_name()) {
+      MS_LOG(ERROR) << "mind_ir TensorProto has no name!";
+      return false;
+    }
+    tensor::TensorPtr tensor_info = BuildTensorInfoForFuncGraph(parameter_proto);
+    MS_EXCEPTION_IF_NULL(tensor_info);
+    copies.emplace_back(tensor_info, &parameter_proto.raw_data());
+    preloaded_param_tensors_[parameter_proto.name()] = tensor_info;
+  }
+  return CopyParametersData(copies);
 }
 
 bool MSANFModelParser::ObtainCNodeAttrInTypeForm(const PrimitivePtr &prim, const mind_ir::AttributeProto &attr_proto) {
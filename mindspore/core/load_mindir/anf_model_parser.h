@@ -20,8 +20,11 @@
 #include <string>
 #include <map>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include "google/protobuf/io/zero_copy_stream_impl.h"
 #include "ir/func_graph.h"
+#include "ir/tensor.h"
 #include "proto/mind_ir.pb.h"
 
 namespace mindspore {
@@ -41,6 +44,9 @@ class MSANFModelParser {
   std::string GetIrVersion() { return ir_version_; }
   void SetLite() { is_lite_ = true; }
   bool IsLite() { return is_lite_; }
+  // Build the tensors of the parameters in a graph proto holding only parameters, ahead of Parse. The parameters of
+  // the model with the same names then take these tensors instead of copying their own raw data.
+  bool LoadParameterTensors(const mind_ir::GraphProto &param_graph);
 
  private:
   bool BuildFuncGraph(const FuncGraphPtr &outputFuncGraph, const mind_ir::GraphProto &importProto);
@@ -74,6 +80,8 @@ class MSANFModelParser {
   std::string ir_version_;
   bool is_lite_ = false;
   std::unordered_map<std::string, AnfNodePtr> anfnode_build_map_;
+  std::unordered_map<std::string, tensor::TensorPtr> preloaded_param_tensors_;
+  std::vector<std::pair<tensor::TensorPtr, const std::string *>> param_data_copies_;
 };
 }  // namespace mindspore
 
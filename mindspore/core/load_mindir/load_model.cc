@@ -15,8 +15,13 @@
  */
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 #include <cstring>
 #include <memory>
 #include <algorithm>
@@ -121,6 +126,43 @@ bool get_all_files(const std::string &dir_in, std::vector<std::string> *files) {
 
 int endsWith(string s, string sub) { return s.rfind(sub) == (s.length() - sub.length()) ? 1 : 0; }
 
+// Parse a proto file through a read-only mapping, so the file is read by the page cache in place instead of being
+// copied through a stream buffer, and the mapping is dropped as soon as the proto is built.
+bool ParseProtoFromFile(const std::string &file_name, google::protobuf::MessageLite *proto) {
+#if defined(_WIN32) || defined(_WIN64)
+  std::fstream input(file_name, std::ios::in | std::ios::binary);
+  return input && proto->ParseFromIstream(&input);
+#else
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Failed to open file: " << file_name;
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size > INT_MAX) {
+    MS_LOG(ERROR) << "Failed to get the size of file: " << file_name << ", or it exceeds the limit of protobuf.";
+    close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  if (size == 0) {
+    close(fd);
+    return proto->ParseFromArray(nullptr, 0);
+  }
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(WARNING) << "Failed to map file: " << file_name << ", read it through a stream instead.";
+    std::fstream input(file_name, std::ios::in | std::ios::binary);
+    return input && proto->ParseFromIstream(&input);
+  }
+  (void)madvise(addr, size, MADV_SEQUENTIAL);
+  bool ret = proto->ParseFromArray(addr, static_cast<int>(size));
+  (void)munmap(addr, size);
+  return ret;
+#endif
+}
+
 std::shared_ptr<FuncGraph> LoadMindIR(const std::string &file_name, bool is_lite) {
   const char *file_path = reinterpret_cast<const char *>(file_name.c_str());
   char abs_path_buff[PATH_MAX];
@@ -136,18 +178,16 @@ std::shared_ptr<FuncGraph> LoadMindIR(const std::string &file_name, bool is_lite
   }
 #endif
   // Read graph
-  std::fstream input_graph(abs_path_buff, std::ios::in | std::ios::binary);
   mind_ir::ModelProto origin_model;
-
-  if (!input_graph) {
-    MS_LOG(ERROR) << "Failed to open file: " << file_name;
-    return nullptr;
-  }
-  if (!origin_model.ParseFromIstream(&input_graph)) {
+  if (!ParseProtoFromFile(abs_path_buff, &origin_model)) {
     MS_LOG(ERROR) << "Load MindIR file failed, please check the correctness of the file.";
     return nullptr;
   }
 
+  MSANFModelParser model_parser;
+  if (is_lite) {
+    model_parser.SetLite();
+  }
   // Load parameter into graph
   if (endsWith(abs_path_buff, "_graph.mindir") && origin_model.graph().parameter_size() == 0) {
     int path_len = strlen(abs_path_buff) - strlen("graph.mindir");
@@ -168,12 +208,13 @@ std::shared_ptr<FuncGraph> LoadMindIR(const std::string &file_name, bool is_lite
       return nullptr;
     }
 
+    // The variable files are loaded one by one into the parameter tensors, and only the description of the
+    // parameters is added to the graph, so at most one variable file is held besides the tensors.
     int file_size = files.size();
     mind_ir::GraphProto *mod_graph = origin_model.mutable_graph();
     for (auto file_index = 0; file_index < file_size; file_index++) {
-      std::fstream input_param(files[file_index], std::ios::in | std::ios::binary);
       mind_ir::GraphProto param_graph;
-      if (!input_param || !param_graph.ParseFromIstream(&input_param)) {
+      if (!ParseProtoFromFile(files[file_index], &param_graph)) {
         MS_LOG(ERROR) << "Load variable file failed, please check the correctness of mindir's variable file.";
         return nullptr;
       }
@@ -182,11 +223,14 @@ std::shared_ptr<FuncGraph> LoadMindIR(const std::string &file_name, bool is_lite
         MS_LOG(ERROR) << "param_graph.parameter_size() is : " << param_graph.parameter_size();
         return nullptr;
       }
+      if (!model_parser.LoadParameterTensors(param_graph)) {
+        MS_LOG(ERROR) << "Load the parameters of variable file " << files[file_index] << " failed.";
+        return nullptr;
+      }
       for (int param_index = 0; param_index < param_graph.parameter_size(); param_index++) {
         mind_ir::TensorProto *param_proto = mod_graph->add_parameter();
         param_proto->set_name(param_graph.parameter(param_index).name());
         param_proto->set_data_type(param_graph.parameter(param_index).data_type());
-        param_proto->set_raw_data(param_graph.parameter(param_index).raw_data());
         for (const auto &dim : param_graph.parameter(param_index).dims()) {
           param_proto->add_dims(dim);
         }
@@ -194,10 +238,6 @@ std::shared_ptr<FuncGraph> LoadMindIR(const std::string &file_name, bool is_lite
     }
   }
 
-  MSANFModelParser model_parser;
-  if (is_lite) {
-    model_parser.SetLite();
-  }
   FuncGraphPtr dstgraph_ptr = model_parser.Parse(origin_model);
   return dstgraph_ptr;
 }
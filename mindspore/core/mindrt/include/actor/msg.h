@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <atomic>
 #include <utility>
 #include <string>
 
@@ -79,6 +80,8 @@ class MessageBase {
   std::string name;
   std::string body;
   Type type;
+  // the intrusive link of the lock-free mailbox
+  std::atomic<MessageBase *> next{nullptr};
 };
 
 }  // namespace mindspore
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <thread>
+
 #include "actor/actor.h"
 #include "actor/actormgr.h"
 #include "actor/actorpolicy.h"
@@ -57,8 +59,8 @@ void SingleThread::Notify() {
   }
 }
 
-std::list<std::unique_ptr<MessageBase>> *SingleThread::GetMsgs() {
-  std::list<std::unique_ptr<MessageBase>> *result;
+MessageList *SingleThread::GetMsgs() {
+  MessageList *result;
   std::unique_lock<std::mutex> lock(mailboxLock);
   conditionVar.wait(lock, [this] { return (!this->enqueMailbox->empty()); });
   SwapMailbox();
@@ -70,8 +72,15 @@ std::list<std::unique_ptr<MessageBase>> *SingleThread::GetMsgs() {
 }
 
 ShardedThread::ShardedThread(const std::shared_ptr<ActorBase> &aActor)
-    : ready(false), terminated(false), actor(aActor) {}
-ShardedThread::~ShardedThread() {}
+    : ready(false), terminated(false), actor(aActor), pendingCount(0), drainedCount(0) {}
+ShardedThread::~ShardedThread() {
+  // release the messages which are not handled
+  MessageBase *msg = mailbox.Dequeue();
+  while (msg != nullptr) {
+    delete msg;
+    msg = mailbox.Dequeue();
+  }
+}
 
 void ShardedThread::Terminate(const ActorBase *aActor) {
   std::string actorName = aActor->GetAID().Name();
@@ -85,43 +94,69 @@ void ShardedThread::Terminate(const ActorBase *aActor) {
   mailboxLock.unlock();
 }
 
+bool ShardedThread::TakeReady() {
+  if (!start || terminated || pendingCount.load() == 0) {
+    return false;
+  }
+  bool expected = false;
+  return ready.compare_exchange_strong(expected, true);
+}
+
+void ShardedThread::SetActorReady() {
+  // the lock protects the actor from being reset by Terminate.
+  if (!terminated && actor != nullptr) {
+    ActorMgr::GetActorMgrRef()->SetActorReady(actor);
+  }
+}
+
 int ShardedThread::EnqueMessage(std::unique_ptr<MessageBase> &&msg) {
-  int result;
-  mailboxLock.lock();
-  enqueMailbox->push_back(std::move(msg));
+  mailbox.Enqueue(msg.release());
+  // the count must be increased after the message is linked, so that the consumer can always dequeue it.
+  int result = ++pendingCount;
   // true : The actor is running. else  the actor will  be  ready to run.
-  if (start && ready == false && terminated == false) {
-    ActorMgr::GetActorMgrRef()->SetActorReady(actor);
-    ready = true;
+  if (TakeReady()) {
+    std::lock_guard<std::mutex> lock(mailboxLock);
+    SetActorReady();
   }
-  result = ++msgCount;
-  mailboxLock.unlock();
   return result;
 }
 
 void ShardedThread::Notify() {
-  if (start && ready == false && terminated == false && msgCount > 0) {
-    ActorMgr::GetActorMgrRef()->SetActorReady(actor);
-    ready = true;
+  // called with the mailbox lock.
+  if (TakeReady()) {
+    SetActorReady();
   }
 }
 
-std::list<std::unique_ptr<MessageBase>> *ShardedThread::GetMsgs() {
-  std::list<std::unique_ptr<MessageBase>> *result;
-  mailboxLock.lock();
-
-  if (enqueMailbox->empty()) {
+MessageList *ShardedThread::GetMsgs() {
+  // the messages of the last batch have been handled.
+  int remain = (drainedCount > 0) ? (pendingCount -= drainedCount) : pendingCount.load();
+  drainedCount = 0;
+  if (remain == 0) {
     ready = false;
-    result = nullptr;
-  } else {
-    ready = true;
-    SwapMailbox();
-    result = dequeMailbox;
+    // the message may be enqueued after the count is checked and before the ready flag is reset, in which case
+    // the producer doesn't set the actor ready, so take the ready flag back and go on.
+    if (!TakeReady()) {
+      return nullptr;
+    }
+    remain = pendingCount.load();
   }
 
-  mailboxLock.unlock();
-
-  return result;
+  // drain the mailbox in batch, the enqueued messages can be dequeued except the one being linked by a producer.
+  dequeMailbox->clear();
+  while (dequeMailbox->size() < static_cast<size_t>(remain)) {
+    MessageBase *msg = mailbox.Dequeue();
+    if (msg == nullptr) {
+      if (!dequeMailbox->empty()) {
+        break;
+      }
+      std::this_thread::yield();
+      continue;
+    }
+    dequeMailbox->emplace_back(msg);
+  }
+  drainedCount = static_cast<int>(dequeMailbox->size());
+  return dequeMailbox;
 }
 
 };  // end of namespace mindspore
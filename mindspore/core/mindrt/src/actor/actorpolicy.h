@@ -16,15 +16,18 @@
 
 #ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICY_H
 #define MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICY_H
-#include <list>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "actor/actorpolicyinterface.h"
+#include "thread/mpscqueue.h"
 
 namespace mindspore {
 
+// The messages are enqueued into the lock-free mailbox, and the lock is only taken when the actor
+// is set ready to the thread pool, which happens when the mailbox changes from empty to non-empty.
 class ShardedThread : public ActorPolicy {
  public:
   explicit ShardedThread(const std::shared_ptr<ActorBase> &actor);
@@ -33,13 +36,23 @@ class ShardedThread : public ActorPolicy {
  protected:
   virtual void Terminate(const ActorBase *actor);
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg);
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs();
+  virtual MessageList *GetMsgs();
   virtual void Notify();
 
  private:
-  bool ready;
-  bool terminated;
+  // take the ready flag and set the actor ready to run, return false if the actor is running or ready already.
+  bool TakeReady();
+  void SetActorReady();
+
+  std::atomic_bool ready;
+  std::atomic_bool terminated;
   std::shared_ptr<ActorBase> actor;
+
+  MpscQueue<MessageBase> mailbox;
+  // the number of messages which are enqueued but not handled
+  std::atomic_int pendingCount;
+  // the number of messages in the last batch returned by GetMsgs
+  int drainedCount;
 };
 
 class SingleThread : public ActorPolicy {
@@ -50,7 +63,7 @@ class SingleThread : public ActorPolicy {
  protected:
   virtual void Terminate(const ActorBase *actor);
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg);
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs();
+  virtual MessageList *GetMsgs();
   virtual void Notify();
 
  private:
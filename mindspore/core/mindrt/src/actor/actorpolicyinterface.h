@@ -17,10 +17,13 @@
 #ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICYINTERFACE_H
 #define MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICYINTERFACE_H
 
-#include <list>
+#include <atomic>
 #include <memory>
+#include <vector>
 
 namespace mindspore {
+// the batch of messages handled by the actor in one run, the capacity is reused across the batches
+using MessageList = std::vector<std::unique_ptr<MessageBase>>;
 
 class ActorPolicy {
  public:
@@ -32,7 +35,7 @@ class ActorPolicy {
   }
   virtual ~ActorPolicy() {}
   inline void SwapMailbox() {
-    std::list<std::unique_ptr<MessageBase>> *temp;
+    MessageList *temp;
     temp = enqueMailbox;
     enqueMailbox = dequeMailbox;
     dequeMailbox = temp;
@@ -43,21 +46,21 @@ class ActorPolicy {
   void SetRunningStatus(bool startRun);
   virtual void Terminate(const ActorBase *actor) = 0;
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg) = 0;
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs() = 0;
+  virtual MessageList *GetMsgs() = 0;
   virtual void Notify() = 0;
 
-  std::list<std::unique_ptr<MessageBase>> *enqueMailbox;
-  std::list<std::unique_ptr<MessageBase>> *dequeMailbox;
+  MessageList *enqueMailbox;
+  MessageList *dequeMailbox;
 
   int msgCount;
-  bool start;
+  std::atomic_bool start;
   std::mutex mailboxLock;
 
  private:
   friend class ActorBase;
 
-  std::list<std::unique_ptr<MessageBase>> mailbox1;
-  std::list<std::unique_ptr<MessageBase>> mailbox2;
+  MessageList mailbox1;
+  MessageList mailbox2;
 };
 
 };  // end of namespace mindspore
@@ -15,9 +15,111 @@
  */
 
 #include "async/async.h"
+#include <mutex>
+#include <utility>
+#include <vector>
 #include "actor/actormgr.h"
 
 namespace mindspore {
+namespace {
+// the number of freed async messages moved between a thread and the shared pool at a time
+constexpr size_t kMessageBatchSize = 64;
+// the max number of batches kept in the shared pool
+constexpr size_t kMaxPooledBatchNum = 64;
+
+// The freed blocks of async messages are shared by all threads in batches, because a message is usually allocated by
+// the thread sending it and freed by the thread running the receiving actor. A thread caches up to two batches, and
+// takes a batch from the pool when its cache is empty or gives one back when it's full, so the lock of the pool is
+// taken once per batch.
+class MessagePool {
+ public:
+  static MessagePool &GetInstance() {
+    // never destructed, so the messages freed at the process exit can still reach it
+    static MessagePool *pool = new MessagePool();
+    return *pool;
+  }
+
+  // append a pooled batch to the blocks, return false if there is none
+  bool TakeBatch(std::vector<void *> *blocks) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (batches.empty()) {
+      return false;
+    }
+    blocks->insert(blocks->end(), batches.back().begin(), batches.back().end());
+    batches.pop_back();
+    return true;
+  }
+
+  // pool the batch of blocks, return false if the pool is full
+  bool GiveBatch(std::vector<void *> &&blocks) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (batches.size() >= kMaxPooledBatchNum) {
+      return false;
+    }
+    batches.emplace_back(std::move(blocks));
+    return true;
+  }
+
+ private:
+  MessagePool() = default;
+  std::mutex mutex;
+  std::vector<std::vector<void *>> batches;
+};
+
+// the message may be freed after the cache is destructed at the thread exit
+thread_local bool messageCacheDestroyed = false;
+
+struct MessageCache {
+  MessageCache() { blocks.reserve(kMessageBatchSize * 2); }
+  ~MessageCache() {
+    messageCacheDestroyed = true;
+    while (blocks.size() >= kMessageBatchSize) {
+      GiveBack();
+    }
+    for (auto block : blocks) {
+      ::operator delete(block);
+    }
+  }
+
+  void *Take() {
+    if (blocks.empty() && !MessagePool::GetInstance().TakeBatch(&blocks)) {
+      return nullptr;
+    }
+    void *block = blocks.back();
+    blocks.pop_back();
+    return block;
+  }
+
+  void Put(void *block) {
+    blocks.push_back(block);
+    if (blocks.size() >= kMessageBatchSize * 2) {
+      GiveBack();
+    }
+  }
+
+  // move a batch of the cached blocks to the pool, or free them if the pool is full
+  void GiveBack() {
+    std::vector<void *> batch(blocks.end() - kMessageBatchSize, blocks.end());
+    blocks.resize(blocks.size() - kMessageBatchSize);
+    if (MessagePool::GetInstance().GiveBatch(std::move(batch))) {
+      return;
+    }
+    for (auto block : batch) {
+      ::operator delete(block);
+    }
+  }
+
+  std::vector<void *> blocks;
+};
+
+MessageCache *GetMessageCache() {
+  if (messageCacheDestroyed) {
+    return nullptr;
+  }
+  thread_local MessageCache cache;
+  return &cache;
+}
+}  // namespace
 
 class MessageAsync : public MessageBase {
  public:
@@ -28,6 +130,31 @@ class MessageAsync : public MessageBase {
 
   void Run(ActorBase *actor) override { (*handler)(actor); }
 
+  static void *operator new(size_t size, const std::nothrow_t &tag) noexcept {
+    auto cache = GetMessageCache();
+    if (size == sizeof(MessageAsync) && cache != nullptr) {
+      void *block = cache->Take();
+      if (block != nullptr) {
+        return block;
+      }
+    }
+    return ::operator new(size, tag);
+  }
+
+  static void operator delete(void *block, size_t size) noexcept {
+    if (block == nullptr) {
+      return;
+    }
+    auto cache = GetMessageCache();
+    if (size == sizeof(MessageAsync) && cache != nullptr) {
+      cache->Put(block);
+      return;
+    }
+    ::operator delete(block);
+  }
+
+  static void operator delete(void *block, const std::nothrow_t &) noexcept { ::operator delete(block); }
+
  private:
   std::unique_ptr<MessageHandler> handler;
 };
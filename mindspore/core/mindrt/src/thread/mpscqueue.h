@@ -0,0 +1,94 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_MPSCQUEUE_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_MPSCQUEUE_H_
+#include <atomic>
+
+namespace mindspore {
+// implement an intrusive lock-free queue with multiple producers and single consumer,
+// the element must have the member 'std::atomic<T *> next' to link the queue.
+// HQueue in hqueue.h is not used for the mailbox: it's a bounded ring whose free head is moved by a plain store, so
+// only one thread may enqueue, and a full ring would make the senders block or drop messages. A mailbox has many
+// senders and no bound, and linking the messages themselves needs no allocation per message.
+template <class T>
+class MpscQueue {
+ public:
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+  MpscQueue() : head(&stub), tail(&stub) { stub.next.store(nullptr, std::memory_order_relaxed); }
+  virtual ~MpscQueue() {
+    head = nullptr;
+    tail = nullptr;
+  }
+
+  // can be called by multiple producers concurrently
+  void Enqueue(T *t) {
+    t->next.store(nullptr, std::memory_order_relaxed);
+    T *prev = head.exchange(t, std::memory_order_acq_rel);
+    // link the previous element, the consumer can't see the new element before this
+    prev->next.store(t, std::memory_order_release);
+  }
+
+  // can only be called by the single consumer, return nullptr when the queue is empty or a producer is linking.
+  T *Dequeue() {
+    T *curTail = tail;
+    T *next = curTail->next.load(std::memory_order_acquire);
+    // skip the stub element
+    if (curTail == &stub) {
+      if (next == nullptr) {
+        return nullptr;
+      }
+      tail = next;
+      curTail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+      tail = next;
+      return curTail;
+    }
+
+    // a producer is enqueueing and has not linked the new element yet
+    T *curHead = head.load(std::memory_order_acquire);
+    if (curTail != curHead) {
+      return nullptr;
+    }
+
+    // the tail is the last element, push the stub back to take the tail out
+    Enqueue(&stub);
+    next = curTail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail = next;
+      return curTail;
+    }
+    return nullptr;
+  }
+
+  // can only be called by the single consumer
+  bool Empty() const {
+    return (tail == &stub) && (stub.next.load(std::memory_order_acquire) == nullptr);
+  }
+
+ private:
+  std::atomic<T *> head;
+  T *tail;
+  T stub;
+};
+
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_MPSCQUEUE_H_
@@ -0,0 +1,157 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""
+Offline auto parallel planner.
+
+It searches the sharding strategies of a network for a described cluster on the CPU, without the cluster itself,
+ranks the candidate configurations by their estimated costs, and saves a strategy checkpoint for each of them, which
+a training job loads through 'strategy_ckpt_load_file' to skip the search.
+"""
+from argparse import ArgumentParser
+import importlib
+import json
+import os
+import sys
+
+from mindspore import context
+import mindspore.log as logger
+from mindspore.common.api import _executor
+from mindspore.parallel._cost_model_context import set_cost_model_context, reset_cost_model_context
+from mindspore._c_expression import get_strategy_search_cost
+
+_COST_MODEL_KEYS = ("device_memory_capacity", "costmodel_alpha", "costmodel_beta", "costmodel_gamma",
+                    "costmodel_communi_threshold", "costmodel_communi_const", "costmodel_communi_bias")
+_CANDIDATE_KEYS = ("pipeline_stages", "auto_parallel_search_mode", "full_batch", "enable_parallel_optimizer")
+
+
+def parse_args(argv=None):
+    """
+    Parse the arguments of the planner.
+
+    Args:
+        argv (list): The arguments to parse. Default: None, which means sys.argv.
+
+    Returns:
+        The parsed arguments.
+    """
+    parser = ArgumentParser(description="MindSpore offline auto parallel planner.")
+    parser.add_argument("--network", type=str, required=True,
+                        help="Network factory in the form 'module:function', which returns the network and a tuple "
+                             "of its inputs.")
+    parser.add_argument("--topology", type=str, required=True,
+                        help="Json file describing the cluster: 'device_num', the optional cost model parameters, "
+                             "and an optional list of 'candidates' overriding " + ", ".join(_CANDIDATE_KEYS) + ".")
+    parser.add_argument("--output_dir", type=str, default="./parallel_plan",
+                        help="Directory of the strategy checkpoints and the plan. Default: ./parallel_plan.")
+    parser.add_argument("--search_mode", type=str, default="dynamic_programming",
+                        choices=["dynamic_programming", "recursive_programming"],
+                        help="Default strategy search mode of the candidates. Default: dynamic_programming.")
+    return parser.parse_args(argv)
+
+
+def _load_network_factory(network):
+    """Import the network factory 'module:function'."""
+    module_name, sep, func_name = network.partition(":")
+    if not sep or not module_name or not func_name:
+        raise ValueError(f"The network should be in the form 'module:function', but got '{network}'.")
+    return getattr(importlib.import_module(module_name), func_name)
+
+
+def _search(factory, topology, candidate, strategy_file):
+    """Search the strategies of one candidate configuration, and return its estimated costs per stage."""
+    context.reset_auto_parallel_context()
+    reset_cost_model_context()
+    cost_model_config = {key: topology[key] for key in _COST_MODEL_KEYS if key in topology}
+    if cost_model_config:
+        set_cost_model_context(**cost_model_config)
+    context.set_auto_parallel_context(parallel_mode="auto_parallel", device_num=topology["device_num"], global_rank=0,
+                                      strategy_ckpt_save_file=strategy_file, **candidate)
+    net, inputs = factory()
+    net.set_auto_parallel()
+    net.set_train()
+    # An 'export' phase stops after the frontend passes, which include the strategy search, so the distributed graph
+    # is never built for a backend.
+    _executor.compile(net, *inputs, phase="export.parallel_plan", do_convert=False, auto_parallel_mode=True)
+    return {int(stage): cost for stage, cost in get_strategy_search_cost().items()}
+
+
+def _estimated_step_cost(stage_costs):
+    """The slowest stage bounds a step, so candidates are ranked by it first and by memory next."""
+    if not stage_costs:
+        return float("inf"), float("inf")
+    return (max(cost[0] + cost[1] for cost in stage_costs.values()),
+            max(cost[2] for cost in stage_costs.values()))
+
+
+def plan(factory, topology, output_dir, search_mode="dynamic_programming"):
+    """
+    Search the strategies of every candidate configuration of the topology.
+
+    Args:
+        factory (Function): Returns the network and a tuple of its inputs.
+        topology (dict): The cluster description.
+        output_dir (str): Directory of the strategy checkpoints.
+        search_mode (str): Default strategy search mode of the candidates.
+
+    Returns:
+        list, the candidates ranked from the cheapest, each with its configuration, costs per stage and
+        strategy checkpoint.
+    """
+    if "device_num" not in topology:
+        raise ValueError("The topology should set 'device_num'.")
+    candidates = topology.get("candidates", [{}])
+    os.makedirs(output_dir, exist_ok=True)
+    results = []
+    for index, candidate in enumerate(candidates):
+        unknown_keys = set(candidate) - set(_CANDIDATE_KEYS)
+        if unknown_keys:
+            raise ValueError(f"Unsupported keys {sorted(unknown_keys)} in candidate {index}.")
+        candidate = dict(candidate)
+        candidate.setdefault("auto_parallel_search_mode", search_mode)
+        strategy_file = os.path.realpath(os.path.join(output_dir, f"strategy_{index}.ckpt"))
+        try:
+            stage_costs = _search(factory, topology, candidate, strategy_file)
+        except RuntimeError as err:
+            logger.warning(f"Searching the strategies of candidate {index} {candidate} failed: {err}")
+            continue
+        results.append({"config": candidate, "stage_costs": stage_costs, "strategy_ckpt_file": strategy_file})
+    results.sort(key=lambda result: _estimated_step_cost(result["stage_costs"]))
+    return results
+
+
+def main(argv=None):
+    """Entry point of the planner."""
+    args = parse_args(argv)
+    with open(args.topology, "r") as f:
+        topology = json.load(f)
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    results = plan(_load_network_factory(args.network), topology, args.output_dir, args.search_mode)
+    if not results:
+        print("No candidate configuration could be searched.")
+        return 1
+    for rank, result in enumerate(results):
+        compute_comm, memory = _estimated_step_cost(result["stage_costs"])
+        print(f"#{rank} {result['config']}: slowest stage cost {compute_comm:.4g}, peak stage memory {memory:.4g}")
+        for stage, (computation, communication, mem) in sorted(result["stage_costs"].items()):
+            print(f"    stage {stage}: computation {computation:.4g}, communication {communication:.4g}, "
+                  f"memory {mem:.4g}")
+        print(f"    strategy checkpoint: {result['strategy_ckpt_file']}")
+    with open(os.path.join(args.output_dir, "plan.json"), "w") as f:
+        json.dump(results, f, indent=2)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
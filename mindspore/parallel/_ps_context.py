@@ -52,8 +52,12 @@ _set_ps_context_func_map = {
     "client_epoch_num": ps_context().set_client_epoch_num,
     "client_batch_size": ps_context().set_client_batch_size,
     "client_learning_rate": ps_context().set_client_learning_rate,
+    "model_store_memory_budget": ps_context().set_model_store_memory_budget,
     "enable_ps_ssl": ps_context().set_enable_ssl,
-    "scheduler_manage_port": ps_context().set_scheduler_manage_port
+    "scheduler_manage_port": ps_context().set_scheduler_manage_port,
+    "cache_policy": ps_context().set_cache_policy,
+    "tcp_transport": ps_context().set_tcp_transport,
+    "load_rebalance_interval": ps_context().set_load_rebalance_interval
 }
 
 _get_ps_context_func_map = {
@@ -92,6 +96,14 @@ def _set_ps_context(**kwargs):
         enable_ps (bool): Whether to enable parameter server training mode.
                           Only after enable_ps is set True, the environment variables will be effective.
                           Default: False.
+        cache_policy (str): The replacement policy of the embedding cache in parameter server training mode,
+                            one of "step", "clock", "lfu" and "tinylfu". Default: "step".
+        tcp_transport (str): The transport of the tcp communication between workers and servers, "libevent" or
+                             "epoll". The epoll transport runs an event loop per core and isn't used with SSL.
+                             Default: "libevent".
+        load_rebalance_interval (int): The number of pushes per dense parameter after which the hot parameters are
+                                       moved off the most loaded servers. The parameters are not rebalanced if it's
+                                       0. Default: 0.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
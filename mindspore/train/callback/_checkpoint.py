@@ -86,6 +86,9 @@ class CheckpointConfig:
                                       is not required. Default: None.
         enc_mode (str): This parameter is valid only when enc_key is not set to None. Specifies the encryption
                         mode, currently supports 'AES-GCM' and 'AES-CBC'. Default: 'AES-GCM'.
+        native_format (bool): Whether to save through the native checkpoint engine, which writes the parameters
+                              with worker threads into a chunked format with a checksum per parameter.
+                              Default: False.
 
     Raises:
         ValueError: If the input_param is None or 0.
@@ -132,7 +135,8 @@ class CheckpointConfig:
                  async_save=False,
                  saved_network=None,
                  enc_key=None,
-                 enc_mode='AES-GCM'):
+                 enc_mode='AES-GCM',
+                 native_format=False):
 
         if save_checkpoint_steps is not None:
             save_checkpoint_steps = Validator.check_non_negative_int(save_checkpoint_steps)
@@ -168,6 +172,7 @@ class CheckpointConfig:
         self._saved_network = saved_network
         self._enc_key = Validator.check_isinstance('enc_key', enc_key, (type(None), bytes))
         self._enc_mode = Validator.check_isinstance('enc_mode', enc_mode, str)
+        self._native_format = Validator.check_bool(native_format)
 
     @property
     def save_checkpoint_steps(self):
@@ -214,6 +219,11 @@ class CheckpointConfig:
         """Get the value of _enc_mode"""
         return self._enc_mode
 
+    @property
+    def native_format(self):
+        """Get the value of _native_format"""
+        return self._native_format
+
     def get_checkpoint_policy(self):
         """Get the policy of checkpoint."""
         checkpoint_policy = {'save_checkpoint_steps': self.save_checkpoint_steps,
@@ -373,7 +383,8 @@ class ModelCheckpoint(Callback):
 
             network = self._config.saved_network if self._config.saved_network is not None else cb_params.train_network
             save_checkpoint(network, cur_file, self._config.integrated_save,
-                            self._config.async_save, self._config.enc_key, self._config.enc_mode)
+                            self._config.async_save, self._config.enc_key, self._config.enc_mode,
+                            self._config.native_format)
 
             self._latest_ckpt_file_name = cur_file
 
@@ -16,6 +16,7 @@
 import os
 
 import sys
+import atexit
 import stat
 import math
 import shutil
@@ -43,6 +44,7 @@ from mindspore.compression.export import quant_export
 from mindspore.parallel._tensor import _load_tensor
 from mindspore.parallel._utils import _infer_rank_list, _remove_repeated_slices
 from .._c_expression import load_mindir, _encrypt, _decrypt, _is_cipher_file
+from .._c_expression import CheckpointWriter_, CheckpointReader_, _is_native_checkpoint
 
 
 tensor_to_ms_type = {"Int8": mstype.int8, "Uint8": mstype.uint8, "Int16": mstype.int16, "Uint16": mstype.uint16,
@@ -55,6 +57,7 @@ tensor_to_np_type = {"Int8": np.int8, "Uint8": np.uint8, "Int16": np.int16, "Uin
                      "Float16": np.float16, "Float32": np.float32, "Float64": np.float64, "Bool": np.bool_}
 
 _ckpt_mutex = Lock()
+_native_ckpt_writers = []
 
 # unit is KB
 SLICE_SIZE = 512 * 1024
@@ -188,7 +191,36 @@ def _exec_save(ckpt_file_name, data_list, enc_key=None, enc_mode="AES-GCM"):
         raise e
 
 
-def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=False, enc_key=None, enc_mode="AES-GCM"):
+def _wait_native_save():
+    """Wait for the checkpoints being saved in the background by the native engine."""
+    while _native_ckpt_writers:
+        _native_ckpt_writers.pop(0).wait()
+
+
+atexit.register(_wait_native_save)
+
+
+def _exec_native_save(ckpt_file_name, param_list, async_save):
+    """Save the checkpoint through the native engine, which writes the parameters with worker threads."""
+    with _ckpt_mutex:
+        _wait_native_save()
+        tensors = []
+        for param in param_list:
+            if isinstance(param["data"], Parameter):
+                param["data"].init_data()
+            tensors.append((param["name"], param["data"]))
+        writer = CheckpointWriter_(os.path.realpath(ckpt_file_name))
+        # The snapshot copies the parameters, so training can go on while they are written.
+        writer.snapshot(tensors)
+        if async_save:
+            writer.write_async()
+            _native_ckpt_writers.append(writer)
+        else:
+            writer.write()
+
+
+def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=False, enc_key=None, enc_mode="AES-GCM",
+                    native_format=False):
     """
     Saves checkpoint info to a specified file.
 
@@ -204,10 +236,15 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
                                       is not required. Default: None.
         enc_mode (str): This parameter is valid only when enc_key is not set to None. Specifies the encryption
                         mode, currently supports 'AES-GCM' and 'AES-CBC'. Default: 'AES-GCM'.
+        native_format (bool): Whether to save through the native checkpoint engine, which writes the parameters
+                              with worker threads into a chunked format with a checksum per parameter. Such a
+                              file is read back by `load_checkpoint`, and does not support encryption.
+                              Default: False.
 
     Raises:
         TypeError: If the parameter save_obj is not `nn.Cell` or list type. And if the parameter
-                   `integrated_save` and `async_save` are not bool type.
+                   `integrated_save`, `async_save` and `native_format` are not bool type.
+        ValueError: If `native_format` is True and `enc_key` is set.
 
     Examples:
         >>> from mindspore import save_checkpoint
@@ -222,6 +259,9 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
     async_save = Validator.check_bool(async_save)
     enc_key = Validator.check_isinstance('enc_key', enc_key, (type(None), bytes))
     enc_mode = Validator.check_isinstance('enc_mode', enc_mode, str)
+    native_format = Validator.check_bool(native_format)
+    if native_format and enc_key is not None:
+        raise ValueError("The native checkpoint format does not support encryption.")
 
     logger.info("Execute the process of saving checkpoint files.")
 
@@ -244,6 +284,11 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
             param_list.append(each_param)
         save_obj = param_list
 
+    if native_format:
+        _exec_native_save(ckpt_file_name, save_obj, async_save)
+        logger.info("Saving checkpoint process is finished.")
+        return
+
     data_list = {}
     with _ckpt_mutex:
         for param in save_obj:
@@ -357,6 +402,14 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
     dec_key = Validator.check_isinstance('dec_key', dec_key, (type(None), bytes))
     dec_mode = Validator.check_isinstance('dec_mode', dec_mode, str)
     logger.info("Execute the process of loading checkpoint files.")
+    if dec_key is None and _is_native_checkpoint(ckpt_file_name):
+        parameter_dict = _load_native_checkpoint(ckpt_file_name, filter_prefix)
+        if not parameter_dict:
+            raise ValueError(f"The loaded parameter dict is empty after filtering, please check filter_prefix.")
+        if net is not None:
+            load_param_into_net(net, parameter_dict, strict_load)
+        return parameter_dict
+
     checkpoint_list = Checkpoint()
 
     try:
@@ -422,6 +475,23 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
     return parameter_dict
 
 
+def _load_native_checkpoint(ckpt_file_name, filter_prefix):
+    """Load a checkpoint saved by the native engine, reading only the parameters kept by the filter."""
+    try:
+        reader = CheckpointReader_(os.path.realpath(ckpt_file_name))
+        names = [name for name in reader.names()
+                 if filter_prefix is None or not _check_param_prefix(filter_prefix, name)]
+        tensors = reader.read_all(names)
+    except RuntimeError as e:
+        logger.error("Failed to load the checkpoint file `%s`.", ckpt_file_name)
+        raise ValueError(e.__str__())
+    parameter_dict = {}
+    for name, tensor in zip(names, tensors):
+        parameter_dict[name] = Parameter(Tensor(tensor), name=name)
+    logger.info("Loading checkpoint files process is finished.")
+    return parameter_dict
+
+
 def _check_checkpoint_param(ckpt_file_name, filter_prefix=None):
     """Check function load_checkpoint's parameter."""
     if not isinstance(ckpt_file_name, str):
@@ -207,6 +207,7 @@ setup(
     entry_points={
         'console_scripts': [
             'cache_admin=mindspore.dataset.engine.cache_admin:main',
+            'parallel_planner=mindspore.parallel._planner:main',
         ],
     },
     python_requires='>=3.7',
@@ -0,0 +1,75 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+# ============================================================================
+"""
+Throughput of the parameter server. Every layer of the network is a parameter of its own, so each step of every
+worker pushes and pulls 2 * layer_num keys, and the number of the keys served per second is printed by the workers.
+"""
+import argparse
+import sys
+import time
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.parallel._ps_context import _is_role_pserver
+
+parser = argparse.ArgumentParser(description="test_ps_throughput")
+parser.add_argument("--device_target", type=str, default="Ascend")
+parser.add_argument("--layer_num", type=int, default=64)
+parser.add_argument("--warmup_steps", type=int, default=5)
+parser.add_argument("--steps", type=int, default=50)
+args, _ = parser.parse_known_args()
+device_target = args.device_target
+context.set_context(mode=context.GRAPH_MODE, device_target=device_target)
+context.set_ps_context(enable_ps=True)
+
+
+class DenseStack(nn.Cell):
+    def __init__(self, layer_num, width=256, num_class=10):
+        super(DenseStack, self).__init__()
+        self.layers = nn.SequentialCell([nn.Dense(width, width, activation="relu") for _ in range(layer_num)])
+        self.head = nn.Dense(width, num_class)
+
+    def construct(self, x):
+        return self.head(self.layers(x))
+
+
+if __name__ == "__main__":
+    np.random.seed(0)
+    network = DenseStack(args.layer_num)
+    network.set_param_ps()
+    criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction="mean")
+    net_opt = nn.Momentum(network.trainable_params(), 0.01, 0.9)
+    train_network = TrainOneStepCell(WithLossCell(network, criterion), net_opt)
+    train_network.set_train()
+    data = Tensor(np.random.rand(32, 256).astype(np.float32))
+    label = Tensor(np.random.randint(0, 9, (32)).astype(np.int32))
+    if _is_role_pserver():
+        train_network(data, label)
+        sys.exit()
+
+    for _ in range(args.warmup_steps):
+        train_network(data, label).asnumpy()
+    begin = time.time()
+    for _ in range(args.steps):
+        loss = train_network(data, label).asnumpy()
+    cost = time.time() - begin
+    key_num = len(network.trainable_params())
+    print(f"layer_num: {args.layer_num}, keys: {key_num}, steps/s: {args.steps / cost:.2f}, "
+          f"pushes and pulls/s: {2 * key_num * args.steps / cost:.2f}, loss: {loss}")
+    assert np.all(np.isfinite(loss))
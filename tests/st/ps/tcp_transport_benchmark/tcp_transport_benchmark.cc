@@ -0,0 +1,153 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The loopback benchmark of the libevent and the epoll tcp transports, run by hand and not with the unit tests:
+//   ./tcp_transport_benchmark [libevent|epoll]
+// The server echoes every message. The latency is measured by round trips of small messages, and the throughput by
+// pipelined messages of 1 MB.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ps/core/communicator/epoll_tcp_client.h"
+#include "ps/core/communicator/epoll_tcp_server.h"
+#include "ps/core/communicator/tcp_client.h"
+#include "ps/core/communicator/tcp_server.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+namespace {
+constexpr size_t kLatencyRounds = 1000;
+constexpr size_t kLatencyMessageSize = 64;
+constexpr size_t kThroughputMessageNum = 256;
+constexpr size_t kThroughputMessageSize = 1 << 20;
+constexpr uint32_t kWaitSeconds = 30;
+
+bool RunBenchmark(bool epoll) {
+  std::shared_ptr<TcpServer> server =
+    epoll ? std::make_shared<EpollTcpServer>("127.0.0.1", 0) : std::make_shared<TcpServer>("127.0.0.1", 0);
+  TcpServer *server_ptr = server.get();
+  server->SetMessageCallback([server_ptr](std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
+                                          const Protos &protos, const void *data, size_t size) {
+    server_ptr->SendMessage(conn, meta, protos, data, size);
+  });
+  server->Init();
+  std::thread server_thread([server_ptr]() { server_ptr->Start(); });
+
+  std::shared_ptr<TcpClient> client = epoll ? std::make_shared<EpollTcpClient>("127.0.0.1", server->BoundPort())
+                                            : std::make_shared<TcpClient>("127.0.0.1", server->BoundPort());
+  std::mutex mtx;
+  std::condition_variable cond;
+  size_t received = 0;
+  size_t received_bytes = 0;
+  bool intact = true;
+  client->SetMessageCallback([&](std::shared_ptr<MessageMeta> meta, const Protos &, const void *data, size_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (size == kLatencyMessageSize &&
+        static_cast<const unsigned char *>(data)[size - 1] != static_cast<unsigned char>(meta->request_id())) {
+      intact = false;
+    }
+    received++;
+    received_bytes += size;
+    cond.notify_all();
+  });
+  client->Init();
+  std::atomic<bool> done(false);
+  std::thread client_thread;
+  if (!epoll) {
+    client_thread = std::thread([&]() {
+      while (!done.load()) {
+        client->StartWithNoBlock();
+      }
+    });
+  }
+  bool success = client->WaitConnected(kWaitSeconds);
+
+  auto meta = std::make_shared<MessageMeta>();
+  meta->set_cmd(NodeCommand::SEND_DATA);
+  std::vector<unsigned char> small(kLatencyMessageSize);
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; success && i < kLatencyRounds; ++i) {
+    meta->set_request_id(i);
+    small.back() = static_cast<unsigned char>(i);
+    client->SendMessage(meta, Protos::RAW, small.data(), small.size());
+    std::unique_lock<std::mutex> lock(mtx);
+    success = cond.wait_for(lock, std::chrono::seconds(kWaitSeconds), [&]() { return received == i + 1; });
+  }
+  double latency = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    success = success && intact;
+    received = 0;
+    received_bytes = 0;
+  }
+
+  DataPtr payload(new unsigned char[kThroughputMessageSize]());
+  begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; success && i < kThroughputMessageNum; ++i) {
+    meta->set_request_id(kLatencyRounds + i);
+    client->SendMessage(meta, Protos::RAW, payload, kThroughputMessageSize);
+  }
+  if (success) {
+    std::unique_lock<std::mutex> lock(mtx);
+    success = cond.wait_for(lock, std::chrono::seconds(kWaitSeconds), [&]() {
+      return received_bytes == kThroughputMessageNum * kThroughputMessageSize;
+    });
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  if (success) {
+    std::cout << (epoll ? "epoll" : "libevent") << " tcp transport: round trip latency " << latency / kLatencyRounds
+              << " us, echo throughput " << kThroughputMessageNum * kThroughputMessageSize / seconds / (1 << 20)
+              << " MB/s" << std::endl;
+  } else {
+    std::cout << (epoll ? "epoll" : "libevent") << " tcp transport: the echoed messages are lost or broken."
+              << std::endl;
+  }
+
+  done = true;
+  if (client_thread.joinable()) {
+    client_thread.join();
+  }
+  client->Stop();
+  server->Stop();
+  server_thread.join();
+  return success;
+}
+}  // namespace
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
+
+int main(int argc, char **argv) {
+  std::string transport = argc > 1 ? argv[1] : "";
+  bool success = true;
+  if (transport.empty() || transport == "libevent") {
+    success = mindspore::ps::core::RunBenchmark(false) && success;
+  }
+  if (transport.empty() || transport == "epoll") {
+    success = mindspore::ps::core::RunBenchmark(true) && success;
+  }
+  return success ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/bucket.h"
+
+namespace mindspore {
+namespace device {
+class TestBucket : public UT::Common {
+ public:
+  TestBucket() = default;
+};
+
+TEST_F(TestBucket, test_plan_bucket_sizes_compute_bound) {
+  // The grads are ready far apart, so each one is reduced while the next is computed.
+  auto bucket_sizes = PlanBucketSizesByTiming({100, 200, 300, 400}, {1000, 1000, 1000, 1000}, 10, 100);
+  std::vector<uint32_t> expect = {1, 1, 1, 1};
+  ASSERT_EQ(bucket_sizes, expect);
+}
+
+TEST_F(TestBucket, test_plan_bucket_sizes_latency_bound) {
+  // The grads are ready together, so one bucket pays the latency only once.
+  auto bucket_sizes = PlanBucketSizesByTiming({1, 2, 3, 4}, {1000, 1000, 1000, 1000}, 10, 100);
+  std::vector<uint32_t> expect = {4};
+  ASSERT_EQ(bucket_sizes, expect);
+}
+
+TEST_F(TestBucket, test_plan_bucket_sizes_overlap) {
+  // The first three grads are reduced while the last one is still computed.
+  auto bucket_sizes = PlanBucketSizesByTiming({0, 0, 0, 100}, {1000, 1000, 1000, 10}, 10, 100);
+  std::vector<uint32_t> expect = {3, 1};
+  ASSERT_EQ(bucket_sizes, expect);
+}
+
+TEST_F(TestBucket, test_bucket_timing_profiler) {
+  BucketTimingProfiler profiler;
+  // The first step builds the single ops, so its grads are not recorded.
+  profiler.NextStep();
+  profiler.set_step_start_time(0);
+  ASSERT_FALSE(profiler.profiling());
+  profiler.RecordGrad(1, 1000);
+  ASSERT_EQ(profiler.grad_num(), 0);
+
+  // The second step is profiled, with the times taken in seconds and planned in us.
+  profiler.NextStep();
+  profiler.set_step_start_time(10);
+  ASSERT_TRUE(profiler.profiling());
+  ASSERT_FALSE(profiler.ready_to_plan());
+  profiler.RecordGrad(10, 1000);
+  profiler.RecordGrad(10, 1000);
+  profiler.RecordGrad(10, 1000);
+  profiler.RecordGrad(10.0001, 10);
+  ASSERT_EQ(profiler.grad_num(), 4);
+
+  // The buckets are planned at the start of the third step, and only once.
+  profiler.NextStep();
+  ASSERT_FALSE(profiler.profiling());
+  ASSERT_TRUE(profiler.ready_to_plan());
+  std::vector<uint32_t> expect = {3, 1};
+  ASSERT_EQ(profiler.Plan(10, 100), expect);
+  ASSERT_EQ(profiler.grad_num(), 0);
+  ASSERT_FALSE(profiler.ready_to_plan());
+  profiler.NextStep();
+  ASSERT_FALSE(profiler.profiling());
+  ASSERT_FALSE(profiler.ready_to_plan());
+}
+}  // namespace device
+}  // namespace mindspore
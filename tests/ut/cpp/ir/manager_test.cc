@@ -13,6 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
+#include <utility>
+#include <vector>
+
 #include "common/common_test.h"
 #include "common/py_func_graph_fetcher.h"
 #include "ir/dtype.h"
@@ -340,6 +344,41 @@ std::vector<FuncGraphPtr> MakeNestedGraph2() {
   return result;
 }
 
+// Make a root graph calling closure_num closures, each of which has node_num nodes and captures y of the root in its
+// first node. The first nodes of the closures are returned with the graphs.
+std::pair<std::vector<FuncGraphPtr>, std::vector<CNodePtr>> MakeClosures(size_t closure_num, size_t node_num) {
+  /*
+   *def root(x, y):
+   *    def closure_i(p):
+   *        a = p + y
+   *        a = a + p  # node_num times
+   *        return a
+   *    return closure_0(x) + ... + closure_n(x)
+   */
+  FuncGraphPtr root = std::make_shared<FuncGraph>();
+  ParameterPtr x = root->add_parameter();
+  ParameterPtr y = root->add_parameter();
+  std::vector<FuncGraphPtr> graphs = {root};
+  std::vector<CNodePtr> first_nodes;
+  AnfNodePtr sum = nullptr;
+  for (size_t i = 0; i < closure_num; ++i) {
+    FuncGraphPtr closure = std::make_shared<FuncGraph>();
+    ParameterPtr p = closure->add_parameter();
+    CNodePtr node = closure->NewCNode({NewValueNode(prim::kPrimScalarAdd), p, y});
+    first_nodes.push_back(node);
+    for (size_t j = 1; j < node_num; ++j) {
+      node = closure->NewCNode({NewValueNode(prim::kPrimScalarAdd), node, p});
+    }
+    closure->set_return(closure->NewCNode({NewValueNode(prim::kPrimReturn), node}));
+    graphs.push_back(closure);
+
+    CNodePtr call = root->NewCNode({NewValueNode(closure), x});
+    sum = sum == nullptr ? call : root->NewCNode({NewValueNode(prim::kPrimScalarAdd), sum, call});
+  }
+  root->set_return(root->NewCNode({NewValueNode(prim::kPrimReturn), sum}));
+  return {graphs, first_nodes};
+}
+
 // Add TestManager::CheckManager function to checkout the result
 void TestManager::CheckAnalysisSize(std::shared_ptr<FuncGraphManager> mng) {
   auto size = mng->func_graphs().size();
@@ -410,6 +449,66 @@ TEST_F(TestManager, test_nested_manual) {
   ASSERT_EQ(1, g->func_graph_cnodes_index().size());
 }
 
+TEST_F(TestManager, test_drop_free_variable) {
+  auto graphs = MakeNestedGraph2();
+  auto foo = graphs[0];
+  auto bar = graphs[1];
+  auto mng = Manage(foo);
+
+  ASSERT_EQ(foo, mng->parent(bar));
+  ASSERT_EQ(1, mng->free_variables_total()[bar].size());
+  ASSERT_TRUE(mng->func_graphs_used_total(foo).contains(bar));
+  ASSERT_FALSE(mng->recursive(foo));
+
+  // bar(x1) returns x1 + x1 after the rewrite, so it no longer captures y of foo.
+  auto cnode_add = bar->output()->cast<CNodePtr>();
+  ASSERT_NE(cnode_add, nullptr);
+  mng->SetEdge(cnode_add, 2, bar->parameters()[0]);
+
+  ASSERT_EQ(nullptr, mng->parent(bar));
+  ASSERT_EQ(0, mng->free_variables_total()[bar].size());
+  ASSERT_TRUE(mng->func_graphs_used_total(foo).contains(bar));
+  ASSERT_FALSE(mng->recursive(foo));
+  CheckAnalysisSize(mng);
+}
+
+// Rewriting a closure of a graph with more than 100k nodes only recomputes the analyses of the closure and the root, and
+// the analyses of the other closures are kept.
+TEST_F(TestManager, test_incremental_invalidation) {
+  constexpr size_t kClosureNum = 1000;
+  constexpr size_t kClosureNodeNum = 100;
+  constexpr size_t kRewriteNum = 200;
+  auto closures = MakeClosures(kClosureNum, kClosureNodeNum);
+  auto &graphs = closures.first;
+  auto &first_nodes = closures.second;
+  auto root = graphs[0];
+  auto mng = Manage(root);
+  ASSERT_GT(mng->all_nodes().size(), kClosureNum * kClosureNodeNum);
+  for (size_t i = 1; i < graphs.size(); ++i) {
+    ASSERT_EQ(root, mng->parent(graphs[i]));
+  }
+  ASSERT_EQ(kClosureNum, mng->children(root).size());
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 1; i <= kRewriteNum; ++i) {
+    // closure_i(p) computes p + p first, so it no longer captures y.
+    auto closure = graphs[i];
+    mng->SetEdge(first_nodes[i - 1], 2, closure->parameters()[0]);
+    EXPECT_EQ(nullptr, mng->parent(closure));
+    EXPECT_EQ(kClosureNum - i, mng->children(root).size());
+    EXPECT_TRUE(mng->func_graph_parent_->IsValidate(graphs.back()));
+  }
+  auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  MS_LOG(INFO) << "Rewrite " << kRewriteNum << " closures of a graph with " << mng->all_nodes().size()
+               << " nodes and query their analyses in " << cost << " us.";
+
+  EXPECT_EQ(root, mng->parent(graphs.back()));
+  EXPECT_EQ(0, mng->free_variables_total()[graphs[1]].size());
+  EXPECT_EQ(1, mng->free_variables_total()[graphs.back()].size());
+  EXPECT_TRUE(mng->func_graphs_used_total(root).contains(graphs[1]));
+  CheckAnalysisSize(mng);
+}
+
 TEST_F(TestManager, test_deep_nested2_manual) {
   // create parser
   FuncGraphPtr func_graph = getPyFun("test_custom");
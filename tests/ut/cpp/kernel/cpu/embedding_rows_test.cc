@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/embedding_rows.h"
+
+namespace mindspore {
+namespace kernel {
+class EmbeddingRowsTest : public UT::Common {
+ public:
+  EmbeddingRowsTest() = default;
+
+  void SetUp() override {
+    // 6 rows of 20 elements, so a row takes a vector loop and a remainder.
+    table_.resize(first_dim_size_ * outer_dim_size_);
+    for (size_t i = 0; i < table_.size(); ++i) {
+      table_[i] = static_cast<float>(i);
+    }
+  }
+
+  size_t first_dim_size_{6};
+  size_t outer_dim_size_{20};
+  std::vector<float> table_;
+};
+
+TEST_F(EmbeddingRowsTest, gather_rows) {
+  // The ids are shifted by the offset 2, so 1 and 8 are out of range.
+  std::vector<int64_t> ids = {2, 7, 1, 4, 8, 7, 3, 2, 5, 6};
+  std::vector<float> output(ids.size() * outer_dim_size_, -1.0f);
+  GatherEmbeddingRows<int64_t>(table_.data(), first_dim_size_, outer_dim_size_, ids.data(), ids.size(), 2,
+                               output.data());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    int64_t row = ids[i] - 2;
+    for (size_t j = 0; j < outer_dim_size_; ++j) {
+      float expect = (row < 0 || row >= 6) ? 0.0f : table_[row * outer_dim_size_ + j];
+      EXPECT_EQ(output[i * outer_dim_size_ + j], expect);
+    }
+  }
+}
+
+TEST_F(EmbeddingRowsTest, scatter_rows) {
+  // The id 3 is repeated, it keeps the last row. The id -1 is out of range and skipped.
+  std::vector<int> ids = {3, 0, -1, 3};
+  std::vector<float> values(ids.size() * outer_dim_size_);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    for (size_t j = 0; j < outer_dim_size_; ++j) {
+      values[i * outer_dim_size_ + j] = static_cast<float>(100 * (i + 1) + j);
+    }
+  }
+  std::vector<float> expect = table_;
+  for (size_t j = 0; j < outer_dim_size_; ++j) {
+    expect[j] = values[outer_dim_size_ + j];
+    expect[3 * outer_dim_size_ + j] = values[3 * outer_dim_size_ + j];
+  }
+  ScatterEmbeddingRows<int>(table_.data(), first_dim_size_, outer_dim_size_, ids.data(), ids.size(), 0,
+                            values.data());
+  EXPECT_EQ(table_, expect);
+}
+}  // namespace kernel
+}  // namespace mindspore
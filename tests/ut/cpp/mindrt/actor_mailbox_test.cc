@@ -0,0 +1,188 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/log_adapter.h"
+#include "actor/actor.h"
+#include "actor/actormgr.h"
+#include "async/async.h"
+#include "thread/inter_threadpool.h"
+#include "thread/mpscqueue.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kThreadNum = 4;
+constexpr size_t kPingPongRounds = 100000;
+constexpr size_t kFanInProducers = 8;
+constexpr size_t kFanInMessagesPerProducer = 100000;
+
+struct QueueNode {
+  explicit QueueNode(size_t v = 0) : value(v) {}
+  size_t value;
+  std::atomic<QueueNode *> next{nullptr};
+};
+
+class PingPongActor : public ActorBase {
+ public:
+  explicit PingPongActor(const std::string &name) : ActorBase(name) {}
+  ~PingPongActor() override = default;
+
+  void Ping(size_t round) {
+    if (round == 0) {
+      done_.set_value();
+      return;
+    }
+    Async(peer_, &PingPongActor::Ping, round - 1);
+  }
+
+  AID peer_;
+  std::promise<void> done_;
+};
+
+class FanInActor : public ActorBase {
+ public:
+  explicit FanInActor(const std::string &name, size_t expect) : ActorBase(name), expect_(expect) {}
+  ~FanInActor() override = default;
+
+  void Collect(size_t) {
+    if (++received_ == expect_) {
+      done_.set_value();
+    }
+  }
+
+  size_t expect_;
+  size_t received_{0};
+  std::promise<void> done_;
+};
+}  // namespace
+
+class TestActorMailbox : public UT::Common {
+ public:
+  TestActorMailbox() = default;
+  virtual ~TestActorMailbox() = default;
+
+  void SetUp() override {
+    thread_pool_ = InterThreadPool::CreateThreadPool(kThreadNum);
+    ASSERT_NE(thread_pool_, nullptr);
+  }
+  void TearDown() override {
+    ActorMgr::GetActorMgrRef()->Finalize();
+    delete thread_pool_;
+    thread_pool_ = nullptr;
+  }
+
+  void SpawnActor(const ActorReference &actor) {
+    auto base_actor = actor;
+    base_actor->set_thread_pool(thread_pool_);
+    (void)ActorMgr::GetActorMgrRef()->Spawn(base_actor);
+  }
+
+  InterThreadPool *thread_pool_{nullptr};
+};
+
+// Multiple producers enqueue concurrently, the consumer dequeues all nodes in the order of each producer.
+TEST_F(TestActorMailbox, MpscQueue) {
+  constexpr size_t kProducerNum = 4;
+  constexpr size_t kNodeNum = 20000;
+  MpscQueue<QueueNode> queue;
+  std::vector<std::unique_ptr<QueueNode[]>> nodes;
+  for (size_t i = 0; i < kProducerNum; ++i) {
+    nodes.emplace_back(new QueueNode[kNodeNum]);
+  }
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < kProducerNum; ++i) {
+    producers.emplace_back([&nodes, &queue, i]() {
+      for (size_t j = 0; j < kNodeNum; ++j) {
+        nodes[i][j].value = i * kNodeNum + j;
+        queue.Enqueue(&nodes[i][j]);
+      }
+    });
+  }
+
+  std::vector<size_t> last_index(kProducerNum, 0);
+  size_t dequeued = 0;
+  size_t out_of_order = 0;
+  while (dequeued < kProducerNum * kNodeNum) {
+    auto node = queue.Dequeue();
+    if (node == nullptr) {
+      continue;
+    }
+    auto producer = node->value / kNodeNum;
+    auto index = node->value % kNodeNum;
+    if (index != last_index[producer]) {
+      ++out_of_order;
+    }
+    last_index[producer] = index + 1;
+    ++dequeued;
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  EXPECT_EQ(out_of_order, 0);
+  EXPECT_EQ(queue.Dequeue(), nullptr);
+  EXPECT_TRUE(queue.Empty());
+}
+
+// Two actors send the message to each other in turn, and log the latency of round trip.
+TEST_F(TestActorMailbox, PingPongLatency) {
+  auto ping = std::make_shared<PingPongActor>("PingActor");
+  auto pong = std::make_shared<PingPongActor>("PongActor");
+  ping->peer_ = pong->GetAID();
+  pong->peer_ = ping->GetAID();
+  auto future = ping->done_.get_future();
+  SpawnActor(ping);
+  SpawnActor(pong);
+
+  auto start = std::chrono::steady_clock::now();
+  // The message of even round is handled by the ping actor.
+  Async(ping->GetAID(), &PingPongActor::Ping, kPingPongRounds * 2);
+  future.wait();
+  auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  MS_LOG(INFO) << "Ping-pong round trip latency: " << cost / kPingPongRounds << " ns, rounds: " << kPingPongRounds;
+}
+
+// Multiple threads send the messages to one actor concurrently, and log the throughput of fan-in.
+TEST_F(TestActorMailbox, FanInThroughput) {
+  constexpr size_t kMessageNum = kFanInProducers * kFanInMessagesPerProducer;
+  auto actor = std::make_shared<FanInActor>("FanInActor", kMessageNum);
+  auto future = actor->done_.get_future();
+  SpawnActor(actor);
+  auto aid = actor->GetAID();
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < kFanInProducers; ++i) {
+    producers.emplace_back([&aid]() {
+      for (size_t j = 0; j < kFanInMessagesPerProducer; ++j) {
+        Async(aid, &FanInActor::Collect, j);
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  future.wait();
+  auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_EQ(actor->received_, kMessageNum);
+  MS_LOG(INFO) << "Fan-in throughput: " << (cost > 0 ? kMessageNum * 1000000 / cost : kMessageNum)
+               << " messages/s, producers: " << kFanInProducers;
+}
+}  // namespace mindspore
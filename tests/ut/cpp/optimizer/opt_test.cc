@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -155,6 +156,16 @@ TEST_F(TestOptOpt, ElimR) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({elim_R})));
 }
 
+TEST_F(TestOptOpt, ElimRWithIndexedSubstitutions) {
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_elimR", "before_1");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_elimR", "after");
+
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+  // Substitutions rooted at other primitives must not shadow the one rooted at R.
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({idempotent_P, Qct_to_P, elim_R})));
+}
+
 TEST_F(TestOptOpt, idempotent) {
   FuncGraphPtr before_2 = getPyFun.CallAndParseRet("test_idempotent", "before_2");
   FuncGraphPtr before_1 = getPyFun.CallAndParseRet("test_idempotent", "before_1");
@@ -212,5 +223,34 @@ TEST_F(TestOptOpt, CSE) {
   draw::Draw("opt_cse_after_2.dot", test_graph2);
 }
 
+TEST_F(TestOptOpt, CSECommutativeAndClosure) {
+  auto count_scalar_add = [](const FuncGraphManagerPtr &manager) {
+    auto &nodes = manager->all_nodes();
+    return std::count_if(nodes.begin(), nodes.end(),
+                         [](const AnfNodePtr &node) { return IsPrimitiveCNode(node, prim::kPrimScalarAdd); });
+  };
+  auto cse = std::make_shared<CSE>();
+
+  // scalar_add(x, y) and scalar_add(y, x) are the same value.
+  FuncGraphPtr test_graph3 = getPyFun.CallAndParseRet("test_cse", "test_f3");
+  ASSERT_TRUE(nullptr != test_graph3);
+  FuncGraphManagerPtr manager3 = Manage(test_graph3);
+  ASSERT_EQ(count_scalar_add(manager3), 2);
+  ASSERT_TRUE(cse->Cse(test_graph3, manager3));
+  ASSERT_EQ(count_scalar_add(manager3), 1);
+
+  // The scalar_add in the closure is replaced by the one of the outer graph.
+  FuncGraphPtr test_graph4 = getPyFun.CallAndParseRet("test_cse", "test_f4");
+  ASSERT_TRUE(nullptr != test_graph4);
+  FuncGraphManagerPtr manager4 = Manage(test_graph4);
+  ASSERT_EQ(count_scalar_add(manager4), 2);
+  ASSERT_TRUE(cse->Cse(test_graph4, manager4));
+  ASSERT_EQ(count_scalar_add(manager4), 1);
+  auto &nodes = manager4->all_nodes();
+  auto add = std::find_if(nodes.begin(), nodes.end(),
+                          [](const AnfNodePtr &node) { return IsPrimitiveCNode(node, prim::kPrimScalarAdd); });
+  ASSERT_EQ((*add)->func_graph(), test_graph4);
+}
+
 }  // namespace opt
 }  // namespace mindspore
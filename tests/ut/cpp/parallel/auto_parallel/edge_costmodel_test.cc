@@ -115,6 +115,38 @@ TEST_F(TestEdgeCostModel, test_InitEdgeCost) {
   ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
 }
 
+TEST_F(TestEdgeCostModel, test_InitEdgeCostMemoized) {
+  std::string edge_name = "MatMul-MatMul";
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  matmul1->AddSuccEdge(edge_m1_m2);
+  matmul2->AddPrevEdge(edge_m1_m2);
+  Edge::ClearRedistributionCostCache();
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  auto computed_costs = edge_m1_m2->GetCostMap();
+  size_t pair_num = matmul1->GetStrategyCost().size() * matmul2->GetStrategyCost().size();
+  ASSERT_EQ(computed_costs.size(), pair_num);
+  // Each strategy pair looks its redistribution up once, and only the layout pairs not seen before are computed.
+  size_t miss_num = Edge::RedistributionCostCacheMissNum();
+  size_t hit_num = Edge::RedistributionCostCacheHitNum();
+  ASSERT_GT(miss_num, 0);
+  ASSERT_EQ(miss_num + hit_num, pair_num);
+  // The second initialization reads all the redistribution costs back from the cache.
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  ASSERT_EQ(Edge::RedistributionCostCacheMissNum(), miss_num);
+  ASSERT_EQ(Edge::RedistributionCostCacheHitNum(), hit_num + pair_num);
+  auto cached_costs = edge_m1_m2->GetCostMap();
+  ASSERT_EQ(computed_costs.size(), cached_costs.size());
+  for (auto &computed : computed_costs) {
+    auto &cached = cached_costs.at(computed.first);
+    ASSERT_EQ(cached.size(), 1);
+    ASSERT_DOUBLE_EQ(cached[0]->communication_cost_, computed.second[0]->communication_cost_);
+    ASSERT_DOUBLE_EQ(cached[0]->computation_cost_, computed.second[0]->computation_cost_);
+    ASSERT_DOUBLE_EQ(cached[0]->memory_with_reuse_, computed.second[0]->memory_with_reuse_);
+  }
+}
+
 TEST_F(TestEdgeCostModel, test_OpEliminationSetNewCost) {
   std::string edge_name = "MatMul-MatMul";
   std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
@@ -15,6 +15,8 @@
  */
 #include <iostream>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "pipeline/jit/static_analysis/prim.h"
 #include "pipeline/static_analysis/helper.h"
@@ -500,5 +502,51 @@ TEST_F(TestGraphInfer, test_graph_infer_vararg_kwonlyargs_kwarg_defaults) {
 }
 */
 
+class TestAnalysisCache : public UT::Common {
+ public:
+  TestAnalysisCache() = default;
+  virtual ~TestAnalysisCache() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// The results of the nodes are published and looked up by several threads at the same time.
+TEST_F(TestAnalysisCache, ConcurrentSetAndGet) {
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kNodeNum = 1000;
+  auto func_graph = std::make_shared<FuncGraph>();
+  auto context = AnalysisContext::DummyContext()->NewFuncGraphContext(func_graph, {});
+  std::vector<AnfNodeConfigPtr> confs;
+  for (size_t i = 0; i < kNodeNum; ++i) {
+    confs.push_back(std::make_shared<AnfNodeConfig>(nullptr, func_graph->add_parameter(), context));
+  }
+
+  AnalysisCache cache;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&cache, &confs, t]() {
+      for (size_t i = t; i < kNodeNum; i += kThreadNum) {
+        auto abstract = FromValue(static_cast<int64_t>(i), false);
+        cache.set_value(confs[i], std::make_shared<EvalResult>(abstract, std::make_shared<AttrValueMap>()));
+        // The results published by the other threads are read while they're written.
+        (void)cache.GetValue(confs[kNodeNum - 1 - i]);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < kNodeNum; ++i) {
+    auto result = cache.GetValue(confs[i]);
+    ASSERT_NE(result, nullptr);
+    ASSERT_EQ(*result->abstract(), *FromValue(static_cast<int64_t>(i), false));
+  }
+  cache.Clear();
+  ASSERT_EQ(cache.GetValue(confs[0]), nullptr);
+}
+
+*/
+
 }  // namespace abstract
 }  // namespace mindspore
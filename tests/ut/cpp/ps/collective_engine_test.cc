@@ -0,0 +1,186 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/server/collective_engine.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+// The mailboxes of the ranks running in the threads of one process.
+class LoopbackHub {
+ public:
+  explicit LoopbackHub(uint32_t rank_size) : mailboxes_(rank_size * rank_size), rank_size_(rank_size) {}
+
+  void Send(uint32_t from, uint32_t to, const void *data, size_t size) {
+    auto bytes = static_cast<const unsigned char *>(data);
+    auto message = std::make_shared<std::vector<unsigned char>>(bytes, bytes + size);
+    std::lock_guard<std::mutex> lock(mtx_);
+    mailboxes_[from * rank_size_ + to].push_back(message);
+    cond_.notify_all();
+  }
+
+  bool Receive(uint32_t from, uint32_t to, VectorPtr *output) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto &mailbox = mailboxes_[from * rank_size_ + to];
+    if (!cond_.wait_for(lock, std::chrono::seconds(10), [&mailbox] { return !mailbox.empty(); })) {
+      return false;
+    }
+    *output = mailbox.front();
+    mailbox.pop_front();
+    return true;
+  }
+
+ private:
+  std::vector<std::deque<VectorPtr>> mailboxes_;
+  uint32_t rank_size_;
+  std::mutex mtx_;
+  std::condition_variable cond_;
+};
+
+class LoopbackTransport : public CollectiveTransport {
+ public:
+  LoopbackTransport(const std::shared_ptr<LoopbackHub> &hub, uint32_t rank_id, uint32_t rank_size)
+      : hub_(hub), rank_id_(rank_id), rank_size_(rank_size) {}
+  ~LoopbackTransport() override = default;
+
+  uint32_t rank_id() const override { return rank_id_; }
+  uint32_t rank_size() const override { return rank_size_; }
+  uint64_t SendAsync(uint32_t rank_id, const void *data, size_t size) override {
+    hub_->Send(rank_id_, rank_id, data, size);
+    return ++request_id_;
+  }
+  bool WaitSend(uint64_t) override { return true; }
+  bool Receive(uint32_t rank_id, VectorPtr *output) override { return hub_->Receive(rank_id, rank_id_, output); }
+
+ private:
+  std::shared_ptr<LoopbackHub> hub_;
+  uint32_t rank_id_;
+  uint32_t rank_size_;
+  uint64_t request_id_{0};
+};
+
+class TestCollectiveEngine : public UT::Common {
+ public:
+  TestCollectiveEngine() = default;
+  virtual ~TestCollectiveEngine() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+ protected:
+  // Run AllReduce of the inputs with a rank per thread, and return the output of each rank.
+  template <typename T>
+  std::vector<std::vector<T>> RunAllReduce(const std::vector<std::vector<T>> &inputs, bool fp16_compression = false,
+                                           size_t segment_size = kRingSegmentSize) {
+    uint32_t rank_size = inputs.size();
+    auto hub = std::make_shared<LoopbackHub>(rank_size);
+    std::vector<std::vector<T>> outputs(rank_size, std::vector<T>(inputs[0].size()));
+    std::vector<int> results(rank_size, 0);
+    std::vector<std::thread> threads;
+    for (uint32_t rank = 0; rank < rank_size; ++rank) {
+      threads.emplace_back([&, rank]() {
+        CollectiveEngine engine(std::make_shared<LoopbackTransport>(hub, rank, rank_size));
+        engine.set_fp16_compression(fp16_compression);
+        engine.set_segment_size(segment_size);
+        results[rank] = engine.AllReduce<T>(inputs[rank].data(), outputs[rank].data(), inputs[rank].size());
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    for (uint32_t rank = 0; rank < rank_size; ++rank) {
+      EXPECT_TRUE(results[rank]);
+    }
+    return outputs;
+  }
+
+  std::vector<std::vector<int>> MakeInputs(uint32_t rank_size, size_t count) {
+    std::vector<std::vector<int>> inputs(rank_size, std::vector<int>(count));
+    for (uint32_t rank = 0; rank < rank_size; ++rank) {
+      for (size_t i = 0; i < count; ++i) {
+        inputs[rank][i] = static_cast<int>(rank * 1000 + i % 997);
+      }
+    }
+    return inputs;
+  }
+};
+
+TEST_F(TestCollectiveEngine, AllReduce) {
+  // The small counts run recursive doubling, the large one the segmented ring.
+  for (uint32_t rank_size : {1, 2, 3, 5, 8}) {
+    for (size_t count : {1, 7, 1000, 100000}) {
+      auto inputs = MakeInputs(rank_size, count);
+      auto outputs = RunAllReduce(inputs, false, 4096);
+      for (size_t i = 0; i < count; ++i) {
+        int expected = 0;
+        for (uint32_t rank = 0; rank < rank_size; ++rank) {
+          expected += inputs[rank][i];
+        }
+        for (uint32_t rank = 0; rank < rank_size; ++rank) {
+          ASSERT_EQ(outputs[rank][i], expected) << "rank_size:" << rank_size << ", count:" << count << ", i:" << i;
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TestCollectiveEngine, AllReduceFp16) {
+  const uint32_t rank_size = 6;
+  for (size_t count : {100, 50000}) {
+    std::vector<std::vector<float>> inputs(rank_size, std::vector<float>(count));
+    for (uint32_t rank = 0; rank < rank_size; ++rank) {
+      for (size_t i = 0; i < count; ++i) {
+        inputs[rank][i] = 0.001f * static_cast<float>((rank + 1) * (i % 100));
+      }
+    }
+    auto outputs = RunAllReduce(inputs, true, 4096);
+    for (size_t i = 0; i < count; ++i) {
+      float expected = 0;
+      for (uint32_t rank = 0; rank < rank_size; ++rank) {
+        expected += inputs[rank][i];
+      }
+      EXPECT_NEAR(outputs[0][i], expected, 0.01f + 0.005f * expected);
+      // The values are rounded the same way on every rank, so the ranks get the same result.
+      for (uint32_t rank = 1; rank < rank_size; ++rank) {
+        ASSERT_EQ(outputs[rank][i], outputs[0][i]);
+      }
+    }
+  }
+}
+
+TEST_F(TestCollectiveEngine, BenchmarkLoopback) {
+  const uint32_t rank_size = 8;
+  for (size_t count : {256, 4 * 1024 * 1024}) {
+    std::vector<std::vector<float>> inputs(rank_size, std::vector<float>(count, 1.0f));
+    auto start = std::chrono::steady_clock::now();
+    auto outputs = RunAllReduce(inputs);
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    ASSERT_EQ(outputs[rank_size - 1][count - 1], static_cast<float>(rank_size));
+    MS_LOG(INFO) << "Loopback AllReduce of " << count << " floats over " << rank_size << " ranks costs "
+                 << cost.count() << "us.";
+  }
+}
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
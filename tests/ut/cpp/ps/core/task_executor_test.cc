@@ -0,0 +1,95 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "common/common_test.h"
+#include "ps/core/communicator/task_executor.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+namespace {
+bool WaitDone(const std::atomic<size_t> &done, size_t task_num) {
+  for (size_t i = 0; i < 5000; ++i) {
+    if (done.load() == task_num) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+}  // namespace
+
+class TestTaskExecutor : public UT::Common {
+ public:
+  TestTaskExecutor() = default;
+  virtual ~TestTaskExecutor() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// The tasks are started as soon as they're submitted, not one per interval.
+TEST_F(TestTaskExecutor, RunAllTasks) {
+  constexpr size_t kTaskNum = 20000;
+  TaskExecutor executor(4);
+  std::atomic<size_t> done(0);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    EXPECT_TRUE(executor.Submit([&done]() { done++; }));
+  }
+  EXPECT_TRUE(WaitDone(done, kTaskNum));
+  auto cost = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(std::chrono::duration_cast<std::chrono::seconds>(cost).count(), 2);
+}
+
+// The submission waits while the queue is full, and fails after the timeout.
+TEST_F(TestTaskExecutor, BoundedQueue) {
+  constexpr size_t kMaxTaskNum = 2;
+  constexpr size_t kSubmitTimeout = 50;
+  TaskExecutor executor(1, kMaxTaskNum, kSubmitTimeout);
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool opened = false;
+  std::atomic<size_t> done(0);
+  auto task = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [&opened] { return opened; });
+    done++;
+  };
+  // One task is taken by the working thread, and the others fill the queue.
+  EXPECT_TRUE(executor.Submit(task));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_TRUE(executor.Submit(task));
+  EXPECT_TRUE(executor.Submit(task));
+  EXPECT_FALSE(executor.Submit(task));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    opened = true;
+  }
+  cond.notify_all();
+  EXPECT_TRUE(WaitDone(done, kMaxTaskNum + 1));
+  EXPECT_TRUE(executor.Submit(task));
+  EXPECT_TRUE(WaitDone(done, kMaxTaskNum + 2));
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,278 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/core/communicator/epoll_tcp_client.h"
+#include "ps/core/communicator/epoll_tcp_server.h"
+#include "ps/core/communicator/tcp_client.h"
+#include "ps/core/communicator/tcp_server.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+namespace {
+constexpr size_t kRoundTripNum = 100;
+constexpr size_t kSmallMessageSize = 64;
+constexpr size_t kLargeMessageNum = 8;
+// Larger than the staging buffer of the epoll channel, so the data is read straight into the message buffers.
+constexpr size_t kLargeMessageSize = 4 * kReadStageSize;
+constexpr uint32_t kWaitSeconds = 30;
+// The serialized meta of the test messages is shorter than this.
+constexpr size_t kMetaSizeLimit = 64;
+
+unsigned char ByteAt(size_t message, size_t offset) { return static_cast<unsigned char>(message * 31 + offset); }
+}  // namespace
+
+// The functional tests of the libevent and the epoll tcp transports over loopback.
+class TestTcpTransport : public UT::Common {
+ public:
+  TestTcpTransport() = default;
+  virtual ~TestTcpTransport() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+ protected:
+  // The server echoes every message. Small messages make round trips one by one, and large ones are pipelined, so
+  // they are split and merged by the reads. Every echoed byte is checked.
+  void RunEcho(bool epoll) {
+    std::shared_ptr<TcpServer> server = epoll ? std::make_shared<EpollTcpServer>("127.0.0.1", 0)
+                                              : std::make_shared<TcpServer>("127.0.0.1", 0);
+    TcpServer *server_ptr = server.get();
+    server->SetMessageCallback([server_ptr](std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
+                                            const Protos &protos, const void *data, size_t size) {
+      server_ptr->SendMessage(conn, meta, protos, data, size);
+    });
+    server->Init();
+    std::thread server_thread([server_ptr]() { server_ptr->Start(); });
+
+    std::shared_ptr<TcpClient> client = epoll ? std::make_shared<EpollTcpClient>("127.0.0.1", server->BoundPort())
+                                              : std::make_shared<TcpClient>("127.0.0.1", server->BoundPort());
+    std::mutex mtx;
+    std::condition_variable cond;
+    size_t received = 0;
+    size_t corrupted = 0;
+    client->SetMessageCallback([&](std::shared_ptr<MessageMeta> meta, const Protos &, const void *data, size_t size) {
+      auto bytes = static_cast<const unsigned char *>(data);
+      size_t message = meta->request_id();
+      size_t expected_size = message < kRoundTripNum ? kSmallMessageSize : kLargeMessageSize;
+      std::lock_guard<std::mutex> lock(mtx);
+      if (size != expected_size) {
+        corrupted++;
+      } else {
+        for (size_t i = 0; i < size; ++i) {
+          if (bytes[i] != ByteAt(message, i)) {
+            corrupted++;
+            break;
+          }
+        }
+      }
+      received++;
+      cond.notify_all();
+    });
+    client->Init();
+    // The libevent base of the clients is polled here, because it may have been dispatched and broken by other tests.
+    std::atomic<bool> done(false);
+    std::thread client_thread;
+    if (!epoll) {
+      client_thread = std::thread([&]() {
+        while (!done.load()) {
+          client->StartWithNoBlock();
+        }
+      });
+    }
+    EXPECT_TRUE(client->WaitConnected(kWaitSeconds));
+
+    auto meta = std::make_shared<MessageMeta>();
+    meta->set_cmd(NodeCommand::SEND_DATA);
+    std::vector<unsigned char> small(kSmallMessageSize);
+    for (size_t i = 0; i < kRoundTripNum; ++i) {
+      meta->set_request_id(i);
+      for (size_t j = 0; j < small.size(); ++j) {
+        small[j] = ByteAt(i, j);
+      }
+      client->SendMessage(meta, Protos::RAW, small.data(), small.size());
+      std::unique_lock<std::mutex> lock(mtx);
+      if (!cond.wait_for(lock, std::chrono::seconds(kWaitSeconds), [&]() { return received == i + 1; })) {
+        break;
+      }
+    }
+
+    for (size_t i = kRoundTripNum; i < kRoundTripNum + kLargeMessageNum; ++i) {
+      meta->set_request_id(i);
+      DataPtr payload(new unsigned char[kLargeMessageSize]);
+      for (size_t j = 0; j < kLargeMessageSize; ++j) {
+        payload[j] = ByteAt(i, j);
+      }
+      client->SendMessage(meta, Protos::RAW, payload, kLargeMessageSize);
+    }
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      cond.wait_for(lock, std::chrono::seconds(kWaitSeconds),
+                    [&]() { return received == kRoundTripNum + kLargeMessageNum; });
+      EXPECT_EQ(received, kRoundTripNum + kLargeMessageNum);
+      EXPECT_EQ(corrupted, 0);
+    }
+
+    done = true;
+    if (client_thread.joinable()) {
+      client_thread.join();
+    }
+    client->Stop();
+    server->Stop();
+    server_thread.join();
+  }
+};
+
+TEST_F(TestTcpTransport, LibeventEcho) { RunEcho(false); }
+
+TEST_F(TestTcpTransport, EpollEcho) { RunEcho(true); }
+
+// The received buffer of a connection owns the data delivered to the server callback, so the server can keep the data
+// after the callback without copying it.
+TEST_F(TestTcpTransport, EpollReceivedBuffer) {
+  auto server = std::make_shared<EpollTcpServer>("127.0.0.1", 0);
+  std::mutex mtx;
+  std::condition_variable cond;
+  std::vector<std::pair<DataPtr, const unsigned char *>> kept;
+  size_t outside_buffer = 0;
+  size_t misaligned = 0;
+  server->SetMessageCallback([&](std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta>, const Protos &,
+                                 const void *data, size_t size) {
+    DataPtr buffer = conn->received_buffer();
+    auto bytes = static_cast<const unsigned char *>(data);
+    std::lock_guard<std::mutex> lock(mtx);
+    if (buffer == nullptr || bytes < buffer.get() ||
+        static_cast<size_t>(bytes - buffer.get()) >= kMessageDataAlignment + kMetaSizeLimit) {
+      outside_buffer++;
+    }
+    if (reinterpret_cast<uintptr_t>(bytes) % kMessageDataAlignment != 0) {
+      misaligned++;
+    }
+    kept.emplace_back(buffer, bytes);
+    cond.notify_all();
+  });
+  server->Init();
+  server->StartWithNoBlock();
+
+  auto client = std::make_shared<EpollTcpClient>("127.0.0.1", server->BoundPort());
+  client->Init();
+  EXPECT_TRUE(client->WaitConnected(kWaitSeconds));
+  auto meta = std::make_shared<MessageMeta>();
+  meta->set_cmd(NodeCommand::SEND_DATA);
+  const std::vector<size_t> sizes = {kSmallMessageSize, kLargeMessageSize, kSmallMessageSize};
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    DataPtr payload(new unsigned char[sizes[i]]);
+    for (size_t j = 0; j < sizes[i]; ++j) {
+      payload[j] = ByteAt(i, j);
+    }
+    client->SendMessage(meta, Protos::RAW, payload, sizes[i]);
+  }
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cond.wait_for(lock, std::chrono::seconds(kWaitSeconds), [&]() { return kept.size() == sizes.size(); });
+    EXPECT_EQ(kept.size(), sizes.size());
+    EXPECT_EQ(outside_buffer, 0);
+    EXPECT_EQ(misaligned, 0);
+    // The buffers of the later messages are new ones, so the data of the earlier messages is intact.
+    for (size_t i = 0; i < kept.size(); ++i) {
+      size_t mismatch = 0;
+      for (size_t j = 0; j < sizes[i]; ++j) {
+        mismatch += kept[i].second[j] != ByteAt(i, j) ? 1 : 0;
+      }
+      EXPECT_EQ(mismatch, 0);
+    }
+  }
+  client->Stop();
+  server->Stop();
+}
+
+// When one side closes the connection, the other side is notified and the server drops the connection.
+TEST_F(TestTcpTransport, EpollPeerDisconnect) {
+  auto server = std::make_shared<EpollTcpServer>("127.0.0.1", 0);
+  std::mutex mtx;
+  std::condition_variable cond;
+  size_t server_received = 0;
+  size_t server_disconnected = 0;
+  size_t client_disconnected = 0;
+  server->SetMessageCallback(
+    [&](std::shared_ptr<TcpConnection>, std::shared_ptr<MessageMeta>, const Protos &, const void *, size_t) {
+      std::lock_guard<std::mutex> lock(mtx);
+      server_received++;
+      cond.notify_all();
+    });
+  server->SetServerCallback(nullptr,
+                            [&](const TcpServer &, const TcpConnection &) {
+                              std::lock_guard<std::mutex> lock(mtx);
+                              server_disconnected++;
+                              cond.notify_all();
+                            },
+                            nullptr);
+  server->Init();
+  server->StartWithNoBlock();
+
+  auto meta = std::make_shared<MessageMeta>();
+  meta->set_cmd(NodeCommand::SEND_DATA);
+  std::vector<unsigned char> small(kSmallMessageSize);
+
+  // The client leaves, and the server sees the end of the stream after the message sent before it.
+  auto leaving = std::make_shared<EpollTcpClient>("127.0.0.1", server->BoundPort());
+  leaving->Init();
+  EXPECT_TRUE(leaving->WaitConnected(kWaitSeconds));
+  leaving->SendMessage(meta, Protos::RAW, small.data(), small.size());
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cond.wait_for(lock, std::chrono::seconds(kWaitSeconds), [&]() { return server_received == 1; });
+  }
+  leaving->Stop();
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cond.wait_for(lock, std::chrono::seconds(kWaitSeconds), [&]() { return server_disconnected == 1; });
+    EXPECT_EQ(server_received, 1);
+    EXPECT_EQ(server_disconnected, 1);
+  }
+  // A closed client fails to send instead of raising SIGPIPE.
+  EXPECT_FALSE(leaving->SendMessage(meta, Protos::RAW, small.data(), small.size()));
+
+  // The server leaves, and the connected client is notified.
+  auto staying = std::make_shared<EpollTcpClient>("127.0.0.1", server->BoundPort());
+  staying->set_disconnected_callback([&]() {
+    std::lock_guard<std::mutex> lock(mtx);
+    client_disconnected++;
+    cond.notify_all();
+  });
+  staying->Init();
+  EXPECT_TRUE(staying->WaitConnected(kWaitSeconds));
+  server->Stop();
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cond.wait_for(lock, std::chrono::seconds(kWaitSeconds), [&]() { return client_disconnected == 1; });
+    EXPECT_EQ(client_disconnected, 1);
+  }
+  staying->Stop();
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/ps_cache/embedding_hash_map.h"
+
+namespace mindspore {
+namespace ps {
+class TestEmbeddingHashMap : public UT::Common {
+ public:
+  TestEmbeddingHashMap() = default;
+  virtual ~TestEmbeddingHashMap() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+ protected:
+  // Fill the 4 free positions of a map of capacity 6 in step 1, access all the ids but the last one again, and
+  // return the id swapped out for a new id in step 2.
+  int SwapOutId(CachePolicy policy) {
+    EmbeddingHashMap hash_map(0, 6, policy);
+    std::vector<int> swap_out_index(4);
+    std::vector<int> swap_out_ids(4);
+    size_t swap_out_size = 0;
+    bool need_wait_graph = false;
+    for (int id = 10; id < 14; ++id) {
+      EXPECT_NE(hash_map.ParseData(id, swap_out_index.data(), swap_out_ids.data(), 1, 1, &swap_out_size,
+                                   &need_wait_graph),
+                INVALID_INDEX_VALUE);
+    }
+    EXPECT_EQ(swap_out_size, 0);
+    for (int i = 0; i < 3; ++i) {
+      for (int id = 10; id < 13; ++id) {
+        hash_map.RecordAccess(id, hash_map.hash_id_to_index().Find(id));
+      }
+    }
+    hash_map.Reset();
+    auto index =
+      hash_map.ParseData(20, swap_out_index.data(), swap_out_ids.data(), 2, 2, &swap_out_size, &need_wait_graph);
+    EXPECT_EQ(swap_out_size, 1);
+    EXPECT_FALSE(need_wait_graph);
+    EXPECT_EQ(hash_map.hash_id_to_index().Find(20), index);
+    EXPECT_EQ(hash_map.hash_id_to_index().Find(swap_out_ids[0]), INVALID_INDEX_VALUE);
+    return swap_out_ids[0];
+  }
+};
+
+TEST_F(TestEmbeddingHashMap, IdToIndexMap) {
+  HashIdToIndexMap map(100);
+  for (int id = 0; id < 100; ++id) {
+    map.Insert(id * 16, id);
+  }
+  ASSERT_EQ(map.size(), 100);
+  for (int id = 0; id < 100; id += 2) {
+    map.Erase(id * 16);
+  }
+  ASSERT_EQ(map.size(), 50);
+  for (int id = 0; id < 100; ++id) {
+    EXPECT_EQ(map.Find(id * 16), id % 2 == 0 ? INVALID_INDEX_VALUE : id);
+  }
+  map.Insert(16, 7);
+  EXPECT_EQ(map.Find(16), 7);
+  size_t count = 0;
+  map.ForEach([&count](int, int) { count++; });
+  EXPECT_EQ(count, 50);
+}
+
+TEST_F(TestEmbeddingHashMap, CachePolicyName) {
+  EXPECT_EQ(CachePolicyFromName("tinylfu"), CachePolicy::kTinyLfu);
+  EXPECT_EQ(CachePolicyName(CachePolicy::kClock), "clock");
+  EXPECT_ANY_THROW(CachePolicyFromName("lru"));
+}
+
+TEST_F(TestEmbeddingHashMap, SwapOutVictim) {
+  // The step policy swaps out the first expired id, the frequency policies the one accessed least.
+  EXPECT_EQ(SwapOutId(CachePolicy::kStep), 10);
+  EXPECT_EQ(SwapOutId(CachePolicy::kLfu), 13);
+  EXPECT_EQ(SwapOutId(CachePolicy::kTinyLfu), 13);
+}
+}  // namespace ps
+}  // namespace mindspore
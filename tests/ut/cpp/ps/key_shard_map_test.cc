@@ -0,0 +1,163 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/key_shard_map.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr Key kKeyNum = 1000;
+}  // namespace
+
+class TestKeyShardMap : public UT::Common {
+ public:
+  TestKeyShardMap() = default;
+  virtual ~TestKeyShardMap() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+ protected:
+  std::vector<std::string> servers_ = {"127.0.0.1:6000", "127.0.0.1:6001", "127.0.0.1:6002"};
+};
+
+TEST_F(TestKeyShardMap, SameRingOnEveryNode) {
+  KeyShardMap map;
+  map.SetServers(servers_);
+  KeyShardMap other;
+  other.SetServers({servers_[2], servers_[0], servers_[1]});
+  std::map<std::string, size_t> key_nums;
+  for (Key key = 0; key < kKeyNum; key++) {
+    EXPECT_EQ(map.Owner(key), other.Owner(key));
+    key_nums[map.Owner(key)]++;
+  }
+  EXPECT_EQ(key_nums.size(), servers_.size());
+  for (const auto &server : servers_) {
+    EXPECT_GT(key_nums[server], kKeyNum / servers_.size() / 2);
+  }
+}
+
+TEST_F(TestKeyShardMap, OnlyKeysOfChangedServerMove) {
+  KeyShardMap map;
+  map.SetServers(servers_);
+  std::vector<std::string> owners;
+  for (Key key = 0; key < kKeyNum; key++) {
+    owners.push_back(map.Owner(key));
+  }
+
+  const std::string new_server = "127.0.0.1:6003";
+  std::vector<std::string> scaled_out = servers_;
+  scaled_out.push_back(new_server);
+  map.SetServers(scaled_out);
+  size_t moved_num = 0;
+  for (Key key = 0; key < kKeyNum; key++) {
+    if (map.Owner(key) != owners[key]) {
+      EXPECT_EQ(map.Owner(key), new_server);
+      moved_num++;
+    }
+  }
+  EXPECT_GT(moved_num, 0);
+  EXPECT_LT(moved_num, kKeyNum / 2);
+
+  map.SetServers({servers_[0], servers_[2]});
+  for (Key key = 0; key < kKeyNum; key++) {
+    if (owners[key] != servers_[1]) {
+      EXPECT_EQ(map.Owner(key), owners[key]);
+    } else {
+      EXPECT_NE(map.Owner(key), servers_[1]);
+    }
+  }
+}
+
+TEST_F(TestKeyShardMap, PinsOverrideRing) {
+  KeyShardMap map;
+  map.SetServers(servers_);
+  std::vector<Key> keys;
+  for (Key key = 0; key < kKeyNum; key++) {
+    keys.push_back(key);
+  }
+  std::vector<std::string> owners;
+  for (const auto &key : keys) {
+    owners.push_back(map.Owner(key));
+  }
+  map.PinOwners(keys);
+  map.SetServers({servers_[0], servers_[1], servers_[2], "127.0.0.1:6003"});
+  for (const auto &key : keys) {
+    EXPECT_EQ(map.Owner(key), owners[key]);
+  }
+
+  Key key = 0;
+  std::string other = owners[key] == servers_[0] ? servers_[1] : servers_[0];
+  map.Pin(key, other);
+  EXPECT_EQ(map.Owner(key), other);
+  map.Unpin(key);
+  EXPECT_EQ(map.Owner(key), map.RingOwner(key));
+
+  // The pins to a server which leaves are dropped, so the keys fall back to the ring.
+  map.SetServers({servers_[0], servers_[2]});
+  for (const auto &key : keys) {
+    if (owners[key] == servers_[1]) {
+      EXPECT_EQ(map.Owner(key), map.RingOwner(key));
+    } else if (key != 0) {
+      EXPECT_EQ(map.Owner(key), owners[key]);
+    }
+  }
+}
+
+TEST_F(TestKeyShardMap, PlanRebalance) {
+  KeyShardMap map;
+  map.SetServers(servers_);
+  std::unordered_map<Key, double> key_loads;
+  for (Key key = 0; key < 30; key++) {
+    key_loads[key] = 1;
+    map.Pin(key, servers_[0]);
+  }
+  key_loads[30] = 20;
+  map.Pin(30, servers_[0]);
+
+  auto moves = map.PlanRebalance(key_loads, kRebalanceLoadTolerance);
+  EXPECT_FALSE(moves.empty());
+  std::map<std::string, double> server_loads;
+  for (const auto &key_load : key_loads) {
+    auto iter = moves.find(key_load.first);
+    std::string owner = iter == moves.end() ? map.Owner(key_load.first) : iter->second;
+    EXPECT_TRUE(map.HasServer(owner));
+    server_loads[owner] += key_load.second;
+  }
+  // The hottest key moves first, and the rest are spread so no server is far above the average of 50 / 3.
+  EXPECT_NE(moves.count(30), 0);
+  for (const auto &server_load : server_loads) {
+    EXPECT_LE(server_load.second, 20);
+  }
+
+  // Balanced loads are not moved.
+  KeyShardMap balanced;
+  balanced.SetServers(servers_);
+  std::unordered_map<Key, double> balanced_loads;
+  for (size_t i = 0; i < servers_.size(); i++) {
+    balanced.Pin(i, servers_[i]);
+    balanced_loads[i] = 10;
+  }
+  EXPECT_TRUE(balanced.PlanRebalance(balanced_loads, kRebalanceLoadTolerance).empty());
+}
+}  // namespace ps
+}  // namespace mindspore
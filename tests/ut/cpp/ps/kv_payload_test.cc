@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/kv_payload.h"
+
+namespace mindspore {
+namespace ps {
+class TestKVPayload : public UT::Common {
+ public:
+  TestKVPayload() = default;
+  virtual ~TestKVPayload() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(TestKVPayload, CreateAndParse) {
+  size_t size = KVPayload::Size(2, 2, 5);
+  std::vector<unsigned char> buffer(size);
+  KVPayload payload = KVPayload::Create(buffer.data(), size, 2, 2, 5);
+  payload.keys()[0] = 3;
+  payload.keys()[1] = 7;
+  payload.lens()[0] = 2;
+  payload.lens()[1] = 3;
+  for (size_t i = 0; i < 5; i++) {
+    payload.values()[i] = static_cast<float>(i) * 0.5f;
+  }
+  // The values start at an aligned offset, so the kernels may read them in place.
+  EXPECT_EQ((reinterpret_cast<unsigned char *>(payload.values()) - buffer.data()) % kKVPayloadAlignment, 0);
+
+  KVPayload parsed = KVPayload::Parse(buffer.data(), size);
+  EXPECT_EQ(parsed.key_num(), 2);
+  EXPECT_EQ(parsed.len_num(), 2);
+  EXPECT_EQ(parsed.value_num(), 5);
+  EXPECT_EQ(parsed.keys()[1], 7);
+  EXPECT_EQ(parsed.lens()[1], 3);
+  EXPECT_EQ(parsed.values()[4], 2.0f);
+}
+
+TEST_F(TestKVPayload, ParseMalformed) {
+  size_t size = KVPayload::Size(1, 1, 4);
+  std::vector<unsigned char> buffer(size);
+  (void)KVPayload::Create(buffer.data(), size, 1, 1, 4);
+  EXPECT_TRUE(KVPayload::IsKVPayload(buffer.data(), size));
+  EXPECT_ANY_THROW(KVPayload::Parse(buffer.data(), size - sizeof(float)));
+  EXPECT_ANY_THROW(KVPayload::Parse(buffer.data(), sizeof(KVPayloadHeader) - 1));
+  buffer[0] ^= 0x1;
+  EXPECT_FALSE(KVPayload::IsKVPayload(buffer.data(), size));
+  EXPECT_ANY_THROW(KVPayload::Parse(buffer.data(), size));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/server/model_version.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+class TestModelVersion : public UT::Common {
+ public:
+  TestModelVersion() = default;
+  virtual ~TestModelVersion() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+ protected:
+  std::map<std::string, AddressPtr> MakeModel(std::vector<float> *weight, std::vector<float> *bias) {
+    std::map<std::string, AddressPtr> model;
+    model["weight"] = std::make_shared<kernel::Address>(weight->data(), weight->size() * sizeof(float));
+    model["bias"] = std::make_shared<kernel::Address>(bias->data(), bias->size() * sizeof(float));
+    return model;
+  }
+};
+
+TEST_F(TestModelVersion, SharePages) {
+  const size_t page_elements = kModelPageSize / sizeof(float);
+  // Three pages and a half.
+  std::vector<float> weight(page_elements * 7 / 2);
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight[i] = static_cast<float>(i);
+  }
+  std::vector<float> bias(10, 1.0f);
+  auto first = ModelVersion::Build(1, MakeModel(&weight, &bias), nullptr);
+  ASSERT_EQ(first->weights().at("weight").pages.size(), 4);
+
+  // Change the second page of the weight and the bias.
+  weight[page_elements + 3] = -1.0f;
+  bias[9] = 2.0f;
+  auto second = ModelVersion::Build(2, MakeModel(&weight, &bias), first);
+  const auto &first_pages = first->weights().at("weight").pages;
+  const auto &second_pages = second->weights().at("weight").pages;
+  EXPECT_EQ(first_pages[0], second_pages[0]);
+  EXPECT_NE(first_pages[1], second_pages[1]);
+  EXPECT_EQ(first_pages[3], second_pages[3]);
+  EXPECT_EQ(second->ChangedPages("weight", *first), std::vector<size_t>({1}));
+  EXPECT_EQ(second->ChangedPages("bias", *first), std::vector<size_t>({0}));
+
+  // The models are not changed by the later ones.
+  std::vector<float> output(weight.size());
+  ASSERT_TRUE(first->CopyWeight("weight", output.data(), output.size() * sizeof(float)));
+  EXPECT_EQ(output[page_elements + 3], static_cast<float>(page_elements + 3));
+  ASSERT_TRUE(second->CopyWeight("weight", output.data(), output.size() * sizeof(float)));
+  EXPECT_EQ(output, weight);
+  EXPECT_FALSE(second->CopyWeight("weight", output.data(), 100));
+
+  // A shared model has the same pages, so there's no delta.
+  auto third = ModelVersion::Share(3, *second);
+  EXPECT_EQ(third->iteration(), 3);
+  EXPECT_TRUE(third->ChangedPages("weight", *second).empty());
+
+  std::vector<float> delta(page_elements);
+  ASSERT_TRUE(third->CopyPages("weight", {1}, delta.data(), delta.size() * sizeof(float)));
+  EXPECT_EQ(delta[3], -1.0f);
+}
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#include "ps/parameter_server.h"
+#include "ps/util.h"
+#undef private
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr Key kTestKey = 1000;
+constexpr size_t kWeightSize = 4;
+
+kernel::AddressPtr MakeAddress(std::vector<float> *buffer) {
+  auto address = std::make_shared<kernel::Address>();
+  address->addr = buffer->data();
+  address->size = buffer->size() * sizeof(float);
+  return address;
+}
+}  // namespace
+
+class TestParameterServer : public UT::Common {
+ public:
+  TestParameterServer() = default;
+  virtual ~TestParameterServer() = default;
+
+  void SetUp() override {
+    auto &ps = ParameterServer::GetInstance();
+    if (ps.server_node_ == nullptr) {
+      ps.server_node_ = std::make_shared<core::ServerNode>();
+    }
+  }
+
+  void TearDown() override {
+    auto &ps = ParameterServer::GetInstance();
+    (void)ps.weights_.erase(kTestKey);
+    (void)ps.grads_.erase(kTestKey);
+    (void)ps.grads_accum_counter_.erase(kTestKey);
+    (void)ps.tokens_.erase(kTestKey);
+    (void)ps.push_admissions_.erase(kTestKey);
+    (void)ps.is_embedding_.erase(kTestKey);
+    (void)ps.optim_infos_.erase(kTestKey);
+    (void)ps.optim_inputs_shape_.erase(kTestKey);
+    (void)ps.original_optim_inputs_shape_.erase(kTestKey);
+    (void)ps.weight_key_to_optims_.erase(kTestKey);
+    (void)ps.weight_key_to_optim_op_.erase(kTestKey);
+    (void)ps.imported_optim_states_.erase(kTestKey);
+    ps.moving_keys_.clear();
+    ps.moved_keys_.clear();
+  }
+
+ protected:
+  // The state of a Momentum key, whose accumulation is the only optimizer state.
+  KeyStateMessage MakeMomentumState(float base) {
+    KeyStateMessage state;
+    state.set_key(kTestKey);
+    state.set_optim_id(Util::optimizer_id(kApplyMomentum));
+    for (size_t i = 0; i < kWeightSize; ++i) {
+      state.add_weight(base + i);
+    }
+    state.add_optim_state_len(SizeToInt(kWeightSize));
+    for (size_t i = 0; i < kWeightSize; ++i) {
+      state.add_optim_states(base * 10 + i);
+    }
+    return state;
+  }
+};
+
+// The weight and the accumulation of a Momentum key migrated from another server are restored when its optimizer info
+// is built by the first push.
+TEST_F(TestParameterServer, ImportAndRestoreMomentumKey) {
+  auto &ps = ParameterServer::GetInstance();
+  KeyStateMessage sent = MakeMomentumState(1.0);
+  KeyStateMessage received;
+  ASSERT_TRUE(received.ParseFromString(sent.SerializeAsString()));
+  ps.ImportKey(received);
+
+  ASSERT_EQ(ps.weights_.count(kTestKey), 1);
+  ASSERT_EQ(ps.weights_[kTestKey]->size(), kWeightSize);
+  for (size_t i = 0; i < kWeightSize; ++i) {
+    EXPECT_FLOAT_EQ((*ps.weights_[kTestKey])[i], 1.0 + i);
+  }
+  EXPECT_EQ(ps.weight_key_to_optims_[kTestKey], kApplyMomentum);
+  EXPECT_FALSE(ps.is_embedding_[kTestKey]);
+  EXPECT_EQ(ps.tokens_[kTestKey], 0);
+
+  // The inputs of Momentum are the weight, accumulation, learning rate, gradient and momentum.
+  std::vector<float> weight(kWeightSize, 0);
+  std::vector<float> accumulation(kWeightSize, 0);
+  std::vector<float> learning_rate(1, 0);
+  std::vector<float> gradient(kWeightSize, 0);
+  std::vector<float> momentum(1, 0);
+  auto optim_info =
+    std::make_shared<MomentumOptimInfo>(MakeAddress(&weight), MakeAddress(&accumulation), MakeAddress(&learning_rate),
+                                        MakeAddress(&gradient), MakeAddress(&momentum));
+  ps.RestoreOptimStates(kTestKey, optim_info);
+  for (size_t i = 0; i < kWeightSize; ++i) {
+    EXPECT_FLOAT_EQ(accumulation[i], 10.0 + i);
+  }
+  EXPECT_FLOAT_EQ(learning_rate[0], 0);
+  EXPECT_FLOAT_EQ(momentum[0], 0);
+  EXPECT_TRUE(ps.imported_optim_states_[kTestKey].empty());
+
+  // The key sent again, whose first confirmation is lost, leaves the key as it is.
+  ps.ImportKey(MakeMomentumState(2.0));
+  for (size_t i = 0; i < kWeightSize; ++i) {
+    EXPECT_FLOAT_EQ((*ps.weights_[kTestKey])[i], 1.0 + i);
+  }
+  EXPECT_TRUE(ps.imported_optim_states_[kTestKey].empty());
+}
+
+// The key in the middle of a step is not migrated, nor is the key whose target server doesn't confirm it, and the key
+// stays on this server in both cases.
+TEST_F(TestParameterServer, MigrateKeyNotDone) {
+  auto &ps = ParameterServer::GetInstance();
+  ps.ImportKey(MakeMomentumState(1.0));
+  const std::string target = "127.0.0.1:1";
+
+  ps.push_admissions_[kTestKey] = 1;
+  EXPECT_FALSE(ps.MigrateKey(kTestKey, target));
+  ps.push_admissions_[kTestKey] = 0;
+  ps.grads_accum_counter_[kTestKey] = 1;
+  EXPECT_FALSE(ps.MigrateKey(kTestKey, target));
+  ps.grads_accum_counter_[kTestKey] = 0;
+  ps.tokens_[kTestKey] = 1;
+  EXPECT_FALSE(ps.MigrateKey(kTestKey, target));
+  ps.tokens_[kTestKey] = 0;
+
+  // The target is not in the cluster, so it can't confirm the key.
+  EXPECT_FALSE(ps.MigrateKey(kTestKey, target));
+  EXPECT_EQ(ps.weights_.count(kTestKey), 1);
+  std::string owner;
+  EXPECT_FALSE(ps.MovedKey(kTestKey, &owner));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,185 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/ps_cache/pending_push_queue.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr size_t kEmbeddingSize = 2;
+constexpr size_t kTableKey = 3;
+
+std::shared_ptr<PendingPush> MakePush(const std::vector<int> &ids, float value) {
+  auto push = std::make_shared<PendingPush>();
+  push->key = kTableKey;
+  push->ids = ids;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    push->id_to_row[ids[i]] = i;
+    push->values.insert(push->values.end(), kEmbeddingSize, value);
+  }
+  return push;
+}
+
+// The pushes wait at the gate until it's opened.
+class PushGate {
+ public:
+  void Open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    opened_ = true;
+    cond_.notify_all();
+  }
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return opened_; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool opened_{false};
+};
+}  // namespace
+
+class TestPendingPushQueue : public UT::Common {
+ public:
+  TestPendingPushQueue() = default;
+  virtual ~TestPendingPushQueue() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// The pushes are sent in order, and their rows are looked up in the queue until they are sent, the newest first.
+TEST_F(TestPendingPushQueue, PushInOrderAndLookUp) {
+  PendingPushQueue queue;
+  PushGate gate;
+  std::vector<float> pushed_values;
+  queue.Start([&](const PendingPush &push) {
+    gate.Wait();
+    pushed_values.push_back(push.values[0]);
+    return true;
+  });
+  EXPECT_TRUE(queue.Add(MakePush({1, 2}, 1.0)));
+  EXPECT_TRUE(queue.Add(MakePush({2, 3}, 2.0)));
+
+  const std::vector<int> ids = {1, 2, 3, 4};
+  std::vector<float> output(ids.size() * kEmbeddingSize, 0);
+  std::vector<int> missing_ids;
+  std::vector<size_t> missing_positions;
+  queue.LookUp(kTableKey, ids.data(), ids.size(), kEmbeddingSize, output.data(), &missing_ids, &missing_positions);
+  const std::vector<float> expected_output = {1.0, 1.0, 2.0, 2.0, 2.0, 2.0, 0, 0};
+  EXPECT_EQ(output, expected_output);
+  EXPECT_EQ(missing_ids, std::vector<int>({4}));
+  EXPECT_EQ(missing_positions, std::vector<size_t>({3}));
+
+  // The rows of other tables are not taken.
+  missing_ids.clear();
+  missing_positions.clear();
+  queue.LookUp(kTableKey + 1, ids.data(), ids.size(), kEmbeddingSize, output.data(), &missing_ids, &missing_positions);
+  EXPECT_EQ(missing_ids, ids);
+
+  // The ids still being pushed are not pulled ahead.
+  std::vector<int> prefetch_ids = ids;
+  queue.RemovePendingIds(kTableKey, &prefetch_ids);
+  EXPECT_EQ(prefetch_ids, std::vector<int>({4}));
+
+  gate.Open();
+  EXPECT_TRUE(queue.WaitEmpty());
+  EXPECT_EQ(pushed_values, std::vector<float>({1.0, 2.0}));
+  queue.Stop();
+  EXPECT_FALSE(queue.Add(MakePush({1}, 3.0)));
+}
+
+// The data processing is blocked while the queue is full.
+TEST_F(TestPendingPushQueue, BoundedQueue) {
+  constexpr size_t kMaxPushNum = 2;
+  PendingPushQueue queue(kMaxPushNum);
+  PushGate gate;
+  queue.Start([&](const PendingPush &) {
+    gate.Wait();
+    return true;
+  });
+  std::atomic<size_t> added(0);
+  std::thread producer([&]() {
+    for (size_t i = 0; i < kMaxPushNum + 2; ++i) {
+      EXPECT_TRUE(queue.Add(MakePush({SizeToInt(i)}, 1.0)));
+      added++;
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_LE(added.load(), kMaxPushNum);
+  EXPECT_LE(queue.size(), kMaxPushNum);
+  gate.Open();
+  producer.join();
+  EXPECT_TRUE(queue.WaitEmpty());
+  EXPECT_EQ(added.load(), kMaxPushNum + 2);
+}
+
+// A push failed is sent again, and it's removed only after the server has the rows.
+TEST_F(TestPendingPushQueue, RetryFailedPush) {
+  PendingPushQueue queue(kMaxPendingPushNum, 3, 1);
+  std::atomic<size_t> attempts(0);
+  queue.Start([&](const PendingPush &) {
+    size_t attempt = attempts++;
+    if (attempt == 0) {
+      throw std::runtime_error("The server is not reachable.");
+    }
+    return attempt >= 2;
+  });
+  EXPECT_TRUE(queue.Add(MakePush({1}, 1.0)));
+  EXPECT_TRUE(queue.WaitEmpty());
+  EXPECT_EQ(attempts.load(), 3);
+  EXPECT_TRUE(queue.running());
+}
+
+// The push still failing after the retries is kept, and the queue stops, so the caller stops the data processing.
+TEST_F(TestPendingPushQueue, StopOnPushFailure) {
+  constexpr size_t kRetryNum = 2;
+  PendingPushQueue queue(kMaxPendingPushNum, kRetryNum, 1);
+  std::atomic<size_t> attempts(0);
+  queue.Start([&](const PendingPush &) {
+    attempts++;
+    return false;
+  });
+  EXPECT_TRUE(queue.Add(MakePush({1}, 1.0)));
+  EXPECT_FALSE(queue.WaitEmpty());
+  EXPECT_EQ(attempts.load(), kRetryNum + 1);
+  EXPECT_FALSE(queue.running());
+  EXPECT_EQ(queue.size(), 1);
+  EXPECT_FALSE(queue.Add(MakePush({2}, 2.0)));
+
+  // The rows of the push kept are still found in the queue.
+  const int id = 1;
+  std::vector<float> output(kEmbeddingSize, 0);
+  std::vector<int> missing_ids;
+  std::vector<size_t> missing_positions;
+  queue.LookUp(kTableKey, &id, 1, kEmbeddingSize, output.data(), &missing_ids, &missing_positions);
+  EXPECT_TRUE(missing_ids.empty());
+  EXPECT_EQ(output, std::vector<float>(kEmbeddingSize, 1.0));
+}
+}  // namespace ps
+}  // namespace mindspore
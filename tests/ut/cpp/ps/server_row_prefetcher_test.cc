@@ -0,0 +1,211 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/ps_cache/server_row_prefetcher.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr size_t kEmbeddingSize = 2;
+constexpr size_t kTableKey = 3;
+
+// The pulls wait at the gate until it's opened.
+class PullGate {
+ public:
+  void Open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    opened_ = true;
+    cond_.notify_all();
+  }
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return opened_; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool opened_{false};
+};
+
+// The server has the id plus the version as the rows of the id.
+class FakeServer {
+ public:
+  bool Pull(const std::vector<int> &ids, std::vector<float> *values) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    values->clear();
+    for (auto id : ids) {
+      values->insert(values->end(), kEmbeddingSize, IntToFloat(id) + version_);
+      pulled_ids_.push_back(id);
+    }
+    return true;
+  }
+  void set_version(float version) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    version_ = version;
+  }
+  std::vector<int> pulled_ids() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pulled_ids_;
+  }
+
+ private:
+  std::mutex mutex_;
+  float version_{0};
+  std::vector<int> pulled_ids_;
+};
+
+void StartPrefetcher(ServerRowPrefetcher *prefetcher, FakeServer *server, PullGate *gate = nullptr) {
+  prefetcher->Start(
+    {kTableKey},
+    [server, gate](size_t, const std::vector<int> &ids, std::vector<float> *values) {
+      if (gate != nullptr) {
+        gate->Wait();
+      }
+      return server->Pull(ids, values);
+    },
+    [](size_t, std::vector<int> *) {});
+}
+
+bool WaitStaged(ServerRowPrefetcher *prefetcher, size_t staged_size) {
+  for (size_t i = 0; i < 1000; ++i) {
+    if (prefetcher->staged_size() == staged_size) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+}  // namespace
+
+class TestServerRowPrefetcher : public UT::Common {
+ public:
+  TestServerRowPrefetcher() = default;
+  virtual ~TestServerRowPrefetcher() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// The ids wanted by several batches are pulled once, and the rows staged are taken at their positions.
+TEST_F(TestServerRowPrefetcher, PullOnceAcrossBatches) {
+  ServerRowPrefetcher prefetcher;
+  FakeServer server;
+  StartPrefetcher(&prefetcher, &server);
+  EXPECT_TRUE(prefetcher.Add(2, {1, 2, 3}));
+  EXPECT_TRUE(prefetcher.Add(3, {2, 3, 4}));
+  EXPECT_TRUE(WaitStaged(&prefetcher, 4));
+  EXPECT_EQ(server.pulled_ids(), std::vector<int>({1, 2, 3, 4}));
+
+  std::vector<int> ids = {5, 2, 4};
+  std::vector<size_t> positions = {0, 1, 2};
+  std::vector<float> output(ids.size() * kEmbeddingSize, 0);
+  EXPECT_EQ(prefetcher.Take(kTableKey, kEmbeddingSize, output.data(), &ids, &positions), 2);
+  EXPECT_EQ(output, std::vector<float>({0, 0, 2.0, 2.0, 4.0, 4.0}));
+  EXPECT_EQ(ids, std::vector<int>({5}));
+  EXPECT_EQ(positions, std::vector<size_t>({0}));
+  EXPECT_EQ(prefetcher.hit_num(), 2);
+
+  // The rows taken are not taken again, and the rows of other tables are not taken.
+  ids = {2, 1};
+  positions = {0, 1};
+  EXPECT_EQ(prefetcher.Take(kTableKey, kEmbeddingSize, output.data(), &ids, &positions), 1);
+  EXPECT_EQ(ids, std::vector<int>({2}));
+  EXPECT_EQ(prefetcher.Take(kTableKey + 1, kEmbeddingSize, output.data(), &ids, &positions), 0);
+  prefetcher.Stop();
+  EXPECT_FALSE(prefetcher.Add(4, {5}));
+}
+
+// The rows staged are dropped once the last batch wanting them has been processed.
+TEST_F(TestServerRowPrefetcher, FinishDropsRows) {
+  ServerRowPrefetcher prefetcher;
+  FakeServer server;
+  StartPrefetcher(&prefetcher, &server);
+  EXPECT_TRUE(prefetcher.Add(2, {1, 2}));
+  EXPECT_TRUE(prefetcher.Add(3, {2, 3}));
+  EXPECT_TRUE(WaitStaged(&prefetcher, 3));
+  prefetcher.Finish(2);
+  EXPECT_EQ(prefetcher.staged_size(), 2);
+  std::vector<int> ids = {1, 2, 3};
+  std::vector<size_t> positions = {0, 1, 2};
+  std::vector<float> output(ids.size() * kEmbeddingSize, 0);
+  EXPECT_EQ(prefetcher.Take(kTableKey, kEmbeddingSize, output.data(), &ids, &positions), 2);
+  EXPECT_EQ(ids, std::vector<int>({1}));
+  prefetcher.Finish(3);
+  EXPECT_EQ(prefetcher.staged_size(), 0);
+}
+
+// A row pushed to the server while it's staged or being pulled is dropped, and pulled again when wanted again.
+TEST_F(TestServerRowPrefetcher, InvalidateOnPush) {
+  ServerRowPrefetcher prefetcher;
+  FakeServer server;
+  PullGate gate;
+  StartPrefetcher(&prefetcher, &server, &gate);
+  EXPECT_TRUE(prefetcher.Add(2, {1, 2}));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  prefetcher.Invalidate(kTableKey, {1});
+  gate.Open();
+  EXPECT_TRUE(WaitStaged(&prefetcher, 2));
+  prefetcher.Invalidate(kTableKey, {2});
+
+  std::vector<int> ids = {1, 2};
+  std::vector<size_t> positions = {0, 1};
+  std::vector<float> output(ids.size() * kEmbeddingSize, 0);
+  EXPECT_EQ(prefetcher.Take(kTableKey, kEmbeddingSize, output.data(), &ids, &positions), 0);
+  EXPECT_EQ(ids, std::vector<int>({1, 2}));
+
+  prefetcher.Finish(2);
+  server.set_version(10.0);
+  EXPECT_TRUE(prefetcher.Add(3, {1}));
+  EXPECT_TRUE(WaitStaged(&prefetcher, 1));
+  ids = {1};
+  positions = {0};
+  EXPECT_EQ(prefetcher.Take(kTableKey, kEmbeddingSize, output.data(), &ids, &positions), 1);
+  EXPECT_EQ(output[0], 11.0);
+}
+
+// The ids still being pushed are not pulled, and the requests are dropped instead of holding the caller up.
+TEST_F(TestServerRowPrefetcher, SkipPendingAndBoundRequests) {
+  constexpr size_t kMaxRequestNum = 1;
+  ServerRowPrefetcher prefetcher(kMaxRequestNum);
+  FakeServer server;
+  PullGate gate;
+  prefetcher.Start(
+    {kTableKey},
+    [&](size_t, const std::vector<int> &ids, std::vector<float> *values) {
+      gate.Wait();
+      return server.Pull(ids, values);
+    },
+    [](size_t, std::vector<int> *ids) { ids->erase(std::remove(ids->begin(), ids->end(), 2), ids->end()); });
+  EXPECT_TRUE(prefetcher.Add(2, {1, 2}));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_TRUE(prefetcher.Add(3, {3}));
+  EXPECT_FALSE(prefetcher.Add(4, {4}));
+  gate.Open();
+  EXPECT_TRUE(WaitStaged(&prefetcher, 3));
+  EXPECT_EQ(server.pulled_ids(), std::vector<int>({1, 3}));
+}
+}  // namespace ps
+}  // namespace mindspore
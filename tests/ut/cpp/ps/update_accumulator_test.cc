@@ -0,0 +1,129 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/server/update_accumulator.h"
+
+namespace mindspore {
+namespace ps {
+namespace server {
+class TestUpdateAccumulator : public UT::Common {
+ public:
+  TestUpdateAccumulator() = default;
+  virtual ~TestUpdateAccumulator() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(TestUpdateAccumulator, ConcurrentDense) {
+  const size_t count = 1003;
+  const size_t thread_num = 16;
+  const size_t update_num = 50;
+  UpdateAccumulator accumulator;
+  accumulator.Initialize(count, 4);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<float> update(count);
+      for (size_t i = 0; i < count; ++i) {
+        update[i] = static_cast<float>(t + i % 7);
+      }
+      for (size_t n = 0; n < update_num; ++n) {
+        EXPECT_TRUE(accumulator.AccumulateDense(update.data(), count, 2));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::vector<float> output(count);
+  EXPECT_EQ(accumulator.Merge(output.data()), thread_num * update_num * 2);
+  for (size_t i = 0; i < count; ++i) {
+    float expected = 0;
+    for (size_t t = 0; t < thread_num; ++t) {
+      expected += static_cast<float>((t + i % 7) * update_num);
+    }
+    ASSERT_FLOAT_EQ(output[i], expected) << "i:" << i;
+  }
+
+  // Nothing is left after Reset.
+  accumulator.Reset();
+  EXPECT_EQ(accumulator.Merge(output.data()), 0);
+  EXPECT_FLOAT_EQ(output[count - 1], 0.0f);
+}
+
+TEST_F(TestUpdateAccumulator, CompressedUpdates) {
+  const size_t count = 37;
+  UpdateAccumulator accumulator;
+  accumulator.Initialize(count, 2);
+
+  // Three blocks of 13, 13 and 11 values.
+  std::vector<int8_t> int8_data(count);
+  for (size_t i = 0; i < count; ++i) {
+    int8_data[i] = static_cast<int8_t>(static_cast<int>(i) - 18);
+  }
+  std::vector<float> scales = {0.5f, 1.0f, 2.0f};
+  EXPECT_TRUE(accumulator.AccumulateInt8(int8_data.data(), count, scales.data(), scales.size(), 13, 3));
+
+  std::vector<int> indices = {36, 0, 20};
+  std::vector<float> values = {1.5f, -1.0f, 4.0f};
+  EXPECT_TRUE(accumulator.AccumulateSparse(indices.data(), values.data(), indices.size(), 5));
+
+  // The bad updates are rejected without changing the sum.
+  std::vector<int> bad_indices = {1, 37, 2};
+  EXPECT_FALSE(accumulator.AccumulateSparse(bad_indices.data(), values.data(), bad_indices.size(), 1));
+  EXPECT_FALSE(accumulator.AccumulateInt8(int8_data.data(), count - 1, scales.data(), scales.size(), 13, 1));
+  EXPECT_FALSE(accumulator.AccumulateInt8(int8_data.data(), count, scales.data(), 0, 13, 1));
+  EXPECT_FALSE(accumulator.AccumulateInt8(int8_data.data(), count, scales.data(), scales.size(), 0, 1));
+  EXPECT_FALSE(accumulator.AccumulateInt8(int8_data.data(), count, scales.data(), scales.size(), 10, 1));
+
+  std::vector<float> output(count);
+  EXPECT_EQ(accumulator.Merge(output.data()), 8);
+  for (size_t i = 0; i < count; ++i) {
+    float expected = static_cast<float>(int8_data[i]) * scales[i / 13];
+    for (size_t j = 0; j < indices.size(); ++j) {
+      if (static_cast<size_t>(indices[j]) == i) {
+        expected += values[j];
+      }
+    }
+    ASSERT_FLOAT_EQ(output[i], expected) << "i:" << i;
+  }
+}
+
+// The block size is given by the client, so the blocks are not taken as even as the scale number allows.
+TEST_F(TestUpdateAccumulator, Int8ShortLastBlock) {
+  const size_t count = 37;
+  const size_t block_size = 16;
+  UpdateAccumulator accumulator;
+  accumulator.Initialize(count, 1);
+
+  // Three blocks of 16, 16 and 5 values, while blocks of 13, 13 and 11 values would take the same number of scales.
+  std::vector<int8_t> int8_data(count, 1);
+  std::vector<float> scales = {0.5f, 1.0f, 2.0f};
+  EXPECT_TRUE(accumulator.AccumulateInt8(int8_data.data(), count, scales.data(), scales.size(), block_size, 1));
+
+  std::vector<float> output(count);
+  EXPECT_EQ(accumulator.Merge(output.data()), 1);
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_FLOAT_EQ(output[i], scales[i / block_size]) << "i:" << i;
+  }
+}
+}  // namespace server
+}  // namespace ps
+}  // namespace mindspore
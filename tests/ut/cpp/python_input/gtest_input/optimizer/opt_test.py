@@ -365,6 +365,23 @@ def test_cse(tag):
         d = scalar_add(b, c)
         return d
 
+    @fns
+    def test_f3(x, y):
+        a = scalar_add(x, y)
+        b = scalar_add(y, x)
+        c = scalar_mul(a, b)
+        return c
+
+    @fns
+    def test_f4(x, y):
+        a = scalar_add(x, y)
+
+        def inner():
+            return scalar_add(x, y)
+
+        c = scalar_mul(a, inner())
+        return c
+
     return fns[tag]
 
 
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include "common/common_test.h"
+#include "runtime/framework/static_memory_planner.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kBlockSize = 1024;
+
+bool IsRangeOverlapped(const StaticMemoryBlock &first, const StaticMemoryBlock &second) {
+  return (first.offset_ < second.offset_ + second.size_) && (second.offset_ < first.offset_ + first.size_);
+}
+}  // namespace
+
+class TestStaticMemoryPlanner : public UT::Common {
+ public:
+  TestStaticMemoryPlanner() = default;
+  virtual ~TestStaticMemoryPlanner() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// In a chain of kernels, each output is read by the next kernel only, so the outputs reuse two blocks in turn.
+TEST_F(TestStaticMemoryPlanner, ChainReuse) {
+  constexpr size_t kKernelNum = 16;
+  StaticMemoryPlanner planner(kKernelNum);
+  for (size_t i = 1; i < kKernelNum; ++i) {
+    planner.AddDependency(i - 1, i);
+  }
+  for (size_t i = 0; i < kKernelNum; ++i) {
+    std::vector<size_t> consumers;
+    if (i + 1 < kKernelNum) {
+      consumers.emplace_back(i + 1);
+    }
+    (void)planner.AddBlock(kBlockSize, i, consumers, false);
+    // The workspace is used in the launch of its kernel only.
+    (void)planner.AddBlock(kBlockSize / 2, i, {}, false);
+  }
+
+  auto peak = planner.Plan();
+  EXPECT_LT(peak, planner.total_block_size());
+  EXPECT_LE(peak, 2 * kBlockSize + kBlockSize / 2);
+  // The output of a kernel is written while its input is read, so they never share the memory.
+  const auto &blocks = planner.blocks();
+  for (size_t i = 1; i < kKernelNum; ++i) {
+    const auto &input = blocks[2 * (i - 1)];
+    const auto &output = blocks[2 * i];
+    const auto &workspace = blocks[2 * i + 1];
+    EXPECT_FALSE(IsRangeOverlapped(input, output));
+    EXPECT_FALSE(IsRangeOverlapped(input, workspace));
+    EXPECT_FALSE(IsRangeOverlapped(output, workspace));
+  }
+}
+
+// The kernels without the dependency may be launched in any order, so their blocks don't share the memory even if one
+// block is used up earlier in the execution order.
+TEST_F(TestStaticMemoryPlanner, IndependentKernels) {
+  auto plan = [](bool is_dependent) {
+    // Kernel 0 outputs to kernel 1, and kernel 2 outputs to kernel 3.
+    StaticMemoryPlanner planner(4);
+    planner.AddDependency(0, 1);
+    planner.AddDependency(2, 3);
+    if (is_dependent) {
+      planner.AddDependency(1, 2);
+    }
+    (void)planner.AddBlock(kBlockSize, 0, {1}, false);
+    (void)planner.AddBlock(kBlockSize, 2, {3}, false);
+    auto peak = planner.Plan();
+    return std::make_pair(peak, IsRangeOverlapped(planner.blocks()[0], planner.blocks()[1]));
+  };
+  auto independent = plan(false);
+  EXPECT_EQ(independent.first, 2 * kBlockSize);
+  EXPECT_FALSE(independent.second);
+  auto dependent = plan(true);
+  EXPECT_EQ(dependent.first, kBlockSize);
+  EXPECT_TRUE(dependent.second);
+}
+
+// The block read by the actor out of the plan keeps its own memory.
+TEST_F(TestStaticMemoryPlanner, LiveForeverBlock) {
+  constexpr size_t kKernelNum = 4;
+  StaticMemoryPlanner planner(kKernelNum);
+  for (size_t i = 1; i < kKernelNum; ++i) {
+    planner.AddDependency(i - 1, i);
+  }
+  (void)planner.AddBlock(kBlockSize, 0, {}, true);
+  for (size_t i = 1; i < kKernelNum; ++i) {
+    (void)planner.AddBlock(kBlockSize, i, {}, false);
+  }
+  EXPECT_EQ(planner.Plan(), 2 * kBlockSize);
+  const auto &blocks = planner.blocks();
+  for (size_t i = 1; i < kKernelNum; ++i) {
+    EXPECT_FALSE(IsRangeOverlapped(blocks[0], blocks[i]));
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
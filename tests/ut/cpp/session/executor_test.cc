@@ -0,0 +1,169 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#include "backend/session/executor.h"
+#undef private
+
+namespace mindspore {
+namespace session {
+namespace {
+const ShapeVector kShape = {2, 3};
+
+// Adds its two inputs into the output placeholder, so the ops queued read the outputs of the ones before.
+class AddSession : public SessionBasic {
+ public:
+  explicit AddSession(bool is_failed) : is_failed_(is_failed) {}
+  ~AddSession() override = default;
+
+  void RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info, std::vector<tensor::TensorPtr> *input_tensors,
+                 VectorRef *outputs, const std::vector<int64_t> &tensors_mask) override {
+    // The caller reaches the output before the op is run.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (is_failed_) {
+      MS_LOG(EXCEPTION) << "Run op " << op_run_info->op_name << " failed.";
+    }
+    // The op run synchronously has no placeholder, its output is created here.
+    auto output = op_run_info->output_placeholder;
+    if (output == nullptr) {
+      output = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, kShape);
+    }
+    auto x = static_cast<float *>((*input_tensors)[0]->data_c());
+    auto y = static_cast<float *>((*input_tensors)[1]->data_c());
+    auto z = static_cast<float *>(output->data_c());
+    for (size_t i = 0; i < output->DataSize(); ++i) {
+      z[i] = x[i] + y[i];
+    }
+    outputs->push_back(output);
+  }
+
+ private:
+  bool is_failed_;
+};
+
+OpRunInfo MakeAddRunInfo() {
+  OpRunInfo op_run_info;
+  op_run_info.op_name = "Add";
+  op_run_info.primitive = std::make_shared<Primitive>("Add");
+  op_run_info.abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, kShape);
+  return op_run_info;
+}
+
+tensor::TensorPtr RunAdd(Executor *executor, const SessionPtr &session, const tensor::TensorPtr &x,
+                         const tensor::TensorPtr &y, bool is_grad_needed) {
+  auto op_run_info = MakeAddRunInfo();
+  op_run_info.is_grad_needed = is_grad_needed;
+  std::vector<tensor::TensorPtr> inputs = {x, y};
+  VectorRef outputs;
+  executor->RunOp(session, &op_run_info, "Add", &inputs, &outputs, {0, 0});
+  EXPECT_EQ(outputs.size(), 1);
+  return utils::cast<tensor::TensorPtr>(outputs[0]);
+}
+
+tensor::TensorPtr RunAddAsync(Executor *executor, const SessionPtr &session, const tensor::TensorPtr &x,
+                              const tensor::TensorPtr &y) {
+  auto op_run_info = MakeAddRunInfo();
+  std::vector<tensor::TensorPtr> inputs = {x, y};
+  VectorRef outputs;
+  EXPECT_TRUE(executor->RunOpAsync(session, &op_run_info, "Add", &inputs, &outputs, {0, 0}));
+  EXPECT_EQ(outputs.size(), 1);
+  return utils::cast<tensor::TensorPtr>(outputs[0]);
+}
+}  // namespace
+
+class TestExecutor : public UT::Common {
+ public:
+  TestExecutor() = default;
+  virtual ~TestExecutor() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// The outputs of the ops queued are returned before they run, and hold the results once they are synced.
+TEST_F(TestExecutor, RunOpAsync) {
+  Executor executor(kCPUDevice, 0);
+  SessionPtr session = std::make_shared<AddSession>(false);
+  std::vector<float> x_data = {1, 2, 3, 4, 5, 6};
+  auto x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, kShape, x_data.data(), kNumberTypeFloat32);
+
+  auto y = RunAddAsync(&executor, session, x, x);
+  auto z = RunAddAsync(&executor, session, y, x);
+  ASSERT_NE(z, nullptr);
+  EXPECT_TRUE(z->NeedWait());
+  EXPECT_EQ(z->data_type(), kNumberTypeFloat32);
+  EXPECT_EQ(z->shape(), kShape);
+
+  z->data_sync(true);
+  EXPECT_FALSE(z->NeedWait());
+  auto z_data = static_cast<float *>(z->data_c());
+  for (size_t i = 0; i < x_data.size(); ++i) {
+    EXPECT_FLOAT_EQ(z_data[i], 3 * x_data[i]);
+  }
+}
+
+// The exception of the op queued is raised to the caller waiting on its output, once only.
+TEST_F(TestExecutor, RunOpAsyncException) {
+  Executor executor(kCPUDevice, 0);
+  SessionPtr session = std::make_shared<AddSession>(true);
+  auto x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, kShape);
+
+  auto y = RunAddAsync(&executor, session, x, x);
+  ASSERT_NE(y, nullptr);
+  EXPECT_ANY_THROW(y->Wait());
+  EXPECT_NO_THROW(y->Wait());
+
+  // The op failed before the wait starts raises the exception as well.
+  auto z = RunAddAsync(&executor, session, x, x);
+  ASSERT_NE(z, nullptr);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_ANY_THROW(z->data_sync(true));
+}
+
+// The op whose outputs are needed by the grad is run synchronously even if the ops are run asynchronously, as the
+// bprop graph reads its output at once. It still waits for its inputs queued before.
+TEST_F(TestExecutor, RunOpWithGrad) {
+  (void)setenv("ENV_PYNATIVE_ASYNC_RUN_OP", "1", 1);
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  ms_context->set_param<std::string>(MS_CTX_DEVICE_TARGET, kCPUDevice);
+  Executor executor(kCPUDevice, 0);
+  SessionPtr session = std::make_shared<AddSession>(false);
+  std::vector<float> x_data = {1, 2, 3, 4, 5, 6};
+  auto x = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, kShape, x_data.data(), kNumberTypeFloat32);
+
+  auto y = RunAdd(&executor, session, x, x, false);
+  ASSERT_NE(y, nullptr);
+  EXPECT_TRUE(y->NeedWait());
+  auto z = RunAdd(&executor, session, y, x, true);
+  ASSERT_NE(z, nullptr);
+  EXPECT_FALSE(y->NeedWait());
+  EXPECT_FALSE(z->NeedWait());
+  auto z_data = static_cast<float *>(z->data_c());
+  for (size_t i = 0; i < x_data.size(); ++i) {
+    EXPECT_FLOAT_EQ(z_data[i], 3 * x_data[i]);
+  }
+  (void)unsetenv("ENV_PYNATIVE_ASYNC_RUN_OP");
+}
+}  // namespace session
+}  // namespace mindspore
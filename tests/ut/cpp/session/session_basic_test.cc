@@ -94,5 +94,34 @@ TEST_F(SessionBasicTest, ConstructKernelGraph) {
   EXPECT_EQ(AnfAlgo::GetCNodeName(new_outputs[0]), prim::kPrimMul->name());
 };
 
+TEST_F(SessionBasicTest, SingleOpSignature) {
+  auto make_graph_info = [](const std::vector<int64_t> &strides, const std::vector<int64_t> &input_shape,
+                            const std::string &format = "NCHW", bool format_first = false) {
+    auto prim = std::make_shared<Primitive>("Conv2D");
+    if (format_first) {
+      prim->AddAttr("format", MakeValue(format));
+    }
+    prim->AddAttr("stride", MakeValue(strides));
+    if (!format_first) {
+      prim->AddAttr("format", MakeValue(format));
+    }
+    SingleOpSignature signature;
+    signature.AddTensor(std::make_shared<tensor::Tensor>(kNumberTypeFloat32, input_shape));
+    signature.AddAttrs(prim);
+    return signature.ToGraphInfo(prim->name());
+  };
+  auto graph_info = make_graph_info({1, 1}, {1, 3, 8, 8});
+  EXPECT_EQ(graph_info, make_graph_info({1, 1}, {1, 3, 8, 8}));
+  EXPECT_EQ(graph_info, make_graph_info({1, 1}, {1, 3, 8, 8}, "NCHW", true));
+  EXPECT_EQ(graph_info.find("Conv2D_"), 0);
+  // Tuple attrs of the same size but different elements must not share a graph.
+  EXPECT_NE(graph_info, make_graph_info({2, 2}, {1, 3, 8, 8}));
+  EXPECT_NE(graph_info, make_graph_info({1, 1}, {1, 3, 8, 16}));
+  EXPECT_NE(graph_info, make_graph_info({1, 1}, {1, 3, 8, 8}, "NHWC"));
+  // The packed numbers can be split again, so moving a digit between two dims changes the key.
+  EXPECT_NE(make_graph_info({1, 1}, {1, 33}), make_graph_info({1, 1}, {13, 3}));
+  EXPECT_NE(make_graph_info({1, 1}, {100000, 1}), make_graph_info({1, 1}, {1, 100000}));
+}
+
 }  // namespace session
 }  // namespace mindspore
\ No newline at end of file
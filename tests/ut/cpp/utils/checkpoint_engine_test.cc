@@ -0,0 +1,92 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/common_test.h"
+#include "utils/checkpoint/checkpoint_engine.h"
+
+namespace mindspore {
+namespace checkpoint {
+class TestCheckpointEngine : public UT::Common {
+ public:
+  TestCheckpointEngine() = default;
+  void TearDown() override { (void)std::remove(file_name_.c_str()); }
+
+ protected:
+  std::vector<std::pair<std::string, tensor::TensorPtr>> MakeTensors() {
+    std::vector<float> weight(1000);
+    for (size_t i = 0; i < weight.size(); ++i) {
+      weight[i] = static_cast<float>(i) * 0.5f;
+    }
+    std::vector<int32_t> step = {7};
+    auto weight_tensor =
+      std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{10, 100}, weight.data(), weight.size() * 4);
+    auto step_tensor = std::make_shared<tensor::Tensor>(kNumberTypeInt32, ShapeVector{}, step.data(), sizeof(int32_t));
+    return {{"conv.weight", weight_tensor}, {"global_step", step_tensor}};
+  }
+
+  std::string file_name_ = "./checkpoint_engine_test.ckpt";
+};
+
+TEST_F(TestCheckpointEngine, test_save_and_load) {
+  auto tensors = MakeTensors();
+  auto writer = std::make_shared<CheckpointWriter>(file_name_);
+  writer->Snapshot(tensors);
+  // The snapshot is written, not the tensors updated by the next step.
+  static_cast<float *>(tensors[0].second->data_c())[0] = -1.0f;
+  writer->WriteAsync();
+  writer->Wait();
+  ASSERT_TRUE(IsCheckpointFile(file_name_));
+
+  CheckpointReader reader(file_name_);
+  ASSERT_EQ(reader.Names(), std::vector<std::string>({"conv.weight", "global_step"}));
+  auto loaded = reader.ReadAll(reader.Names());
+  ASSERT_EQ(loaded.size(), 2);
+  ASSERT_EQ(loaded[0]->shape(), ShapeVector({10, 100}));
+  ASSERT_EQ(loaded[0]->data_type(), kNumberTypeFloat32);
+  auto weight = static_cast<float *>(loaded[0]->data_c());
+  ASSERT_EQ(weight[0], 0.0f);
+  ASSERT_EQ(weight[999], 499.5f);
+  ASSERT_EQ(loaded[1]->shape(), ShapeVector());
+  ASSERT_EQ(static_cast<int32_t *>(loaded[1]->data_c())[0], 7);
+}
+
+TEST_F(TestCheckpointEngine, test_corrupted_data) {
+  // Flip a bit of the last tensor, which is at the end of the file.
+  CheckpointWriter writer(file_name_);
+  writer.Snapshot(MakeTensors());
+  writer.Write();
+  (void)std::remove((file_name_ + ".bad").c_str());
+  {
+    std::ifstream ifs(file_name_, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    content[content.size() - sizeof(int32_t)] ^= 0x1;
+    std::ofstream ofs(file_name_ + ".bad", std::ios::binary);
+    ofs << content;
+  }
+  CheckpointReader reader(file_name_ + ".bad");
+  ASSERT_NE(reader.Read("conv.weight"), nullptr);
+  EXPECT_ANY_THROW(reader.Read("global_step"));
+  (void)std::remove((file_name_ + ".bad").c_str());
+}
+}  // namespace checkpoint
+}  // namespace mindspore
@@ -0,0 +1,65 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+import os
+import numpy as np
+
+import mindspore as ms
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+from mindspore.parallel._planner import plan
+from tests.ut.python.ops.test_math_ops import VirtualLoss
+
+
+class NetWithLoss(nn.Cell):
+    def __init__(self, network):
+        super(NetWithLoss, self).__init__()
+        self.loss = VirtualLoss()
+        self.network = network
+
+    def construct(self, x, y, b):
+        predict = self.network(x, y, b)
+        return self.loss(predict)
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.matmul1 = P.MatMul()
+        self.matmul2 = P.MatMul()
+
+    def construct(self, x, y, b):
+        out = self.matmul1(x, y)
+        out = self.matmul2(out, b)
+        return out
+
+
+def network_factory():
+    x = Tensor(np.ones([128, 32]), dtype=ms.float32)
+    y = Tensor(np.ones([32, 64]), dtype=ms.float32)
+    b = Tensor(np.ones([64, 64]), dtype=ms.float32)
+    return NetWithLoss(Net()), (x, y, b)
+
+
+def test_parallel_planner(tmpdir):
+    topology = {"device_num": 8,
+                "candidates": [{"auto_parallel_search_mode": "recursive_programming"},
+                               {"auto_parallel_search_mode": "dynamic_programming"}]}
+    results = plan(network_factory, topology, str(tmpdir))
+    assert len(results) == 2
+    # The recursive programming search does not estimate costs, so it is ranked after the searched costs.
+    assert results[0]["config"]["auto_parallel_search_mode"] == "dynamic_programming"
+    assert results[0]["stage_costs"]
+    for result in results:
+        assert os.path.exists(result["strategy_ckpt_file"])
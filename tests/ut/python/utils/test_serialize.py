@@ -324,6 +324,30 @@ def test_save_and_load_checkpoint_for_network_with_encryption():
         os.remove(ckpt_path)
 
 
+def test_save_and_load_checkpoint_for_network_with_native_format():
+    """ test save and load checkpoint for network through the native checkpoint engine"""
+    net = Net()
+    loss = SoftmaxCrossEntropyWithLogits(sparse=True)
+    opt = Momentum(net.trainable_params(), 0.0, 0.9, 0.0001, 1024)
+
+    loss_net = WithLossCell(net, loss)
+    train_network = TrainOneStepCell(loss_net, opt)
+    ckpt_path = "./native_ckpt.ckpt"
+    save_checkpoint(train_network, ckpt_file_name=ckpt_path, async_save=True, native_format=True)
+    save_checkpoint(train_network, ckpt_file_name=ckpt_path, native_format=True)
+    param_dict = load_checkpoint(ckpt_path, filter_prefix="moments")
+    assert not [name for name in param_dict if name.startswith("moments")]
+    for param in train_network.get_parameters():
+        if not param.name.startswith("moments"):
+            assert np.array_equal(param_dict[param.name].data.asnumpy(), param.data.asnumpy())
+    load_param_into_net(net, param_dict)
+    with pytest.raises(ValueError):
+        save_checkpoint(train_network, ckpt_file_name=ckpt_path, enc_key=os.urandom(16), native_format=True)
+    if os.path.exists(ckpt_path):
+        os.chmod(ckpt_path, stat.S_IWRITE)
+        os.remove(ckpt_path)
+
+
 class MYNET(nn.Cell):
     """ NET definition """
 